@@ -0,0 +1,79 @@
+-- Benchmark: storage and read latency of kept cache versions, full vs delta bodies
+--
+-- Start the fixture server first:
+--   python3 benchmark/fixture_server.py --port 8765 &
+-- Then run:
+--   duckdb -unsigned < benchmark/cache_delta_storage.sql
+--
+-- 2k /mutating/<n> pages (~4.4KB, ~10% of the bytes change per day) are
+-- recrawled on 10 simulated days with crawler_cache_keep_versions = 10, once
+-- storing full bodies and once storing deltas. Each variant reports stored
+-- bytes and the time to read all 20k versions back with crawler_cache_history().
+
+LOAD crawler;
+SET crawler_default_delay = 0;
+SET crawler_respect_robots = false;
+SET crawler_cache_keep_versions = 10;
+
+CREATE TABLE bench_urls AS
+SELECT 'http://127.0.0.1:8765/mutating/' || i AS url FROM range(2000) t(i);
+
+CREATE TABLE results (variant VARCHAR, versions BIGINT, logical_bytes BIGINT, stored_bytes BIGINT);
+
+CREATE MACRO recrawl() AS TABLE
+SELECT count(*) AS pages FROM crawl('SELECT url FROM bench_urls', cache_ttl := 0, workers := 16);
+
+CREATE MACRO next_day() AS TABLE
+SELECT c.status_code FROM crawl_url('http://127.0.0.1:8765/_next_day', cache := false) c;
+
+CREATE MACRO stored_bytes() AS
+    (SELECT sum(body_bytes) FROM __crawler_cache) +
+    (SELECT coalesce(sum(body_bytes), 0) FROM __crawler_cache_versions) +
+    (SELECT coalesce(sum(body_bytes), 0) FROM __crawler_cache_base);
+
+-- 1. Full bodies
+SET crawler_cache_delta = false;
+SELECT * FROM recrawl(); SELECT * FROM next_day();
+SELECT * FROM recrawl(); SELECT * FROM next_day();
+SELECT * FROM recrawl(); SELECT * FROM next_day();
+SELECT * FROM recrawl(); SELECT * FROM next_day();
+SELECT * FROM recrawl(); SELECT * FROM next_day();
+SELECT * FROM recrawl(); SELECT * FROM next_day();
+SELECT * FROM recrawl(); SELECT * FROM next_day();
+SELECT * FROM recrawl(); SELECT * FROM next_day();
+SELECT * FROM recrawl(); SELECT * FROM next_day();
+SELECT * FROM recrawl();
+
+.timer on
+SELECT count(*), sum(octet_length(encode(body))) FROM crawler_cache_history();
+.timer off
+
+INSERT INTO results
+SELECT 'full', count(*), sum(octet_length(encode(body))), stored_bytes() FROM crawler_cache_history();
+
+-- 2. Delta bodies, same recrawl sequence from a fresh cache
+DELETE FROM __crawler_cache;
+DELETE FROM __crawler_cache_versions;
+DELETE FROM __crawler_cache_base;
+SET crawler_cache_delta = true;
+SELECT * FROM recrawl(); SELECT * FROM next_day();
+SELECT * FROM recrawl(); SELECT * FROM next_day();
+SELECT * FROM recrawl(); SELECT * FROM next_day();
+SELECT * FROM recrawl(); SELECT * FROM next_day();
+SELECT * FROM recrawl(); SELECT * FROM next_day();
+SELECT * FROM recrawl(); SELECT * FROM next_day();
+SELECT * FROM recrawl(); SELECT * FROM next_day();
+SELECT * FROM recrawl(); SELECT * FROM next_day();
+SELECT * FROM recrawl(); SELECT * FROM next_day();
+SELECT * FROM recrawl();
+
+.timer on
+SELECT count(*), sum(octet_length(encode(body))) FROM crawler_cache_history();
+.timer off
+
+INSERT INTO results
+SELECT 'delta', count(*), sum(octet_length(encode(body))), stored_bytes() FROM crawler_cache_history();
+
+SELECT variant, versions, logical_bytes, stored_bytes,
+       round(stored_bytes / logical_bytes, 3) AS storage_ratio
+FROM results;
@@ -0,0 +1,42 @@
+-- Benchmark: __crawler_cache hit latency while the cache is filled past crawler_cache_max_bytes
+--
+-- Start the fixture server first:
+--   python3 benchmark/fixture_server.py --port 8765 &
+-- Then run:
+--   duckdb -unsigned < benchmark/cache_hit_latency.sql
+--
+-- Each round fetches 20k new pages (forcing LRU eviction once the budget is
+-- reached) and then re-reads the 1k most recent ones from the cache. The hit
+-- query time should stay flat across rounds instead of growing with the
+-- number of pages ever fetched.
+
+LOAD crawler;
+SET crawler_default_delay = 0;
+SET crawler_respect_robots = false;
+SET crawler_cache_max_bytes = 64 * 1024 * 1024;
+
+CREATE MACRO fill_round(r) AS TABLE
+SELECT c.url FROM (
+    SELECT 'http://127.0.0.1:8765/page/' || (r * 20000 + i) AS url FROM range(20000) t(i)
+) s, LATERAL crawl_url(s.url) c;
+
+CREATE MACRO hit_round(r) AS TABLE
+SELECT count(c.html) AS hits FROM (
+    SELECT 'http://127.0.0.1:8765/page/' || (r * 20000 + 19000 + i) AS url FROM range(1000) t(i)
+) s, LATERAL crawl_url(s.url) c;
+
+.timer on
+
+SELECT count(*) FROM fill_round(0);
+SELECT * FROM hit_round(0);
+SELECT count(*) FROM fill_round(1);
+SELECT * FROM hit_round(1);
+SELECT count(*) FROM fill_round(2);
+SELECT * FROM hit_round(2);
+SELECT count(*) FROM fill_round(3);
+SELECT * FROM hit_round(3);
+
+.timer off
+
+SELECT count(*) AS entries, sum(body_bytes) AS bytes FROM __crawler_cache;
+SELECT * FROM crawler_cache_vacuum();
@@ -0,0 +1,39 @@
+-- Benchmark: crawl() link following on a duplicate-heavy site, dedupe off vs on
+--
+-- Start the fixture server first:
+--   python3 benchmark/fixture_server.py --port 8765 &
+-- Then run:
+--   duckdb -unsigned < benchmark/crawl_dedupe.sql
+--
+-- Every /dupsite/<n> page links to the next page four times: plain, with
+-- utm_source, with a sessionid and sorted by price (different HTML, same
+-- rel=canonical, plus a link to /dupsite/<n + 100>). Without dedupe each
+-- variant is fetched, returned and followed; with dedupe the tracking and
+-- session variants are never fetched and the sort variant is dropped after
+-- one fetch, without following its links.
+
+LOAD crawler;
+SET crawler_respect_robots = false;
+
+.timer on
+
+-- 1. No dedupe: every URL variant is fetched and stored
+CREATE TABLE pages_all AS
+SELECT url, canonical_url, html.document AS body
+FROM crawl('http://127.0.0.1:8765/dupsite/0', follow := 'a', max_depth := 1000,
+           delay := 0, cache := false, dedupe := false);
+
+-- 2. Dedupe: one row per canonical page
+CREATE TABLE pages_dedupe AS
+SELECT url, canonical_url, html.document AS body
+FROM crawl('http://127.0.0.1:8765/dupsite/0', follow := 'a', max_depth := 1000,
+           delay := 0, cache := false, dedupe := true);
+
+.timer off
+
+SELECT 'all' AS run, count(*) AS pages, count(DISTINCT canonical_url) AS canonical, sum(length(body)) AS stored_bytes
+FROM pages_all
+UNION ALL
+SELECT 'dedupe', count(*), count(DISTINCT canonical_url), sum(length(body)) FROM pages_dedupe;
+
+SELECT * FROM crawl_dedupe_stats();
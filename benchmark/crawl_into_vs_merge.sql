@@ -0,0 +1,45 @@
+-- Benchmark: CRAWL ... INTO (batched fetch + Appender) vs CRAWLING MERGE INTO (per-row SQL)
+--
+-- Start the fixture server first:
+--   python3 benchmark/fixture_server.py --port 8765 &
+-- Then run:
+--   duckdb -unsigned < benchmark/crawl_into_vs_merge.sql
+--
+-- Both variants fetch the same 100k local pages and extract the same fields.
+
+LOAD crawler;
+SET crawler_default_delay = 0;
+SET crawler_respect_robots = false;
+
+CREATE TABLE seeds AS
+SELECT 'http://127.0.0.1:8765/page/' || i AS url FROM range(100000) t(i);
+
+.timer on
+
+-- 1. Native CRAWL INTO: Rust workers fetch + extract, batches appended
+CRAWL (SELECT url FROM seeds)
+INTO pages_into
+EXTRACT (
+    jsonld.Product.name AS name,
+    jsonld.Product.offers.price AS price,
+    og.title AS og_title
+)
+WITH (max_parallel_per_domain 32, batch_size 256);
+
+-- 2. CRAWLING MERGE INTO: crawl_url() + one INSERT per row
+CRAWLING MERGE INTO pages_merge
+USING (
+    SELECT c.url,
+           c.html.schema['Product']->0->>'name' AS name,
+           c.html.schema['Product']->0->'offers'->>'price' AS price,
+           c.html.opengraph->>'title' AS og_title
+    FROM seeds, LATERAL crawl_url(seeds.url) c
+) AS src
+ON (src.url = pages_merge.url)
+WHEN NOT MATCHED THEN INSERT BY NAME;
+
+.timer off
+
+SELECT 'into' AS variant, count(*) AS pages, count(name) AS extracted FROM pages_into
+UNION ALL
+SELECT 'merge', count(*), count(name) FROM pages_merge;
@@ -0,0 +1,34 @@
+-- Benchmark: crawl_plan() over 10M seed URLs
+--
+-- No fixture server needed:
+--   duckdb -unsigned < benchmark/crawl_plan.sql
+--
+-- 10M seeds on 10k hosts; 2M of them are in the response cache and another
+-- 1M in the state table. Nothing is fetched, so the plan should take seconds
+-- (dominated by the cache semi-join and the per-URL host bookkeeping).
+
+LOAD crawler;
+
+CREATE TABLE seeds AS
+SELECT 'https://shop' || (i % 10000) || '.example.com/product/' || i AS url FROM range(10000000) t(i);
+
+-- Create the cache table, then fill it
+SELECT c.url FROM crawl_url('not-a-url-plan-benchmark') c;
+INSERT INTO __crawler_cache (url, status_code, content_type, body, body_bytes)
+SELECT url, 200, 'text/html', '<html></html>', 13 FROM seeds WHERE hash(url) % 5 = 0 LIMIT 2000000;
+
+CREATE TABLE crawl_state (url VARCHAR PRIMARY KEY, http_status INTEGER, extracted JSON,
+                          crawled_at TIMESTAMP, etag VARCHAR, last_modified VARCHAR);
+INSERT INTO crawl_state (url, http_status)
+SELECT url, 200 FROM seeds WHERE hash(url) % 5 = 1 LIMIT 1000000;
+
+.timer on
+
+CREATE TABLE plan AS
+SELECT * FROM crawl_plan('SELECT url FROM seeds', state_table := 'crawl_state', delay := 500);
+
+.timer off
+
+SELECT count(*) AS hosts, sum(urls) AS urls, sum(to_fetch) AS to_fetch, sum(cached) AS cached,
+       sum(skipped) AS skipped, max(min_duration_s) AS min_duration_s
+FROM plan;
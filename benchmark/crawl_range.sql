@@ -0,0 +1,38 @@
+-- Benchmark: crawl_range() end detection vs crawl() over a generated ID list
+--
+-- Start the fixture server first:
+--   python3 benchmark/fixture_server.py --port 8765 &
+-- Then run:
+--   duckdb -unsigned < benchmark/crawl_range.sql
+--
+-- /sparse/<n> is live for IDs 1..20000 except those ending in 3, 4 or 7. The
+-- generated list guesses an upper bound of 100k and fetches 80k 404s past the
+-- end; crawl_range() probes its way to ID 20000 (a few hundred requests) and
+-- fetches only the discovered range. Both should return the same 14k live pages.
+
+LOAD crawler;
+SET crawler_respect_robots = false;
+
+.timer on
+
+-- 1. Every ID up to a guessed bound
+CREATE TABLE by_list AS
+SELECT url, status
+FROM crawl((SELECT list('http://127.0.0.1:8765/sparse/' || i) FROM range(1, 100001) t(i)),
+           delay := 0, workers := 16, cache := false);
+
+-- 2. Galloping end detection, then the discovered range
+CREATE TABLE by_range AS
+SELECT url, status
+FROM crawl_range('http://127.0.0.1:8765/sparse/{n}', 1, delay := 0, workers := 16, cache := false);
+
+.timer off
+
+SELECT 'list' AS run, count(*) AS requests, count(*) FILTER (WHERE status = 200) AS live FROM by_list
+UNION ALL
+SELECT 'range', count(*), count(*) FILTER (WHERE status = 200) FROM by_range;
+
+-- Live pages missed by crawl_range(): must return no rows
+SELECT url FROM by_list WHERE status = 200
+EXCEPT
+SELECT url FROM by_range WHERE status = 200;
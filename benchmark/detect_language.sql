@@ -0,0 +1,52 @@
+-- Benchmark: language of 4k ~250KB pages, crawl(language := true) vs readability text + detect_language()
+--
+-- Start the fixture server first:
+--   python3 benchmark/fixture_server.py --port 8765 &
+-- Then run:
+--   duckdb -unsigned < benchmark/detect_language.sql
+--
+-- /multilang/<n> pages are English, German, Spanish or Finnish (n % 4), with
+-- navigation, inline scripts and styles before the text. Some declare their
+-- language (some wrongly, as "en"), some send Content-Language, some neither.
+-- The language column classifies a bounded text prefix during the extraction
+-- pass; the old route pulls the whole readability text out first. Accuracy
+-- should be 1.0 for both.
+
+LOAD crawler;
+SET crawler_default_delay = 0;
+SET crawler_respect_robots = false;
+
+-- Fetched once: the language column of an online crawl also sees Content-Language
+CREATE TABLE fetched AS
+SELECT url, language, html.document AS body
+FROM crawl((SELECT list('http://127.0.0.1:8765/multilang/' || i) FROM range(4000) t(i)), language := true);
+
+.timer on
+
+-- 1. Baseline: offline crawl without the language column
+SELECT count(*) FROM crawl((SELECT list(url) FROM fetched), offline := true);
+
+-- 2. Language column in the extraction pass
+CREATE TABLE detected AS
+SELECT url, language FROM crawl((SELECT list(url) FROM fetched), offline := true, language := true);
+
+-- 3. Old route: full readability text, then per-row detection
+CREATE TABLE via_readability AS
+SELECT url, detect_language(html.readability->>'$.text_content') AS language
+FROM crawl((SELECT list(url) FROM fetched), offline := true);
+
+-- 4. The scalar alone over stored bodies (bounded prefix of html_to_text())
+CREATE TABLE via_text AS
+SELECT url, detect_language(html_to_text(body, {'max_length': 4096})) AS language FROM fetched;
+
+.timer off
+
+CREATE MACRO expected_language(u) AS ['en', 'de', 'es', 'fi'][regexp_extract(u, '[0-9]+$')::INT % 4 + 1];
+
+SELECT 'fetched' AS run, avg((language = expected_language(url))::INT) AS accuracy FROM fetched
+UNION ALL SELECT 'language column', avg((language = expected_language(url))::INT) FROM detected
+UNION ALL SELECT 'readability + detect_language', avg((language = expected_language(url))::INT) FROM via_readability
+UNION ALL SELECT 'html_to_text + detect_language', avg((language = expected_language(url))::INT) FROM via_text;
+
+-- Mismatches: must return no rows
+SELECT url, language, expected_language(url) FROM detected WHERE language IS DISTINCT FROM expected_language(url);
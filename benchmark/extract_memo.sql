@@ -0,0 +1,41 @@
+-- Benchmark: repeated jq() / htmlpath() extraction over stored pages, memo off vs on
+--
+-- Start the fixture server first:
+--   python3 benchmark/fixture_server.py --port 8765 &
+-- Then run:
+--   duckdb -unsigned < benchmark/extract_memo.sql
+--
+-- 50k pages are crawled once into a table. The same extraction query then
+-- runs with crawler_extract_memo off (every body is parsed each time) and on:
+-- the first memo run parses and fills the connection's memo, later runs are
+-- served from it and should take milliseconds instead of seconds.
+
+LOAD crawler;
+SET crawler_default_delay = 0;
+SET crawler_respect_robots = false;
+
+CRAWL (SELECT 'http://127.0.0.1:8765/page/' || i AS url FROM range(50000) t(i))
+INTO pages
+WITH (max_parallel_per_domain 32, batch_size 256);
+
+CREATE MACRO extract_round() AS TABLE
+SELECT count(DISTINCT jq(body, 'h1').text) AS titles,
+       count(DISTINCT jq(body, 'p.price').text) AS prices,
+       count(DISTINCT htmlpath(body, 'a@href')::VARCHAR) AS links
+FROM pages;
+
+.timer on
+
+-- 1. No memo: parse every body on every run
+SET crawler_extract_memo = false;
+SELECT * FROM extract_round();
+SELECT * FROM extract_round();
+
+-- 2. Memo: the first run fills the memo, the second one is served from it
+SET crawler_extract_memo = true;
+SELECT * FROM extract_round();
+SELECT * FROM extract_round();
+
+.timer off
+
+SELECT * FROM crawler_extract_memo_stats();
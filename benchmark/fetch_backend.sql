@@ -0,0 +1,32 @@
+-- Benchmark: crawler_fetch_backend = 'reqwest' vs 'curl'
+--
+-- Start the fixture server first:
+--   python3 benchmark/fixture_server.py --port 8765 &
+-- Then run:
+--   duckdb -unsigned < benchmark/fetch_backend.sql
+--
+-- 1. crawl() over 2k pages: one fetch per call, so the reqwest path pays for a
+--    new client (and connection) every page while curl reuses its connections.
+-- 2. CRAWL INTO over 50k pages in batches of 256 with 32 concurrent requests.
+-- test/sql/fetch_backend.test checks that both return the same rows.
+
+LOAD crawler;
+SET crawler_default_delay = 0;
+SET crawler_respect_robots = false;
+
+.timer on
+
+SET crawler_fetch_backend = 'reqwest';
+SELECT count(*) FROM crawl((SELECT list('http://127.0.0.1:8765/page/' || i) FROM range(2000) t(i)), cache := false);
+CRAWL (SELECT 'http://127.0.0.1:8765/page/' || i AS url FROM range(50000) t(i)) INTO pages_reqwest
+WITH (respect_robots_txt false, default_crawl_delay 0, batch_size 256, max_parallel_per_domain 32);
+
+SET crawler_fetch_backend = 'curl';
+SELECT count(*) FROM crawl((SELECT list('http://127.0.0.1:8765/page/' || i) FROM range(2000) t(i)), cache := false);
+CRAWL (SELECT 'http://127.0.0.1:8765/page/' || i AS url FROM range(50000) t(i)) INTO pages_curl
+WITH (respect_robots_txt false, default_crawl_delay 0, batch_size 256, max_parallel_per_domain 32);
+
+.timer off
+
+SELECT (SELECT count(*) FROM pages_reqwest WHERE status_code = 200) AS reqwest_ok,
+       (SELECT count(*) FROM pages_curl WHERE status_code = 200) AS curl_ok;
@@ -0,0 +1,354 @@
+#!/usr/bin/env python3
+"""Local fixture server for crawler benchmarks.
+
+Serves synthetic product pages so benchmarks measure the crawler, not the
+network:
+
+    /page/<n>      HTML page with JSON-LD Product, OpenGraph and meta tags
+    /mutating/<n>  HTML page of which ~10% of the bytes change every "day"
+    /_next_day     advance the day used by /mutating/<n>
+    /large/<n>     ~250KB article page with navigation, scripts, styles and tables
+    /dupsite/<n>   page of a duplicate-heavy site: every page is linked under
+                   tracking, session and sort variants, all rel=canonical to /dupsite/<n>;
+                   the sort variant also links to /dupsite/<n + 100>
+    /redirect/<n>  302 redirect to /page/<n>
+    /gzip/<n>      /page/<n>, gzip-encoded when the client accepts it
+    /latin1/<n>    page declared and encoded as iso-8859-1
+    /status/<code> HTML error page with that status
+    /softsite/<n>  page of a site with soft 404s: links to the next page and to a
+                   removed page; with --soft-404 unknown paths (including removed
+                   pages) answer 200 with a "page not found" template; --soft-404-port
+                   serves them that way on a second port, next to the normal one
+    /sparse/<n>    /page/<n> for IDs up to 20000, except those ending in 3, 4 or 7
+                   (gaps of up to two IDs); 404 otherwise
+    /multilang/<n> ~250KB article page in English, German, Spanish or Finnish (n % 4),
+                   declared by <html lang> (n % 3 == 0, "en" whatever the text when
+                   n % 8 == 7), a Content-Language header (n % 3 == 1) or not at all
+    /echo/...      any method: JSON of the request's method, path, headers
+                   (lowercase names) and body
+    /robots.txt    allow-all, except /robots-blocked/
+
+Usage:
+    python3 benchmark/fixture_server.py [--port 8765] [--soft-404] [--soft-404-port 8766]
+"""
+
+import argparse
+import gzip
+import html
+import json
+import random
+import threading
+from http.server import BaseHTTPRequestHandler, ThreadingHTTPServer
+
+PAGE_TEMPLATE = """<!DOCTYPE html>
+<html lang="en">
+<head>
+<title>Product {n}</title>
+<meta name="description" content="Description of product {n}">
+<meta property="og:title" content="Product {n}">
+<script type="application/ld+json">
+{{"@context": "https://schema.org", "@type": "Product", "name": "Product {n}", "sku": "SKU-{n}",
+  "offers": {{"@type": "Offer", "price": "{price}", "priceCurrency": "EUR"}}}}
+</script>
+</head>
+<body>
+<h1>Product {n}</h1>
+<p class="price">{price} EUR</p>
+<div class="description">{filler}</div>
+<a href="/page/{next}">next</a>
+</body>
+</html>
+"""
+
+FILLER = "Lorem ipsum dolor sit amet, consectetur adipiscing elit. " * 40
+
+
+def render_page(n):
+    return PAGE_TEMPLATE.format(n=n, price=f"{(n % 1000) + 0.99:.2f}", filler=FILLER, next=n + 1)
+
+
+MUTATING_SECTIONS = 40
+day = 0
+
+
+def render_mutating_page(n, current_day):
+    # Each section changes on the days where (n + section + day) % 10 == 0, so
+    # about a tenth of the page differs from the previous day
+    sections = []
+    for section in range(MUTATING_SECTIONS):
+        version = (current_day + n + section) // 10
+        rng = random.Random(f"{n}/{section}/{version}")
+        words = " ".join(rng.choice(("alpha", "beta", "gamma", "delta", "omega", "sigma")) for _ in range(16))
+        sections.append(f'<p id="s{section}">{words}</p>')
+    return f"<!DOCTYPE html><html><head><title>Page {n}</title></head><body>{''.join(sections)}</body></html>"
+
+
+def render_large_page(n):
+    rng = random.Random(n)
+    words = ("crawler", "duckdb", "page", "extract", "table", "query", "html", "text", "index", "vector")
+    nav = "".join(f'<li><a href="/large/{i}">Section {i}</a></li>' for i in range(200))
+    paragraphs = "".join(
+        f"<h2>Part {i}</h2><p>{' '.join(rng.choice(words) for _ in range(120))}</p>"
+        f"<table><tr><td>{i}</td><td>{rng.random():.4f}</td></tr></table>"
+        for i in range(150)
+    )
+    script = "<script>var data = " + str([rng.random() for _ in range(2000)]) + ";</script>"
+    style = "<style>" + "".join(f".c{i} {{ margin: {i}px; }}" for i in range(500)) + "</style>"
+    return (
+        f"<!DOCTYPE html><html><head><title>Article {n}</title>{style}{script}</head>"
+        f"<body><nav><ul>{nav}</ul></nav><article><h1>Article {n}</h1>{paragraphs}</article>{script}</body></html>"
+    )
+
+
+MULTILANG_SENTENCES = {
+    "en": ("The committee will publish its final report on the new railway line early next year.",
+           "Most visitors arrive by train and stay for two or three nights in the old town.",
+           "The museum is closed on Mondays, but the garden remains open to the public."),
+    "de": ("Der Ausschuss wird seinen Abschlussbericht über die neue Bahnstrecke Anfang nächsten Jahres vorlegen.",
+           "Die meisten Besucher kommen mit dem Zug und bleiben zwei oder drei Nächte in der Altstadt.",
+           "Das Museum ist montags geschlossen, der Garten bleibt jedoch für die Öffentlichkeit geöffnet."),
+    "es": ("El comité publicará su informe final sobre la nueva línea de ferrocarril a principios del próximo año.",
+           "La mayoría de los visitantes llegan en tren y se quedan dos o tres noches en el casco antiguo.",
+           "El museo cierra los lunes, pero el jardín sigue abierto al público."),
+    "fi": ("Valiokunta julkaisee loppuraporttinsa uudesta rautatieyhteydestä ensi vuoden alussa.",
+           "Useimmat kävijät saapuvat junalla ja viipyvät vanhassakaupungissa kaksi tai kolme yötä.",
+           "Museo on suljettu maanantaisin, mutta puutarha on avoinna yleisölle."),
+}
+MULTILANG_LANGUAGES = ("en", "de", "es", "fi")
+
+
+def multilang_language(n):
+    return MULTILANG_LANGUAGES[n % 4]
+
+
+def render_multilang_page(n):
+    rng = random.Random(n)
+    sentences = MULTILANG_SENTENCES[multilang_language(n)]
+    nav = "".join(f'<li><a href="/multilang/{i}">{i}</a></li>' for i in range(200))
+    paragraphs = "".join(
+        f"<h2>{i}</h2><p>{' '.join(rng.choice(sentences) for _ in range(12))}</p>"
+        f"<table><tr><td>{i}</td><td>{rng.random():.4f}</td></tr></table>"
+        for i in range(150)
+    )
+    script = "<script>var data = " + str([rng.random() for _ in range(2000)]) + ";</script>"
+    style = "<style>" + "".join(f".c{i} {{ margin: {i}px; }}" for i in range(500)) + "</style>"
+    lang = ""
+    if n % 8 == 7:
+        lang = ' lang="en"'
+    elif n % 3 == 0:
+        lang = f' lang="{multilang_language(n)}"'
+    return (
+        f"<!DOCTYPE html><html{lang}><head><title>{n}</title>{style}{script}</head>"
+        f"<body><nav><ul>{nav}</ul></nav><article>{paragraphs}</article>{script}</body></html>"
+    )
+
+
+DUPSITE_PAGES = 500
+
+
+def render_dupsite_page(n, query):
+    # The sort variant renders differently, so only rel=canonical identifies it
+    order = "price" if "sort=price" in query else "name"
+    links = "".join(
+        f'<a href="/dupsite/{n + 1}{variant}">next</a>'
+        for variant in ("", "?utm_source=nav", f"?sessionid={n}", "?sort=price")
+    )
+    # Only the sort variant links here, so a followed duplicate shows up as an extra page
+    if order == "price":
+        links += f'<a href="/dupsite/{n + 100}">related</a>'
+    return (
+        f'<!DOCTYPE html><html><head><title>Item {n}</title>'
+        f'<link rel="canonical" href="/dupsite/{n}"></head>'
+        f'<body><h1>Item {n}</h1><p>Sorted by {order}</p><div>{FILLER}</div>{links}</body></html>'
+    )
+
+
+SOFTSITE_PAGES = 500
+
+SOFT_404_TEMPLATE = """<!DOCTYPE html>
+<html lang="en">
+<head><title>Page not found</title></head>
+<body>
+<header><a href="/">Home</a> <a href="/softsite/0">Catalog</a></header>
+<div class="box">
+<h1>Sorry, we could not find that page</h1>
+<p>The page {path} does not exist or has been moved. Try the search, or go back to the home page.</p>
+</div>
+<footer>Shipping within two days</footer>
+</body>
+</html>
+"""
+
+
+def render_softsite_page(n):
+    rng = random.Random(n)
+    words = ("chair", "desk", "lamp", "shelf", "oak", "steel", "mesh", "adjustable", "compact", "warranty")
+    features = "".join(f"<li>{' '.join(rng.choice(words) for _ in range(6))}</li>" for _ in range(8))
+    return (
+        f'<!DOCTYPE html><html lang="en"><head><title>Item {n}</title></head><body>'
+        f'<header><a href="/">Home</a> <a href="/softsite/0">Catalog</a></header>'
+        f'<main><h1>Item {n}</h1><ul>{features}</ul><p class="price">{(n % 500) + 9.99:.2f} EUR</p>'
+        f'<a href="/softsite/{n + 1}">next</a> <a href="/softsite/removed-{n}">previous model</a></main>'
+        f'<footer>Shipping within two days</footer></body></html>'
+    )
+
+
+SPARSE_IDS = 20000
+
+
+def is_sparse_id(n):
+    return 1 <= n <= SPARSE_IDS and n % 10 not in (3, 4, 7)
+
+
+class FixtureHandler(BaseHTTPRequestHandler):
+    protocol_version = "HTTP/1.1"
+
+    def do_echo(self):
+        length = int(self.headers.get("Content-Length") or 0)
+        body = self.rfile.read(length).decode("utf-8", "replace") if length else None
+        echo = {
+            "method": self.command,
+            "path": self.path,
+            "headers": {name.lower(): value for name, value in self.headers.items()},
+            "body": body,
+        }
+        self.respond(200, "application/json", json.dumps(echo, sort_keys=True))
+
+    def do_POST(self):
+        if self.path.startswith("/echo/"):
+            self.do_echo()
+        else:
+            self.respond(405, "text/html", "<html><body>Method not allowed</body></html>")
+
+    do_PUT = do_PATCH = do_DELETE = do_OPTIONS = do_POST
+
+    def do_HEAD(self):
+        data = b"" if self.path.startswith("/echo/") else b"<html><body>Not found</body></html>"
+        self.send_response(200 if self.path.startswith("/echo/") else 404)
+        self.send_header("Content-Type", "application/json" if self.path.startswith("/echo/") else "text/html")
+        self.send_header("Content-Length", str(len(data)))
+        self.end_headers()
+
+    def do_GET(self):
+        global day
+        if self.path.startswith("/echo/"):
+            self.do_echo()
+        elif self.path == "/robots.txt":
+            self.respond(200, "text/plain", "User-agent: *\nDisallow: /robots-blocked/\nAllow: /\n")
+        elif self.path == "/_next_day":
+            day += 1
+            self.respond(200, "text/plain", str(day))
+        elif self.path.startswith("/mutating/"):
+            try:
+                n = int(self.path[len("/mutating/"):])
+            except ValueError:
+                self.respond(404, "text/html", "<html><body>Not found</body></html>")
+                return
+            self.respond(200, "text/html; charset=utf-8", render_mutating_page(n, day))
+        elif self.path.startswith("/large/"):
+            try:
+                n = int(self.path[len("/large/"):])
+            except ValueError:
+                self.respond(404, "text/html", "<html><body>Not found</body></html>")
+                return
+            self.respond(200, "text/html; charset=utf-8", render_large_page(n))
+        elif self.path.startswith("/multilang/"):
+            try:
+                n = int(self.path[len("/multilang/"):])
+            except ValueError:
+                self.respond(404, "text/html", "<html><body>Not found</body></html>")
+                return
+            headers = {"Content-Language": multilang_language(n)} if n % 3 == 1 and n % 8 != 7 else None
+            self.respond_bytes(200, "text/html; charset=utf-8", render_multilang_page(n).encode("utf-8"), headers)
+        elif self.path.startswith("/dupsite/"):
+            path, _, query = self.path[len("/dupsite/"):].partition("?")
+            try:
+                n = int(path)
+            except ValueError:
+                n = DUPSITE_PAGES
+            if n >= DUPSITE_PAGES:
+                self.respond(404, "text/html", "<html><body>Not found</body></html>")
+                return
+            self.respond(200, "text/html; charset=utf-8", render_dupsite_page(n, query))
+        elif self.path.startswith("/redirect/"):
+            self.send_response(302)
+            self.send_header("Location", "/page/" + self.path[len("/redirect/"):])
+            self.send_header("Content-Length", "0")
+            self.end_headers()
+        elif self.path.startswith("/gzip/"):
+            try:
+                n = int(self.path[len("/gzip/"):])
+            except ValueError:
+                self.respond(404, "text/html", "<html><body>Not found</body></html>")
+                return
+            data = render_page(n).encode("utf-8")
+            if "gzip" in self.headers.get("Accept-Encoding", ""):
+                self.respond_bytes(200, "text/html; charset=utf-8", gzip.compress(data), {"Content-Encoding": "gzip"})
+            else:
+                self.respond_bytes(200, "text/html; charset=utf-8", data)
+        elif self.path.startswith("/latin1/"):
+            n = self.path[len("/latin1/"):]
+            body = f"<html><head><title>Caf\u00e9 {n}</title></head><body><h1>Cr\u00e8me br\u00fbl\u00e9e {n}</h1></body></html>"
+            self.respond_bytes(200, "text/html; charset=iso-8859-1", body.encode("iso-8859-1"))
+        elif self.path.startswith("/status/"):
+            try:
+                code = int(self.path[len("/status/"):])
+            except ValueError:
+                code = 404
+            self.respond(code, "text/html", f"<html><body>Status {code}</body></html>")
+        elif self.path.startswith("/sparse/"):
+            n = self.path[len("/sparse/"):]
+            if n.isdigit() and is_sparse_id(int(n)):
+                self.respond(200, "text/html; charset=utf-8", render_page(int(n)))
+            else:
+                self.respond(404, "text/html", "<html><body>Not found</body></html>")
+        elif self.path.startswith("/page/"):
+            try:
+                n = int(self.path[len("/page/"):])
+            except ValueError:
+                self.respond(404, "text/html", "<html><body>Not found</body></html>")
+                return
+            self.respond(200, "text/html; charset=utf-8", render_page(n))
+        elif self.path.startswith("/softsite/") and self.path[len("/softsite/"):].isdigit() and \
+                int(self.path[len("/softsite/"):]) < SOFTSITE_PAGES:
+            self.respond(200, "text/html; charset=utf-8", render_softsite_page(int(self.path[len("/softsite/"):])))
+        elif self.server.soft_404:
+            self.respond(200, "text/html; charset=utf-8", SOFT_404_TEMPLATE.format(path=html.escape(self.path)))
+        else:
+            self.respond(404, "text/html", "<html><body>Not found</body></html>")
+
+    def respond(self, status, content_type, body):
+        self.respond_bytes(status, content_type, body.encode("utf-8"))
+
+    def respond_bytes(self, status, content_type, data, headers=None):
+        self.send_response(status)
+        self.send_header("Content-Type", content_type)
+        for name, value in (headers or {}).items():
+            self.send_header(name, value)
+        self.send_header("Content-Length", str(len(data)))
+        self.end_headers()
+        self.wfile.write(data)
+
+    def log_message(self, format, *args):
+        pass
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--port", type=int, default=8765)
+    parser.add_argument("--soft-404", action="store_true", help="answer unknown paths with 200 and a not-found page")
+    parser.add_argument("--soft-404-port", type=int, help="also serve with --soft-404 on this port")
+    args = parser.parse_args()
+    server = ThreadingHTTPServer(("127.0.0.1", args.port), FixtureHandler)
+    server.soft_404 = args.soft_404
+    print(f"fixture server listening on http://127.0.0.1:{args.port}")
+    if args.soft_404_port:
+        soft_server = ThreadingHTTPServer(("127.0.0.1", args.soft_404_port), FixtureHandler)
+        soft_server.soft_404 = True
+        threading.Thread(target=soft_server.serve_forever, daemon=True).start()
+        print(f"soft 404 fixture server listening on http://127.0.0.1:{args.soft_404_port}")
+    server.serve_forever()
+
+
+if __name__ == "__main__":
+    main()
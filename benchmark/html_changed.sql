@@ -0,0 +1,68 @@
+-- Benchmark: html_changed() / html_diff() over 1M page pairs
+--
+-- No fixture server needed:
+--   duckdb -unsigned < benchmark/html_changed.sql
+--
+-- 1M pairs of ~3KB generated pages (template, inline script, 30 paragraphs,
+-- an ad slot, a "generated at" timestamp and a CSRF token). Between the two
+-- crawls, 70% of pages are byte-identical, 20% only differ in the volatile
+-- parts (ad, timestamp, token, script) and 10% have one paragraph edited.
+-- Changed pages are counted four ways: raw body inequality, hashes of
+-- html_to_text(), html_changed() with the volatile selectors ignored, and
+-- html_diff() (which also materializes the changed blocks). The last query
+-- checks html_changed() against the generator's ground truth.
+
+LOAD crawler;
+
+-- 30 paragraphs, {page} is replaced by the page number
+CREATE TABLE paragraphs AS
+SELECT string_agg('<p class="para-' || p || '">Paragraph ' || p || ' of page {page}: lorem ipsum dolor sit amet, '
+                  || 'consectetur adipiscing elit.</p>', '' ORDER BY p) AS template
+FROM range(30) t(p);
+
+CREATE TABLE page_pairs AS
+WITH pages AS (
+    SELECT i, CASE WHEN i % 10 < 7 THEN 'same' WHEN i % 10 < 9 THEN 'volatile' ELSE 'edited' END AS kind,
+           replace(template, '{page}', i::VARCHAR) AS paras
+    FROM range(1000000) t(i), paragraphs
+)
+SELECT i, kind,
+       '<html><head><title>Page ' || i || '</title><script>var t = 1;</script></head><body><nav><a href="/">Home</a></nav>'
+           || '<div class="ad">Buy product 17 now</div><span data-ts>generated 2026-01-01 10:00</span>'
+           || '<form><input type="hidden" name="csrf" value="a1"></form><main>' || paras
+           || '</main></body></html>' AS old_body,
+       '<html><head><title>Page ' || i || '</title><script>var t = ' || (CASE WHEN kind = 'same' THEN 1 ELSE 2 END)
+           || ';</script></head><body><nav><a href="/">Home</a></nav>'
+           || '<div class="ad">Buy product ' || (CASE WHEN kind = 'same' THEN 17 ELSE i % 1000 END) || ' now</div>'
+           || '<span data-ts>generated 2026-01-' || (CASE WHEN kind = 'same' THEN '01' ELSE '02' END) || ' 10:00</span>'
+           || '<form><input type="hidden" name="csrf" value="' || (CASE WHEN kind = 'same' THEN 'a1' ELSE 'b2' END)
+           || '"></form><main>'
+           || (CASE WHEN kind = 'edited' THEN replace(paras, 'Paragraph 12 of', 'Rewritten paragraph 12 of') ELSE paras END)
+           || '</main></body></html>' AS new_body
+FROM pages;
+
+SELECT count(*) AS pairs, avg(length(old_body))::INTEGER AS avg_bytes FROM page_pairs;
+
+.timer on
+
+-- 1. Raw bytes: every volatile change counts
+SELECT count(*) FILTER (WHERE old_body != new_body) AS changed FROM page_pairs;
+
+-- 2. Visible text hashes: the ad and timestamp still count
+SELECT count(*) FILTER (WHERE md5(html_to_text(old_body)) != md5(html_to_text(new_body))) AS changed FROM page_pairs;
+
+-- 3. html_changed() with the volatile elements ignored
+SELECT count(*) FILTER (WHERE html_changed(old_body, new_body, {'ignore': ['.ad', '[data-ts]']})) AS changed
+FROM page_pairs;
+
+-- 4. html_diff(): change ratio and changed blocks
+SELECT count(*) FILTER (WHERE d.changed) AS changed, avg(d.change_ratio) FILTER (WHERE d.changed) AS avg_ratio,
+       sum(len(d.removed) + len(d.added)) AS changed_blocks
+FROM (SELECT html_diff(old_body, new_body, {'ignore': ['.ad', '[data-ts]']}) AS d FROM page_pairs);
+
+.timer off
+
+-- Agreement with the generator: only 'edited' pages should be changed
+SELECT kind, count(*) AS pages,
+       count(*) FILTER (WHERE html_changed(old_body, new_body, {'ignore': ['.ad', '[data-ts]']})) AS changed
+FROM page_pairs GROUP BY kind ORDER BY kind;
@@ -0,0 +1,34 @@
+-- Benchmark: html_to_text() vs html.readability on large pages
+--
+-- Start the fixture server first:
+--   python3 benchmark/fixture_server.py --port 8765 &
+-- Then run:
+--   duckdb -unsigned < benchmark/html_to_text_vs_readability.sql
+--
+-- 2k article pages of ~220KB (navigation, inline scripts and styles, tables)
+-- are crawled once into the cache. Plain text is then produced three ways:
+-- html_to_text() over the stored bodies, the same with a length cap, and the
+-- readability field of an offline crawl() over the cached pages (which also
+-- builds the other html struct fields).
+
+LOAD crawler;
+SET crawler_default_delay = 0;
+SET crawler_respect_robots = false;
+
+CREATE TABLE large_pages AS
+SELECT url, html.document AS body
+FROM crawl((SELECT list('http://127.0.0.1:8765/large/' || i) FROM range(2000) t(i)), delay := 0);
+
+.timer on
+
+-- 1. html_to_text(): streaming tokenizer
+SELECT sum(length(html_to_text(body))) AS text_chars FROM large_pages;
+
+-- 2. html_to_text() with a cap (stops reading at 2000 characters)
+SELECT sum(length(html_to_text(body, {'max_length': 2000}))) AS text_chars FROM large_pages;
+
+-- 3. Readability (DOM build + scoring) over the same cached pages
+SELECT sum(length(html.readability::VARCHAR)) AS readability_chars
+FROM crawl((SELECT list(url) FROM large_pages), offline := true);
+
+.timer off
@@ -0,0 +1,60 @@
+-- Conformance and throughput: STRUCT(url, method, headers, body) requests
+--
+-- Start the fixture server first:
+--   python3 benchmark/fixture_server.py --port 8765 &
+-- Then run:
+--   duckdb -unsigned < benchmark/request_spec.sql
+--
+-- /echo/... answers every method with a JSON echo of the request. Both fetch
+-- backends send the same method, body and headers through crawl() and
+-- crawl_url(); the second crawl() run is served from the cache, keyed on
+-- method, URL and body. Every mismatch query must return no rows.
+
+LOAD crawler;
+SET crawler_default_delay = 0;
+SET crawler_respect_robots = false;
+
+CREATE TABLE requests AS
+SELECT {'url': 'http://127.0.0.1:8765/echo/' || i,
+        'method': ['GET', 'POST', 'PUT', 'PATCH', 'DELETE'][i % 5 + 1],
+        'headers': MAP {'X-Request': i::VARCHAR},
+        'body': CASE WHEN i % 5 IN (1, 2, 3) THEN '{"id": ' || i || '}' END} AS request
+FROM range(2000) t(i);
+
+.timer on
+
+SET crawler_fetch_backend = 'reqwest';
+CREATE TABLE reqwest_raw AS
+SELECT r.request, c.html.document AS body FROM crawl((SELECT list(request) FROM requests), cache := false) c
+JOIN requests r ON r.request.url = c.url;
+
+SET crawler_fetch_backend = 'curl';
+CREATE TABLE curl_raw AS
+SELECT r.request, c.html.document AS body FROM crawl((SELECT list(request) FROM requests), cache := false) c
+JOIN requests r ON r.request.url = c.url;
+
+CREATE TABLE lateral_raw AS
+SELECT r.request, c.body FROM (FROM requests LIMIT 100) r, crawl_url(r.request, cache := false) c;
+
+-- Cache: the first run stores, the second only reads (run both with the curl backend)
+CREATE TABLE cached_first AS FROM crawl((SELECT list(request) FROM (FROM requests LIMIT 500)));
+CREATE TABLE cached_second AS FROM crawl((SELECT list(request) FROM (FROM requests LIMIT 500)));
+
+.timer off
+
+CREATE TABLE echoes AS
+SELECT backend, request.url, request.method, request.body AS sent_body,
+       body->>'$.method' AS echo_method, body->>'$.body' AS echo_body,
+       body->>'$.headers."x-request"' AS echo_header
+FROM (SELECT 'reqwest' AS backend, * FROM reqwest_raw
+      UNION ALL SELECT 'curl', * FROM curl_raw
+      UNION ALL SELECT 'crawl_url', * FROM lateral_raw);
+
+SELECT backend, count(*) AS responses FROM echoes GROUP BY ALL ORDER BY backend;
+
+-- Requests that did not arrive as sent: must return no rows
+SELECT * FROM echoes
+WHERE echo_method IS DISTINCT FROM method OR echo_body IS DISTINCT FROM sent_body
+   OR echo_header IS DISTINCT FROM regexp_extract(url, '[0-9]+$');
+
+SELECT count(*) AS cached_requests FROM __crawler_cache WHERE url LIKE 'POST http://127.0.0.1:8765/echo/% body:%';
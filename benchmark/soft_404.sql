@@ -0,0 +1,48 @@
+-- Benchmark: crawl(soft_404 := ...) on a site that answers unknown paths with a 200 template
+--
+-- Start the fixture server in soft 404 mode first:
+--   python3 benchmark/fixture_server.py --port 8766 --soft-404 &
+-- Then run:
+--   duckdb -unsigned < benchmark/soft_404.sql
+--
+-- Every /softsite/<n> page links to the next page and to /softsite/removed-<n>,
+-- which answers 200 with a "page not found" template echoing the path. Soft
+-- errors are flagged against the template of the one probe request. Precision
+-- and recall should both be 1.0; the skip run stores and follows only real pages.
+
+LOAD crawler;
+SET crawler_respect_robots = false;
+
+.timer on
+
+-- 1. Flag: every page is returned, soft errors marked
+CREATE TABLE soft_flag AS
+SELECT url, status, soft_404, html.document AS body
+FROM crawl('http://127.0.0.1:8766/softsite/0', follow := 'a[href^="/softsite/"]', max_depth := 1000,
+           delay := 0, cache := false, soft_404 := 'flag');
+
+-- 2. Skip: soft errors are neither returned nor followed
+CREATE TABLE soft_skip AS
+SELECT url, html.document AS body
+FROM crawl('http://127.0.0.1:8766/softsite/0', follow := 'a[href^="/softsite/"]', max_depth := 1000,
+           delay := 0, cache := false, soft_404 := 'skip');
+
+.timer off
+
+-- Ground truth: /softsite/removed-* and pages past the end of the catalog are soft errors
+CREATE MACRO is_removed(u) AS u LIKE '%/softsite/removed-%' OR NOT regexp_matches(u, '/softsite/([0-9]|[1-9][0-9]|[1-4][0-9][0-9])$');
+
+SELECT count(*) AS pages,
+       count(*) FILTER (WHERE is_removed(url)) AS actual_soft_404,
+       count(*) FILTER (WHERE soft_404) AS flagged,
+       count(*) FILTER (WHERE soft_404 AND is_removed(url)) / nullif(count(*) FILTER (WHERE soft_404), 0) AS precision,
+       count(*) FILTER (WHERE soft_404 AND is_removed(url)) / nullif(count(*) FILTER (WHERE is_removed(url)), 0) AS recall
+FROM soft_flag;
+
+SELECT 'flag' AS run, count(*) AS pages, sum(length(body)) AS stored_bytes FROM soft_flag
+UNION ALL
+SELECT 'skip', count(*), sum(length(body)) FROM soft_skip;
+
+-- Mismatches: must return no rows
+SELECT url, soft_404 FROM soft_flag WHERE soft_404 <> is_removed(url);
+SELECT url FROM soft_skip WHERE is_removed(url);
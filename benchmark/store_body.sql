@@ -0,0 +1,39 @@
+-- Benchmark: stored body size with store_body := 'raw' / 'minified' / 'main_content'
+--
+-- Start the fixture server first:
+--   python3 benchmark/fixture_server.py --port 8765 &
+-- Then run:
+--   duckdb -unsigned < benchmark/store_body.sql
+--
+-- 2k article pages of ~220KB (navigation, inline scripts and styles) are
+-- crawled once per mode. Compares the bytes stored and the time of a jq()
+-- extraction over the stored bodies, which parses less HTML when compacted.
+
+LOAD crawler;
+SET crawler_default_delay = 0;
+SET crawler_respect_robots = false;
+SET crawler_extract_memo = false;
+
+CREATE TABLE urls AS SELECT list('http://127.0.0.1:8765/large/' || i) AS urls FROM range(2000) t(i);
+
+.timer on
+
+CREATE TABLE pages_raw AS
+SELECT url, html.document AS body FROM crawl((SELECT urls FROM urls), cache := false, store_body := 'raw');
+
+CREATE TABLE pages_minified AS
+SELECT url, html.document AS body FROM crawl((SELECT urls FROM urls), cache := false, store_body := 'minified');
+
+CREATE TABLE pages_main AS
+SELECT url, html.document AS body FROM crawl((SELECT urls FROM urls), cache := false, store_body := 'main_content');
+
+-- Extraction over each stored form
+SELECT count(jq(body, 'h1').text) FROM pages_raw;
+SELECT count(jq(body, 'h1').text) FROM pages_minified;
+SELECT count(jq(body, 'h1').text) FROM pages_main;
+
+.timer off
+
+SELECT 'raw' AS mode, sum(length(body)) AS stored_bytes FROM pages_raw
+UNION ALL SELECT 'minified', sum(length(body)) FROM pages_minified
+UNION ALL SELECT 'main_content', sum(length(body)) FROM pages_main;
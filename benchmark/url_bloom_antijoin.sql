@@ -0,0 +1,34 @@
+-- Benchmark: anti-join vs url_bloom_contains() for "already crawled?" checks
+--
+-- No fixture server needed:
+--   duckdb -unsigned < benchmark/url_bloom_antijoin.sql
+--
+-- 50M seen URLs, 10M candidates of which half were seen. The anti-join builds
+-- a hash table over every seen URL string; the filter is built once (~60MB at
+-- 1%) and probed per candidate. Watch peak memory (e.g. /usr/bin/time -v) as
+-- well as the timings. The last query reports the measured false-positive rate.
+
+LOAD crawler;
+
+CREATE TABLE seen AS
+SELECT 'https://shop' || (i % 1000) || '.example.com/product/' || i AS url FROM range(50000000) t(i);
+CREATE TABLE candidates AS
+SELECT 'https://shop' || (i % 1000) || '.example.com/product/' || (i * 5 + (i % 2)) AS url FROM range(10000000) t(i);
+
+.timer on
+
+-- 1. Anti-join
+SELECT count(*) FROM candidates c WHERE NOT EXISTS (SELECT 1 FROM seen s WHERE s.url = c.url);
+
+-- 2. Build the filter, then probe it
+CREATE TABLE seen_filter AS SELECT url_bloom_agg(url, 0.01, 50000000) AS f FROM seen;
+SELECT count(*) FROM candidates, seen_filter WHERE NOT url_bloom_contains(f, url);
+
+.timer off
+
+SELECT octet_length(f) AS filter_bytes FROM seen_filter;
+
+-- Candidates that were not seen but the filter reports as seen
+SELECT avg(url_bloom_contains(f, url)::DOUBLE) AS false_positive_rate
+FROM candidates c, seen_filter
+WHERE NOT EXISTS (SELECT 1 FROM seen s WHERE s.url = c.url);
@@ -0,0 +1,39 @@
+-- Benchmark: xpath() vs css_select() over the same stored pages
+--
+-- Start the fixture server first:
+--   python3 benchmark/fixture_server.py --port 8765 &
+-- Then run:
+--   duckdb -unsigned < benchmark/xpath_vs_css_select.sql
+--
+-- 50k product pages are crawled once into a table. Title, price and next link
+-- are then extracted with css_select() (one Rust parse per call and row) and
+-- with xpath() (one libxml2 parse per row, shared by the three calls). The
+-- extraction memo is off so both sides parse every body.
+
+LOAD crawler;
+SET crawler_default_delay = 0;
+SET crawler_respect_robots = false;
+SET crawler_extract_memo = false;
+
+CRAWL (SELECT 'http://127.0.0.1:8765/page/' || i AS url FROM range(50000) t(i))
+INTO pages
+WITH (max_parallel_per_domain 32, batch_size 256);
+
+.timer on
+
+-- 1. css_select(): three selectors
+SELECT count(DISTINCT css_select(body, 'h1', 'text')) AS titles,
+       count(DISTINCT css_select(body, 'p.price', 'text')) AS prices,
+       count(DISTINCT css_select(body, 'a', 'href')) AS links
+FROM pages;
+
+-- 2. xpath(): the same three fields
+SELECT count(DISTINCT xpath(body, '//h1')) AS titles,
+       count(DISTINCT xpath(body, '//p[@class="price"]')) AS prices,
+       count(DISTINCT xpath(body, '//a/@href')) AS links
+FROM pages;
+
+-- 3. xpath() with a single field, for the per-parse cost
+SELECT count(DISTINCT xpath(body, '//h1')) AS titles FROM pages;
+
+.timer off
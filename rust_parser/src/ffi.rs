@@ -368,6 +368,115 @@ pub unsafe extern "C" fn extract_readability_ffi(
     }
 }
 
+/// Optional C string argument: NULL or empty is None
+unsafe fn optional_str<'a>(ptr: *const c_char) -> Option<&'a str> {
+    if ptr.is_null() {
+        return None;
+    }
+    CStr::from_ptr(ptr).to_str().ok().filter(|s| !s.is_empty())
+}
+
+/// Language codes of count texts as a JSON array in json_ptr ("" where unknown); see
+/// language::detect_language. One call classifies a whole vector of detect_language().
+/// hint_ptrs is NULL (no hints) or holds count C strings, NULL or empty for no hint.
+#[no_mangle]
+pub unsafe extern "C" fn detect_languages_ffi(
+    text_ptrs: *const *const c_char,
+    text_lens: *const usize,
+    hint_ptrs: *const *const c_char,
+    count: usize,
+) -> ExtractionResultFFI {
+    // Wrap in catch_unwind to prevent panics from crashing the process
+    let result = std::panic::catch_unwind(|| detect_languages_ffi_inner(text_ptrs, text_lens, hint_ptrs, count));
+
+    match result {
+        Ok(r) => r,
+        Err(_) => ExtractionResultFFI {
+            json_ptr: ptr::null_mut(),
+            error_ptr: string_to_ptr("Panic in language detection".to_string()),
+        },
+    }
+}
+
+unsafe fn detect_languages_ffi_inner(
+    text_ptrs: *const *const c_char,
+    text_lens: *const usize,
+    hint_ptrs: *const *const c_char,
+    count: usize,
+) -> ExtractionResultFFI {
+    if count == 0 {
+        return ExtractionResultFFI {
+            json_ptr: string_to_ptr("[]".to_string()),
+            error_ptr: ptr::null_mut(),
+        };
+    }
+    let text_ptrs = std::slice::from_raw_parts(text_ptrs, count);
+    let text_lens = std::slice::from_raw_parts(text_lens, count);
+    let hint_ptrs = if hint_ptrs.is_null() {
+        None
+    } else {
+        Some(std::slice::from_raw_parts(hint_ptrs, count))
+    };
+    let languages: Vec<String> = (0..count)
+        .map(|i| {
+            let bytes = std::slice::from_raw_parts(text_ptrs[i] as *const u8, text_lens[i]);
+            let text = String::from_utf8_lossy(&bytes[..text_lens[i].min(crate::language::TEXT_PREFIX_BYTES)]);
+            let hint = hint_ptrs.and_then(|hints| optional_str(hints[i]));
+            crate::language::detect_language(&text, hint).unwrap_or_default()
+        })
+        .collect();
+    match serde_json::to_string(&languages) {
+        Ok(json) => ExtractionResultFFI {
+            json_ptr: string_to_ptr(json),
+            error_ptr: ptr::null_mut(),
+        },
+        Err(e) => ExtractionResultFFI {
+            json_ptr: ptr::null_mut(),
+            error_ptr: string_to_ptr(format!("Serialization error: {}", e)),
+        },
+    }
+}
+
+/// Language code of a response body in json_ptr (empty if unknown); see
+/// language::detect_page_language. For bodies that did not come through crawl_batch_ffi.
+#[no_mangle]
+pub unsafe extern "C" fn detect_page_language_ffi(
+    body_ptr: *const c_char,
+    body_len: usize,
+    content_type_ptr: *const c_char,
+    content_language_ptr: *const c_char,
+) -> ExtractionResultFFI {
+    // Wrap in catch_unwind to prevent panics from crashing the process
+    let result = std::panic::catch_unwind(|| {
+        detect_page_language_ffi_inner(body_ptr, body_len, content_type_ptr, content_language_ptr)
+    });
+
+    match result {
+        Ok(r) => r,
+        Err(_) => ExtractionResultFFI {
+            json_ptr: ptr::null_mut(),
+            error_ptr: string_to_ptr("Panic in language detection".to_string()),
+        },
+    }
+}
+
+unsafe fn detect_page_language_ffi_inner(
+    body_ptr: *const c_char,
+    body_len: usize,
+    content_type_ptr: *const c_char,
+    content_language_ptr: *const c_char,
+) -> ExtractionResultFFI {
+    let bytes = std::slice::from_raw_parts(body_ptr as *const u8, body_len);
+    let scanned = body_len.min(crate::language::HTML_SCAN_BYTES);
+    let body = String::from_utf8_lossy(&bytes[..scanned]);
+    let content_type = optional_str(content_type_ptr).unwrap_or("");
+    let language = crate::language::detect_page_language(&body, content_type, optional_str(content_language_ptr));
+    ExtractionResultFFI {
+        json_ptr: string_to_ptr(language.unwrap_or_default()),
+        error_ptr: ptr::null_mut(),
+    }
+}
+
 /// Extract elements matching CSS selector
 #[no_mangle]
 pub unsafe extern "C" fn extract_css_ffi(
@@ -666,6 +775,21 @@ struct BatchCrawlRequest {
     http_proxy_password: Option<String>,
     #[serde(default)]
     extra_headers: Option<std::collections::HashMap<String, String>>, // Extra HTTP headers
+    #[serde(default)]
+    requests: Option<Vec<Option<RequestOptions>>>, // Per-URL method / headers / body, aligned with urls
+    #[serde(default)]
+    detect_language: bool, // Fill each result's language (crawl(language := true))
+}
+
+/// Method, headers and body of one request (crawl() STRUCT input); absent = plain GET
+#[derive(Debug, Clone, serde::Deserialize)]
+struct RequestOptions {
+    #[serde(default)]
+    method: Option<String>,
+    #[serde(default)]
+    headers: Option<HashMap<String, String>>,
+    #[serde(default)]
+    body: Option<String>,
 }
 
 fn default_user_agent() -> String {
@@ -698,9 +822,13 @@ struct CrawlResult {
     final_url: String,
     status: i32,
     content_type: String,
+    /// Content-Language header (a language detection hint)
+    content_language: String,
     body: String,
     error: Option<String>,
     extracted: Option<serde_json::Value>,
+    /// Page language, detected with the extraction while the body is here (detect_language only)
+    language: Option<String>,
     response_time_ms: u64,
 }
 
@@ -714,9 +842,11 @@ struct BatchCrawlResponse {
 async fn fetch_and_extract(
     client: &reqwest::Client,
     url: String,
+    options: Option<RequestOptions>,
     extraction: &Option<ExtractionRequest>,
     rate_limiter: &DomainRateLimiter,
     delay_ms: u64,
+    detect_language: bool,
 ) -> CrawlResult {
     let start = std::time::Instant::now();
 
@@ -750,7 +880,27 @@ async fn fetch_and_extract(
         }
     }
 
-    match client.get(&url).send().await {
+    // Per-request headers replace client default (extra) headers of the same name
+    let request = match options {
+        Some(options) => {
+            let method = options
+                .method
+                .as_deref()
+                .and_then(|m| reqwest::Method::from_bytes(m.as_bytes()).ok())
+                .unwrap_or(reqwest::Method::GET);
+            let mut builder = client.request(method, &url);
+            for (name, value) in options.headers.iter().flatten() {
+                builder = builder.header(name.as_str(), value.as_str());
+            }
+            if let Some(body) = options.body {
+                builder = builder.body(body);
+            }
+            builder
+        }
+        None => client.get(&url),
+    };
+
+    match request.send().await {
         Ok(response) => {
             let status = response.status().as_u16() as i32;
             let final_url = response.url().to_string();
@@ -760,6 +910,12 @@ async fn fetch_and_extract(
                 .and_then(|v| v.to_str().ok())
                 .unwrap_or("")
                 .to_string();
+            let content_language = response
+                .headers()
+                .get("content-language")
+                .and_then(|v| v.to_str().ok())
+                .unwrap_or("")
+                .to_string();
 
             match response.text().await {
                 Ok(body) => {
@@ -770,15 +926,23 @@ async fn fetch_and_extract(
                     } else {
                         None
                     };
+                    let language = if detect_language {
+                        let hint = Some(content_language.as_str()).filter(|s| !s.is_empty());
+                        crate::language::detect_page_language(&body, &content_type, hint)
+                    } else {
+                        None
+                    };
 
                     CrawlResult {
                         url,
                         final_url,
                         status,
                         content_type,
+                        content_language,
                         body,
                         error: None,
                         extracted,
+                        language,
                         response_time_ms: start.elapsed().as_millis() as u64,
                     }
                 }
@@ -787,9 +951,11 @@ async fn fetch_and_extract(
                     final_url: url,
                     status,
                     content_type,
+                    content_language,
                     body: String::new(),
                     error: Some(format!("Body read error: {}", e)),
                     extracted: None,
+                    language: None,
                     response_time_ms: start.elapsed().as_millis() as u64,
                 },
             }
@@ -799,9 +965,11 @@ async fn fetch_and_extract(
             final_url: url,
             status: 0,
             content_type: String::new(),
+            content_language: String::new(),
             body: String::new(),
             error: Some(e.to_string()),
             extracted: None,
+            language: None,
             response_time_ms: start.elapsed().as_millis() as u64,
         },
     }
@@ -895,37 +1063,49 @@ pub unsafe extern "C" fn crawl_batch_ffi(
         let concurrency = request.concurrency.max(1).min(32);
         let extraction = request.extraction.clone();
         let delay_ms = request.delay_ms;
+        let detect_language = request.detect_language;
         let respect_robots = request.respect_robots;
         let user_agent = request.user_agent.clone();
         let rate_limiter: DomainRateLimiter = Arc::new(Mutex::new(HashMap::new()));
 
+        // Pair every URL with its request options (None = GET)
+        let mut options = request.requests.unwrap_or_default().into_iter();
+        let requests: Vec<(String, Option<RequestOptions>)> = request
+            .urls
+            .into_iter()
+            .map(|url| (url, options.next().flatten()))
+            .collect();
+
         // Filter URLs by robots.txt if enabled
-        let urls: Vec<String> = if respect_robots {
+        let requests: Vec<(String, Option<RequestOptions>)> = if respect_robots {
             let robots_cache = crate::robots::RobotsCache::new();
             let config = ureq::Agent::config_builder()
                 .timeout_global(Some(Duration::from_secs(10)))
                 .build();
             let blocking_agent = ureq::Agent::new_with_config(config);
 
-            request.urls
+            requests
                 .into_iter()
-                .filter(|url| {
+                .filter(|(url, _)| {
                     let check = robots_cache.check_blocking(&blocking_agent, url, &user_agent);
                     check.allowed
                 })
                 .collect()
         } else {
-            request.urls
+            requests
         };
 
         // Process URLs with interrupt checking
         let mut results = Vec::new();
-        let mut url_stream = stream::iter(urls)
-            .map(|url| {
+        let mut url_stream = stream::iter(requests)
+            .map(|(url, options)| {
                 let client = client.clone();
                 let extraction = extraction.clone();
                 let rate_limiter = rate_limiter.clone();
-                async move { fetch_and_extract(&client, url, &extraction, &rate_limiter, delay_ms).await }
+                async move {
+                    fetch_and_extract(&client, url, options, &extraction, &rate_limiter, delay_ms, detect_language)
+                        .await
+                }
             })
             .buffer_unordered(concurrency);
 
@@ -0,0 +1,397 @@
+//! Language detection (crawl(language := true), detect_language())
+//!
+//! whatlang's trigram models run over a bounded prefix of the visible text, so
+//! the cost per page stays the same on huge pages. `<html lang>`,
+//! `<meta http-equiv="content-language">` and the Content-Language header are
+//! hints: they decide when the text is too short or too mixed for a reliable
+//! answer. Languages are reported as ISO 639-1 codes ("en", "de"), or ISO 639-3
+//! for languages without one.
+
+/// Visible text that is classified, in bytes
+pub const TEXT_PREFIX_BYTES: usize = 4096;
+
+/// HTML scanned for that text; the rest of a page is never looked at
+pub const HTML_SCAN_BYTES: usize = 256 * 1024;
+
+/// Texts with fewer letters are left to the hint
+const MIN_LETTERS: usize = 16;
+
+/// Language of text (only its first TEXT_PREFIX_BYTES are read).
+/// hint is a language tag ("en-US", "de, en"); it wins over an unreliable detection.
+pub fn detect_language(text: &str, hint: Option<&str>) -> Option<String> {
+    let hint = hint.and_then(normalize_language_tag);
+    let prefix = truncate_at_char(text, TEXT_PREFIX_BYTES);
+    if prefix.chars().filter(|c| c.is_alphabetic()).take(MIN_LETTERS).count() < MIN_LETTERS {
+        return hint;
+    }
+    match whatlang::detect(prefix) {
+        Some(info) if info.is_reliable() => Some(iso_code(info.lang().code())),
+        Some(info) => hint.or_else(|| Some(iso_code(info.lang().code()))),
+        None => hint,
+    }
+}
+
+/// Language of an HTML page: visible text, with `<html lang>` / `<meta http-equiv>`
+/// and then the Content-Language header as hints
+pub fn detect_html_language(html: &str, content_language: Option<&str>) -> Option<String> {
+    let page = visible_text_prefix(html);
+    let hint = page
+        .lang
+        .as_deref()
+        .filter(|tag| normalize_language_tag(tag).is_some())
+        .or(content_language);
+    detect_language(&page.text, hint)
+}
+
+/// Language of a fetched response: HTML by its visible text, other text/* bodies as text,
+/// None for other content types. content_language is the Content-Language header.
+pub fn detect_page_language(body: &str, content_type: &str, content_language: Option<&str>) -> Option<String> {
+    if body.is_empty() {
+        return None;
+    }
+    let content_type = content_type.to_ascii_lowercase();
+    if content_type.contains("html") {
+        detect_html_language(body, content_language)
+    } else if content_type.starts_with("text/") {
+        detect_language(body, content_language)
+    } else {
+        None
+    }
+}
+
+/// Leading visible text of a page and its declared language
+#[derive(Debug, Default)]
+pub struct PageTextPrefix {
+    pub text: String,
+    pub lang: Option<String>,
+}
+
+/// Collect up to TEXT_PREFIX_BYTES of visible text from the first HTML_SCAN_BYTES of html.
+/// A linear scan, not a parse: script, style and similar elements, comments and markup are skipped.
+pub fn visible_text_prefix(html: &str) -> PageTextPrefix {
+    let bytes = html.as_bytes();
+    let mut end = bytes.len().min(HTML_SCAN_BYTES);
+    while !html.is_char_boundary(end) {
+        end -= 1;
+    }
+
+    let mut page = PageTextPrefix::default();
+    let mut i = 0;
+    while i < end && page.text.len() < TEXT_PREFIX_BYTES {
+        if bytes[i] != b'<' {
+            let next = find_byte(bytes, i, end, b'<').unwrap_or(end);
+            push_text(&mut page.text, &html[i..next]);
+            i = next;
+            continue;
+        }
+        if bytes[i..end].starts_with(b"<!--") {
+            i = find_ci(bytes, i + 4, end, b"-->").map_or(end, |p| p + 3);
+            continue;
+        }
+        let close = match find_byte(bytes, i, end, b'>') {
+            Some(close) => close,
+            None => break,
+        };
+        let tag = &html[i + 1..close];
+        let name: String = tag
+            .chars()
+            .take_while(|c| c.is_ascii_alphanumeric())
+            .map(|c| c.to_ascii_lowercase())
+            .collect();
+        i = close + 1;
+        match name.as_str() {
+            // A self-closing <svg/> or <textarea/> has no end tag to skip to
+            "script" | "style" | "noscript" | "template" | "svg" | "textarea"
+                if !tag.trim_end().ends_with('/') =>
+            {
+                let end_tag = format!("</{}", name);
+                i = find_ci(bytes, i, end, end_tag.as_bytes()).unwrap_or(end);
+            }
+            "html" if page.lang.is_none() => {
+                page.lang = attribute(tag, "lang").or_else(|| attribute(tag, "xml:lang"));
+            }
+            "meta" if page.lang.is_none() => {
+                let is_language = attribute(tag, "http-equiv")
+                    .map_or(false, |v| v.eq_ignore_ascii_case("content-language"));
+                if is_language {
+                    page.lang = attribute(tag, "content");
+                }
+            }
+            _ => {}
+        }
+        if !page.text.is_empty() && !page.text.ends_with(' ') {
+            page.text.push(' ');
+        }
+    }
+    let len = truncate_at_char(&page.text, TEXT_PREFIX_BYTES).len();
+    page.text.truncate(len);
+    page
+}
+
+/// Primary subtag of a language tag as an ISO 639-1 code where there is one.
+/// "en-US" -> "en", "de, en" -> "de", "deu" -> "de", "iw" -> "he"; None for "und" and malformed tags.
+pub fn normalize_language_tag(tag: &str) -> Option<String> {
+    let first = tag.split(',').next()?.trim();
+    let primary = first.split(|c| c == '-' || c == '_').next()?.to_ascii_lowercase();
+    if !(2..=3).contains(&primary.len()) || !primary.bytes().all(|b| b.is_ascii_lowercase()) {
+        return None;
+    }
+    let code = match primary.as_str() {
+        "und" | "mul" | "zxx" | "mis" => return None,
+        "iw" => "he".to_string(),
+        "in" => "id".to_string(),
+        "ji" => "yi".to_string(),
+        "no" => "nb".to_string(),
+        _ => iso_code(&primary),
+    };
+    Some(code)
+}
+
+/// ISO 639-1 code of an ISO 639-3 code known to whatlang; other codes are returned as is
+fn iso_code(code: &str) -> String {
+    let short = match code {
+        "afr" => "af",
+        "aka" => "ak",
+        "amh" => "am",
+        "ara" => "ar",
+        "aze" => "az",
+        "bel" => "be",
+        "ben" => "bn",
+        "bul" => "bg",
+        "cat" => "ca",
+        "ces" => "cs",
+        "cmn" | "zho" => "zh",
+        "dan" => "da",
+        "deu" => "de",
+        "ell" => "el",
+        "eng" => "en",
+        "epo" => "eo",
+        "est" => "et",
+        "fin" => "fi",
+        "fra" => "fr",
+        "guj" => "gu",
+        "heb" => "he",
+        "hin" => "hi",
+        "hrv" => "hr",
+        "hun" => "hu",
+        "hye" => "hy",
+        "ind" => "id",
+        "ita" => "it",
+        "jav" => "jv",
+        "jpn" => "ja",
+        "kan" => "kn",
+        "kat" => "ka",
+        "khm" => "km",
+        "kor" => "ko",
+        "lat" => "la",
+        "lav" => "lv",
+        "lit" => "lt",
+        "mal" => "ml",
+        "mar" => "mr",
+        "mkd" => "mk",
+        "mya" => "my",
+        "nep" => "ne",
+        "nld" => "nl",
+        "nob" => "nb",
+        "ori" => "or",
+        "pan" => "pa",
+        "pes" | "fas" => "fa",
+        "pol" => "pl",
+        "por" => "pt",
+        "ron" => "ro",
+        "rus" => "ru",
+        "sin" => "si",
+        "slk" => "sk",
+        "slv" => "sl",
+        "sna" => "sn",
+        "spa" => "es",
+        "srp" => "sr",
+        "swe" => "sv",
+        "tam" => "ta",
+        "tel" => "te",
+        "tgl" => "tl",
+        "tha" => "th",
+        "tuk" => "tk",
+        "tur" => "tr",
+        "ukr" => "uk",
+        "urd" => "ur",
+        "uzb" => "uz",
+        "vie" => "vi",
+        "yid" => "yi",
+        "zul" => "zu",
+        other => other,
+    };
+    short.to_string()
+}
+
+fn truncate_at_char(text: &str, max_bytes: usize) -> &str {
+    if text.len() <= max_bytes {
+        return text;
+    }
+    let mut end = max_bytes;
+    while !text.is_char_boundary(end) {
+        end -= 1;
+    }
+    &text[..end]
+}
+
+fn find_byte(bytes: &[u8], from: usize, end: usize, needle: u8) -> Option<usize> {
+    bytes[from..end].iter().position(|&b| b == needle).map(|p| from + p)
+}
+
+/// Position of an ASCII needle, ignoring case
+fn find_ci(bytes: &[u8], from: usize, end: usize, needle: &[u8]) -> Option<usize> {
+    if from >= end || end - from < needle.len() {
+        return None;
+    }
+    bytes[from..end]
+        .windows(needle.len())
+        .position(|window| window.eq_ignore_ascii_case(needle))
+        .map(|p| from + p)
+}
+
+/// Value of a tag attribute (tag is the text between '<' and '>')
+fn attribute(tag: &str, name: &str) -> Option<String> {
+    let bytes = tag.as_bytes();
+    let mut from = 0;
+    while let Some(pos) = find_ci(bytes, from, bytes.len(), name.as_bytes()) {
+        from = pos + name.len();
+        let starts_word = pos > 0 && bytes[pos - 1].is_ascii_whitespace();
+        let rest = tag[from..].trim_start();
+        if !starts_word || !rest.starts_with('=') {
+            continue;
+        }
+        let value = rest[1..].trim_start();
+        let value = match value.chars().next() {
+            Some(quote @ ('"' | '\'')) => value[1..].split(quote).next().unwrap_or(""),
+            _ => value.split(|c: char| c.is_ascii_whitespace() || c == '/').next().unwrap_or(""),
+        };
+        return Some(value.trim().to_string());
+    }
+    None
+}
+
+/// Append text with whitespace collapsed and character references decoded, up to
+/// TEXT_PREFIX_BYTES (unknown named references become a space, so they are not read as words)
+fn push_text(out: &mut String, raw: &str) {
+    let mut rest = raw;
+    while let Some(c) = rest.chars().next() {
+        if out.len() >= TEXT_PREFIX_BYTES {
+            return;
+        }
+        rest = &rest[c.len_utf8()..];
+        let c = match c {
+            '&' => match rest.find(';').filter(|&semi| semi <= 10) {
+                Some(semi) => {
+                    let decoded = decode_reference(&rest[..semi]).unwrap_or(' ');
+                    rest = &rest[semi + 1..];
+                    decoded
+                }
+                None => '&',
+            },
+            c => c,
+        };
+        if !c.is_whitespace() {
+            out.push(c);
+        } else if !out.is_empty() && !out.ends_with(' ') {
+            out.push(' ');
+        }
+    }
+}
+
+fn decode_reference(name: &str) -> Option<char> {
+    if let Some(number) = name.strip_prefix('#') {
+        let code = match number.strip_prefix(|c| c == 'x' || c == 'X') {
+            Some(hex) => u32::from_str_radix(hex, 16).ok()?,
+            None => number.parse().ok()?,
+        };
+        return char::from_u32(code);
+    }
+    match name {
+        "amp" => Some('&'),
+        "lt" => Some('<'),
+        "gt" => Some('>'),
+        "quot" => Some('"'),
+        "apos" => Some('\''),
+        _ => None,
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    #[test]
+    fn test_detect_text() {
+        let english = "The quick brown fox jumps over the lazy dog while the farmer watches from the porch.";
+        let german = "Der schnelle braune Fuchs springt über den faulen Hund, während der Bauer zusieht.";
+        assert_eq!(detect_language(english, None).as_deref(), Some("en"));
+        assert_eq!(detect_language(german, None).as_deref(), Some("de"));
+        // Too short to classify: the hint decides
+        assert_eq!(detect_language("OK", Some("fr-CA")).as_deref(), Some("fr"));
+        assert_eq!(detect_language("OK", None), None);
+    }
+
+    #[test]
+    fn test_normalize_language_tag() {
+        assert_eq!(normalize_language_tag("en-US").as_deref(), Some("en"));
+        assert_eq!(normalize_language_tag(" de, en").as_deref(), Some("de"));
+        assert_eq!(normalize_language_tag("deu").as_deref(), Some("de"));
+        assert_eq!(normalize_language_tag("iw").as_deref(), Some("he"));
+        assert_eq!(normalize_language_tag("und"), None);
+        assert_eq!(normalize_language_tag(""), None);
+        assert_eq!(normalize_language_tag("x1"), None);
+    }
+
+    #[test]
+    fn test_visible_text_prefix() {
+        let html = r#"<!DOCTYPE html><html lang="fi-FI"><head><title>Otsikko</title>
+            <style>body { color: red }</style><script>var x = "<p>not text</p>";</script></head>
+            <body><!-- comment --><p>Hyv&#xe4;&nbsp;p&#228;iv&#228;&amp;terve</p></body></html>"#;
+        let page = visible_text_prefix(html);
+        assert_eq!(page.lang.as_deref(), Some("fi-FI"));
+        assert!(page.text.contains("Otsikko"));
+        assert!(page.text.contains("Hyvä päivä&terve"));
+        assert!(!page.text.contains("color"));
+        assert!(!page.text.contains("not text"));
+        assert!(!page.text.contains("comment"));
+    }
+
+    #[test]
+    fn test_detect_page() {
+        let html = "<html lang=\"es\"><body><p>Hola</p></body></html>";
+        assert_eq!(detect_page_language(html, "text/html; charset=utf-8", None).as_deref(), Some("es"));
+        assert_eq!(detect_page_language("Hej", "text/plain", Some("sv")).as_deref(), Some("sv"));
+        assert_eq!(detect_page_language("{\"a\": 1}", "application/json", Some("en")), None);
+        assert_eq!(detect_page_language("", "text/html", Some("en")), None);
+    }
+
+    #[test]
+    fn test_self_closing_skipped_elements() {
+        // No end tag follows: the text after them is still visible
+        let html = r#"<body><svg class="icon"/><p>after svg</p><textarea name="q" /><p>after textarea</p>
+            <svg><text>drawn</text></svg><p>end</p></body>"#;
+        let page = visible_text_prefix(html);
+        assert!(page.text.contains("after svg"));
+        assert!(page.text.contains("after textarea"));
+        assert!(page.text.contains("end"));
+        assert!(!page.text.contains("drawn"));
+    }
+
+    #[test]
+    fn test_prefix_is_bounded() {
+        let html = format!("<html><body>{}</body></html>", "<p>hello world</p>".repeat(1_000_000));
+        let page = visible_text_prefix(&html);
+        assert!(page.text.len() <= TEXT_PREFIX_BYTES);
+    }
+
+    #[test]
+    fn test_detect_html() {
+        let html = "<html lang=\"es\"><body><p>Hola</p></body></html>";
+        assert_eq!(detect_html_language(html, Some("en")).as_deref(), Some("es"));
+        let html = "<html><body><p>Hola</p></body></html>";
+        assert_eq!(detect_html_language(html, Some("en-GB")).as_deref(), Some("en"));
+        let html = "<meta http-equiv=\"Content-Language\" content=\"sv\"><p>Hej</p>";
+        assert_eq!(detect_html_language(html, None).as_deref(), Some("sv"));
+    }
+}
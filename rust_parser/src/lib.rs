@@ -6,11 +6,13 @@
 //! - OpenGraph meta tags
 //! - Meta tags
 //! - CSS selectors (jQuery-like syntax)
+//! - Language detection
 //! - robots.txt parsing
 //! - Sitemap XML parsing
 
 mod extractors;
 mod ffi;
+pub mod language;
 pub mod robots;
 pub mod sitemap;
 
@@ -0,0 +1,212 @@
+#include "crawl_batch.hpp"
+#include "yyjson.hpp"
+
+#include <algorithm>
+
+namespace duckdb {
+
+using namespace duckdb_yyjson;
+
+//===--------------------------------------------------------------------===//
+// Settings
+//===--------------------------------------------------------------------===//
+
+void LoadCrawlBatchSettings(ClientContext &context, CrawlBatchOptions &options) {
+	Value setting_value;
+	if (context.TryGetCurrentSetting("crawler_user_agent", setting_value)) {
+		options.user_agent = setting_value.ToString();
+	}
+	if (context.TryGetCurrentSetting("crawler_default_delay", setting_value)) {
+		options.delay_ms = static_cast<int>(setting_value.GetValue<double>() * 1000);
+	}
+	if (context.TryGetCurrentSetting("crawler_timeout_ms", setting_value)) {
+		options.timeout_ms = static_cast<int>(setting_value.GetValue<int64_t>());
+	}
+	if (context.TryGetCurrentSetting("crawler_respect_robots", setting_value)) {
+		options.respect_robots = setting_value.GetValue<bool>();
+	}
+	options.dedupe = LoadCrawlDedupeSetting(context);
+	options.store_body = LoadStoreBodyMode(context);
+	options.fetch_backend = LoadFetchBackendType(context);
+	if (context.TryGetCurrentSetting("http_proxy", setting_value) && !setting_value.IsNull()) {
+		options.http_proxy = setting_value.ToString();
+	}
+	if (context.TryGetCurrentSetting("http_proxy_username", setting_value) && !setting_value.IsNull()) {
+		options.http_proxy_username = setting_value.ToString();
+	}
+	if (context.TryGetCurrentSetting("http_proxy_password", setting_value) && !setting_value.IsNull()) {
+		options.http_proxy_password = setting_value.ToString();
+	}
+}
+
+//===--------------------------------------------------------------------===//
+// Dedupe
+//===--------------------------------------------------------------------===//
+
+CrawlBatchDedupe::CrawlBatchDedupe(ClientContext &context, bool enabled)
+    : enabled(enabled), counters(GetCrawlDedupeCounters(context)) {
+}
+
+idx_t CrawlBatchDedupe::SkipSeenUrls(vector<string> &urls) {
+	if (!enabled) {
+		return 0;
+	}
+	std::lock_guard<std::mutex> guard(lock);
+	idx_t before = urls.size();
+	urls.erase(std::remove_if(urls.begin(), urls.end(), [&](const string &url) { return dedupe.SeenUrl(url); }),
+	           urls.end());
+	idx_t skipped = before - urls.size();
+	counters->fetches_avoided += NumericCast<int64_t>(skipped);
+	return skipped;
+}
+
+void CrawlBatchDedupe::CollapseDuplicates(vector<CrawlBatchResult> &results) {
+	counters->pages_fetched += NumericCast<int64_t>(results.size());
+	if (!enabled) {
+		return;
+	}
+	std::lock_guard<std::mutex> guard(lock);
+	idx_t kept = 0;
+	for (auto &result : results) {
+		string canonical_url;
+		if (dedupe.IsDuplicate(result.url, result.final_url, result.status_code, result.content_type, result.body,
+		                       canonical_url)) {
+			counters->duplicates_collapsed++;
+			counters->bytes_not_returned += NumericCast<int64_t>(result.body.size());
+			continue;
+		}
+		if (&results[kept] != &result) {
+			results[kept] = std::move(result);
+		}
+		kept++;
+	}
+	results.resize(kept);
+}
+
+//===--------------------------------------------------------------------===//
+// Request
+//===--------------------------------------------------------------------===//
+
+string BuildCrawlBatchRequest(const CrawlBatchOptions &options, const vector<string> &urls) {
+	yyjson_mut_doc *doc = yyjson_mut_doc_new(nullptr);
+	if (!doc) return "{}";
+
+	yyjson_mut_val *root = yyjson_mut_obj(doc);
+	yyjson_mut_doc_set_root(doc, root);
+
+	yyjson_mut_val *urls_arr = yyjson_mut_arr(doc);
+	for (const auto &url : urls) {
+		yyjson_mut_arr_add_strcpy(doc, urls_arr, url.c_str());
+	}
+	yyjson_mut_obj_add_val(doc, root, "urls", urls_arr);
+
+	if (!options.extraction_json.empty()) {
+		yyjson_doc *ext_doc = yyjson_read(options.extraction_json.c_str(), options.extraction_json.size(), 0);
+		if (ext_doc) {
+			yyjson_mut_obj_add_val(doc, root, "extraction", yyjson_val_mut_copy(doc, yyjson_doc_get_root(ext_doc)));
+			yyjson_doc_free(ext_doc);
+		}
+	}
+
+	yyjson_mut_obj_add_strcpy(doc, root, "user_agent", options.user_agent.c_str());
+	yyjson_mut_obj_add_uint(doc, root, "timeout_ms", options.timeout_ms);
+	yyjson_mut_obj_add_uint(doc, root, "concurrency", options.concurrency);
+	yyjson_mut_obj_add_uint(doc, root, "delay_ms", options.delay_ms);
+	yyjson_mut_obj_add_bool(doc, root, "respect_robots", options.respect_robots);
+	if (!options.http_proxy.empty()) {
+		yyjson_mut_obj_add_strcpy(doc, root, "http_proxy", options.http_proxy.c_str());
+		if (!options.http_proxy_username.empty()) {
+			yyjson_mut_obj_add_strcpy(doc, root, "http_proxy_username", options.http_proxy_username.c_str());
+		}
+		if (!options.http_proxy_password.empty()) {
+			yyjson_mut_obj_add_strcpy(doc, root, "http_proxy_password", options.http_proxy_password.c_str());
+		}
+	}
+
+	size_t len = 0;
+	char *json_str = yyjson_mut_write(doc, 0, &len);
+	yyjson_mut_doc_free(doc);
+	if (!json_str) return "{}";
+
+	string result(json_str, len);
+	free(json_str);
+	return result;
+}
+
+//===--------------------------------------------------------------------===//
+// Response
+//===--------------------------------------------------------------------===//
+
+static bool GetJsonString(yyjson_val *obj, const char *key, string &out) {
+	yyjson_val *val = yyjson_obj_get(obj, key);
+	if (!val || !yyjson_is_str(val)) {
+		return false;
+	}
+	out = string(yyjson_get_str(val), yyjson_get_len(val));
+	return true;
+}
+
+vector<CrawlBatchResult> ParseCrawlBatchResponse(const string &response_json) {
+	vector<CrawlBatchResult> results;
+
+	yyjson_doc *doc = yyjson_read(response_json.c_str(), response_json.size(), 0);
+	if (!doc) {
+		throw IOException("Invalid response from Rust crawler");
+	}
+	yyjson_val *root = yyjson_doc_get_root(doc);
+
+	string error;
+	if (GetJsonString(root, "error", error)) {
+		yyjson_doc_free(doc);
+		throw IOException("Rust crawl error: %s", error);
+	}
+
+	yyjson_val *results_arr = yyjson_obj_get(root, "results");
+	size_t idx, max;
+	yyjson_val *item;
+	yyjson_arr_foreach(results_arr, idx, max, item) {
+		CrawlBatchResult result;
+		GetJsonString(item, "url", result.url);
+		GetJsonString(item, "final_url", result.final_url);
+		GetJsonString(item, "content_type", result.content_type);
+		result.has_body = GetJsonString(item, "body", result.body);
+		result.has_error = GetJsonString(item, "error", result.error);
+
+		yyjson_val *status = yyjson_obj_get(item, "status");
+		if (status && yyjson_is_int(status)) {
+			result.status_code = static_cast<int32_t>(yyjson_get_int(status));
+		}
+		yyjson_val *elapsed = yyjson_obj_get(item, "response_time_ms");
+		if (elapsed && yyjson_is_uint(elapsed)) {
+			result.elapsed_ms = static_cast<int64_t>(yyjson_get_uint(elapsed));
+		}
+
+		yyjson_val *extracted = yyjson_obj_get(item, "extracted");
+		if (extracted && yyjson_is_obj(extracted)) {
+			size_t ext_idx, ext_max;
+			yyjson_val *key, *val;
+			yyjson_obj_foreach(extracted, ext_idx, ext_max, key, val) {
+				if (yyjson_is_str(val)) {
+					result.extracted[yyjson_get_str(key)] = string(yyjson_get_str(val), yyjson_get_len(val));
+				}
+			}
+		}
+		results.push_back(std::move(result));
+	}
+
+	yyjson_doc_free(doc);
+	return results;
+}
+
+void CompactCrawlBatchBodies(vector<CrawlBatchResult> &results, StoreBodyMode store_body) {
+	if (store_body == StoreBodyMode::RAW) {
+		return;
+	}
+	for (auto &result : results) {
+		if (result.has_body) {
+			result.body = CompactHtmlBody(result.body, result.content_type, store_body);
+		}
+	}
+}
+
+} // namespace duckdb
@@ -0,0 +1,130 @@
+// Crawl dedupe - collapse URL variants by rel=canonical and body fingerprint
+//
+//   SELECT url, canonical_url FROM crawl(['https://shop.example.com/'], follow := 'a');
+//   SET crawler_dedupe = true;
+//   CRAWL (SELECT url FROM seeds) INTO pages;
+//   SELECT * FROM crawl_dedupe_stats();
+//
+// One CrawlDedupe lives in the state of each crawl run. The counters are a
+// ClientContextState, so crawl_dedupe_stats() reports the runs of the current
+// connection since it was opened.
+
+#include "crawl_dedupe.hpp"
+#include "crawler_utils.hpp"
+#include "link_parser.hpp"
+
+#include "duckdb/common/string_util.hpp"
+#include "duckdb/function/table_function.hpp"
+#include "duckdb/main/client_context.hpp"
+#include "mbedtls_wrapper.hpp"
+
+namespace duckdb {
+
+static constexpr const char *CRAWL_DEDUPE_STATE = "crawler_dedupe_counters";
+
+static bool IsSuccess(int status_code) {
+	return status_code >= 200 && status_code < 300;
+}
+
+//===--------------------------------------------------------------------===//
+// CrawlDedupe
+//===--------------------------------------------------------------------===//
+
+bool CrawlDedupe::SeenUrl(const string &url) const {
+	return seen_url_keys.count(UrlDedupeKey(url)) > 0;
+}
+
+string CrawlDedupe::PageCanonicalUrl(const string &url, const string &final_url, int status_code,
+                                     const string &content_type, const string &body) {
+	if (!IsSuccess(status_code) || body.empty() || StringUtil::Lower(content_type).find("html") == string::npos) {
+		return "";
+	}
+	return LinkParser::ExtractCanonical(body, final_url.empty() ? url : final_url);
+}
+
+bool CrawlDedupe::IsDuplicate(const string &url, const string &final_url, int status_code, const string &content_type,
+                              const string &body, string &canonical_url) {
+	canonical_url = PageCanonicalUrl(url, final_url, status_code, content_type, body);
+	if (!IsSuccess(status_code)) {
+		return false;
+	}
+	string own_key = UrlDedupeKey(final_url.empty() ? url : final_url);
+	string canonical_key = canonical_url.empty() ? own_key : UrlDedupeKey(canonical_url);
+	// SHA-256: a fingerprint collision would drop a distinct page
+	string fingerprint;
+	if (!body.empty()) {
+		duckdb_mbedtls::MbedTlsWrapper::SHA256State state;
+		state.AddString(body);
+		fingerprint = state.Finalize();
+	}
+
+	if (seen_url_keys.count(canonical_key) > 0 || (!fingerprint.empty() && seen_fingerprints.count(fingerprint) > 0)) {
+		return true;
+	}
+	seen_url_keys.insert(UrlDedupeKey(url));
+	seen_url_keys.insert(own_key);
+	seen_url_keys.insert(canonical_key);
+	if (!fingerprint.empty()) {
+		seen_fingerprints.insert(std::move(fingerprint));
+	}
+	return false;
+}
+
+//===--------------------------------------------------------------------===//
+// Counters and Setting
+//===--------------------------------------------------------------------===//
+
+shared_ptr<CrawlDedupeCounters> GetCrawlDedupeCounters(ClientContext &context) {
+	return context.registered_state->GetOrCreate<CrawlDedupeCounters>(CRAWL_DEDUPE_STATE);
+}
+
+bool LoadCrawlDedupeSetting(ClientContext &context) {
+	Value setting_value;
+	if (context.TryGetCurrentSetting("crawler_dedupe", setting_value) && !setting_value.IsNull()) {
+		return setting_value.GetValue<bool>();
+	}
+	return false;
+}
+
+//===--------------------------------------------------------------------===//
+// crawl_dedupe_stats() - Cumulative Counters of the Connection
+//===--------------------------------------------------------------------===//
+
+struct CrawlDedupeStatsState : public GlobalTableFunctionState {
+	bool done = false;
+};
+
+static unique_ptr<FunctionData> CrawlDedupeStatsBind(ClientContext &context, TableFunctionBindInput &input,
+                                                     vector<LogicalType> &return_types, vector<string> &names) {
+	names = {"pages_fetched", "fetches_avoided", "duplicates_collapsed", "bytes_not_returned"};
+	return_types = vector<LogicalType>(names.size(), LogicalType::BIGINT);
+	return make_uniq<TableFunctionData>();
+}
+
+static unique_ptr<GlobalTableFunctionState> CrawlDedupeStatsInit(ClientContext &context,
+                                                                 TableFunctionInitInput &input) {
+	return make_uniq<CrawlDedupeStatsState>();
+}
+
+static void CrawlDedupeStatsFunction(ClientContext &context, TableFunctionInput &data, DataChunk &output) {
+	auto &state = data.global_state->Cast<CrawlDedupeStatsState>();
+	if (state.done) {
+		output.SetCardinality(0);
+		return;
+	}
+	state.done = true;
+	auto counters = GetCrawlDedupeCounters(context);
+	output.SetValue(0, 0, Value::BIGINT(counters->pages_fetched.load()));
+	output.SetValue(1, 0, Value::BIGINT(counters->fetches_avoided.load()));
+	output.SetValue(2, 0, Value::BIGINT(counters->duplicates_collapsed.load()));
+	output.SetValue(3, 0, Value::BIGINT(counters->bytes_not_returned.load()));
+	output.SetCardinality(1);
+}
+
+void RegisterCrawlDedupeFunctions(ExtensionLoader &loader) {
+	TableFunction stats_func("crawl_dedupe_stats", {}, CrawlDedupeStatsFunction, CrawlDedupeStatsBind,
+	                         CrawlDedupeStatsInit);
+	loader.RegisterFunction(stats_func);
+}
+
+} // namespace duckdb
@@ -0,0 +1,684 @@
+// crawl_into_internal - CRAWL (...) INTO <table> with bulk appends
+//
+// Fetches the URLs produced by the source query in batches through the Rust
+// crawler (which evaluates the EXTRACT specs while the body is still hot) and
+// appends each batch to the target table column by column, in the caller's
+// transaction. Unlike CRAWLING MERGE INTO there is no per-row SQL: one batch is
+// appended while the next batch is already being fetched.
+//
+// Usage (via CRAWL statement):
+//   CRAWL (SELECT url FROM seeds)
+//   INTO pages
+//   EXTRACT (jsonld.Product.name AS name, css '.price::text' AS price)
+//   WITH (user_agent 'MyBot/1.0', max_parallel_per_domain 8)
+//   LIMIT 1000;
+
+#include "crawl_into_function.hpp"
+#include "crawl_batch.hpp"
+#include "crawl_progress.hpp"
+#include "crawler_utils.hpp"
+#include "rust_ffi.hpp"
+#include "yyjson.hpp"
+
+#include "duckdb/catalog/catalog.hpp"
+#include "duckdb/catalog/catalog_entry/table_catalog_entry.hpp"
+#include "duckdb/function/table_function.hpp"
+#include "duckdb/main/connection.hpp"
+#include "duckdb/common/string_util.hpp"
+#include "duckdb/common/types/timestamp.hpp"
+#include "duckdb/common/vector_operations/vector_operations.hpp"
+#include "duckdb/parser/parsed_data/create_table_info.hpp"
+#include "duckdb/parser/qualified_name.hpp"
+#include "duckdb/planner/binder.hpp"
+#include "duckdb/storage/data_table.hpp"
+#include "duckdb/storage/table/append_state.hpp"
+
+#include <atomic>
+#include <future>
+#include <set>
+
+namespace duckdb {
+
+using namespace duckdb_yyjson;
+
+//===--------------------------------------------------------------------===//
+// EXTRACT Spec Compilation
+//===--------------------------------------------------------------------===//
+
+static string TrimSpec(const string &str) {
+	size_t start = 0;
+	size_t end = str.length();
+	while (start < end && std::isspace(static_cast<unsigned char>(str[start]))) {
+		start++;
+	}
+	while (end > start && std::isspace(static_cast<unsigned char>(str[end - 1]))) {
+		end--;
+	}
+	return str.substr(start, end - start);
+}
+
+vector<string> SplitCrawlList(const string &list) {
+	vector<string> parts;
+	string current;
+	int depth = 0;
+	char quote = 0;
+
+	for (size_t i = 0; i < list.length(); i++) {
+		char c = list[i];
+		if (quote) {
+			current += c;
+			if (c == quote) {
+				if (i + 1 < list.length() && list[i + 1] == quote) {
+					current += list[++i]; // Escaped quote
+				} else {
+					quote = 0;
+				}
+			}
+			continue;
+		}
+		if (c == '\'' || c == '"') {
+			quote = c;
+		} else if (c == '(' || c == '[') {
+			depth++;
+		} else if ((c == ')' || c == ']') && depth > 0) {
+			depth--;
+		} else if (c == ',' && depth == 0) {
+			auto part = TrimSpec(current);
+			if (!part.empty()) {
+				parts.push_back(part);
+			}
+			current.clear();
+			continue;
+		}
+		current += c;
+	}
+	auto part = TrimSpec(current);
+	if (!part.empty()) {
+		parts.push_back(part);
+	}
+	return parts;
+}
+
+// Structured form of one EXTRACT expression (mirrors ExtractSpec in extractors.rs)
+struct CrawlIntoExtractItem {
+	string source;
+	vector<string> path;
+	string selector;
+	string accessor;
+	vector<CrawlIntoExtractItem> alternatives;
+};
+
+// Position of a top-level " AS " in an EXTRACT item, or npos
+static size_t FindTopLevelAlias(const string &item) {
+	string lower = StringUtil::Lower(item);
+	size_t found = string::npos;
+	int depth = 0;
+	char quote = 0;
+	for (size_t i = 0; i < lower.length(); i++) {
+		char c = lower[i];
+		if (quote) {
+			if (c == quote) {
+				quote = 0;
+			}
+			continue;
+		}
+		if (c == '\'' || c == '"') {
+			quote = c;
+		} else if (c == '(') {
+			depth++;
+		} else if (c == ')') {
+			depth--;
+		} else if (depth == 0 && std::isspace(static_cast<unsigned char>(c)) && lower.compare(i + 1, 3, "as ") == 0) {
+			found = i;
+		}
+	}
+	return found;
+}
+
+static bool IsStructuredSource(const string &source) {
+	return source == "jsonld" || source == "microdata" || source == "og" || source == "meta" || source == "js";
+}
+
+static CrawlIntoExtractItem ParseExtractExpression(const string &expr_p) {
+	string expr = TrimSpec(expr_p);
+	string lower = StringUtil::Lower(expr);
+	CrawlIntoExtractItem item;
+
+	// COALESCE(a, b, ...) - first spec is primary, the rest are tried in order
+	if (StringUtil::StartsWith(lower, "coalesce")) {
+		auto open = expr.find('(');
+		auto close = expr.rfind(')');
+		if (open == string::npos || close == string::npos || close < open) {
+			throw ParserException("EXTRACT: malformed COALESCE in '%s'", expr);
+		}
+		auto args = SplitCrawlList(expr.substr(open + 1, close - open - 1));
+		if (args.empty()) {
+			throw ParserException("EXTRACT: COALESCE needs at least one argument");
+		}
+		item = ParseExtractExpression(args[0]);
+		for (idx_t i = 1; i < args.size(); i++) {
+			item.alternatives.push_back(ParseExtractExpression(args[i]));
+		}
+		return item;
+	}
+
+	// css 'selector[::text|::attr(name)]'
+	if (StringUtil::StartsWith(lower, "css") && lower.length() > 3 &&
+	    (std::isspace(static_cast<unsigned char>(lower[3])) || lower[3] == '\'')) {
+		string quoted = TrimSpec(expr.substr(3));
+		if (quoted.length() < 2 || quoted.front() != '\'' || quoted.back() != '\'') {
+			throw ParserException("EXTRACT: css selector must be a quoted string in '%s'", expr);
+		}
+		string selector = StringUtil::Replace(quoted.substr(1, quoted.length() - 2), "''", "'");
+		item.source = "css";
+		item.accessor = "html";
+		auto pseudo = selector.rfind("::");
+		if (pseudo != string::npos) {
+			string name = selector.substr(pseudo + 2);
+			if (name == "text") {
+				item.accessor = "text";
+			} else if (StringUtil::StartsWith(name, "attr(") && name.back() == ')') {
+				item.accessor = "attr:" + name.substr(5, name.length() - 6);
+			} else {
+				throw ParserException("EXTRACT: unsupported pseudo-element '::%s'", name);
+			}
+			selector = TrimSpec(selector.substr(0, pseudo));
+		}
+		if (selector.empty()) {
+			throw ParserException("EXTRACT: empty css selector in '%s'", expr);
+		}
+		item.selector = selector;
+		return item;
+	}
+
+	// source.path.to.field with optional [n] array access
+	auto dot = expr.find('.');
+	if (dot == string::npos) {
+		throw ParserException("EXTRACT: expected source.path or css '...', got '%s'", expr);
+	}
+	item.source = StringUtil::Lower(TrimSpec(expr.substr(0, dot)));
+	if (!IsStructuredSource(item.source)) {
+		throw ParserException("EXTRACT: unknown source '%s' (expected jsonld, microdata, og, meta, js or css)",
+		                      item.source);
+	}
+	for (auto &segment : StringUtil::Split(expr.substr(dot + 1), '.')) {
+		string name = TrimSpec(segment);
+		auto bracket = name.find('[');
+		string index;
+		if (bracket != string::npos && name.back() == ']') {
+			index = name.substr(bracket + 1, name.length() - bracket - 2);
+			name = name.substr(0, bracket);
+		}
+		if (!name.empty()) {
+			item.path.push_back(name);
+		}
+		if (!index.empty()) {
+			item.path.push_back(index);
+		}
+	}
+	if (item.path.empty()) {
+		throw ParserException("EXTRACT: missing path after '%s.'", item.source);
+	}
+	return item;
+}
+
+static string DefaultAlias(const CrawlIntoExtractItem &item) {
+	for (auto it = item.path.rbegin(); it != item.path.rend(); ++it) {
+		if (!it->empty() && !std::isdigit(static_cast<unsigned char>((*it)[0]))) {
+			return *it;
+		}
+	}
+	return "";
+}
+
+static yyjson_mut_val *ExtractItemToJson(yyjson_mut_doc *doc, const CrawlIntoExtractItem &item, const string &alias) {
+	yyjson_mut_val *obj = yyjson_mut_obj(doc);
+	yyjson_mut_obj_add_strcpy(doc, obj, "source", item.source.c_str());
+	yyjson_mut_obj_add_strcpy(doc, obj, "alias", alias.c_str());
+	yyjson_mut_obj_add_bool(doc, obj, "return_text", true);
+
+	yyjson_mut_val *path_arr = yyjson_mut_arr(doc);
+	for (auto &segment : item.path) {
+		yyjson_mut_arr_add_strcpy(doc, path_arr, segment.c_str());
+	}
+	yyjson_mut_obj_add_val(doc, obj, "path", path_arr);
+
+	if (!item.selector.empty()) {
+		yyjson_mut_obj_add_strcpy(doc, obj, "selector", item.selector.c_str());
+		yyjson_mut_obj_add_strcpy(doc, obj, "accessor", item.accessor.c_str());
+	}
+	if (!item.alternatives.empty()) {
+		yyjson_mut_val *alt_arr = yyjson_mut_arr(doc);
+		for (auto &alt : item.alternatives) {
+			yyjson_mut_arr_append(alt_arr, ExtractItemToJson(doc, alt, alias));
+		}
+		yyjson_mut_obj_add_val(doc, obj, "alternatives", alt_arr);
+	}
+	return obj;
+}
+
+// Standard columns written for every crawled page (see README "Output Schema")
+static const char *const CRAWL_INTO_COLUMNS[] = {"url",        "surt_key", "status_code",  "content_type", "body",
+                                                 "error",      "final_url", "elapsed_ms", "content_hash", "crawled_at"};
+
+vector<string> CrawlIntoOutputColumns(const vector<string> &aliases) {
+	vector<string> columns(std::begin(CRAWL_INTO_COLUMNS), std::end(CRAWL_INTO_COLUMNS));
+	columns.insert(columns.end(), aliases.begin(), aliases.end());
+	return columns;
+}
+
+string CompileCrawlExtractSpecs(const vector<string> &items, vector<string> &aliases) {
+	std::set<string> seen;
+	for (auto &column : CRAWL_INTO_COLUMNS) {
+		seen.insert(column);
+	}
+
+	vector<CrawlIntoExtractItem> parsed;
+	for (auto &item_text : items) {
+		string expr = item_text;
+		string alias;
+		auto as_pos = FindTopLevelAlias(item_text);
+		if (as_pos != string::npos) {
+			expr = TrimSpec(item_text.substr(0, as_pos));
+			alias = TrimSpec(item_text.substr(as_pos + 4));
+			if (alias.length() >= 2 && alias.front() == '"' && alias.back() == '"') {
+				alias = alias.substr(1, alias.length() - 2);
+			}
+		}
+		auto item = ParseExtractExpression(expr);
+		if (alias.empty()) {
+			alias = DefaultAlias(item);
+		}
+		if (alias.empty()) {
+			throw ParserException("EXTRACT: '%s' needs an alias (... AS name)", item_text);
+		}
+		if (!IsValidSqlIdentifier(alias)) {
+			throw ParserException("EXTRACT: invalid alias '%s'", alias);
+		}
+		if (!seen.insert(StringUtil::Lower(alias)).second) {
+			throw ParserException("EXTRACT: duplicate column name '%s'", alias);
+		}
+		aliases.push_back(alias);
+		parsed.push_back(std::move(item));
+	}
+
+	if (parsed.empty()) {
+		return "";
+	}
+
+	yyjson_mut_doc *doc = yyjson_mut_doc_new(nullptr);
+	yyjson_mut_val *root = yyjson_mut_obj(doc);
+	yyjson_mut_doc_set_root(doc, root);
+	yyjson_mut_val *specs = yyjson_mut_arr(doc);
+	for (idx_t i = 0; i < parsed.size(); i++) {
+		yyjson_mut_arr_append(specs, ExtractItemToJson(doc, parsed[i], aliases[i]));
+	}
+	yyjson_mut_obj_add_val(doc, root, "specs", specs);
+
+	size_t len = 0;
+	char *json_str = yyjson_mut_write(doc, 0, &len);
+	yyjson_mut_doc_free(doc);
+	if (!json_str) {
+		throw InternalException("EXTRACT: failed to serialize extraction specs");
+	}
+	string result(json_str, len);
+	free(json_str);
+	return result;
+}
+
+//===--------------------------------------------------------------------===//
+// Bind Data
+//===--------------------------------------------------------------------===//
+
+struct CrawlIntoBindData : public TableFunctionData {
+	string source_query;
+	string target_catalog;
+	string target_schema;
+	string target_table;
+	vector<string> aliases;
+	CrawlBatchOptions options;
+	int64_t row_limit = 0;
+};
+
+//===--------------------------------------------------------------------===//
+// Global State
+//===--------------------------------------------------------------------===//
+
+struct CrawlIntoGlobalState : public GlobalTableFunctionState {
+	bool finished = false;
+
+	// Counts for the progress bar and crawl_progress()
+	shared_ptr<CrawlProgress> progress;
+
+	idx_t MaxThreads() const override {
+		return 1;
+	}
+};
+
+//===--------------------------------------------------------------------===//
+// Bind Function
+//===--------------------------------------------------------------------===//
+
+// WITH options passed positionally from PlanCrawl, starting at inputs[first]:
+// user_agent, timeout_ms, delay_ms, concurrency, batch_size, respect_robots (-1 / empty = unset)
+static void BindCrawlIntoOptions(const vector<Value> &inputs, idx_t first, CrawlBatchOptions &options) {
+	string user_agent = StringValue::Get(inputs[first]);
+	if (!user_agent.empty()) {
+		options.user_agent = user_agent;
+	}
+	auto timeout_ms = inputs[first + 1].GetValue<int32_t>();
+	if (timeout_ms >= 0) {
+		options.timeout_ms = timeout_ms;
+	}
+	auto delay_ms = inputs[first + 2].GetValue<int32_t>();
+	if (delay_ms >= 0) {
+		options.delay_ms = delay_ms;
+	}
+	auto concurrency = inputs[first + 3].GetValue<int32_t>();
+	if (concurrency > 0) {
+		options.concurrency = concurrency;
+	}
+	auto batch_size = inputs[first + 4].GetValue<int32_t>();
+	if (batch_size > 0) {
+		options.batch_size = batch_size;
+	}
+	auto respect_robots = inputs[first + 5].GetValue<int32_t>();
+	if (respect_robots >= 0) {
+		options.respect_robots = respect_robots != 0;
+	}
+}
+
+static unique_ptr<FunctionData> CrawlIntoBind(ClientContext &context, TableFunctionBindInput &input,
+                                              vector<LogicalType> &return_types, vector<string> &names) {
+	auto bind_data = make_uniq<CrawlIntoBindData>();
+
+	// Extension settings are defaults, WITH options override them
+	LoadCrawlBatchSettings(context, bind_data->options);
+
+	// Parameters from parser (see PlanCrawl in crawl_parser.cpp)
+	// Negative / empty values mean "not set in WITH (...)"
+	bind_data->source_query = StringValue::Get(input.inputs[0]);
+
+	auto qualified = QualifiedName::Parse(StringValue::Get(input.inputs[1]));
+	bind_data->target_catalog = qualified.catalog;
+	bind_data->target_schema = qualified.schema.empty() ? DEFAULT_SCHEMA : qualified.schema;
+	bind_data->target_table = qualified.name;
+
+	bind_data->options.extraction_json = StringValue::Get(input.inputs[2]);
+	for (auto &alias : ListValue::GetChildren(input.inputs[3])) {
+		bind_data->aliases.push_back(StringValue::Get(alias));
+	}
+
+	BindCrawlIntoOptions(input.inputs, 4, bind_data->options);
+	bind_data->row_limit = input.inputs[10].GetValue<int64_t>();
+
+	return_types.push_back(LogicalType::BIGINT);
+	names.push_back("rows_inserted");
+
+	return std::move(bind_data);
+}
+
+static unique_ptr<GlobalTableFunctionState> CrawlIntoInitGlobal(ClientContext &context,
+                                                                TableFunctionInitInput &input) {
+	auto state = make_uniq<CrawlIntoGlobalState>();
+	state->progress = RegisterCrawlProgress(context, "crawl_into");
+	// URLs are known once the source query has run
+	state->progress->discovering = true;
+	return std::move(state);
+}
+
+//===--------------------------------------------------------------------===//
+// Batch Append
+//===--------------------------------------------------------------------===//
+
+// Types of CrawlIntoOutputColumns(aliases)
+static vector<LogicalType> CrawlIntoOutputTypes(const vector<string> &aliases) {
+	vector<LogicalType> types = {LogicalType::VARCHAR, LogicalType::VARCHAR, LogicalType::INTEGER,
+	                             LogicalType::VARCHAR, LogicalType::VARCHAR, LogicalType::VARCHAR,
+	                             LogicalType::VARCHAR, LogicalType::BIGINT,  LogicalType::VARCHAR,
+	                             LogicalType::TIMESTAMP};
+	for (idx_t i = 0; i < aliases.size(); i++) {
+		types.push_back(LogicalType::VARCHAR);
+	}
+	return types;
+}
+
+static void SetCrawlString(Vector &vector, idx_t row, bool valid, const string &value) {
+	if (!valid) {
+		FlatVector::SetNull(vector, row, true);
+		return;
+	}
+	FlatVector::GetData<string_t>(vector)[row] = StringVector::AddString(vector, value);
+}
+
+// Write results[offset, offset + count) column by column into chunk (CrawlIntoOutputTypes layout)
+static void FillCrawlResultChunk(DataChunk &chunk, const vector<CrawlBatchResult> &results, idx_t offset,
+                                 idx_t count, const vector<string> &aliases, timestamp_t crawled_at) {
+	auto status_codes = FlatVector::GetData<int32_t>(chunk.data[2]);
+	auto elapsed = FlatVector::GetData<int64_t>(chunk.data[7]);
+	auto crawled = FlatVector::GetData<timestamp_t>(chunk.data[9]);
+	for (idx_t row = 0; row < count; row++) {
+		auto &result = results[offset + row];
+		SetCrawlString(chunk.data[0], row, true, result.url);
+		SetCrawlString(chunk.data[1], row, true, GenerateSurtKey(result.url));
+		status_codes[row] = result.status_code;
+		SetCrawlString(chunk.data[3], row, !result.content_type.empty(), result.content_type);
+		SetCrawlString(chunk.data[4], row, result.has_body, result.body);
+		SetCrawlString(chunk.data[5], row, result.has_error, result.error);
+		SetCrawlString(chunk.data[6], row, !result.final_url.empty(), result.final_url);
+		elapsed[row] = result.elapsed_ms;
+		SetCrawlString(chunk.data[8], row, result.has_body, result.has_body ? GenerateContentHash(result.body) : "");
+		crawled[row] = crawled_at;
+		for (idx_t a = 0; a < aliases.size(); a++) {
+			auto entry = result.extracted.find(aliases[a]);
+			bool found = entry != result.extracted.end();
+			SetCrawlString(chunk.data[10 + a], row, found, found ? entry->second : "");
+		}
+	}
+	chunk.SetCardinality(count);
+}
+
+// Target table written by crawl_into_internal in the caller's transaction
+struct CrawlIntoTarget {
+	TableCatalogEntry &table;
+	vector<unique_ptr<BoundConstraint>> constraints;
+	// Output column (CrawlIntoOutputColumns index) per physical target column, INVALID_INDEX = NULL
+	vector<idx_t> column_map;
+};
+
+// Create the target with the standard columns + one VARCHAR per EXTRACT alias if it does not exist
+static TableCatalogEntry &EnsureCrawlIntoTarget(ClientContext &context, const CrawlIntoBindData &bind_data) {
+	auto existing = Catalog::GetEntry<TableCatalogEntry>(context, bind_data.target_catalog, bind_data.target_schema,
+	                                                     bind_data.target_table, OnEntryNotFound::RETURN_NULL);
+	if (existing) {
+		return *existing;
+	}
+	auto info = make_uniq<CreateTableInfo>(bind_data.target_catalog, bind_data.target_schema, bind_data.target_table);
+	info->on_conflict = OnCreateConflict::IGNORE_ON_CONFLICT;
+	auto names = CrawlIntoOutputColumns(bind_data.aliases);
+	auto types = CrawlIntoOutputTypes(bind_data.aliases);
+	for (idx_t i = 0; i < names.size(); i++) {
+		info->columns.AddColumn(ColumnDefinition(names[i], types[i]));
+	}
+	Catalog::GetCatalog(context, bind_data.target_catalog).CreateTable(context, std::move(info));
+	return Catalog::GetEntry<TableCatalogEntry>(context, bind_data.target_catalog, bind_data.target_schema,
+	                                            bind_data.target_table);
+}
+
+// Map target columns (by name) to the values we produce; unknown columns get NULL
+static vector<idx_t> MapCrawlIntoColumns(TableCatalogEntry &table, const vector<string> &aliases) {
+	auto produced = CrawlIntoOutputColumns(aliases);
+	vector<idx_t> column_map;
+	for (auto &column : table.GetColumns().Physical()) {
+		idx_t source_idx = DConstants::INVALID_INDEX;
+		for (idx_t c = 0; c < produced.size(); c++) {
+			if (StringUtil::CIEquals(column.Name(), produced[c])) {
+				source_idx = c;
+			}
+		}
+		column_map.push_back(source_idx);
+	}
+	return column_map;
+}
+
+// Append one Rust batch response to the target in the caller's transaction. Returns number of rows appended.
+static int64_t AppendCrawlBatch(ClientContext &context, CrawlIntoTarget &target, const CrawlIntoBindData &bind_data,
+                                CrawlBatchDedupe &dedupe, const string &response_json) {
+	auto results = ParseCrawlBatchResponse(response_json);
+	dedupe.CollapseDuplicates(results);
+	CompactCrawlBatchBodies(results, bind_data.options.store_body);
+	auto crawled_at = Timestamp::GetCurrentTimestamp();
+	auto &allocator = Allocator::Get(context);
+
+	DataChunk produced;
+	produced.Initialize(allocator, CrawlIntoOutputTypes(bind_data.aliases));
+	DataChunk append_chunk;
+	append_chunk.Initialize(allocator, target.table.GetTypes());
+
+	auto &storage = target.table.GetStorage();
+	LocalAppendState append_state;
+	storage.InitializeLocalAppend(append_state, target.table, context, target.constraints);
+	for (idx_t offset = 0; offset < results.size(); offset += STANDARD_VECTOR_SIZE) {
+		idx_t count = MinValue<idx_t>(STANDARD_VECTOR_SIZE, results.size() - offset);
+		produced.Reset();
+		FillCrawlResultChunk(produced, results, offset, count, bind_data.aliases, crawled_at);
+
+		append_chunk.Reset();
+		for (idx_t col = 0; col < target.column_map.size(); col++) {
+			auto source_idx = target.column_map[col];
+			auto &column = append_chunk.data[col];
+			if (source_idx == DConstants::INVALID_INDEX) {
+				column.SetVectorType(VectorType::CONSTANT_VECTOR);
+				ConstantVector::SetNull(column, true);
+			} else if (column.GetType() == produced.data[source_idx].GetType()) {
+				column.Reference(produced.data[source_idx]);
+			} else {
+				VectorOperations::Cast(context, produced.data[source_idx], column, count);
+			}
+		}
+		append_chunk.SetCardinality(count);
+		storage.LocalAppend(append_state, context, append_chunk, false);
+	}
+	storage.FinalizeLocalAppend(append_state);
+	return static_cast<int64_t>(results.size());
+}
+
+//===--------------------------------------------------------------------===//
+// Main Function
+//===--------------------------------------------------------------------===//
+
+static void CrawlIntoFunction(ClientContext &context, TableFunctionInput &data, DataChunk &output) {
+	auto &bind_data = data.bind_data->Cast<CrawlIntoBindData>();
+	auto &state = data.global_state->Cast<CrawlIntoGlobalState>();
+
+	if (state.finished) {
+		output.SetCardinality(0);
+		return;
+	}
+
+	// The source query runs on its own connection (the caller's is executing this
+	// statement); it only reads, all writes below belong to the caller's transaction
+	vector<string> urls;
+	{
+		Connection conn(*context.db);
+		conn.Query("LOAD crawler");
+
+		// Collect source URLs (first column of the source query)
+		auto query_result = conn.Query(bind_data.source_query);
+		if (query_result->HasError()) {
+			throw IOException("CRAWL INTO source query error: " + query_result->GetError());
+		}
+		std::set<string> seen;
+		while (auto chunk = query_result->Fetch()) {
+			for (idx_t i = 0; i < chunk->size(); i++) {
+				auto val = chunk->GetValue(0, i);
+				if (!val.IsNull() && seen.insert(val.ToString()).second) {
+					urls.push_back(val.ToString());
+				}
+			}
+		}
+	}
+	if (bind_data.row_limit > 0 && urls.size() > static_cast<idx_t>(bind_data.row_limit)) {
+		urls.resize(bind_data.row_limit);
+	}
+	state.progress->queued = NumericCast<int64_t>(urls.size());
+	state.progress->discovering = false;
+
+	auto &table = EnsureCrawlIntoTarget(context, bind_data);
+	auto binder = Binder::CreateBinder(context);
+	CrawlIntoTarget target {table, binder->BindConstraints(table), MapCrawlIntoColumns(table, bind_data.aliases)};
+	int64_t rows_inserted = 0;
+	CrawlBatchDedupe dedupe(context, bind_data.options.dedupe);
+
+	// Pipeline: fetch batch N+1 in Rust while batch N is being appended
+	idx_t next_url = 0;
+	auto launch_next = [&]() -> std::future<string> {
+		vector<string> batch;
+		while (batch.empty()) {
+			if (next_url >= urls.size() || IsInterrupted()) {
+				return std::future<string>();
+			}
+			idx_t end = MinValue<idx_t>(next_url + bind_data.options.batch_size, urls.size());
+			batch.assign(urls.begin() + next_url, urls.begin() + end);
+			next_url = end;
+			state.progress->queued -= NumericCast<int64_t>(batch.size());
+			// Variants of pages stored by earlier batches are not fetched
+			state.progress->Complete(NumericCast<int64_t>(dedupe.SkipSeenUrls(batch)));
+		}
+		state.progress->in_flight += NumericCast<int64_t>(batch.size());
+		string request_json = BuildCrawlBatchRequest(bind_data.options, batch);
+		auto backend = bind_data.options.fetch_backend;
+		return std::async(std::launch::async,
+		                  [backend, request_json]() { return CrawlBatchWithBackend(backend, request_json); });
+	};
+
+	auto pending = launch_next();
+	while (pending.valid()) {
+		string response_json = pending.get();
+		// Completed counts every URL of the batch, the next batch is in flight
+		auto batch_size = state.progress->in_flight.load();
+		pending = launch_next();
+
+		rows_inserted += AppendCrawlBatch(context, target, bind_data, dedupe, response_json);
+		state.progress->Complete(batch_size, true);
+	}
+	// Interrupted: the rest is never fetched
+	state.progress->queued = 0;
+
+	state.finished = true;
+	output.SetValue(0, 0, Value::BIGINT(rows_inserted));
+	output.SetCardinality(1);
+}
+
+//===--------------------------------------------------------------------===//
+// Progress Callback
+//===--------------------------------------------------------------------===//
+
+static double CrawlIntoProgress(ClientContext &context, const FunctionData *bind_data_p,
+                                const GlobalTableFunctionState *gstate_p) {
+	if (!gstate_p) {
+		return -1.0;
+	}
+	return CrawlProgressPercentage(gstate_p->Cast<CrawlIntoGlobalState>().progress);
+}
+
+//===--------------------------------------------------------------------===//
+// Register Function
+//===--------------------------------------------------------------------===//
+
+void RegisterCrawlIntoFunction(ExtensionLoader &loader) {
+	// Parameters: source_query, target_table, extraction_json, aliases,
+	//             user_agent, timeout_ms, delay_ms, concurrency, batch_size, respect_robots (-1 = unset),
+	//             row_limit
+	TableFunction func("crawl_into_internal",
+	                   {LogicalType::VARCHAR, LogicalType::VARCHAR, LogicalType::VARCHAR,
+	                    LogicalType::LIST(LogicalType::VARCHAR),
+	                    LogicalType::VARCHAR, LogicalType::INTEGER, LogicalType::INTEGER, LogicalType::INTEGER,
+	                    LogicalType::INTEGER, LogicalType::INTEGER,
+	                    LogicalType::BIGINT},
+	                   CrawlIntoFunction, CrawlIntoBind, CrawlIntoInitGlobal);
+	func.table_scan_progress = CrawlIntoProgress;
+	loader.RegisterFunction(func);
+}
+
+} // namespace duckdb
@@ -20,9 +20,18 @@
 //   )
 //   SELECT l.url as source, c.*
 //   FROM links l, LATERAL crawl_url(l.link) c
+//
+//   -- Or one request per row with its own method, headers and body (see request_spec.hpp):
+//   SELECT q.id, c.status, c.html.document
+//   FROM queries q, LATERAL crawl_url({'url': 'https://api.example.com/graphql', 'method': 'POST',
+//                                      'headers': MAP {'Content-Type': 'application/json'}, 'body': q.body}) c
 
 #include "crawl_table_function.hpp"
 #include "crawler_utils.hpp"
+#include "crawler_cache.hpp"
+#include "html_compact.hpp"
+#include "fetch_backend.hpp"
+#include "request_spec.hpp"
 #include "rust_ffi.hpp"
 #include "yyjson.hpp"
 #include "pipeline_state.hpp"
@@ -93,57 +102,39 @@ struct SingleCrawlResult {
 };
 
 //===--------------------------------------------------------------------===//
-// HTTP Cache Table Management (__crawler_cache)
+// HTTP Cache (__crawler_cache, see crawler_cache.cpp)
 //===--------------------------------------------------------------------===//
 
-static constexpr const char* CACHE_TABLE_NAME = "__crawler_cache";
-
-static void EnsureCacheTable(Connection &conn) {
-    string sql = "CREATE TABLE IF NOT EXISTS " + string(CACHE_TABLE_NAME) + " ("
-                 "url VARCHAR PRIMARY KEY, "
-                 "status_code INTEGER, "
-                 "content_type VARCHAR, "
-                 "body VARCHAR, "
-                 "error VARCHAR, "
-                 "response_time_ms BIGINT, "
-                 "cached_at TIMESTAMP DEFAULT current_timestamp)";
-    conn.Query(sql);
-}
-
-static unique_ptr<SingleCrawlResult> GetCachedEntry(Connection &conn, const string &url, int ttl_hours) {
-    EnsureCacheTable(conn);
-    auto result = conn.Query(
-        "SELECT url, status_code, content_type, body, error, response_time_ms "
-        "FROM " + string(CACHE_TABLE_NAME) + " "
-        "WHERE url = $1 AND cached_at > current_timestamp - INTERVAL '" + std::to_string(ttl_hours) + " hours'",
-        url);
-
-    if (!result->HasError()) {
-        auto chunk = result->Fetch();
-        if (chunk && chunk->size() > 0) {
-            auto entry = make_uniq<SingleCrawlResult>();
-            entry->url = chunk->GetValue(0, 0).ToString();
-            entry->status_code = chunk->GetValue(1, 0).GetValue<int>();
-            entry->content_type = chunk->GetValue(2, 0).IsNull() ? "" : chunk->GetValue(2, 0).ToString();
-            entry->body = chunk->GetValue(3, 0).IsNull() ? "" : chunk->GetValue(3, 0).ToString();
-            entry->error = chunk->GetValue(4, 0).IsNull() ? "" : chunk->GetValue(4, 0).ToString();
-            entry->response_time_ms = chunk->GetValue(5, 0).IsNull() ? 0 : chunk->GetValue(5, 0).GetValue<int64_t>();
-            return entry;
-        }
+static unique_ptr<SingleCrawlResult> GetCachedEntry(Connection &conn, const string &url, int ttl_hours,
+                                                     const CrawlerCachePolicy &policy) {
+    auto hits = CrawlerCacheLookup(conn, {url}, ttl_hours, policy);
+    // Bodies compacted by crawl(store_body := ...) lost their markup: not a hit for the raw body
+    StoreBodyMode stored_mode;
+    if (hits.empty() || !UntagStoredContentType(hits[0].content_type, stored_mode) ||
+        stored_mode != StoreBodyMode::RAW) {
+        return nullptr;
     }
-    return nullptr;
+    auto entry = make_uniq<SingleCrawlResult>();
+    entry->url = std::move(hits[0].url);
+    entry->status_code = hits[0].status_code;
+    entry->content_type = std::move(hits[0].content_type);
+    entry->body = std::move(hits[0].body);
+    entry->error = std::move(hits[0].error);
+    entry->response_time_ms = hits[0].response_time_ms;
+    return entry;
 }
 
-static void SaveToCache(Connection &conn, const SingleCrawlResult &result) {
-    EnsureCacheTable(conn);
-    string sql = "INSERT OR REPLACE INTO " + string(CACHE_TABLE_NAME) +
-                 " (url, status_code, content_type, body, error, response_time_ms, cached_at) "
-                 "VALUES ($1, $2, $3, $4, $5, $6, current_timestamp)";
-    conn.Query(sql, result.url, result.status_code,
-               result.content_type.empty() ? Value() : Value(result.content_type),
-               result.body.empty() ? Value() : Value(result.body),
-               result.error.empty() ? Value() : Value(result.error),
-               result.response_time_ms);
+// key: the URL, or CrawlRequestSpec::Key() of a request spec
+static void SaveToCache(Connection &conn, const string &key, const SingleCrawlResult &result,
+                        const CrawlerCachePolicy &policy) {
+    CrawlerCacheEntry entry;
+    entry.url = key;
+    entry.status_code = result.status_code;
+    entry.content_type = result.content_type;
+    entry.body = result.body;
+    entry.error = result.error;
+    entry.response_time_ms = result.response_time_ms;
+    CrawlerCacheStore(conn, entry, policy);
 }
 
 //===--------------------------------------------------------------------===//
@@ -332,6 +323,8 @@ struct CrawlUrlBindData : public TableFunctionData {
     int timeout_ms = 30000;
     bool use_cache = true;      // Enable HTTP response caching
     int cache_ttl_hours = 24;   // Cache TTL in hours
+    CrawlerCachePolicy cache_policy;  // crawler_cache_max_bytes / crawler_cache_max_age
+    FetchBackendType fetch_backend = FetchBackendType::REQWEST;  // crawler_fetch_backend
     int64_t max_results = -1;   // Max results to return (-1 = unlimited)
 
     // Shared pipeline state for LIMIT pushdown across LATERAL calls
@@ -369,13 +362,15 @@ struct CrawlUrlGlobalState : public GlobalTableFunctionState {
 };
 
 //===--------------------------------------------------------------------===//
-// Helper: Crawl single URL using Rust
+// Helper: Crawl single URL (fetch backend)
 //===--------------------------------------------------------------------===//
 
 static SingleCrawlResult CrawlSingleUrl(const string &url,
                                          const string &extraction_json,
                                          const string &user_agent,
-                                         int timeout_ms) {
+                                         int timeout_ms,
+                                         FetchBackendType fetch_backend,
+                                         const CrawlRequestSpec *request = nullptr) {
     SingleCrawlResult result;
     result.url = url;
 
@@ -394,6 +389,13 @@ static SingleCrawlResult CrawlSingleUrl(const string &url,
     yyjson_mut_arr_add_strcpy(doc, urls_arr, url.c_str());
     yyjson_mut_obj_add_val(doc, root, "urls", urls_arr);
 
+    // Method / headers / body of a request spec
+    if (request) {
+        yyjson_mut_val *requests_arr = yyjson_mut_arr(doc);
+        yyjson_mut_arr_append(requests_arr, CrawlRequestSpecJson(doc, *request));
+        yyjson_mut_obj_add_val(doc, root, "requests", requests_arr);
+    }
+
     // Extraction specs
     if (!extraction_json.empty() && extraction_json != "{}") {
         yyjson_doc *ext_doc = yyjson_read(extraction_json.c_str(), extraction_json.size(), 0);
@@ -423,8 +425,8 @@ static SingleCrawlResult CrawlSingleUrl(const string &url,
     string request_json(json_str, len);
     free(json_str);
 
-    // Call Rust
-    string response_json = CrawlBatchWithRust(request_json);
+    // Fetch (crawler_fetch_backend)
+    string response_json = CrawlBatchWithBackend(fetch_backend, request_json);
 
     // Parse response
     yyjson_doc *resp_doc = yyjson_read(response_json.c_str(), response_json.size(), 0);
@@ -509,6 +511,8 @@ static unique_ptr<FunctionData> CrawlUrlBind(ClientContext &context, TableFuncti
     if (context.TryGetCurrentSetting("crawler_timeout_ms", setting_value)) {
         bind_data->timeout_ms = static_cast<int>(setting_value.GetValue<int64_t>());
     }
+    bind_data->cache_policy = LoadCrawlerCachePolicy(context);
+    bind_data->fetch_backend = LoadFetchBackendType(context);
 
     // Check for optional second positional argument (max_results)
     // This enables LIMIT pushdown in LATERAL joins where named params don't work
@@ -550,6 +554,7 @@ static unique_ptr<FunctionData> CrawlUrlBind(ClientContext &context, TableFuncti
     return_types.push_back(LogicalType::VARCHAR);  // error
     return_types.push_back(LogicalType::VARCHAR);  // extract
     return_types.push_back(LogicalType::BIGINT);   // response_time_ms
+    return_types.push_back(LogicalType::VARCHAR);  // request_key
 
     names.push_back("url");
     names.push_back("status");
@@ -559,6 +564,7 @@ static unique_ptr<FunctionData> CrawlUrlBind(ClientContext &context, TableFuncti
     names.push_back("error");
     names.push_back("extract");
     names.push_back("response_time_ms");
+    names.push_back("request_key");
 
     // Look up shared pipeline state for LIMIT pushdown across LATERAL calls
     // The state is created by stream_into_function BEFORE running the query
@@ -641,6 +647,7 @@ static OperatorResultType CrawlUrlInOut(ExecutionContext &context, TableFunction
             output.SetValue(5, 0, Value("NULL URL"));
             output.SetValue(6, 0, Value());
             output.SetValue(7, 0, Value());
+            output.SetValue(8, 0, Value());
             output.SetCardinality(1);
             local_state.current_row++;
             local_state.results_returned++;
@@ -661,7 +668,13 @@ static OperatorResultType CrawlUrlInOut(ExecutionContext &context, TableFunction
             return OperatorResultType::NEED_MORE_INPUT;
         }
 
-        string url = StringValue::Get(url_val);
+        // URL string, or STRUCT(url, method, headers, body) request spec
+        unique_ptr<CrawlRequestSpec> request;
+        if (url_val.type().id() == LogicalTypeId::STRUCT) {
+            request = make_uniq<CrawlRequestSpec>(CrawlRequestSpecFromValue(url_val));
+        }
+        string url = request ? request->url : StringValue::Get(url_val);
+        string cache_key = request ? request->Key() : url;
 
         // Skip empty URLs
         if (url.empty()) {
@@ -675,9 +688,10 @@ static OperatorResultType CrawlUrlInOut(ExecutionContext &context, TableFunction
         // Check cache first
         if (bind_data.use_cache) {
             Connection cache_conn(*context.client.db);
-            auto cached = GetCachedEntry(cache_conn, url, bind_data.cache_ttl_hours);
+            auto cached = GetCachedEntry(cache_conn, cache_key, bind_data.cache_ttl_hours, bind_data.cache_policy);
             if (cached) {
                 result = std::move(*cached);
+                result.url = url;
                 from_cache = true;
             }
         }
@@ -685,12 +699,13 @@ static OperatorResultType CrawlUrlInOut(ExecutionContext &context, TableFunction
         // Crawl if not in cache
         if (!from_cache) {
             result = CrawlSingleUrl(url, "{}",  // No extraction specs
-                                    bind_data.user_agent, bind_data.timeout_ms);
+                                    bind_data.user_agent, bind_data.timeout_ms, bind_data.fetch_backend,
+                                    request.get());
 
             // Save to cache
             if (bind_data.use_cache) {
                 Connection cache_conn(*context.client.db);
-                SaveToCache(cache_conn, result);
+                SaveToCache(cache_conn, cache_key, result, bind_data.cache_policy);
             }
         }
 
@@ -703,6 +718,7 @@ static OperatorResultType CrawlUrlInOut(ExecutionContext &context, TableFunction
         output.SetValue(5, 0, result.error.empty() ? Value() : Value(result.error));
         output.SetValue(6, 0, result.extracted_json.empty() ? Value() : Value(result.extracted_json));
         output.SetValue(7, 0, Value::BIGINT(result.response_time_ms));
+        output.SetValue(8, 0, cache_key == url ? Value() : Value(cache_key));
         output.SetCardinality(1);
 
         local_state.current_row++;
@@ -763,6 +779,21 @@ void RegisterCrawlUrlFunction(ExtensionLoader &loader) {
     func_with_limit.named_parameters["cache_ttl"] = LogicalType::INTEGER;
 
     loader.RegisterFunction(func_with_limit);
+
+    // crawl_url(request STRUCT(url, method, headers, body) [, max_results BIGINT])
+    for (idx_t arg_count = 1; arg_count <= 2; arg_count++) {
+        vector<LogicalType> args = {CrawlRequestSpecType()};
+        if (arg_count == 2) {
+            args.push_back(LogicalType::BIGINT);
+        }
+        TableFunction request_func("crawl_url", args, nullptr, CrawlUrlBind, CrawlUrlInitGlobal, CrawlUrlInitLocal);
+        request_func.in_out_function = CrawlUrlInOut;
+        request_func.named_parameters["user_agent"] = LogicalType::VARCHAR;
+        request_func.named_parameters["timeout"] = LogicalType::INTEGER;
+        request_func.named_parameters["cache"] = LogicalType::BOOLEAN;
+        request_func.named_parameters["cache_ttl"] = LogicalType::INTEGER;
+        loader.RegisterFunction(request_func);
+    }
 }
 
 } // namespace duckdb
@@ -1,10 +1,14 @@
 #include "crawl_parser.hpp"
+#include "crawl_into_function.hpp"
+#include "duckdb/common/error_data.hpp"
 #include "duckdb/common/string_util.hpp"
 #include "duckdb/parser/parser.hpp"
+#include "duckdb/parser/qualified_name.hpp"
 #include "duckdb/parser/statement/merge_into_statement.hpp"
 #include "duckdb/parser/expression/columnref_expression.hpp"
 #include "duckdb/parser/expression/comparison_expression.hpp"
 #include "duckdb/parser/tableref/subqueryref.hpp"
+#include "duckdb/common/enums/statement_type.hpp"
 #include "duckdb/main/config.hpp"
 #include "duckdb/catalog/catalog.hpp"
 #include "duckdb/catalog/catalog_entry/table_function_catalog_entry.hpp"
@@ -84,6 +88,21 @@ string CrawlingMergeParseData::ToString() const {
 	return result;
 }
 
+//===--------------------------------------------------------------------===//
+// CrawlIntoParseData
+//===--------------------------------------------------------------------===//
+unique_ptr<ParserExtensionParseData> CrawlIntoParseData::Copy() const {
+	return make_uniq<CrawlIntoParseData>(*this);
+}
+
+string CrawlIntoParseData::ToString() const {
+	string result = "CRAWL (" + source_query_sql + ") INTO " + target_table;
+	if (!extract_aliases.empty()) {
+		result += " EXTRACT (" + StringUtil::Join(extract_aliases, ", ") + ")";
+	}
+	return result;
+}
+
 //===--------------------------------------------------------------------===//
 // Parser helpers
 //===--------------------------------------------------------------------===//
@@ -371,6 +390,244 @@ static ParserExtensionParseResult ParseCrawlingMerge(const string &query) {
 	return ParserExtensionParseResult(std::move(data));
 }
 
+//===--------------------------------------------------------------------===//
+// Parse CRAWL (<source>) INTO <table>
+//===--------------------------------------------------------------------===//
+// Syntax: CRAWL (<select returning urls>)
+//         INTO <table>
+//         [EXTRACT (<spec> [AS alias], ...)]
+//         [WHERE <url filter>]
+//         [WITH (<option> <value>, ...)]
+//         [LIMIT <n>]
+//
+// The statement is planned to crawl_into_internal(), which fetches in batches
+// and bulk-appends rows instead of issuing one INSERT per page.
+
+// Strip -- line comments outside string literals
+static string StripLineComments(const string &query) {
+	string result;
+	result.reserve(query.length());
+	char quote = 0;
+	for (size_t i = 0; i < query.length(); i++) {
+		char c = query[i];
+		if (quote) {
+			if (c == quote) {
+				quote = 0;
+			}
+		} else if (c == '\'' || c == '"') {
+			quote = c;
+		} else if (c == '-' && i + 1 < query.length() && query[i + 1] == '-') {
+			while (i < query.length() && query[i] != '\n') {
+				i++;
+			}
+			result += '\n';
+			continue;
+		}
+		result += c;
+	}
+	return result;
+}
+
+static size_t SkipSpaces(const string &str, size_t pos) {
+	while (pos < str.length() && std::isspace(static_cast<unsigned char>(str[pos]))) {
+		pos++;
+	}
+	return pos;
+}
+
+// Check for keyword at pos (lowercase input) followed by a non-identifier character
+static bool MatchKeyword(const string &lower, size_t pos, const string &keyword) {
+	if (lower.compare(pos, keyword.length(), keyword) != 0) {
+		return false;
+	}
+	size_t end = pos + keyword.length();
+	return end >= lower.length() || !(std::isalnum(static_cast<unsigned char>(lower[end])) || lower[end] == '_');
+}
+
+// Find the first top-level clause keyword at or after start (outside quotes and parentheses)
+static size_t FindNextClause(const string &lower, size_t start) {
+	static const char *const CLAUSES[] = {"extract", "where", "with", "limit"};
+	int depth = 0;
+	char quote = 0;
+	for (size_t i = start; i < lower.length(); i++) {
+		char c = lower[i];
+		if (quote) {
+			if (c == quote) {
+				quote = 0;
+			}
+			continue;
+		}
+		if (c == '\'' || c == '"') {
+			quote = c;
+		} else if (c == '(') {
+			depth++;
+		} else if (c == ')') {
+			depth--;
+		} else if (depth == 0 && i > 0 && std::isspace(static_cast<unsigned char>(lower[i - 1]))) {
+			for (auto clause : CLAUSES) {
+				if (MatchKeyword(lower, i, clause)) {
+					return i;
+				}
+			}
+		}
+	}
+	return lower.length();
+}
+
+static string UnquoteOption(const string &value) {
+	if (value.length() >= 2 && value.front() == '\'' && value.back() == '\'') {
+		return StringUtil::Replace(value.substr(1, value.length() - 2), "''", "'");
+	}
+	return value;
+}
+
+// Apply a single WITH option. Returns an error message, empty on success.
+static string ApplyCrawlIntoOption(CrawlIntoParseData &data, const string &option) {
+	size_t split = 0;
+	while (split < option.length() && !std::isspace(static_cast<unsigned char>(option[split]))) {
+		split++;
+	}
+	string name = StringUtil::Lower(option.substr(0, split));
+	string value = UnquoteOption(Trim(option.substr(split)));
+	if (value.empty()) {
+		return "CRAWL syntax error: option '" + name + "' requires a value";
+	}
+
+	try {
+		if (name == "user_agent") {
+			data.user_agent = value;
+		} else if (name == "timeout_seconds") {
+			data.timeout_ms = static_cast<int32_t>(std::stod(value) * 1000);
+		} else if (name == "timeout_ms") {
+			data.timeout_ms = std::stoi(value);
+		} else if (name == "default_crawl_delay") {
+			data.delay_ms = static_cast<int32_t>(std::stod(value) * 1000);
+		} else if (name == "max_parallel_per_domain" || name == "workers") {
+			data.concurrency = std::stoi(value);
+		} else if (name == "batch_size") {
+			data.batch_size = std::stoi(value);
+		} else if (name == "respect_robots_txt") {
+			string lower_value = StringUtil::Lower(value);
+			if (lower_value != "true" && lower_value != "false") {
+				return "CRAWL syntax error: respect_robots_txt expects true or false";
+			}
+			data.respect_robots = lower_value == "true" ? 1 : 0;
+		} else {
+			return "CRAWL syntax error: unknown option '" + name + "'";
+		}
+	} catch (std::exception &) {
+		return "CRAWL syntax error: invalid value '" + value + "' for option '" + name + "'";
+	}
+	return "";
+}
+
+static ParserExtensionParseResult ParseCrawlInto(const string &query) {
+	string text = Trim(StripLineComments(query));
+	if (!text.empty() && text.back() == ';') {
+		text.pop_back();
+		text = Trim(text);
+	}
+	string lower = StringUtil::Lower(text);
+
+	// CRAWL (<source>)
+	size_t pos = SkipSpaces(text, 5);
+	if (pos >= text.length() || text[pos] != '(') {
+		return ParserExtensionParseResult("CRAWL syntax error: expected '(<query>)' after CRAWL");
+	}
+	size_t close = FindClosingParen(text, pos);
+	if (close == string::npos) {
+		return ParserExtensionParseResult("CRAWL syntax error: unterminated source query");
+	}
+	string source = Trim(text.substr(pos + 1, close - pos - 1));
+
+	Parser parser;
+	try {
+		parser.ParseQuery(source);
+	} catch (std::exception &e) {
+		return ParserExtensionParseResult("CRAWL syntax error in source query: " + ErrorData(e).RawMessage());
+	}
+	if (parser.statements.size() != 1 || parser.statements[0]->type != StatementType::SELECT_STATEMENT) {
+		return ParserExtensionParseResult("CRAWL syntax error: source must be a single SELECT returning URLs");
+	}
+
+	// INTO <table>
+	pos = SkipSpaces(text, close + 1);
+	if (!MatchKeyword(lower, pos, "into")) {
+		return ParserExtensionParseResult("CRAWL syntax error: expected INTO <table>");
+	}
+	pos = SkipSpaces(text, pos + 4);
+	size_t name_end = pos;
+	while (name_end < text.length() && !std::isspace(static_cast<unsigned char>(text[name_end]))) {
+		name_end++;
+	}
+	auto data = make_uniq<CrawlIntoParseData>();
+	data->target_table = text.substr(pos, name_end - pos);
+	if (data->target_table.empty()) {
+		return ParserExtensionParseResult("CRAWL syntax error: expected table name after INTO");
+	}
+	pos = SkipSpaces(text, name_end);
+
+	// Optional clauses, in any order
+	string where_clause;
+	vector<string> extract_items;
+	while (pos < text.length()) {
+		if (MatchKeyword(lower, pos, "extract") || MatchKeyword(lower, pos, "with")) {
+			bool is_extract = MatchKeyword(lower, pos, "extract");
+			size_t open = SkipSpaces(text, pos + (is_extract ? 7 : 4));
+			size_t end = open < text.length() && text[open] == '(' ? FindClosingParen(text, open) : string::npos;
+			if (end == string::npos) {
+				return ParserExtensionParseResult(string("CRAWL syntax error: expected ") +
+				                                  (is_extract ? "EXTRACT (...)" : "WITH (...)"));
+			}
+			auto items = SplitCrawlList(text.substr(open + 1, end - open - 1));
+			if (is_extract) {
+				extract_items = std::move(items);
+			} else {
+				for (auto &option : items) {
+					auto error = ApplyCrawlIntoOption(*data, option);
+					if (!error.empty()) {
+						return ParserExtensionParseResult(error);
+					}
+				}
+			}
+			pos = SkipSpaces(text, end + 1);
+		} else if (MatchKeyword(lower, pos, "where")) {
+			size_t end = FindNextClause(lower, pos + 5);
+			where_clause = Trim(text.substr(pos + 5, end - pos - 5));
+			if (where_clause.empty()) {
+				return ParserExtensionParseResult("CRAWL syntax error: empty WHERE clause");
+			}
+			pos = end;
+		} else if (MatchKeyword(lower, pos, "limit")) {
+			size_t num_start = SkipSpaces(text, pos + 5);
+			size_t num_end = num_start;
+			while (num_end < text.length() && std::isdigit(static_cast<unsigned char>(text[num_end]))) {
+				num_end++;
+			}
+			if (num_end == num_start) {
+				return ParserExtensionParseResult("CRAWL syntax error: LIMIT expects a number");
+			}
+			data->row_limit = std::stoll(text.substr(num_start, num_end - num_start));
+			pos = SkipSpaces(text, num_end);
+		} else {
+			return ParserExtensionParseResult("CRAWL syntax error: unexpected '" + text.substr(pos, 20) + "'");
+		}
+	}
+
+	try {
+		data->extraction_json = CompileCrawlExtractSpecs(extract_items, data->extract_aliases);
+	} catch (std::exception &e) {
+		return ParserExtensionParseResult(ErrorData(e).RawMessage());
+	}
+
+	data->source_query_sql = source;
+	if (!where_clause.empty()) {
+		data->source_query_sql = "SELECT * FROM (" + source + ") AS __crawl_source WHERE " + where_clause;
+	}
+
+	return ParserExtensionParseResult(std::move(data));
+}
+
 //===--------------------------------------------------------------------===//
 // CrawlParserExtension
 //===--------------------------------------------------------------------===//
@@ -380,7 +637,7 @@ CrawlParserExtension::CrawlParserExtension() {
 }
 
 ParserExtensionParseResult CrawlParserExtension::ParseCrawl(ParserExtensionInfo *info, const string &query) {
-	// Only handle CRAWLING MERGE INTO statements
+	// Only handle CRAWLING MERGE INTO and CRAWL ... INTO statements
 	// Table functions (crawl, crawl_url, htmlpath) are registered separately
 	string trimmed = Trim(query);
 	string lower = StringUtil::Lower(trimmed);
@@ -390,6 +647,12 @@ ParserExtensionParseResult CrawlParserExtension::ParseCrawl(ParserExtensionInfo
 		return ParseCrawlingMerge(trimmed);
 	}
 
+	// Handle CRAWL (<source>) INTO <table>
+	if (StringUtil::StartsWith(lower, "crawl") && lower.length() > 5 &&
+	    (std::isspace(static_cast<unsigned char>(lower[5])) || lower[5] == '(')) {
+		return ParseCrawlInto(trimmed);
+	}
+
 	// Not a statement we handle, let default parser handle it
 	return ParserExtensionParseResult();
 }
@@ -535,7 +798,53 @@ ParserExtensionPlanResult CrawlParserExtension::PlanCrawl(ParserExtensionInfo *i
 		return result;
 	}
 
-	// Only CRAWLING MERGE INTO is supported; this should never be reached
+	// Check if this is a CRAWL ... INTO statement
+	if (dynamic_cast<CrawlIntoParseData *>(parse_data.get())) {
+		auto &into_data = (CrawlIntoParseData &)*parse_data;
+
+		auto catalog_entry = catalog.GetEntry(context, CatalogType::TABLE_FUNCTION_ENTRY, DEFAULT_SCHEMA,
+		                                       "crawl_into_internal", OnEntryNotFound::THROW_EXCEPTION);
+		auto &table_function_catalog_entry = catalog_entry->Cast<TableFunctionCatalogEntry>();
+		if (table_function_catalog_entry.functions.functions.empty()) {
+			throw BinderException("CRAWL INTO: crawl_into_internal function not found");
+		}
+		result.function = table_function_catalog_entry.functions.functions[0];
+
+		vector<Value> aliases;
+		for (auto &alias : into_data.extract_aliases) {
+			aliases.push_back(Value(alias));
+		}
+
+		// Pass parameters to crawl_into_internal
+		// Order: source_query, target_table, extraction_json, aliases,
+		//        user_agent, timeout_ms, delay_ms, concurrency, batch_size, respect_robots, row_limit
+		result.parameters.push_back(Value(into_data.source_query_sql));
+		result.parameters.push_back(Value(into_data.target_table));
+		result.parameters.push_back(Value(into_data.extraction_json));
+		result.parameters.push_back(Value::LIST(LogicalType::VARCHAR, std::move(aliases)));
+		result.parameters.push_back(Value(into_data.user_agent));
+		result.parameters.push_back(Value::INTEGER(into_data.timeout_ms));
+		result.parameters.push_back(Value::INTEGER(into_data.delay_ms));
+		result.parameters.push_back(Value::INTEGER(into_data.concurrency));
+		result.parameters.push_back(Value::INTEGER(into_data.batch_size));
+		result.parameters.push_back(Value::INTEGER(into_data.respect_robots));
+		result.parameters.push_back(Value::BIGINT(into_data.row_limit));
+
+		// crawl_into_internal creates the target and appends to it in the caller's transaction
+		auto qualified = QualifiedName::Parse(into_data.target_table);
+		auto &target_catalog = Catalog::GetCatalog(context, qualified.catalog);
+		StatementProperties properties;
+		properties.RegisterDBModify(target_catalog, context, DatabaseModificationType::CREATE_CATALOG_ENTRY);
+		properties.RegisterDBModify(target_catalog, context, DatabaseModificationType::INSERT_DATA);
+		result.modified_databases = properties.modified_databases;
+
+		result.requires_valid_transaction = true;
+		result.return_type = StatementReturnType::CHANGED_ROWS;
+
+		return result;
+	}
+
+	// Only CRAWLING MERGE INTO and CRAWL ... INTO are supported; this should never be reached
 	throw BinderException("CRAWLING parser: unexpected parse data type");
 }
 
@@ -0,0 +1,201 @@
+// Progress of running crawl table functions
+//
+//   SELECT * FROM crawl_progress();
+//
+// lists every crawl(), crawl_stream(), sitemap(), CRAWL INTO, STREAM INTO /
+// CRAWLING MERGE and crawl_to_parquet() run of the database, from any
+// connection: URLs completed / in flight / queued, the estimated total, and
+// the time of the last completed URL. A run whose last_activity stops moving
+// while urls_in_flight > 0 is stuck on a fetch.
+
+#include "crawl_progress.hpp"
+
+#include "duckdb/common/types/timestamp.hpp"
+#include "duckdb/function/table_function.hpp"
+#include "duckdb/main/client_context.hpp"
+#include "duckdb/storage/object_cache.hpp"
+
+#include <algorithm>
+#include <mutex>
+
+namespace duckdb {
+
+//===--------------------------------------------------------------------===//
+// CrawlProgress
+//===--------------------------------------------------------------------===//
+
+void CrawlProgress::Complete(int64_t count, bool from_in_flight) {
+	if (from_in_flight) {
+		in_flight -= count;
+	}
+	completed += count;
+	last_activity_us = Timestamp::GetEpochMicroSeconds(Timestamp::GetCurrentTimestamp());
+}
+
+void CrawlProgress::SetSource(shared_ptr<CrawlProgress> source_p) {
+	std::lock_guard<std::mutex> guard(source_lock);
+	source = std::move(source_p);
+}
+
+int64_t CrawlProgress::EstimatedTotal() const {
+	auto done = completed.load();
+	double total = static_cast<double>(done + in_flight.load() + queued.load());
+	if (discovering.load()) {
+		shared_ptr<CrawlProgress> source_progress;
+		{
+			std::lock_guard<std::mutex> guard(source_lock);
+			source_progress = source.lock();
+		}
+		if (source_progress) {
+			total = MaxValue<double>(total, static_cast<double>(source_progress->EstimatedTotal()));
+		}
+	}
+	// Pages still to be expanded will add about as many new URLs as expanded pages did so far
+	auto pages_expanded = expanded.load();
+	if (pages_expanded > 0) {
+		total += static_cast<double>(expandable.load()) * static_cast<double>(discovered.load()) /
+		         static_cast<double>(pages_expanded);
+	}
+	auto wanted = limit.load();
+	if (wanted >= 0) {
+		total = MinValue<double>(total, static_cast<double>(wanted));
+	}
+	return MaxValue<int64_t>(done, static_cast<int64_t>(total));
+}
+
+bool CrawlProgress::TotalIsEstimate() const {
+	return discovering.load() || expandable.load() > 0;
+}
+
+double CrawlProgress::Percentage() const {
+	auto total = EstimatedTotal();
+	if (total <= 0) {
+		return discovering.load() ? -1.0 : 100.0;
+	}
+	return MinValue<double>(100.0, static_cast<double>(completed.load()) / static_cast<double>(total) * 100.0);
+}
+
+//===--------------------------------------------------------------------===//
+// Registry
+//===--------------------------------------------------------------------===//
+
+// Runs of one database, in its object cache: shared by all its connections and
+// dropped with the database
+class CrawlProgressRegistry : public ObjectCacheEntry {
+public:
+	static string ObjectType() {
+		return "crawler_progress_registry";
+	}
+	string GetObjectType() override {
+		return ObjectType();
+	}
+	// Never evicted: running crawls would disappear from crawl_progress()
+	optional_idx GetEstimatedCacheMemory() const override {
+		return optional_idx();
+	}
+
+	std::mutex lock;
+	vector<weak_ptr<CrawlProgress>> runs;
+};
+
+static shared_ptr<CrawlProgressRegistry> GetProgressRegistry(ClientContext &context) {
+	return ObjectCache::GetObjectCache(context).GetOrCreate<CrawlProgressRegistry>(
+	    CrawlProgressRegistry::ObjectType());
+}
+
+shared_ptr<CrawlProgress> RegisterCrawlProgress(ClientContext &context, const string &function) {
+	auto progress = make_shared_ptr<CrawlProgress>();
+	progress->function = function;
+	progress->connection_id = context.GetConnectionId();
+	progress->started_at = Timestamp::GetCurrentTimestamp();
+	progress->last_activity_us = Timestamp::GetEpochMicroSeconds(progress->started_at);
+
+	auto registry = GetProgressRegistry(context);
+	std::lock_guard<std::mutex> guard(registry->lock);
+	// Drop finished runs
+	auto &runs = registry->runs;
+	runs.erase(std::remove_if(runs.begin(), runs.end(), [](const weak_ptr<CrawlProgress> &run) { return run.expired(); }),
+	           runs.end());
+	runs.push_back(progress);
+	return progress;
+}
+
+shared_ptr<CrawlProgress> FindCrawlProgress(ClientContext &context, idx_t connection_id) {
+	auto registry = GetProgressRegistry(context);
+	std::lock_guard<std::mutex> guard(registry->lock);
+	auto &runs = registry->runs;
+	for (auto run = runs.rbegin(); run != runs.rend(); ++run) {
+		auto progress = run->lock();
+		if (progress && progress->connection_id == connection_id) {
+			return progress;
+		}
+	}
+	return nullptr;
+}
+
+double CrawlProgressPercentage(const shared_ptr<CrawlProgress> &progress) {
+	return progress ? progress->Percentage() : -1.0;
+}
+
+//===--------------------------------------------------------------------===//
+// crawl_progress()
+//===--------------------------------------------------------------------===//
+
+struct CrawlProgressGlobalState : public GlobalTableFunctionState {
+	vector<shared_ptr<CrawlProgress>> runs;
+	idx_t offset = 0;
+};
+
+static unique_ptr<FunctionData> CrawlProgressBind(ClientContext &context, TableFunctionBindInput &input,
+                                                  vector<LogicalType> &return_types, vector<string> &names) {
+	names = {"function",     "connection_id",  "started_at",  "last_activity",   "urls_completed",
+	         "urls_in_flight", "urls_queued", "estimated_total", "total_is_estimate", "progress"};
+	return_types = {LogicalType::VARCHAR, LogicalType::UBIGINT, LogicalType::TIMESTAMP_TZ, LogicalType::TIMESTAMP_TZ,
+	                LogicalType::BIGINT,  LogicalType::BIGINT,  LogicalType::BIGINT,    LogicalType::BIGINT,
+	                LogicalType::BOOLEAN, LogicalType::DOUBLE};
+	return make_uniq<TableFunctionData>();
+}
+
+static unique_ptr<GlobalTableFunctionState> CrawlProgressInitGlobal(ClientContext &context,
+                                                                    TableFunctionInitInput &input) {
+	auto state = make_uniq<CrawlProgressGlobalState>();
+	auto registry = GetProgressRegistry(context);
+	std::lock_guard<std::mutex> guard(registry->lock);
+	for (auto &run : registry->runs) {
+		auto progress = run.lock();
+		if (progress) {
+			state->runs.push_back(std::move(progress));
+		}
+	}
+	return std::move(state);
+}
+
+static void CrawlProgressFunction(ClientContext &context, TableFunctionInput &data, DataChunk &output) {
+	auto &state = data.global_state->Cast<CrawlProgressGlobalState>();
+	idx_t count = 0;
+	while (state.offset < state.runs.size() && count < STANDARD_VECTOR_SIZE) {
+		auto &run = *state.runs[state.offset++];
+		auto percentage = run.Percentage();
+		output.SetValue(0, count, Value(run.function));
+		output.SetValue(1, count, Value::UBIGINT(run.connection_id));
+		output.SetValue(2, count, Value::TIMESTAMPTZ(timestamp_tz_t(run.started_at)));
+		output.SetValue(3, count,
+		                Value::TIMESTAMPTZ(timestamp_tz_t(Timestamp::FromEpochMicroSeconds(run.last_activity_us.load()))));
+		output.SetValue(4, count, Value::BIGINT(run.completed.load()));
+		output.SetValue(5, count, Value::BIGINT(run.in_flight.load()));
+		output.SetValue(6, count, Value::BIGINT(run.queued.load()));
+		output.SetValue(7, count, Value::BIGINT(run.EstimatedTotal()));
+		output.SetValue(8, count, Value::BOOLEAN(run.TotalIsEstimate()));
+		output.SetValue(9, count, percentage < 0 ? Value(LogicalType::DOUBLE) : Value::DOUBLE(percentage));
+		count++;
+	}
+	output.SetCardinality(count);
+}
+
+void RegisterCrawlProgressFunction(ExtensionLoader &loader) {
+	TableFunction progress_func("crawl_progress", {}, CrawlProgressFunction, CrawlProgressBind,
+	                            CrawlProgressInitGlobal);
+	loader.RegisterFunction(progress_func);
+}
+
+} // namespace duckdb
@@ -7,6 +7,8 @@
 // Returns rows as they are crawled (streaming), not blocking until all complete.
 
 #include "crawl_stream_function.hpp"
+#include "crawl_dedupe.hpp"
+#include "crawl_progress.hpp"
 #include "crawler_internal.hpp"
 #include "crawler_utils.hpp"
 #include "thread_utils.hpp"
@@ -167,6 +169,7 @@ struct CrawlStreamBindData : public TableFunctionData {
     double crawl_delay = 0.2;
     int timeout_seconds = 30;
     bool respect_robots_txt = false;
+    bool dedupe = false;  // Drop URL variants / duplicate bodies of pages already returned
 };
 
 // Thread-safe result queue
@@ -212,6 +215,12 @@ struct CrawlStreamGlobalState : public GlobalTableFunctionState {
     bool workers_started = false;
     bool query_executed = false;
     std::mutex start_mutex;
+    // Counts for the progress bar and crawl_progress()
+    shared_ptr<CrawlProgress> progress;
+    // dedupe - shared by the workers
+    std::mutex dedupe_mutex;
+    CrawlDedupe dedupe;
+    shared_ptr<CrawlDedupeCounters> dedupe_counters;
 
     idx_t MaxThreads() const override {
         return 1; // Only one thread reads results
@@ -239,6 +248,8 @@ static void StreamCrawlWorker(
         }
 
         const string &url = bind_data.urls[url_idx];
+        global_state.progress->queued--;
+        global_state.progress->in_flight++;
         string domain = ExtractDomain(url);
         string path = ExtractPath(url);
 
@@ -259,9 +270,20 @@ static void StreamCrawlWorker(
         }
 
         if (!robots_allow) {
+            global_state.progress->Complete(1, true);
             continue;
         }
 
+        // Variant of a page another worker already returned
+        if (bind_data.dedupe) {
+            std::lock_guard<std::mutex> lock(global_state.dedupe_mutex);
+            if (global_state.dedupe.SeenUrl(url)) {
+                global_state.dedupe_counters->fetches_avoided++;
+                global_state.progress->Complete(1, true);
+                continue;
+            }
+        }
+
         // Fetch the URL using Rust
         string request_json = BuildStreamCrawlRequest(url, bind_data.user_agent,
                                                        bind_data.timeout_seconds * 1000);
@@ -271,6 +293,20 @@ static void StreamCrawlWorker(
         BatchCrawlEntry entry;
         entry.url = url;
         ParseStreamCrawlResponse(response_json, entry);
+        global_state.dedupe_counters->pages_fetched++;
+
+        // Duplicate of a page already returned: dropped
+        if (bind_data.dedupe) {
+            std::lock_guard<std::mutex> lock(global_state.dedupe_mutex);
+            string canonical_url;
+            if (global_state.dedupe.IsDuplicate(entry.url, entry.final_url, entry.status_code, entry.content_type,
+                                                entry.body, canonical_url)) {
+                global_state.dedupe_counters->duplicates_collapsed++;
+                global_state.dedupe_counters->bytes_not_returned += NumericCast<int64_t>(entry.body.size());
+                global_state.progress->Complete(1, true);
+                continue;
+            }
+        }
 
         // Extract structured data using Rust if successful
         if (entry.status_code >= 200 && entry.status_code < 300 && !entry.body.empty()) {
@@ -284,6 +320,7 @@ static void StreamCrawlWorker(
 
         // Push result to queue
         global_state.result_queue->Push(std::move(entry));
+        global_state.progress->Complete(1, true);
 
         // Respect crawl delay
         if (bind_data.crawl_delay > 0) {
@@ -318,6 +355,7 @@ static unique_ptr<FunctionData> CrawlStreamBind(ClientContext &context, TableFun
     if (context.TryGetCurrentSetting("crawler_respect_robots", setting_value)) {
         bind_data->respect_robots_txt = setting_value.GetValue<bool>();
     }
+    bind_data->dedupe = LoadCrawlDedupeSetting(context);
 
     // First argument is list of URLs
     auto &url_list = ListValue::GetChildren(input.inputs[0]);
@@ -337,6 +375,8 @@ static unique_ptr<FunctionData> CrawlStreamBind(ClientContext &context, TableFun
             bind_data->timeout_seconds = kv.second.GetValue<int>();
         } else if (kv.first == "respect_robots_txt") {
             bind_data->respect_robots_txt = kv.second.GetValue<bool>();
+        } else if (kv.first == "dedupe") {
+            bind_data->dedupe = kv.second.GetValue<bool>();
         }
     }
 
@@ -379,6 +419,7 @@ static unique_ptr<FunctionData> CrawlStreamBindQuery(ClientContext &context, Tab
     if (context.TryGetCurrentSetting("crawler_respect_robots", setting_value)) {
         bind_data->respect_robots_txt = setting_value.GetValue<bool>();
     }
+    bind_data->dedupe = LoadCrawlDedupeSetting(context);
 
     // First argument is a query string
     bind_data->source_query = StringValue::Get(input.inputs[0]);
@@ -393,6 +434,8 @@ static unique_ptr<FunctionData> CrawlStreamBindQuery(ClientContext &context, Tab
             bind_data->timeout_seconds = kv.second.GetValue<int>();
         } else if (kv.first == "respect_robots_txt") {
             bind_data->respect_robots_txt = kv.second.GetValue<bool>();
+        } else if (kv.first == "dedupe") {
+            bind_data->dedupe = kv.second.GetValue<bool>();
         }
     }
 
@@ -419,11 +462,25 @@ static unique_ptr<FunctionData> CrawlStreamBindQuery(ClientContext &context, Tab
 // Global state init
 static unique_ptr<GlobalTableFunctionState> CrawlStreamInitGlobal(ClientContext &context,
                                                                     TableFunctionInitInput &input) {
+    auto &bind_data = input.bind_data->Cast<CrawlStreamBindData>();
     auto state = make_uniq<CrawlStreamGlobalState>();
     state->result_queue = make_uniq<StreamResultQueue>();
+    state->progress = RegisterCrawlProgress(context, "crawl_stream");
+    state->dedupe_counters = GetCrawlDedupeCounters(context);
+    state->progress->queued = NumericCast<int64_t>(bind_data.urls.size());
+    // The URLs of a source query are known once it has run
+    state->progress->discovering = !bind_data.source_query.empty();
     return std::move(state);
 }
 
+static double CrawlStreamProgress(ClientContext &context, const FunctionData *bind_data_p,
+                                  const GlobalTableFunctionState *gstate_p) {
+    if (!gstate_p) {
+        return -1.0;
+    }
+    return CrawlProgressPercentage(gstate_p->Cast<CrawlStreamGlobalState>().progress);
+}
+
 // Main function - called repeatedly to get results
 static void CrawlStreamFunction(ClientContext &context, TableFunctionInput &data, DataChunk &output) {
     auto &bind_data = data.bind_data->CastNoConst<CrawlStreamBindData>();
@@ -450,6 +507,8 @@ static void CrawlStreamFunction(ClientContext &context, TableFunctionInput &data
                     }
                 }
             }
+            global_state.progress->queued = NumericCast<int64_t>(bind_data.urls.size());
+            global_state.progress->discovering = false;
         }
 
         if (!global_state.workers_started) {
@@ -509,6 +568,8 @@ void RegisterCrawlStreamFunction(ExtensionLoader &loader) {
     list_func.named_parameters["crawl_delay"] = LogicalType::DOUBLE;
     list_func.named_parameters["timeout"] = LogicalType::INTEGER;
     list_func.named_parameters["respect_robots_txt"] = LogicalType::BOOLEAN;
+    list_func.named_parameters["dedupe"] = LogicalType::BOOLEAN;
+    list_func.table_scan_progress = CrawlStreamProgress;
 
     // Version 2: Accept query string
     TableFunction query_func("crawl_stream",
@@ -518,6 +579,8 @@ void RegisterCrawlStreamFunction(ExtensionLoader &loader) {
     query_func.named_parameters["crawl_delay"] = LogicalType::DOUBLE;
     query_func.named_parameters["timeout"] = LogicalType::INTEGER;
     query_func.named_parameters["respect_robots_txt"] = LogicalType::BOOLEAN;
+    query_func.named_parameters["dedupe"] = LogicalType::BOOLEAN;
+    query_func.table_scan_progress = CrawlStreamProgress;
 
     // Register both as a function set
     TableFunctionSet crawl_stream_set("crawl_stream");
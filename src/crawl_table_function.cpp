@@ -12,6 +12,34 @@
 // Or with URL list:
 //   SELECT * FROM crawl(['https://example.com'], user_agent = 'Bot/1.0')
 //
+// Or with a source query and a priority expression over its rows (highest first):
+//   SELECT * FROM crawl('SELECT url, lastmod FROM sitemap(...)', priority := 'epoch(lastmod::TIMESTAMP)') LIMIT 1000
+//
+// Or a reproducible sample: 1% of each host's URLs, at most 200 per host:
+//   SELECT * FROM crawl('SELECT url FROM all_urls', sample_rate := 0.01, sample_per_host := 200)
+//
+// Re-extract stored pages without network access (parallel cache scan):
+//   SELECT url, html.schema['Product'] FROM crawl((SELECT list(url) FROM pages), offline := true)
+//
+// Return and cache compact bodies (see html_compact.hpp):
+//   SELECT url, html.document FROM crawl(urls, store_body := 'main_content')
+//
+// Flag (or drop) HTTP 200 "page not found" templates (see soft_error_detector.hpp):
+//   SELECT url FROM crawl(urls, soft_404 := 'flag') WHERE NOT soft_404
+//
+// Language of each page (<html lang> and Content-Language are hints; see detect_language_function.cpp):
+//   SELECT url, language FROM crawl(urls, language := true) WHERE language = 'de'
+//
+// Skip URLs already crawled elsewhere (see url_bloom_function.hpp):
+//   SELECT * FROM crawl('SELECT url FROM candidates', skip_bloom := (SELECT url_bloom_agg(url) FROM crawled))
+//
+// POST / GraphQL / per-request headers: STRUCT(url, method, headers, body) inputs (see request_spec.hpp):
+//   SELECT url, status FROM crawl([{'url': 'https://api.example.com/graphql', 'method': 'POST',
+//                                   'headers': MAP {'Content-Type': 'application/json'}, 'body': '{"query": "{ id }"}'}])
+//
+// Sequential IDs up to the last live one (found by galloping probes + binary search):
+//   SELECT url, status FROM crawl_range('https://example.com/item/{n}', 1, miss_window := 20)
+//
 // The 'html' column is a STRUCT containing:
 //   - body: raw HTML content
 //   - js: extracted JavaScript variables as JSON
@@ -19,19 +47,41 @@
 //   - schema: combined JSON-LD + microdata as JSON
 
 #include "crawl_table_function.hpp"
+#include "crawl_dedupe.hpp"
+#include "crawl_progress.hpp"
 #include "crawler_utils.hpp"
+#include "crawler_cache.hpp"
+#include "fetch_backend.hpp"
+#include "html_compact.hpp"
+#include "request_spec.hpp"
+#include "robots_parser.hpp"
 #include "rust_ffi.hpp"
+#include "soft_error_detector.hpp"
+#include "url_bloom_function.hpp"
 #include "yyjson.hpp"
 
 #include "duckdb/function/table_function.hpp"
 #include "duckdb/main/extension/extension_loader.hpp"
 #include "duckdb/main/connection.hpp"
+#include "duckdb/main/database.hpp"
 #include "duckdb/common/string_util.hpp"
 #include "duckdb/main/secret/secret_manager.hpp"
 #include "duckdb/catalog/catalog_transaction.hpp"
-
+#include "duckdb/common/types/hash.hpp"
+#include "duckdb/common/operator/add.hpp"
+#include "duckdb/common/operator/subtract.hpp"
+#include "duckdb/parallel/task_scheduler.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <queue>
 #include <set>
 #include <map>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
 
 namespace duckdb {
 
@@ -49,7 +99,9 @@ static string BuildBatchCrawlRequest(const vector<string> &urls,
                                       const string &http_proxy = "",
                                       const string &http_proxy_username = "",
                                       const string &http_proxy_password = "",
-                                      const std::map<string, string> &extra_headers = {}) {
+                                      const std::map<string, string> &extra_headers = {},
+                                      const vector<const CrawlRequestSpec *> &requests = {},
+                                      bool detect_language = false) {
     yyjson_mut_doc *doc = yyjson_mut_doc_new(nullptr);
     if (!doc) return "{}";
 
@@ -63,6 +115,15 @@ static string BuildBatchCrawlRequest(const vector<string> &urls,
     }
     yyjson_mut_obj_add_val(doc, root, "urls", urls_arr);
 
+    // Method / headers / body per URL (null = GET)
+    if (!requests.empty()) {
+        yyjson_mut_val *requests_arr = yyjson_mut_arr(doc);
+        for (auto request : requests) {
+            yyjson_mut_arr_append(requests_arr, request ? CrawlRequestSpecJson(doc, *request) : yyjson_mut_null(doc));
+        }
+        yyjson_mut_obj_add_val(doc, root, "requests", requests_arr);
+    }
+
     // Extraction specs (if any)
     if (!extraction_json.empty() && extraction_json != "{}") {
         yyjson_doc *ext_doc = yyjson_read(extraction_json.c_str(), extraction_json.size(), 0);
@@ -80,6 +141,10 @@ static string BuildBatchCrawlRequest(const vector<string> &urls,
     yyjson_mut_obj_add_uint(doc, root, "concurrency", concurrency);
     yyjson_mut_obj_add_uint(doc, root, "delay_ms", delay_ms);
     yyjson_mut_obj_add_bool(doc, root, "respect_robots", respect_robots);
+    // Pages are classified with the extraction, while the body is on the Rust side
+    if (detect_language) {
+        yyjson_mut_obj_add_bool(doc, root, "detect_language", true);
+    }
 
     // Proxy settings (from DuckDB http_proxy)
     if (!http_proxy.empty()) {
@@ -177,13 +242,26 @@ struct CrawlResultEntry {
     string final_url;
     int status_code = 0;
     string content_type;
+    string content_language;  // Content-Language header (empty for cache hits)
     string body;
     string error;
     string extracted_json;
     int64_t response_time_ms = 0;
     int depth = 1;  // Crawl depth (1 = initial URL)
+    double priority = 0;  // Scheduling priority (inherited by followed links)
+    string canonical_url;  // <link rel=canonical>, resolved (empty = none)
+    bool canonical_resolved = false;  // canonical_url was already looked up (by dedupe)
+    bool soft_error = false;  // 2xx page matching its host's soft error template (soft_404)
+    string request_key;  // Cache / state key of a request spec input (empty = url)
+    string language;  // Detected by the fetch (detect_language requests; empty = unknown)
+    bool language_detected = false;  // language came with the response (not for cache hits)
 };
 
+// Key of an entry in the cache, the state table and processed_urls
+static const string &EntryKey(const CrawlResultEntry &entry) {
+    return entry.request_key.empty() ? entry.url : entry.request_key;
+}
+
 // Parse batch crawl response from Rust
 static vector<CrawlResultEntry> ParseBatchCrawlResponse(const string &response_json) {
     vector<CrawlResultEntry> results;
@@ -232,6 +310,19 @@ static vector<CrawlResultEntry> ParseBatchCrawlResponse(const string &response_j
             entry.content_type = yyjson_get_str(ct_val);
         }
 
+        yyjson_val *cl_val = yyjson_obj_get(item, "content_language");
+        if (cl_val && yyjson_is_str(cl_val)) {
+            entry.content_language = yyjson_get_str(cl_val);
+        }
+
+        yyjson_val *language_val = yyjson_obj_get(item, "language");
+        if (language_val) {
+            entry.language_detected = true;
+            if (yyjson_is_str(language_val)) {
+                entry.language = yyjson_get_str(language_val);
+            }
+        }
+
         yyjson_val *body_val = yyjson_obj_get(item, "body");
         if (body_val && yyjson_is_str(body_val)) {
             entry.body = yyjson_get_str(body_val);
@@ -397,7 +488,12 @@ static Value MakeSchemaMapValue(const string &schema_json) {
     return Value::MAP(LogicalType::VARCHAR, LogicalType::JSON(), keys, values);
 }
 
-static Value BuildHtmlStructValue(const string &body, const string &content_type, const string &url = "") {
+// Fields are extracted from body; document is the body as returned (store_body), null = body
+static Value BuildHtmlStructValue(const string &body, const string &content_type, const string &url = "",
+                                  const string *document = nullptr) {
+    if (!document) {
+        document = &body;
+    }
     child_list_t<Value> html_values;
 
     bool is_html = content_type.find("text/html") != string::npos ||
@@ -413,14 +509,14 @@ static Value BuildHtmlStructValue(const string &body, const string &content_type
         string schema_json = CombineSchemaData(jsonld_json, microdata_json);
         string readability_json = ExtractReadabilityWithRust(body, url);
 
-        html_values.push_back(make_pair("document", Value(body)));
+        html_values.push_back(make_pair("document", Value(*document)));
         html_values.push_back(make_pair("js", MakeJsonValue(js_json)));
         html_values.push_back(make_pair("meta", MakeJsonValue(meta_json)));
         html_values.push_back(make_pair("opengraph", MakeJsonValue(og_json)));
         html_values.push_back(make_pair("schema", MakeSchemaMapValue(schema_json)));
         html_values.push_back(make_pair("readability", MakeJsonValue(readability_json)));
 #else
-        html_values.push_back(make_pair("document", Value(body)));
+        html_values.push_back(make_pair("document", Value(*document)));
         html_values.push_back(make_pair("js", Value(LogicalType::JSON())));
         html_values.push_back(make_pair("meta", Value(LogicalType::JSON())));
         html_values.push_back(make_pair("opengraph", Value(LogicalType::JSON())));
@@ -429,7 +525,7 @@ static Value BuildHtmlStructValue(const string &body, const string &content_type
 #endif
     } else {
         // Non-HTML content or empty body
-        html_values.push_back(make_pair("document", body.empty() ? Value() : Value(body)));
+        html_values.push_back(make_pair("document", document->empty() ? Value() : Value(*document)));
         html_values.push_back(make_pair("js", Value(LogicalType::JSON())));
         html_values.push_back(make_pair("meta", Value(LogicalType::JSON())));
         html_values.push_back(make_pair("opengraph", Value(LogicalType::JSON())));
@@ -447,6 +543,11 @@ static Value BuildHtmlStructValue(const string &body, const string &content_type
 struct CrawlBindData : public TableFunctionData {
     vector<string> urls;
     string source_query;
+    string priority_expr;  // SQL expression over source rows, higher = fetched first
+    double sample_rate = 1.0;      // Fraction of each host's seed URLs to crawl
+    int64_t sample_per_host = -1;  // Max seed URLs per host (-1 = unlimited)
+    bool dedupe = false;     // Collapse URL variants by canonical URL / body fingerprint
+    bool dedupe_set = false; // dedupe given explicitly (default: on when following links, else crawler_dedupe)
     string state_table;
     string user_agent = "DuckDB-Crawler/1.0";
     int timeout_ms = 30000;
@@ -458,6 +559,21 @@ struct CrawlBindData : public TableFunctionData {
     int max_depth = 1;       // Max crawl depth (1 = initial URLs only)
     bool use_cache = true;   // Enable HTTP response caching
     int cache_ttl_hours = 24;  // Cache TTL in hours
+    bool cache_ttl_set = false;  // cache_ttl given explicitly
+    bool offline = false;    // Serve from the cache only, no network (parallel scan)
+    StoreBodyMode store_body = StoreBodyMode::RAW;  // html.document and cached body (raw / minified / main_content)
+    SoftErrorMode soft_404 = SoftErrorMode::OFF;  // Flag or skip pages matching their host's soft error template
+    bool detect_language = false;  // Fill the language column
+    string skip_bloom;  // url_bloom_agg() filter of URLs not to crawl (empty = none)
+    // STRUCT(url, method, headers, body) inputs by CrawlRequestSpec::Key(), which stands in
+    // for the URL in urls and the scheduler
+    std::unordered_map<string, CrawlRequestSpec> requests;
+    string range_template;   // crawl_range(): URL with {n}
+    int64_t range_start = 0;
+    int range_miss_window = 10;  // Consecutive dead IDs that end the range
+    bool range_discover = false; // crawl_range() without an end: find it before crawling
+    FetchBackendType fetch_backend = FetchBackendType::REQWEST;  // crawler_fetch_backend
+    CrawlerCachePolicy cache_policy;  // crawler_cache_max_bytes / crawler_cache_max_age
     int64_t max_results = -1;  // Max results to return (-1 = unlimited), for LIMIT pushdown
     idx_t reported_cardinality = 0;  // Cardinality we report to optimizer (for LIMIT detection)
     // Proxy settings (from DuckDB http_proxy or CREATE SECRET)
@@ -467,12 +583,24 @@ struct CrawlBindData : public TableFunctionData {
     std::map<string, string> extra_headers;  // From CREATE SECRET extra_http_headers
 };
 
-// URL with depth tracking for link following
-struct UrlWithDepth {
+// URL waiting to be fetched, ordered by priority (then input order)
+struct ScheduledUrl {
+    double priority;
+    idx_t seq;
     string url;
     int depth;
 };
 
+struct ScheduledUrlOrder {
+    // std::priority_queue pops the largest element: highest priority, lowest seq
+    bool operator()(const ScheduledUrl &a, const ScheduledUrl &b) const {
+        if (a.priority != b.priority) {
+            return a.priority < b.priority;
+        }
+        return a.seq > b.seq;
+    }
+};
+
 //===--------------------------------------------------------------------===//
 // Global State
 //===--------------------------------------------------------------------===//
@@ -482,14 +610,64 @@ struct CrawlGlobalState : public GlobalTableFunctionState {
     idx_t result_idx = 0;                      // Index into pending_results
     idx_t next_url_idx = 0;                    // Next URL from initial list
     std::set<string> processed_urls;           // Already crawled (from state table)
-    vector<UrlWithDepth> url_queue;            // URLs to crawl with depth tracking
-    idx_t queue_idx = 0;                       // Next index in url_queue
+    // URLs to crawl (with depth for link following), highest priority first
+    std::priority_queue<ScheduledUrl, vector<ScheduledUrl>, ScheduledUrlOrder> url_heap;
+    idx_t next_seq = 0;
+    // Earliest next fetch per host (delay between requests to the same host)
+    std::unordered_map<string, std::chrono::steady_clock::time_point> host_next_fetch;
     bool initialized = false;
     bool finished = false;
     int64_t results_returned = 0;              // Count of results returned (for max_results)
     int64_t limit_from_query = -1;             // LIMIT value pushed down from query (-1 = unlimited)
 
-    idx_t MaxThreads() const override { return 1; }
+    // offline := true - URL batches are claimed by parallel scan threads
+    std::atomic<idx_t> next_offline_url {0};
+    std::atomic<int64_t> offline_results {0};
+    idx_t max_threads = 1;
+
+    // dedupe - URL variants and bodies of the pages returned so far
+    CrawlDedupe dedupe;
+
+    // soft_404 - soft error templates of the hosts seen so far
+    SoftErrorDetector soft_errors;
+
+    // skip_bloom - view of bind_data.skip_bloom
+    unique_ptr<UrlBloomFilter> skip_bloom;
+
+    // Counts for the progress bar and crawl_progress()
+    shared_ptr<CrawlProgress> progress;
+
+    idx_t MaxThreads() const override { return max_threads; }
+};
+
+// Queued URLs below max_depth will have their links followed
+static bool IsExpandable(const CrawlBindData &bind_data, int depth) {
+    return !bind_data.follow_selector.empty() && depth < bind_data.max_depth;
+}
+
+static void ScheduleUrl(CrawlGlobalState &state, const CrawlBindData &bind_data, ScheduledUrl item) {
+    if (IsExpandable(bind_data, item.depth)) {
+        state.progress->expandable++;
+    }
+    state.url_heap.push(std::move(item));
+    state.progress->queued = NumericCast<int64_t>(state.url_heap.size());
+}
+
+static ScheduledUrl UnscheduleTopUrl(CrawlGlobalState &state, const CrawlBindData &bind_data) {
+    auto item = state.url_heap.top();
+    state.url_heap.pop();
+    if (IsExpandable(bind_data, item.depth)) {
+        state.progress->expandable--;
+    }
+    state.progress->queued = NumericCast<int64_t>(state.url_heap.size());
+    return item;
+}
+
+// Per-thread state of the offline scan
+struct CrawlOfflineLocalState : public LocalTableFunctionState {
+    unique_ptr<Connection> conn;
+    vector<CrawlResultEntry> results;  // Current batch, in URL order
+    idx_t result_idx = 0;
 };
 
 //===--------------------------------------------------------------------===//
@@ -527,98 +705,132 @@ static void SaveToStateTable(Connection &conn, const string &table_name, const C
     string sql = "INSERT OR REPLACE INTO " + QuoteSqlIdentifier(table_name) +
                  " (url, http_status, extracted, crawled_at) VALUES ($1, $2, $3, current_timestamp)";
     Value extracted_val = entry.extracted_json.empty() ? Value() : Value(entry.extracted_json);
-    conn.Query(sql, entry.url, entry.status_code, extracted_val);
+    conn.Query(sql, EntryKey(entry), entry.status_code, extracted_val);
 }
 
 //===--------------------------------------------------------------------===//
-// HTTP Cache Table Management (__crawler_cache)
+// HTTP Cache (__crawler_cache, see crawler_cache.cpp)
 //===--------------------------------------------------------------------===//
 
-static constexpr const char* CACHE_TABLE_NAME = "__crawler_cache";
-
-static void EnsureCacheTable(Connection &conn) {
-    string sql = "CREATE TABLE IF NOT EXISTS " + string(CACHE_TABLE_NAME) + " ("
-                 "url VARCHAR PRIMARY KEY, "
-                 "status_code INTEGER, "
-                 "content_type VARCHAR, "
-                 "body VARCHAR, "
-                 "error VARCHAR, "
-                 "response_time_ms BIGINT, "
-                 "cached_at TIMESTAMP DEFAULT current_timestamp)";
-    conn.Query(sql);
-}
-
-// Get cached entries for URLs that are fresher than ttl_hours
-// Uses batch query to avoid N+1 problem
-static vector<CrawlResultEntry> GetCachedEntries(Connection &conn, const vector<string> &urls, int ttl_hours) {
+// Raw bodies serve every store_body mode. A body stored compacted serves only its own
+// mode: the markup it dropped is gone, so under another mode the row is a miss, and
+// the fields of a hit are extracted from the compact body.
+static vector<CrawlResultEntry> GetCachedEntries(Connection &conn, const vector<string> &urls, int ttl_hours,
+                                                 const CrawlerCachePolicy &policy, StoreBodyMode store_body) {
     vector<CrawlResultEntry> cached;
-    if (urls.empty()) return cached;
-
-    EnsureCacheTable(conn);
+    for (auto &hit : CrawlerCacheLookup(conn, urls, ttl_hours, policy)) {
+        StoreBodyMode stored_mode;
+        if (!UntagStoredContentType(hit.content_type, stored_mode) ||
+            (stored_mode != StoreBodyMode::RAW && stored_mode != store_body)) {
+            continue;
+        }
+        CrawlResultEntry entry;
+        entry.url = std::move(hit.url);
+        entry.status_code = hit.status_code;
+        entry.content_type = std::move(hit.content_type);
+        entry.body = std::move(hit.body);
+        entry.error = std::move(hit.error);
+        entry.response_time_ms = hit.response_time_ms;
+        cached.push_back(std::move(entry));
+    }
+    return cached;
+}
 
-    // Build IN clause with properly quoted URLs
-    string url_list;
-    for (size_t i = 0; i < urls.size(); i++) {
-        if (i > 0) url_list += ", ";
-        url_list += EscapeSqlString(urls[i]);
+// Entries of request spec inputs are cached under CrawlRequestSpec::Key(): restore the URL
+static void ResolveRequestEntry(const CrawlBindData &bind_data, CrawlResultEntry &entry) {
+    auto spec = bind_data.requests.find(entry.url);
+    if (spec != bind_data.requests.end()) {
+        entry.request_key = std::move(entry.url);
+        entry.url = spec->second.url;
     }
+}
 
-    // Single batch query instead of N queries
-    string sql = "SELECT url, status_code, content_type, body, error, response_time_ms "
-                 "FROM " + string(CACHE_TABLE_NAME) + " "
-                 "WHERE url IN (" + url_list + ") "
-                 "AND cached_at > current_timestamp - INTERVAL '" + std::to_string(ttl_hours) + " hours'";
+// The body is cached as returned (store_body), its mode recorded in the content type
+static void SaveToCache(Connection &conn, const CrawlResultEntry &entry, const CrawlerCachePolicy &policy,
+                        StoreBodyMode store_body) {
+    CrawlerCacheEntry cache_entry;
+    cache_entry.url = EntryKey(entry);
+    cache_entry.status_code = entry.status_code;
+    cache_entry.content_type = TagStoredContentType(entry.content_type, store_body);
+    cache_entry.body = CompactHtmlBody(entry.body, entry.content_type, store_body);
+    cache_entry.error = entry.error;
+    cache_entry.response_time_ms = entry.response_time_ms;
+    CrawlerCacheStore(conn, cache_entry, policy);
+}
 
-    auto result = conn.Query(sql);
-    if (result->HasError()) {
-        return cached;
-    }
+//===--------------------------------------------------------------------===//
+// Seed Sampling (sample_rate / sample_per_host)
+//===--------------------------------------------------------------------===//
 
-    // Process all results from single query
-    while (true) {
-        auto chunk = result->Fetch();
-        if (!chunk || chunk->size() == 0) break;
+// Position of a URL in [0, 1), from the hash of its normalized form: the same URL
+// lands at the same point in every run, independent of input order
+static double UrlSamplePoint(const string &normalized_url) {
+    hash_t h = Hash(normalized_url.c_str(), normalized_url.size());
+    return static_cast<double>(h >> 11) * (1.0 / 9007199254740992.0);  // top 53 bits / 2^53
+}
 
-        for (idx_t row = 0; row < chunk->size(); row++) {
-            CrawlResultEntry entry;
-            entry.url = chunk->GetValue(0, row).ToString();
-            entry.status_code = chunk->GetValue(1, row).GetValue<int>();
-            entry.content_type = chunk->GetValue(2, row).IsNull() ? "" : chunk->GetValue(2, row).ToString();
-            entry.body = chunk->GetValue(3, row).IsNull() ? "" : chunk->GetValue(3, row).ToString();
-            entry.error = chunk->GetValue(4, row).IsNull() ? "" : chunk->GetValue(4, row).ToString();
-            entry.response_time_ms = chunk->GetValue(5, row).IsNull() ? 0 : chunk->GetValue(5, row).GetValue<int64_t>();
-            cached.push_back(std::move(entry));
+// Keep URLs whose sample point is below sample_rate, then the sample_per_host URLs
+// with the lowest points per host (a bottom-k sample, so caps stay unbiased).
+// priorities (if not empty) is filtered alongside urls.
+static void SampleSeedUrls(const CrawlBindData &bind_data, vector<string> &urls, vector<double> &priorities) {
+    if (bind_data.sample_rate >= 1.0 && bind_data.sample_per_host < 0) {
+        return;
+    }
+    struct Candidate {
+        double point;
+        idx_t index;
+    };
+    std::unordered_map<string, vector<Candidate>> by_host;
+    for (idx_t i = 0; i < urls.size(); i++) {
+        auto normalized = NormalizeUrl(urls[i]);
+        double point = UrlSamplePoint(normalized);
+        if (point < bind_data.sample_rate) {
+            by_host[ExtractDomain(normalized)].push_back({point, i});
         }
     }
-    return cached;
-}
 
-// Check which URLs are in cache and fresh
-static std::set<string> GetCachedUrls(Connection &conn, const vector<string> &urls, int ttl_hours) {
-    std::set<string> cached_urls;
-    auto entries = GetCachedEntries(conn, urls, ttl_hours);
-    for (const auto &entry : entries) {
-        cached_urls.insert(entry.url);
+    vector<bool> keep(urls.size(), false);
+    for (auto &host : by_host) {
+        auto &candidates = host.second;
+        if (bind_data.sample_per_host >= 0 && candidates.size() > idx_t(bind_data.sample_per_host)) {
+            std::nth_element(candidates.begin(), candidates.begin() + bind_data.sample_per_host, candidates.end(),
+                             [](const Candidate &a, const Candidate &b) { return a.point < b.point; });
+            candidates.resize(bind_data.sample_per_host);
+        }
+        for (auto &candidate : candidates) {
+            keep[candidate.index] = true;
+        }
     }
-    return cached_urls;
-}
 
-static void SaveToCache(Connection &conn, const CrawlResultEntry &entry) {
-    EnsureCacheTable(conn);
-    string sql = "INSERT OR REPLACE INTO " + string(CACHE_TABLE_NAME) +
-                 " (url, status_code, content_type, body, error, response_time_ms, cached_at) "
-                 "VALUES ($1, $2, $3, $4, $5, $6, current_timestamp)";
-    conn.Query(sql, entry.url, entry.status_code,
-               entry.content_type.empty() ? Value() : Value(entry.content_type),
-               entry.body.empty() ? Value() : Value(entry.body),
-               entry.error.empty() ? Value() : Value(entry.error),
-               entry.response_time_ms);
+    // Compact in input order
+    idx_t kept = 0;
+    for (idx_t i = 0; i < urls.size(); i++) {
+        if (keep[i]) {
+            urls[kept] = std::move(urls[i]);
+            if (!priorities.empty()) {
+                priorities[kept] = priorities[i];
+            }
+            kept++;
+        }
+    }
+    urls.resize(kept);
+    if (!priorities.empty()) {
+        priorities.resize(kept);
+    }
 }
 
 //===--------------------------------------------------------------------===//
 // Bind Function
 //===--------------------------------------------------------------------===//
 
+// Register a STRUCT(url, method, headers, body) input; returns the key that stands in for its URL
+static string AddRequestSpec(CrawlBindData &bind_data, const Value &value) {
+    auto spec = CrawlRequestSpecFromValue(value);
+    auto key = spec.Key();
+    bind_data.requests[key] = std::move(spec);
+    return key;
+}
+
 static unique_ptr<FunctionData> CrawlBind(ClientContext &context, TableFunctionBindInput &input,
                                            vector<LogicalType> &return_types, vector<string> &names) {
     auto bind_data = make_uniq<CrawlBindData>();
@@ -637,6 +849,9 @@ static unique_ptr<FunctionData> CrawlBind(ClientContext &context, TableFunctionB
     if (context.TryGetCurrentSetting("crawler_respect_robots", setting_value)) {
         bind_data->respect_robots = setting_value.GetValue<bool>();
     }
+    bind_data->cache_policy = LoadCrawlerCachePolicy(context);
+    bind_data->store_body = LoadStoreBodyMode(context);
+    bind_data->fetch_backend = LoadFetchBackendType(context);
 
     // Read DuckDB's http_proxy settings
     if (context.TryGetCurrentSetting("http_proxy", setting_value) && !setting_value.IsNull()) {
@@ -649,18 +864,31 @@ static unique_ptr<FunctionData> CrawlBind(ClientContext &context, TableFunctionB
         bind_data->http_proxy_password = setting_value.ToString();
     }
 
-    // First argument: URL list or single URL string
+    // First argument: URL list, request spec list or single URL string
     auto &first_arg = input.inputs[0];
     if (first_arg.type().id() == LogicalTypeId::LIST) {
         auto &url_list = ListValue::GetChildren(first_arg);
         for (auto &url_val : url_list) {
-            if (!url_val.IsNull()) {
+            if (url_val.IsNull()) {
+                continue;
+            }
+            if (url_val.type().id() == LogicalTypeId::STRUCT) {
+                bind_data->urls.push_back(AddRequestSpec(*bind_data, url_val));
+            } else {
                 bind_data->urls.push_back(StringValue::Get(url_val));
             }
         }
     } else {
-        // Single URL string
-        bind_data->urls.push_back(StringValue::Get(first_arg));
+        // Single URL string, or a query whose first column is the URL
+        auto arg = StringValue::Get(first_arg);
+        auto lowered = StringUtil::Lower(arg);
+        StringUtil::Trim(lowered);
+        if (StringUtil::StartsWith(lowered, "select ") || StringUtil::StartsWith(lowered, "with ") ||
+            StringUtil::StartsWith(lowered, "from ")) {
+            bind_data->source_query = arg;
+        } else {
+            bind_data->urls.push_back(arg);
+        }
     }
 
     // Named parameters
@@ -688,11 +916,80 @@ static unique_ptr<FunctionData> CrawlBind(ClientContext &context, TableFunctionB
             bind_data->use_cache = kv.second.GetValue<bool>();
         } else if (kv.first == "cache_ttl") {
             bind_data->cache_ttl_hours = kv.second.GetValue<int>();
+            bind_data->cache_ttl_set = true;
+        } else if (kv.first == "priority") {
+            bind_data->priority_expr = StringValue::Get(kv.second);
+        } else if (kv.first == "sample_rate") {
+            bind_data->sample_rate = kv.second.GetValue<double>();
+            if (!(bind_data->sample_rate > 0 && bind_data->sample_rate <= 1)) {
+                throw BinderException("crawl: sample_rate must be in (0, 1]");
+            }
+        } else if (kv.first == "sample_per_host") {
+            bind_data->sample_per_host = kv.second.GetValue<int64_t>();
+            if (bind_data->sample_per_host < 1) {
+                throw BinderException("crawl: sample_per_host must be at least 1");
+            }
+        } else if (kv.first == "dedupe") {
+            bind_data->dedupe = kv.second.GetValue<bool>();
+            bind_data->dedupe_set = true;
+        } else if (kv.first == "offline") {
+            bind_data->offline = kv.second.GetValue<bool>();
+        } else if (kv.first == "store_body") {
+            if (!TryParseStoreBodyMode(StringValue::Get(kv.second), bind_data->store_body)) {
+                throw BinderException("crawl: store_body must be 'raw', 'minified' or 'main_content'");
+            }
+        } else if (kv.first == "soft_404") {
+            if (!TryParseSoftErrorMode(StringValue::Get(kv.second), bind_data->soft_404)) {
+                throw BinderException("crawl: soft_404 must be 'off', 'flag' or 'skip'");
+            }
+        } else if (kv.first == "language") {
+            bind_data->detect_language = kv.second.GetValue<bool>();
+        } else if (kv.first == "skip_bloom") {
+            if (!kv.second.IsNull()) {
+                bind_data->skip_bloom = StringValue::Get(kv.second);
+                if (!UrlBloomFilter::IsFilter(bind_data->skip_bloom)) {
+                    throw BinderException("crawl: skip_bloom must be a url_bloom_agg() filter");
+                }
+            }
         } else if (kv.first == "max_results") {
             bind_data->max_results = kv.second.GetValue<int64_t>();
         }
     }
 
+    if (!bind_data->dedupe_set) {
+        // The parallel offline scan serves cached pages as they are
+        bind_data->dedupe = !bind_data->follow_selector.empty() ||
+                            (!bind_data->offline && LoadCrawlDedupeSetting(context));
+    }
+
+    if (bind_data->offline) {
+        if (!bind_data->use_cache) {
+            throw BinderException("crawl: offline := true requires cache := true");
+        }
+        if (!bind_data->follow_selector.empty()) {
+            throw BinderException("crawl: offline := true cannot follow links");
+        }
+        if (!bind_data->state_table.empty()) {
+            throw BinderException("crawl: offline := true does not support state_table");
+        }
+        if (!bind_data->source_query.empty()) {
+            throw BinderException("crawl: offline := true takes a URL list, e.g. (SELECT list(url) FROM pages)");
+        }
+        // Re-extraction serves stored pages of any age unless cache_ttl is given
+        if (!bind_data->cache_ttl_set) {
+            bind_data->cache_ttl_hours = -1;
+        }
+        // The URL list is final here (the online path samples after running the source query)
+        vector<double> no_priorities;
+        SampleSeedUrls(*bind_data, bind_data->urls, no_priorities);
+        if (!bind_data->skip_bloom.empty()) {
+            UrlBloomFilter skip(bind_data->skip_bloom.data(), bind_data->skip_bloom.size());
+            auto &urls = bind_data->urls;
+            urls.erase(std::remove_if(urls.begin(), urls.end(), [&](const string &url) { return skip.Contains(url); }),
+                       urls.end());
+        }
+    }
+
     // Return columns
     return_types.push_back(LogicalType::VARCHAR);  // url
     return_types.push_back(LogicalType::INTEGER);  // status
@@ -714,6 +1011,10 @@ static unique_ptr<FunctionData> CrawlBind(ClientContext &context, TableFunctionB
     return_types.push_back(LogicalType::VARCHAR);  // extract
     return_types.push_back(LogicalType::BIGINT);   // response_time_ms
     return_types.push_back(LogicalType::INTEGER);  // depth
+    return_types.push_back(LogicalType::VARCHAR);  // canonical_url
+    return_types.push_back(LogicalType::BOOLEAN);  // soft_404
+    return_types.push_back(LogicalType::VARCHAR);  // language
+    return_types.push_back(LogicalType::VARCHAR);  // request_key
 
     names.push_back("url");
     names.push_back("status");
@@ -724,6 +1025,10 @@ static unique_ptr<FunctionData> CrawlBind(ClientContext &context, TableFunctionB
     names.push_back("extract");
     names.push_back("response_time_ms");
     names.push_back("depth");
+    names.push_back("canonical_url");
+    names.push_back("soft_404");
+    names.push_back("language");
+    names.push_back("request_key");
 
     return std::move(bind_data);
 }
@@ -744,9 +1049,29 @@ static unique_ptr<NodeStatistics> CrawlCardinality(ClientContext &context, const
 // Init Global
 //===--------------------------------------------------------------------===//
 
+// URLs per cache lookup in offline mode (one IN-list query per batch)
+static constexpr idx_t CRAWL_OFFLINE_BATCH = 1024;
+
 static unique_ptr<GlobalTableFunctionState> CrawlInitGlobal(ClientContext &context,
                                                              TableFunctionInitInput &input) {
+    auto &bind_data = input.bind_data->Cast<CrawlBindData>();
     auto state = make_uniq<CrawlGlobalState>();
+    state->progress = RegisterCrawlProgress(context, "crawl");
+    if (!bind_data.skip_bloom.empty()) {
+        state->skip_bloom = make_uniq<UrlBloomFilter>(bind_data.skip_bloom.data(), bind_data.skip_bloom.size());
+    }
+    state->progress->queued = NumericCast<int64_t>(bind_data.urls.size());
+    // Until the source query has run, the URL count is not known
+    state->progress->discovering = !bind_data.offline && (!bind_data.source_query.empty() ||
+                                                          !bind_data.follow_selector.empty() ||
+                                                          bind_data.range_discover);
+
+    // Offline: no fetch ordering or politeness to keep, so every thread scans batches
+    if (bind_data.offline) {
+        idx_t batches = (bind_data.urls.size() + CRAWL_OFFLINE_BATCH - 1) / CRAWL_OFFLINE_BATCH;
+        idx_t threads = NumericCast<idx_t>(TaskScheduler::GetScheduler(context).NumberOfThreads());
+        state->max_threads = MaxValue<idx_t>(1, MinValue<idx_t>(threads, batches));
+    }
 
     // LIMIT pushdown: compare estimated_cardinality with our reported cardinality
     // If estimated < reported, LIMIT was applied by the optimizer
@@ -757,16 +1082,559 @@ static unique_ptr<GlobalTableFunctionState> CrawlInitGlobal(ClientContext &conte
             state->limit_from_query = static_cast<int64_t>(estimated);
         }
     }
+    state->progress->limit = bind_data.max_results >= 0 ? bind_data.max_results : state->limit_from_query;
 
     return std::move(state);
 }
 
+static unique_ptr<LocalTableFunctionState> CrawlInitLocal(ExecutionContext &context, TableFunctionInitInput &input,
+                                                          GlobalTableFunctionState *global_state) {
+    return make_uniq<CrawlOfflineLocalState>();
+}
+
+//===--------------------------------------------------------------------===//
+// Output Row
+//===--------------------------------------------------------------------===//
+
+// Canonical URL of a successful HTML response, resolved against the final URL
+static string PageCanonicalUrl(const CrawlResultEntry &entry) {
+    if (entry.canonical_resolved) {
+        return entry.canonical_url;
+    }
+    return CrawlDedupe::PageCanonicalUrl(entry.url, entry.final_url, entry.status_code, entry.content_type,
+                                         entry.body);
+}
+
+// ISO 639-1 code of an HTML or plain text page (NULL if unknown). Fetched pages come
+// classified from the Rust extraction pass; cache hits are classified here. Only a
+// bounded prefix of the visible text is read.
+static Value PageLanguage(const CrawlResultEntry &entry) {
+    if (entry.body.empty() || entry.soft_error) {
+        return Value();
+    }
+    string language = entry.language_detected
+                          ? entry.language
+                          : DetectPageLanguageWithRust(entry.body, entry.content_type, entry.content_language);
+    return language.empty() ? Value() : Value(language);
+}
+
+// Body as returned in html.document and cached: compacted for store_body. A cache hit
+// stored in that mode is compact already (compacting is idempotent).
+static string ReturnedBody(const CrawlResultEntry &entry, const CrawlBindData &bind_data) {
+    return CompactHtmlBody(entry.body, entry.content_type, bind_data.store_body);
+}
+
+// document: ReturnedBody(entry). Fields are extracted from the fetched body.
+// soft_404 is NULL unless soft error detection is on, language unless language := true
+static void SetCrawlOutputRow(DataChunk &output, idx_t row, const CrawlResultEntry &entry,
+                              const CrawlBindData &bind_data, const string &document) {
+    auto soft_404 = bind_data.soft_404;
+    output.SetValue(0, row, Value(entry.url));
+    output.SetValue(1, row, Value(entry.status_code));
+    output.SetValue(2, row, Value(entry.content_type));
+    // Soft errors keep their document, but nothing is extracted from the error template
+    output.SetValue(3, row, entry.soft_error ? BuildHtmlStructValue(document, "")
+                                             : BuildHtmlStructValue(entry.body, entry.content_type, entry.url,
+                                                                    &document));
+    output.SetValue(4, row, entry.final_url.empty() ? Value() : Value(entry.final_url));
+    output.SetValue(5, row, entry.error.empty() ? Value() : Value(entry.error));
+    output.SetValue(6, row, entry.extracted_json.empty() || entry.soft_error ? Value() : Value(entry.extracted_json));
+    output.SetValue(7, row, Value::BIGINT(entry.response_time_ms));
+    output.SetValue(8, row, Value::INTEGER(entry.depth));
+    string canonical = PageCanonicalUrl(entry);
+    output.SetValue(9, row, canonical.empty() ? Value() : Value(canonical));
+    output.SetValue(10, row, soft_404 == SoftErrorMode::OFF ? Value(LogicalType::BOOLEAN)
+                                                            : Value::BOOLEAN(entry.soft_error));
+    output.SetValue(11, row, bind_data.detect_language ? PageLanguage(entry) : Value());
+    // Cache / state key of a request spec, NULL where it is the URL itself
+    output.SetValue(12, row, entry.request_key.empty() || entry.request_key == entry.url ? Value()
+                                                                                       : Value(entry.request_key));
+}
+
+//===--------------------------------------------------------------------===//
+// Fetch
+//===--------------------------------------------------------------------===//
+
+// Fetch one URL, bypassing the cache. The body stays raw: it is compacted for
+// store_body when returned and cached. Returns false if the backend returned no result.
+// url is a URL or the key of a request spec input (bind_data.requests)
+static bool FetchUrl(ClientContext &context, const CrawlBindData &bind_data, const string &url_or_key,
+                     CrawlResultEntry &result) {
+    auto spec = bind_data.requests.find(url_or_key);
+    const CrawlRequestSpec *request = spec == bind_data.requests.end() ? nullptr : &spec->second;
+    const string &url = request ? request->url : url_or_key;
+
+    // Apply HTTP secrets for this specific URL (may override global settings)
+    string http_proxy = bind_data.http_proxy;
+    string http_proxy_username = bind_data.http_proxy_username;
+    string http_proxy_password = bind_data.http_proxy_password;
+    std::map<string, string> extra_headers = bind_data.extra_headers;
+    ApplyHttpSecrets(context, url, http_proxy, http_proxy_username, http_proxy_password, extra_headers);
+
+    string request_json = BuildBatchCrawlRequest(
+        {url},
+        "{}",  // No extraction specs
+        bind_data.user_agent,
+        bind_data.timeout_ms,
+        1,  // Single URL, single concurrency
+        bind_data.delay_ms,
+        bind_data.respect_robots,
+        http_proxy,
+        http_proxy_username,
+        http_proxy_password,
+        extra_headers,
+        {request},
+        bind_data.detect_language
+    );
+
+    string response_json = CrawlBatchWithBackend(bind_data.fetch_backend, request_json);
+    auto fetched = ParseBatchCrawlResponse(response_json);
+    if (fetched.empty()) {
+        return false;
+    }
+    result = std::move(fetched[0]);
+    if (request) {
+        result.request_key = url_or_key;
+    }
+    return true;
+}
+
+//===--------------------------------------------------------------------===//
+// Soft Errors (soft_404)
+//===--------------------------------------------------------------------===//
+
+// Answer of a host to its soft error probe URL: from the cache (under cache_key, which does not
+// change between runs), else fetched (not offline). Redirected probes are not cached: the cache
+// does not keep the redirect target.
+static SoftErrorResponse ProbeSoftErrorTemplate(ClientContext &context, Connection &conn,
+                                                const CrawlBindData &bind_data, const string &probe_url,
+                                                const string &cache_key) {
+    CrawlResultEntry probe;
+    bool found = false;
+    if (bind_data.use_cache) {
+        auto cached = GetCachedEntries(conn, {cache_key}, bind_data.cache_ttl_hours, bind_data.cache_policy,
+                                       bind_data.store_body);
+        if (!cached.empty()) {
+            probe = std::move(cached[0]);
+            found = true;
+        }
+    }
+    if (!found && !bind_data.offline && FetchUrl(context, bind_data, probe_url, probe)) {
+        found = true;
+        bool redirected = !probe.final_url.empty() && probe.final_url != probe_url;
+        if (bind_data.use_cache && !redirected) {
+            probe.url = cache_key;
+            SaveToCache(conn, probe, bind_data.cache_policy, bind_data.store_body);
+        }
+    }
+
+    SoftErrorResponse response;
+    response.url = probe_url;
+    if (found) {
+        response.final_url = std::move(probe.final_url);
+        response.status_code = probe.status_code;
+        response.content_type = std::move(probe.content_type);
+        response.body = std::move(probe.body);
+    }
+    return response;
+}
+
+// Set entry.soft_error when soft_404 is on; probes the entry's host the first time it is seen
+static void ClassifySoftError(ClientContext &context, Connection &conn, CrawlGlobalState &state,
+                              const CrawlBindData &bind_data, CrawlResultEntry &entry) {
+    if (bind_data.soft_404 == SoftErrorMode::OFF) {
+        return;
+    }
+    SoftErrorResponse response;
+    response.url = entry.url;
+    response.final_url = entry.final_url;
+    response.status_code = entry.status_code;
+    response.content_type = entry.content_type;
+    response.body = std::move(entry.body);
+    entry.soft_error = state.soft_errors.IsSoftError(response, [&](const string &probe_url, const string &cache_key) {
+        return ProbeSoftErrorTemplate(context, conn, bind_data, probe_url, cache_key);
+    });
+    entry.body = std::move(response.body);
+}
+
+//===--------------------------------------------------------------------===//
+// crawl_range() - Sequential ID Enumeration
+//===--------------------------------------------------------------------===//
+
+static constexpr const char *CRAWL_RANGE_PLACEHOLDER = "{n}";
+static constexpr int CRAWL_RANGE_DEFAULT_MISS_WINDOW = 10;
+// IDs of one crawl_range(): a given range must be no larger, and galloping this far without
+// a dead window means every ID answers (e.g. a 200 "not found" template)
+static constexpr int64_t CRAWL_RANGE_MAX_IDS = 10000000;
+
+static string CrawlRangeUrl(const string &url_template, int64_t n) {
+    return StringUtil::Replace(url_template, CRAWL_RANGE_PLACEHOLDER, std::to_string(n));
+}
+
+// Liveness of the IDs of a crawl_range() without an end. Probe responses are cached
+// like crawl() responses, so the crawl of the discovered range does not fetch them again.
+class CrawlRangeProber {
+public:
+    CrawlRangeProber(ClientContext &context, Connection &conn, CrawlGlobalState &state,
+                     const CrawlBindData &bind_data)
+        : context(context), conn(conn), state(state), bind_data(bind_data) {
+    }
+
+    // Some ID of [n, n + miss_window) answers 2xx (and is no soft error). The first ID
+    // is probed alone, the rest of the window in one concurrent batch.
+    bool WindowIsLive(int64_t n) {
+        if (IsLive(n)) {
+            return true;
+        }
+        vector<int64_t> rest;
+        int64_t id;
+        // IDs past the BIGINT maximum do not exist
+        for (int64_t i = 1; i < bind_data.range_miss_window && TryAddOperator::Operation(n, i, id); i++) {
+            rest.push_back(id);
+        }
+        Probe(rest);
+        for (auto id : rest) {
+            if (live[id]) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+private:
+    bool IsLive(int64_t n) {
+        Probe({n});
+        return live[n];
+    }
+
+    void Probe(const vector<int64_t> &ids) {
+        std::unordered_map<string, int64_t> pending;
+        vector<string> urls;
+        for (auto id : ids) {
+            if (live.count(id) == 0) {
+                auto url = CrawlRangeUrl(bind_data.range_template, id);
+                pending[url] = id;
+                urls.push_back(std::move(url));
+                live[id] = false;  // Unless a 2xx response says otherwise
+            }
+        }
+        if (urls.empty()) {
+            return;
+        }
+
+        vector<CrawlResultEntry> responses;
+        if (bind_data.use_cache) {
+            responses = GetCachedEntries(conn, urls, bind_data.cache_ttl_hours, bind_data.cache_policy,
+                                         bind_data.store_body);
+        }
+        std::unordered_set<string> cached;
+        for (auto &entry : responses) {
+            cached.insert(entry.url);
+        }
+        vector<string> misses;
+        for (auto &url : urls) {
+            if (cached.count(url) == 0) {
+                misses.push_back(url);
+            }
+        }
+        idx_t fetched_from = responses.size();
+        if (!misses.empty()) {
+            // One template, one host: the secrets of the first URL apply to all
+            string http_proxy = bind_data.http_proxy;
+            string http_proxy_username = bind_data.http_proxy_username;
+            string http_proxy_password = bind_data.http_proxy_password;
+            std::map<string, string> extra_headers = bind_data.extra_headers;
+            ApplyHttpSecrets(context, misses[0], http_proxy, http_proxy_username, http_proxy_password,
+                             extra_headers);
+            string request_json = BuildBatchCrawlRequest(misses, "{}", bind_data.user_agent, bind_data.timeout_ms,
+                                                         bind_data.concurrency, bind_data.delay_ms,
+                                                         bind_data.respect_robots, http_proxy, http_proxy_username,
+                                                         http_proxy_password, extra_headers);
+            for (auto &entry : ParseBatchCrawlResponse(CrawlBatchWithBackend(bind_data.fetch_backend, request_json))) {
+                responses.push_back(std::move(entry));
+            }
+            GetCrawlDedupeCounters(context)->pages_fetched += NumericCast<int64_t>(misses.size());
+        }
+
+        for (idx_t i = 0; i < responses.size(); i++) {
+            auto &entry = responses[i];
+            ClassifySoftError(context, conn, state, bind_data, entry);
+            bool fetched = i >= fetched_from;
+            if (fetched && bind_data.use_cache &&
+                !(entry.soft_error && bind_data.soft_404 == SoftErrorMode::SKIP)) {
+                SaveToCache(conn, entry, bind_data.cache_policy, bind_data.store_body);
+            }
+            auto id = pending.find(entry.url);
+            if (id != pending.end()) {
+                live[id->second] = entry.status_code >= 200 && entry.status_code < 300 && !entry.soft_error;
+            }
+        }
+    }
+
+    ClientContext &context;
+    Connection &conn;
+    CrawlGlobalState &state;
+    const CrawlBindData &bind_data;
+    std::unordered_map<int64_t, bool> live;
+};
+
+// URLs of range_start up to the last live ID. Gallops (start + 1, 2, 4, ...) while windows
+// are live, then binary searches between the last live and the first dead window; with
+// window(end) live and window(end + 1) dead, end itself is the last live ID. Gaps shorter
+// than the miss window do not end the range, longer ones do.
+static vector<string> DiscoverCrawlRange(ClientContext &context, Connection &conn, CrawlGlobalState &state,
+                                         const CrawlBindData &bind_data) {
+    CrawlRangeProber prober(context, conn, state, bind_data);
+    int64_t start = bind_data.range_start;
+    int64_t count = 0;
+    if (prober.WindowIsLive(start)) {
+        int64_t lo = start;
+        int64_t hi;
+        for (int64_t step = 1;; step *= 2) {
+            if (step >= CRAWL_RANGE_MAX_IDS) {
+                throw IOException("crawl_range: every probe up to " + std::to_string(lo) + " answered (more than " +
+                                  std::to_string(CRAWL_RANGE_MAX_IDS) + " IDs); pass an end or soft_404 := 'flag'");
+            }
+            if (!TryAddOperator::Operation(start, step, hi)) {
+                // Past the BIGINT maximum: the last ID is at most the maximum
+                hi = NumericLimits<int64_t>::Maximum();
+                if (prober.WindowIsLive(hi)) {
+                    lo = hi;
+                }
+                break;
+            }
+            if (!prober.WindowIsLive(hi)) {
+                break;
+            }
+            lo = hi;
+        }
+        while (hi - lo > 1) {
+            int64_t mid = lo + (hi - lo) / 2;
+            if (prober.WindowIsLive(mid)) {
+                lo = mid;
+            } else {
+                hi = mid;
+            }
+        }
+        count = lo - start + 1;
+    }
+
+    vector<string> urls;
+    for (int64_t i = 0; i < count; i++) {
+        urls.push_back(CrawlRangeUrl(bind_data.range_template, start + i));
+    }
+    return urls;
+}
+
+// crawl_range(template, start [, end], miss_window := 10, <crawl() options>)
+static unique_ptr<FunctionData> CrawlRangeBind(ClientContext &context, TableFunctionBindInput &input,
+                                                vector<LogicalType> &return_types, vector<string> &names) {
+    for (auto &arg : input.inputs) {
+        if (arg.IsNull()) {
+            throw BinderException("crawl_range: template, start and end must not be NULL");
+        }
+    }
+    auto url_template = StringValue::Get(input.inputs[0]);
+    if (url_template.find(CRAWL_RANGE_PLACEHOLDER) == string::npos) {
+        throw BinderException("crawl_range: template must contain {n}, e.g. 'https://example.com/item/{n}'");
+    }
+    int miss_window = CRAWL_RANGE_DEFAULT_MISS_WINDOW;
+    auto window_param = input.named_parameters.find("miss_window");
+    if (window_param != input.named_parameters.end()) {
+        miss_window = window_param->second.GetValue<int>();
+        if (miss_window < 1) {
+            throw BinderException("crawl_range: miss_window must be at least 1");
+        }
+    }
+
+    // The crawl() options; the template stands in for the URL list
+    auto result = CrawlBind(context, input, return_types, names);
+    auto &bind_data = result->Cast<CrawlBindData>();
+    if (bind_data.offline) {
+        throw BinderException("crawl_range: offline := true is not supported, use crawl() over the cached URLs");
+    }
+    bind_data.urls.clear();
+    bind_data.range_template = url_template;
+    bind_data.range_start = input.inputs[1].GetValue<int64_t>();
+    bind_data.range_miss_window = miss_window;
+    if (input.inputs.size() > 2) {
+        // Known end: enumerate it, no probes
+        auto start = bind_data.range_start;
+        auto end = input.inputs[2].GetValue<int64_t>();
+        int64_t span = 0;
+        if (end >= start && (!TrySubtractOperator::Operation(end, start, span) || span >= CRAWL_RANGE_MAX_IDS)) {
+            throw BinderException("crawl_range: %d to %d is more than %d IDs; split the range", start, end,
+                                  CRAWL_RANGE_MAX_IDS);
+        }
+        for (int64_t i = 0; end >= start && i <= span; i++) {
+            bind_data.urls.push_back(CrawlRangeUrl(url_template, start + i));
+        }
+    } else {
+        bind_data.range_discover = true;
+    }
+    return result;
+}
+
+//===--------------------------------------------------------------------===//
+// Offline Mode - Parallel Cache Scan, No Network
+//===--------------------------------------------------------------------===//
+
+static constexpr const char *CRAWL_OFFLINE_MISS_ERROR = "not in cache (offline)";
+
+// Cached entries for a batch in URL order; URLs without an entry are marked with an error
+static vector<CrawlResultEntry> LookupOfflineBatch(Connection &conn, const vector<string> &urls,
+                                                   const CrawlBindData &bind_data) {
+    std::map<string, CrawlResultEntry> hits;
+    for (auto &entry : GetCachedEntries(conn, urls, bind_data.cache_ttl_hours, bind_data.cache_policy,
+                                        bind_data.store_body)) {
+        hits[entry.url] = std::move(entry);
+    }
+    vector<CrawlResultEntry> results;
+    results.reserve(urls.size());
+    for (auto &url : urls) {
+        auto hit = hits.find(url);
+        if (hit != hits.end()) {
+            results.push_back(hit->second);
+        } else {
+            CrawlResultEntry miss;
+            miss.url = url;
+            miss.error = CRAWL_OFFLINE_MISS_ERROR;
+            results.push_back(std::move(miss));
+        }
+        ResolveRequestEntry(bind_data, results.back());
+    }
+    return results;
+}
+
+static void CrawlOfflineFunction(ClientContext &context, TableFunctionInput &data, DataChunk &output) {
+    auto &bind_data = data.bind_data->Cast<CrawlBindData>();
+    auto &state = data.global_state->Cast<CrawlGlobalState>();
+    auto &local = data.local_state->Cast<CrawlOfflineLocalState>();
+
+    int64_t effective_limit = bind_data.max_results;
+    if (effective_limit < 0 && state.limit_from_query >= 0) {
+        effective_limit = state.limit_from_query;
+    }
+
+    idx_t count = 0;
+    while (count < STANDARD_VECTOR_SIZE) {
+        if (local.result_idx >= local.results.size()) {
+            if (IsInterrupted()) {
+                break;
+            }
+            // Claim the next batch of URLs
+            idx_t start = state.next_offline_url.fetch_add(CRAWL_OFFLINE_BATCH);
+            if (start >= bind_data.urls.size()) {
+                break;
+            }
+            idx_t end = MinValue<idx_t>(start + CRAWL_OFFLINE_BATCH, bind_data.urls.size());
+            vector<string> batch(bind_data.urls.begin() + start, bind_data.urls.begin() + end);
+            auto batch_size = NumericCast<int64_t>(batch.size());
+            state.progress->queued -= batch_size;
+            state.progress->in_flight += batch_size;
+            if (!local.conn) {
+                local.conn = make_uniq<Connection>(*context.db);
+            }
+            local.results = LookupOfflineBatch(*local.conn, batch, bind_data);
+            for (auto &entry : local.results) {
+                ClassifySoftError(context, *local.conn, state, bind_data, entry);
+            }
+            state.progress->Complete(batch_size, true);
+            local.result_idx = 0;
+            continue;
+        }
+        if (bind_data.soft_404 == SoftErrorMode::SKIP && local.results[local.result_idx].soft_error) {
+            local.result_idx++;
+            continue;
+        }
+        if (effective_limit >= 0 && state.offline_results.fetch_add(1) >= effective_limit) {
+            break;
+        }
+        // HTML parsing (js / opengraph / schema / readability) runs here, on every scan thread
+        auto &entry = local.results[local.result_idx++];
+        SetCrawlOutputRow(output, count, entry, bind_data, ReturnedBody(entry, bind_data));
+        count++;
+    }
+    output.SetCardinality(count);
+}
+
+//===--------------------------------------------------------------------===//
+// Scheduler - Priority Heap with Per-Host Delay
+//===--------------------------------------------------------------------===//
+
+// Heap entries inspected per pick while looking for a host that may be fetched now
+static constexpr idx_t CRAWL_SCHEDULER_SCAN = 1024;
+
+// Pop the highest-priority unprocessed URL whose host is past its delay. Higher-priority
+// URLs of a host that is still waiting go back on the heap; when no scanned host is
+// ready, sleep until the earliest one is. Returns false when nothing is left.
+static bool PopNextUrl(CrawlGlobalState &state, const CrawlBindData &bind_data, CrawlDedupeCounters &counters,
+                       ScheduledUrl &next) {
+    using clock = std::chrono::steady_clock;
+    auto delay = std::chrono::milliseconds(bind_data.delay_ms);
+
+    while (!state.url_heap.empty()) {
+        vector<ScheduledUrl> waiting;
+        auto now = clock::now();
+        auto earliest = clock::time_point::max();
+        bool found = false;
+        while (!state.url_heap.empty() && waiting.size() < CRAWL_SCHEDULER_SCAN) {
+            auto item = UnscheduleTopUrl(state, bind_data);
+            // Skip if already processed (handles duplicates and resumption from state table)
+            if (state.processed_urls.count(item.url) > 0) {
+                continue;
+            }
+            // Variant of a URL (or canonical) already fetched: never fetch it
+            if (bind_data.dedupe && state.dedupe.SeenUrl(item.url)) {
+                state.processed_urls.insert(item.url);
+                counters.fetches_avoided++;
+                continue;
+            }
+            string host = ExtractDomain(item.url);
+            if (bind_data.delay_ms > 0 && !host.empty()) {
+                auto host_entry = state.host_next_fetch.find(host);
+                if (host_entry != state.host_next_fetch.end() && host_entry->second > now) {
+                    earliest = MinValue(earliest, host_entry->second);
+                    waiting.push_back(std::move(item));
+                    continue;
+                }
+                state.host_next_fetch[host] = now + delay;
+            }
+            next = std::move(item);
+            found = true;
+            break;
+        }
+        for (auto &item : waiting) {
+            ScheduleUrl(state, bind_data, std::move(item));
+        }
+        if (found) {
+            return true;
+        }
+        if (waiting.empty()) {
+            return false;
+        }
+        // Every candidate host is waiting: sleep in small steps so Ctrl+C stays responsive
+        while (clock::now() < earliest) {
+            if (IsInterrupted()) {
+                return false;
+            }
+            auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(earliest - clock::now());
+            std::this_thread::sleep_for(MinValue(remaining, std::chrono::milliseconds(50)));
+        }
+    }
+    return false;
+}
+
 //===--------------------------------------------------------------------===//
 // Main Function - Streaming with Rust HTTP + Link Following
 //===--------------------------------------------------------------------===//
 
 static void CrawlFunction(ClientContext &context, TableFunctionInput &data, DataChunk &output) {
     auto &bind_data = data.bind_data->CastNoConst<CrawlBindData>();
+    if (bind_data.offline) {
+        CrawlOfflineFunction(context, data, output);
+        return;
+    }
     auto &state = data.global_state->Cast<CrawlGlobalState>();
 
     // Initialize on first call
@@ -775,9 +1643,25 @@ static void CrawlFunction(ClientContext &context, TableFunctionInput &data, Data
 
         Connection conn(*context.db);
 
-        // Execute source query if provided
-        if (!bind_data.source_query.empty()) {
-            auto query_result = conn.Query(bind_data.source_query);
+        // Execute source query if provided; with a priority the expression is evaluated per source row
+        vector<double> priorities;
+        if (!bind_data.source_query.empty() || !bind_data.priority_expr.empty()) {
+            unique_ptr<QueryResult> query_result;
+            if (bind_data.priority_expr.empty()) {
+                query_result = conn.Query(bind_data.source_query);
+            } else if (!bind_data.source_query.empty()) {
+                query_result = conn.Query("SELECT #1, (" + bind_data.priority_expr + ")::DOUBLE FROM (" +
+                                          bind_data.source_query + ") AS __crawl_source");
+            } else {
+                vector<Value> url_values;
+                for (auto &url : bind_data.urls) {
+                    url_values.push_back(Value(url));
+                }
+                bind_data.urls.clear();
+                query_result = conn.Query("SELECT url, (" + bind_data.priority_expr + ")::DOUBLE "
+                                          "FROM (SELECT unnest($1::VARCHAR[]) AS url) AS __crawl_source",
+                                          Value::LIST(LogicalType::VARCHAR, url_values));
+            }
             if (query_result->HasError()) {
                 throw IOException("crawl source query error: " + query_result->GetError());
             }
@@ -785,24 +1669,47 @@ static void CrawlFunction(ClientContext &context, TableFunctionInput &data, Data
                 for (idx_t i = 0; i < chunk->size(); i++) {
                     auto val = chunk->GetValue(0, i);
                     if (!val.IsNull()) {
-                        bind_data.urls.push_back(val.ToString());
+                        bind_data.urls.push_back(val.type().id() == LogicalTypeId::STRUCT
+                                                     ? AddRequestSpec(bind_data, val)
+                                                     : val.ToString());
+                        if (!bind_data.priority_expr.empty()) {
+                            // NULL priority: after every scored URL
+                            auto priority = chunk->GetValue(1, i);
+                            priorities.push_back(priority.IsNull() ? -std::numeric_limits<double>::infinity()
+                                                                   : priority.GetValue<double>());
+                        }
                     }
                 }
             }
         }
 
+        // crawl_range() without an end: find the last live ID first
+        if (bind_data.range_discover) {
+            bind_data.urls = DiscoverCrawlRange(context, conn, state, bind_data);
+        }
+
         // Load processed URLs from state table
         if (!bind_data.state_table.empty()) {
             EnsureStateTable(conn, bind_data.state_table);
             state.processed_urls = LoadProcessedUrls(conn, bind_data.state_table);
         }
 
-        // Initialize URL queue with initial URLs at depth 1
-        for (const auto &url : bind_data.urls) {
-            state.url_queue.push_back({url, 1});
+        // Sample seeds before anything is scheduled
+        SampleSeedUrls(bind_data, bind_data.urls, priorities);
+
+        // Initialize URL heap with initial URLs at depth 1 (equal priorities keep input order)
+        for (idx_t i = 0; i < bind_data.urls.size(); i++) {
+            if (state.skip_bloom && state.skip_bloom->Contains(bind_data.urls[i])) {
+                continue;
+            }
+            double priority = priorities.empty() ? 0 : priorities[i];
+            ScheduleUrl(state, bind_data, {priority, state.next_seq++, bind_data.urls[i], 1});
         }
+        state.progress->discovering = !bind_data.follow_selector.empty();
     }
 
+    auto counters = GetCrawlDedupeCounters(context);
+
     // Connection for state table updates
     unique_ptr<Connection> conn_holder;
     Connection *conn = nullptr;
@@ -836,33 +1743,57 @@ static void CrawlFunction(ClientContext &context, TableFunctionInput &data, Data
         if (state.result_idx < state.pending_results.size()) {
             auto &entry = state.pending_results[state.result_idx++];
 
-            output.SetValue(0, count, Value(entry.url));
-            output.SetValue(1, count, Value(entry.status_code));
-            output.SetValue(2, count, Value(entry.content_type));
-            output.SetValue(3, count, BuildHtmlStructValue(entry.body, entry.content_type, entry.url));
-            output.SetValue(4, count, entry.final_url.empty() ? Value() : Value(entry.final_url));
-            output.SetValue(5, count, entry.error.empty() ? Value() : Value(entry.error));
-            output.SetValue(6, count, entry.extracted_json.empty() ? Value() : Value(entry.extracted_json));
-            output.SetValue(7, count, Value::BIGINT(entry.response_time_ms));
-            output.SetValue(8, count, Value::INTEGER(entry.depth));
+            // Soft error with soft_404 := 'skip': not returned, links not followed
+            if (entry.soft_error && bind_data.soft_404 == SoftErrorMode::SKIP) {
+                state.processed_urls.insert(EntryKey(entry));
+                if (conn) {
+                    SaveToStateTable(*conn, bind_data.state_table, entry);
+                }
+                continue;
+            }
+
+            // Duplicate of a page already returned: drop it and do not follow its links
+            // (request specs to one URL differ by method and body, they are no URL variants).
+            // The fingerprint is of the returned body, the same for fetched pages and cache hits.
+            auto document = ReturnedBody(entry, bind_data);
+            bool duplicate = false;
+            if (bind_data.dedupe && entry.request_key.empty()) {
+                duplicate = state.dedupe.IsDuplicate(entry.url, entry.final_url, entry.status_code,
+                                                     entry.content_type, document, entry.canonical_url);
+                entry.canonical_resolved = true;
+            }
+            if (duplicate) {
+                counters->duplicates_collapsed++;
+                counters->bytes_not_returned += NumericCast<int64_t>(document.size());
+                state.processed_urls.insert(EntryKey(entry));
+                if (conn) {
+                    SaveToStateTable(*conn, bind_data.state_table, entry);
+                }
+                continue;
+            }
+
+            SetCrawlOutputRow(output, count, entry, bind_data, document);
             count++;
             state.results_returned++;  // Track for max_results limit
 
             // Mark as processed (before extracting links to avoid re-queuing)
-            state.processed_urls.insert(entry.url);
+            state.processed_urls.insert(EntryKey(entry));
 
             // Extract links for following if configured and within max_depth
             if (!bind_data.follow_selector.empty() &&
                 entry.depth < bind_data.max_depth &&
                 entry.status_code >= 200 && entry.status_code < 300 &&
-                !entry.body.empty()) {
+                !entry.body.empty() && !entry.soft_error) {
                 auto links = ExtractLinksWithRust(entry.body, bind_data.follow_selector, entry.url);
                 for (const auto &link : links) {
                     // Only add if not already processed (don't add to processed_urls yet)
-                    if (state.processed_urls.count(link) == 0) {
-                        state.url_queue.push_back({link, entry.depth + 1});
+                    if (state.processed_urls.count(link) == 0 &&
+                        !(state.skip_bloom && state.skip_bloom->Contains(link))) {
+                        ScheduleUrl(state, bind_data, {entry.priority, state.next_seq++, link, entry.depth + 1});
+                        state.progress->discovered++;
                     }
                 }
+                state.progress->expanded++;
             }
             if (conn) {
                 SaveToStateTable(*conn, bind_data.state_table, entry);
@@ -874,18 +1805,14 @@ static void CrawlFunction(ClientContext &context, TableFunctionInput &data, Data
         state.pending_results.clear();
         state.result_idx = 0;
 
-        // Get next single URL from queue (skip already processed)
-        string url_to_fetch;
-        int url_depth = 1;
-        while (state.queue_idx < state.url_queue.size()) {
-            auto &item = state.url_queue[state.queue_idx++];
-            // Skip if already processed (handles duplicates and resumption from state table)
-            if (state.processed_urls.count(item.url) == 0) {
-                url_to_fetch = item.url;
-                url_depth = item.depth;
-                break;
-            }
+        // Get next single URL from the heap (skip already processed, respect per-host delay)
+        ScheduledUrl next;
+        if (!PopNextUrl(state, bind_data, *counters, next)) {
+            state.finished = true;
+            break;
         }
+        string url_to_fetch = next.url;
+        int url_depth = next.depth;
 
         // No more URLs to fetch
         if (url_to_fetch.empty()) {
@@ -894,63 +1821,63 @@ static void CrawlFunction(ClientContext &context, TableFunctionInput &data, Data
         }
 
         Connection cache_conn(*context.db);
+        state.progress->in_flight++;
 
         // Check cache first
         CrawlResultEntry result;
         bool from_cache = false;
 
         if (bind_data.use_cache) {
-            auto cached = GetCachedEntries(cache_conn, {url_to_fetch}, bind_data.cache_ttl_hours);
+            auto cached = GetCachedEntries(cache_conn, {url_to_fetch}, bind_data.cache_ttl_hours,
+                                           bind_data.cache_policy, bind_data.store_body);
             if (!cached.empty()) {
                 result = std::move(cached[0]);
+                ResolveRequestEntry(bind_data, result);
                 result.depth = url_depth;
+                result.priority = next.priority;
                 from_cache = true;
             }
         }
 
         // Fetch if not cached
+        bool fetched = false;
         if (!from_cache) {
-            // Apply HTTP secrets for this specific URL (may override global settings)
-            string http_proxy = bind_data.http_proxy;
-            string http_proxy_username = bind_data.http_proxy_username;
-            string http_proxy_password = bind_data.http_proxy_password;
-            std::map<string, string> extra_headers = bind_data.extra_headers;
-            ApplyHttpSecrets(context, url_to_fetch, http_proxy, http_proxy_username, http_proxy_password, extra_headers);
-
-            string request_json = BuildBatchCrawlRequest(
-                {url_to_fetch},
-                "{}",  // No extraction specs
-                bind_data.user_agent,
-                bind_data.timeout_ms,
-                1,  // Single URL, single concurrency
-                bind_data.delay_ms,
-                bind_data.respect_robots,
-                http_proxy,
-                http_proxy_username,
-                http_proxy_password,
-                extra_headers
-            );
-
-            string response_json = CrawlBatchWithRust(request_json);
-            auto fetched = ParseBatchCrawlResponse(response_json);
-
-            if (!fetched.empty()) {
-                result = std::move(fetched[0]);
+            fetched = FetchUrl(context, bind_data, url_to_fetch, result);
+            counters->pages_fetched++;
+            if (fetched) {
                 result.depth = url_depth;
-
-                if (bind_data.use_cache) {
-                    SaveToCache(cache_conn, result);
-                }
+                result.priority = next.priority;
             }
         }
 
+        if (from_cache || fetched) {
+            ClassifySoftError(context, cache_conn, state, bind_data, result);
+        }
+        // soft_404 := 'skip' stores no soft errors
+        if (fetched && bind_data.use_cache &&
+            !(result.soft_error && bind_data.soft_404 == SoftErrorMode::SKIP)) {
+            SaveToCache(cache_conn, result, bind_data.cache_policy, bind_data.store_body);
+        }
+
         // Add to pending results for immediate yield
         state.pending_results.push_back(std::move(result));
+        state.progress->Complete(1, true);
     }
 
+    if (state.finished) {
+        state.progress->discovering = false;
+    }
     output.SetCardinality(count);
 }
 
+static double CrawlProgressCallback(ClientContext &context, const FunctionData *bind_data_p,
+                                    const GlobalTableFunctionState *gstate_p) {
+    if (!gstate_p) {
+        return -1.0;
+    }
+    return CrawlProgressPercentage(gstate_p->Cast<CrawlGlobalState>().progress);
+}
+
 //===--------------------------------------------------------------------===//
 // LATERAL Join Support (In-Out Function)
 //===--------------------------------------------------------------------===//
@@ -1029,7 +1956,7 @@ static OperatorResultType CrawlInOut(ExecutionContext &context, TableFunctionInp
         string request_json(json_str, len);
         free(json_str);
 
-        string response_json = CrawlBatchWithRust(request_json);
+        string response_json = CrawlBatchWithBackend(bind_data.fetch_backend, request_json);
 
         // Parse response
         yyjson_doc *resp_doc = yyjson_read(response_json.c_str(), response_json.size(), 0);
@@ -1108,6 +2035,280 @@ static OperatorResultType CrawlInOut(ExecutionContext &context, TableFunctionInp
     return OperatorResultType::NEED_MORE_INPUT;
 }
 
+//===--------------------------------------------------------------------===//
+// crawl_plan() - Dry Run: What crawl() Would Fetch, Per Host
+//===--------------------------------------------------------------------===//
+
+// Takes crawl()'s arguments and resolves everything that decides whether a seed
+// URL is fetched - sampling, duplicates / dedupe, state table, skip_bloom, the
+// cache and robots.txt - without fetching anything. robots.txt comes from the
+// robots_txt := MAP {'host': '<robots.txt>'} fixtures, else from a cached
+// <origin>/robots.txt response, else it is unknown (nothing counted as disallowed).
+// Links that follow would discover are not planned.
+
+struct CrawlPlanBindData : public TableFunctionData {
+    unique_ptr<FunctionData> crawl;  // CrawlBindData for the same arguments
+    vector<string> seed_urls;        // URL list as given (offline CrawlBind already samples and filters it)
+    std::unordered_map<string, string> robots_fixtures;  // host (lowercase) -> robots.txt
+};
+
+struct CrawlPlanHost {
+    string host;
+    int64_t urls = 0;
+    int64_t to_fetch = 0;
+    int64_t cached = 0;
+    int64_t skipped = 0;
+    int64_t disallowed = 0;
+    string robots;  // robots.txt source: fixture / cache / unknown / ignored
+    double delay_s = 0;
+
+    double MinDurationSeconds() const {
+        return to_fetch > 1 ? static_cast<double>(to_fetch - 1) * delay_s : 0;
+    }
+};
+
+struct CrawlPlanGlobalState : public GlobalTableFunctionState {
+    bool planned = false;
+    vector<CrawlPlanHost> hosts;
+    idx_t offset = 0;
+};
+
+static unique_ptr<FunctionData> CrawlPlanBind(ClientContext &context, TableFunctionBindInput &input,
+                                              vector<LogicalType> &return_types, vector<string> &names) {
+    auto bind_data = make_uniq<CrawlPlanBindData>();
+    vector<LogicalType> crawl_types;
+    vector<string> crawl_names;
+    bind_data->crawl = CrawlBind(context, input, crawl_types, crawl_names);
+    auto &first_arg = input.inputs[0];
+    if (first_arg.type().id() == LogicalTypeId::LIST) {
+        for (auto &url_val : ListValue::GetChildren(first_arg)) {
+            if (!url_val.IsNull()) {
+                bind_data->seed_urls.push_back(StringValue::Get(url_val));
+            }
+        }
+    } else if (bind_data->crawl->Cast<CrawlBindData>().source_query.empty()) {
+        bind_data->seed_urls.push_back(StringValue::Get(first_arg));
+    }
+
+    auto fixtures = input.named_parameters.find("robots_txt");
+    if (fixtures != input.named_parameters.end() && !fixtures->second.IsNull()) {
+        for (auto &entry : MapValue::GetChildren(fixtures->second)) {
+            auto &key_value = StructValue::GetChildren(entry);
+            if (!key_value[0].IsNull() && !key_value[1].IsNull()) {
+                bind_data->robots_fixtures[StringUtil::Lower(StringValue::Get(key_value[0]))] =
+                    StringValue::Get(key_value[1]);
+            }
+        }
+    }
+
+    names = {"host", "urls", "to_fetch", "cached", "skipped", "disallowed", "robots", "delay_s", "min_duration_s"};
+    return_types = {LogicalType::VARCHAR, LogicalType::BIGINT,  LogicalType::BIGINT,
+                    LogicalType::BIGINT,  LogicalType::BIGINT,  LogicalType::BIGINT,
+                    LogicalType::VARCHAR, LogicalType::DOUBLE,  LogicalType::DOUBLE};
+    return std::move(bind_data);
+}
+
+static unique_ptr<GlobalTableFunctionState> CrawlPlanInitGlobal(ClientContext &context,
+                                                                 TableFunctionInitInput &input) {
+    return make_uniq<CrawlPlanGlobalState>();
+}
+
+// Seed URLs of a crawl() call: the URL list, or the first column of the source query
+static vector<string> LoadCrawlPlanUrls(Connection &conn, const CrawlPlanBindData &plan_data) {
+    auto &bind_data = plan_data.crawl->Cast<CrawlBindData>();
+    if (bind_data.source_query.empty()) {
+        return plan_data.seed_urls;
+    }
+    vector<string> urls;
+    auto result = conn.Query("SELECT (#1)::VARCHAR FROM (" + bind_data.source_query + ") AS __crawl_source");
+    if (result->HasError()) {
+        throw IOException("crawl_plan source query error: " + result->GetError());
+    }
+    while (auto chunk = result->Fetch()) {
+        chunk->Flatten();
+        auto data = FlatVector::GetData<string_t>(chunk->data[0]);
+        auto &validity = FlatVector::Validity(chunk->data[0]);
+        for (idx_t row = 0; row < chunk->size(); row++) {
+            if (validity.RowIsValid(row)) {
+                urls.push_back(data[row].GetString());
+            }
+        }
+    }
+    return urls;
+}
+
+static vector<CrawlPlanHost> BuildCrawlPlan(ClientContext &context, const CrawlPlanBindData &plan_data) {
+    auto &bind_data = plan_data.crawl->Cast<CrawlBindData>();
+    Connection conn(*context.db);
+
+    std::unordered_map<string, CrawlPlanHost> hosts;
+    auto host_of = [&](const string &url) -> CrawlPlanHost & {
+        auto host = StringUtil::Lower(ExtractDomain(url));
+        auto &entry = hosts[host];
+        entry.host = host;
+        return entry;
+    };
+
+    // Seeds dropped by sampling are skipped
+    auto urls = LoadCrawlPlanUrls(conn, plan_data);
+    for (auto &url : urls) {
+        auto &host = host_of(url);
+        host.urls++;
+        host.skipped++;
+    }
+    vector<double> no_priorities;
+    SampleSeedUrls(bind_data, urls, no_priorities);
+    for (auto &url : urls) {
+        host_of(url).skipped--;
+    }
+
+    // Repeated seeds, URL variants (dedupe), processed URLs (state_table) and skip_bloom members are skipped
+    std::set<string> processed;
+    if (!bind_data.state_table.empty()) {
+        processed = LoadProcessedUrls(conn, bind_data.state_table);
+    }
+    unique_ptr<UrlBloomFilter> skip_bloom;
+    if (!bind_data.skip_bloom.empty()) {
+        skip_bloom = make_uniq<UrlBloomFilter>(bind_data.skip_bloom.data(), bind_data.skip_bloom.size());
+    }
+    std::unordered_set<string> seen;
+    std::unordered_set<string> seen_keys;
+    vector<string> candidates;
+    for (auto &url : urls) {
+        bool skip = !seen.insert(url).second || processed.count(url) > 0 ||
+                    (bind_data.dedupe && !seen_keys.insert(UrlDedupeKey(url)).second) ||
+                    (skip_bloom && skip_bloom->Contains(url));
+        if (skip) {
+            host_of(url).skipped++;
+        } else {
+            candidates.push_back(std::move(url));
+        }
+    }
+    urls.clear();
+
+    // Fresh cache entries are served without a fetch (and without a robots.txt check)
+    std::unordered_set<string> fresh;
+    if (bind_data.use_cache) {
+        fresh = CrawlerCacheFreshUrls(conn, candidates, bind_data.cache_ttl_hours, bind_data.cache_policy);
+    }
+
+    // robots.txt rules per host: fixtures, else cached responses
+    bool check_robots = bind_data.respect_robots && !bind_data.offline;
+    std::unordered_map<string, RobotsRules> host_rules;
+    if (check_robots) {
+        std::unordered_map<string, string> robots_urls;  // robots.txt URL -> host
+        for (auto &url : candidates) {
+            if (fresh.count(url) > 0) {
+                continue;
+            }
+            auto &host = host_of(url);
+            if (!host.robots.empty()) {
+                continue;
+            }
+            auto fixture = plan_data.robots_fixtures.find(host.host);
+            if (fixture != plan_data.robots_fixtures.end()) {
+                host.robots = "fixture";
+                host_rules[host.host] = RobotsParser::GetRulesForUserAgent(RobotsParser::Parse(fixture->second),
+                                                                           bind_data.user_agent);
+                continue;
+            }
+            host.robots = "unknown";
+            auto robots_url = RobotsTxtUrl(url);
+            if (!robots_url.empty()) {
+                robots_urls[robots_url] = host.host;
+            }
+        }
+        vector<string> lookups;
+        for (auto &entry : robots_urls) {
+            lookups.push_back(entry.first);
+        }
+        for (idx_t start = 0; start < lookups.size(); start += CRAWL_OFFLINE_BATCH) {
+            idx_t end = MinValue<idx_t>(start + CRAWL_OFFLINE_BATCH, lookups.size());
+            vector<string> batch(lookups.begin() + start, lookups.begin() + end);
+            for (auto &hit : CrawlerCacheLookup(conn, batch, -1, bind_data.cache_policy)) {
+                // 4xx: no robots.txt, everything allowed; 5xx / errors: unknown
+                if (hit.status_code >= 500 || hit.status_code < 200) {
+                    continue;
+                }
+                auto &host = hosts[robots_urls[hit.url]];
+                host.robots = "cache";
+                host_rules[host.host] = hit.status_code < 300 ? RobotsParser::GetRulesForUserAgent(
+                                                                   RobotsParser::Parse(hit.body), bind_data.user_agent)
+                                                             : RobotsRules();
+            }
+        }
+    }
+
+    for (auto &url : candidates) {
+        auto &host = host_of(url);
+        if (fresh.count(url) > 0) {
+            host.cached++;
+            continue;
+        }
+        if (bind_data.offline) {
+            // Not in the cache: an error row, never a fetch
+            host.skipped++;
+            continue;
+        }
+        auto rules = host_rules.find(host.host);
+        if (rules != host_rules.end() && !RobotsParser::IsAllowed(rules->second, ExtractPath(url))) {
+            host.disallowed++;
+            continue;
+        }
+        host.to_fetch++;
+    }
+
+    vector<CrawlPlanHost> result;
+    double delay_s = static_cast<double>(bind_data.delay_ms) / 1000.0;
+    for (auto &entry : hosts) {
+        auto &host = entry.second;
+        host.delay_s = delay_s;
+        if (host.robots.empty()) {
+            host.robots = check_robots ? "unknown" : "ignored";
+        }
+        auto rules = host_rules.find(host.host);
+        if (rules != host_rules.end() && rules->second.HasCrawlDelay()) {
+            host.delay_s = MaxValue(host.delay_s, rules->second.GetEffectiveDelay());
+        }
+        result.push_back(std::move(host));
+    }
+    // Politeness bottlenecks first
+    std::sort(result.begin(), result.end(), [](const CrawlPlanHost &a, const CrawlPlanHost &b) {
+        if (a.MinDurationSeconds() != b.MinDurationSeconds()) {
+            return a.MinDurationSeconds() > b.MinDurationSeconds();
+        }
+        if (a.to_fetch != b.to_fetch) {
+            return a.to_fetch > b.to_fetch;
+        }
+        return a.host < b.host;
+    });
+    return result;
+}
+
+static void CrawlPlanFunction(ClientContext &context, TableFunctionInput &data, DataChunk &output) {
+    auto &plan_data = data.bind_data->Cast<CrawlPlanBindData>();
+    auto &state = data.global_state->Cast<CrawlPlanGlobalState>();
+    if (!state.planned) {
+        state.planned = true;
+        state.hosts = BuildCrawlPlan(context, plan_data);
+    }
+    idx_t count = 0;
+    while (state.offset < state.hosts.size() && count < STANDARD_VECTOR_SIZE) {
+        auto &host = state.hosts[state.offset++];
+        output.SetValue(0, count, host.host.empty() ? Value() : Value(host.host));
+        output.SetValue(1, count, Value::BIGINT(host.urls));
+        output.SetValue(2, count, Value::BIGINT(host.to_fetch));
+        output.SetValue(3, count, Value::BIGINT(host.cached));
+        output.SetValue(4, count, Value::BIGINT(host.skipped));
+        output.SetValue(5, count, Value::BIGINT(host.disallowed));
+        output.SetValue(6, count, Value(host.robots));
+        output.SetValue(7, count, Value::DOUBLE(host.delay_s));
+        output.SetValue(8, count, Value::DOUBLE(host.MinDurationSeconds()));
+        count++;
+    }
+    output.SetCardinality(count);
+}
+
 //===--------------------------------------------------------------------===//
 // Register Function
 //===--------------------------------------------------------------------===//
@@ -1128,26 +2329,73 @@ void RegisterCrawlTableFunction(ExtensionLoader &loader) {
         func.named_parameters["cache"] = LogicalType::BOOLEAN;
         func.named_parameters["cache_ttl"] = LogicalType::INTEGER;
         func.named_parameters["max_results"] = LogicalType::BIGINT;
+        func.named_parameters["offline"] = LogicalType::BOOLEAN;
+        func.named_parameters["priority"] = LogicalType::VARCHAR;
+        func.named_parameters["sample_rate"] = LogicalType::DOUBLE;
+        func.named_parameters["sample_per_host"] = LogicalType::BIGINT;
+        func.named_parameters["dedupe"] = LogicalType::BOOLEAN;
+        func.named_parameters["store_body"] = LogicalType::VARCHAR;
+        func.named_parameters["soft_404"] = LogicalType::VARCHAR;
+        func.named_parameters["language"] = LogicalType::BOOLEAN;
+        func.named_parameters["skip_bloom"] = LogicalType::BLOB;
     };
 
     // crawl() with URL list (batch mode)
     TableFunction list_func("crawl",
                             {LogicalType::LIST(LogicalType::VARCHAR)},
-                            CrawlFunction, CrawlBind, CrawlInitGlobal);
+                            CrawlFunction, CrawlBind, CrawlInitGlobal, CrawlInitLocal);
     list_func.cardinality = CrawlCardinality;  // Enable LIMIT pushdown detection
+    list_func.table_scan_progress = CrawlProgressCallback;
     add_params(list_func);
 
     // crawl() with single URL (also batch mode, no LATERAL)
     TableFunction single_func("crawl",
                               {LogicalType::VARCHAR},
-                              CrawlFunction, CrawlBind, CrawlInitGlobal);
+                              CrawlFunction, CrawlBind, CrawlInitGlobal, CrawlInitLocal);
     single_func.cardinality = CrawlCardinality;  // Enable LIMIT pushdown detection
+    single_func.table_scan_progress = CrawlProgressCallback;
     add_params(single_func);
 
+    // crawl() with request specs: LIST(STRUCT(url, method, headers, body))
+    TableFunction request_func("crawl",
+                               {LogicalType::LIST(CrawlRequestSpecType())},
+                               CrawlFunction, CrawlBind, CrawlInitGlobal, CrawlInitLocal);
+    request_func.cardinality = CrawlCardinality;
+    request_func.table_scan_progress = CrawlProgressCallback;
+    add_params(request_func);
+
     TableFunctionSet crawl_set("crawl");
     crawl_set.AddFunction(list_func);
     crawl_set.AddFunction(single_func);
+    crawl_set.AddFunction(request_func);
     loader.RegisterFunction(crawl_set);
+
+    // crawl_range(template, start [, end]) - {n} = start..end, or up to the last live ID
+    TableFunctionSet range_set("crawl_range");
+    for (idx_t arg_count = 2; arg_count <= 3; arg_count++) {
+        vector<LogicalType> args = {LogicalType::VARCHAR, LogicalType::BIGINT};
+        if (arg_count == 3) {
+            args.push_back(LogicalType::BIGINT);
+        }
+        TableFunction range_func("crawl_range", args, CrawlFunction, CrawlRangeBind, CrawlInitGlobal,
+                                 CrawlInitLocal);
+        range_func.cardinality = CrawlCardinality;
+        range_func.table_scan_progress = CrawlProgressCallback;
+        add_params(range_func);
+        range_func.named_parameters["miss_window"] = LogicalType::INTEGER;
+        range_set.AddFunction(range_func);
+    }
+    loader.RegisterFunction(range_set);
+
+    // crawl_plan() - what crawl() with the same arguments would fetch, per host, without fetching
+    TableFunctionSet plan_set("crawl_plan");
+    for (auto &arg_type : {LogicalType::LIST(LogicalType::VARCHAR), LogicalType(LogicalType::VARCHAR)}) {
+        TableFunction plan_func("crawl_plan", {arg_type}, CrawlPlanFunction, CrawlPlanBind, CrawlPlanInitGlobal);
+        add_params(plan_func);
+        plan_func.named_parameters["robots_txt"] = LogicalType::MAP(LogicalType::VARCHAR, LogicalType::VARCHAR);
+        plan_set.AddFunction(plan_func);
+    }
+    loader.RegisterFunction(plan_set);
 }
 
 } // namespace duckdb
@@ -0,0 +1,350 @@
+// crawl_to_parquet() - crawl straight into Hive-partitioned Parquet files
+//
+// Usage:
+//   SELECT * FROM crawl_to_parquet(
+//       ['https://example.com/a', 'https://example.org/b'],
+//       'crawl_output/',
+//       max_file_size := 64 * 1024 * 1024
+//   )
+//
+// Output layout:
+//   crawl_output/domain=example.com/crawl_date=2025-01-14/part_<uuid>.parquet
+//
+// Fetching and writing overlap: the scan thread feeds Rust batch results to a
+// background writer thread, which buffers rows in a temp table and flushes them
+// with COPY ... (PARTITION_BY, APPEND) once roughly max_file_size bytes are
+// buffered. Files roll over at max_file_size within a flush.
+
+#include "crawl_to_parquet_function.hpp"
+#include "crawl_batch.hpp"
+#include "crawl_progress.hpp"
+#include "crawler_utils.hpp"
+#include "rust_ffi.hpp"
+#include "url_bloom_function.hpp"
+#include "write_behind_writer.hpp"
+
+#include "duckdb/function/table_function.hpp"
+#include "duckdb/main/connection.hpp"
+#include "duckdb/main/appender.hpp"
+#include "duckdb/common/string_util.hpp"
+#include "duckdb/common/types/timestamp.hpp"
+
+#include <algorithm>
+#include <atomic>
+
+namespace duckdb {
+
+static constexpr const char *PARQUET_BUFFER_TABLE = "__crawl_parquet_buffer";
+static constexpr idx_t PARQUET_SINK_MAX_PENDING_BATCHES = 4;
+
+//===--------------------------------------------------------------------===//
+// Background Parquet Writer
+//===--------------------------------------------------------------------===//
+
+class ParquetSinkWriter {
+public:
+	ParquetSinkWriter(DatabaseInstance &db, string path_p, idx_t max_file_bytes_p, string compression_p)
+	    : path(std::move(path_p)), max_file_bytes(max_file_bytes_p), compression(std::move(compression_p)),
+	      queue(
+	          db, "crawl_to_parquet", PARQUET_SINK_MAX_PENDING_BATCHES, 0,
+	          [this](Connection &conn, vector<CrawlBatchResult> &batch) { return WriteBatch(conn, batch); },
+	          [this](Connection &conn) { FinishBuffer(conn); }, [this]() { appender.reset(); }) {
+	}
+
+	// Hand a batch to the writer. Blocks while the writer is PARQUET_SINK_MAX_PENDING_BATCHES behind.
+	void Push(vector<CrawlBatchResult> batch) {
+		queue.Push(std::move(batch));
+	}
+
+	// Flush everything, stop the writer and surface any write error
+	void Finish() {
+		queue.Finish();
+	}
+
+	std::atomic<int64_t> rows_written {0};
+	std::atomic<int64_t> flushes {0};
+
+private:
+	idx_t WriteBatch(Connection &conn, vector<CrawlBatchResult> &batch) {
+		if (!appender) {
+			RunQuery(conn, "CREATE TEMP TABLE " + string(PARQUET_BUFFER_TABLE) +
+			                   " (url VARCHAR, final_url VARCHAR, status_code INTEGER, content_type VARCHAR, "
+			                   "body VARCHAR, error VARCHAR, elapsed_ms BIGINT, content_hash VARCHAR, "
+			                   "crawled_at TIMESTAMP, domain VARCHAR, crawl_date DATE)");
+			appender = make_uniq<Appender>(conn, PARQUET_BUFFER_TABLE);
+		}
+
+		auto now = Timestamp::GetCurrentTimestamp();
+		auto crawled_at = Value::TIMESTAMP(now);
+		auto crawl_date = Value::DATE(Timestamp::GetDate(now));
+		for (auto &result : batch) {
+			string domain = ExtractDomain(result.url);
+			appender->BeginRow();
+			appender->Append(Value(result.url));
+			appender->Append(result.final_url.empty() ? Value() : Value(result.final_url));
+			appender->Append(Value::INTEGER(result.status_code));
+			appender->Append(result.content_type.empty() ? Value() : Value(result.content_type));
+			appender->Append(result.has_body ? Value(result.body) : Value());
+			appender->Append(result.has_error ? Value(result.error) : Value());
+			appender->Append(Value::BIGINT(result.elapsed_ms));
+			appender->Append(result.has_body ? Value(GenerateContentHash(result.body)) : Value());
+			appender->Append(crawled_at);
+			appender->Append(Value(domain.empty() ? "_unknown" : StringUtil::Lower(domain)));
+			appender->Append(crawl_date);
+			appender->EndRow();
+			buffered_rows++;
+			buffered_bytes += result.url.size() + result.body.size() + result.content_type.size() + 64;
+		}
+
+		if (buffered_bytes >= max_file_bytes) {
+			appender->Flush();
+			FlushToParquet(conn);
+		}
+		return batch.size();
+	}
+
+	void FinishBuffer(Connection &conn) {
+		if (!appender) {
+			return;
+		}
+		appender->Close();
+		appender.reset();
+		if (buffered_rows > 0) {
+			FlushToParquet(conn);
+		}
+	}
+
+	void FlushToParquet(Connection &conn) {
+		auto result = RunQuery(conn, "COPY " + string(PARQUET_BUFFER_TABLE) + " TO " + EscapeSqlString(path) +
+		                                 " (FORMAT parquet, PARTITION_BY (domain, crawl_date), APPEND, "
+		                                 "FILENAME_PATTERN 'part_{uuid}', FILE_SIZE_BYTES " +
+		                                 std::to_string(max_file_bytes) + ", COMPRESSION " + compression + ")");
+		auto chunk = result->Fetch();
+		if (chunk && chunk->size() > 0) {
+			rows_written.fetch_add(chunk->GetValue(0, 0).GetValue<int64_t>());
+		}
+		RunQuery(conn, "DELETE FROM " + string(PARQUET_BUFFER_TABLE));
+		flushes.fetch_add(1);
+		buffered_rows = 0;
+		buffered_bytes = 0;
+	}
+
+	static unique_ptr<MaterializedQueryResult> RunQuery(Connection &conn, const string &sql) {
+		auto result = conn.Query(sql);
+		if (result->HasError()) {
+			throw IOException(result->GetError());
+		}
+		return result;
+	}
+
+	string path;
+	idx_t max_file_bytes;
+	string compression;
+
+	// Writer thread state; the appender is released on the writer thread before its connection
+	unique_ptr<Appender> appender;
+	idx_t buffered_rows = 0;
+	idx_t buffered_bytes = 0;
+	WriteBehindWriter<vector<CrawlBatchResult>> queue;
+};
+
+//===--------------------------------------------------------------------===//
+// Bind Data
+//===--------------------------------------------------------------------===//
+
+struct CrawlToParquetBindData : public TableFunctionData {
+	vector<string> urls;
+	string path;
+	idx_t max_file_bytes = 64 * 1024 * 1024;
+	string compression = "zstd";
+	CrawlBatchOptions options;
+};
+
+struct CrawlToParquetGlobalState : public GlobalTableFunctionState {
+	bool finished = false;
+
+	// Counts for the progress bar and crawl_progress()
+	shared_ptr<CrawlProgress> progress;
+
+	idx_t MaxThreads() const override {
+		return 1;
+	}
+};
+
+//===--------------------------------------------------------------------===//
+// Bind Function
+//===--------------------------------------------------------------------===//
+
+static unique_ptr<FunctionData> CrawlToParquetBind(ClientContext &context, TableFunctionBindInput &input,
+                                                   vector<LogicalType> &return_types, vector<string> &names) {
+	auto bind_data = make_uniq<CrawlToParquetBindData>();
+	LoadCrawlBatchSettings(context, bind_data->options);
+
+	auto &first_arg = input.inputs[0];
+	if (first_arg.type().id() == LogicalTypeId::LIST) {
+		for (auto &url_val : ListValue::GetChildren(first_arg)) {
+			if (!url_val.IsNull()) {
+				bind_data->urls.push_back(StringValue::Get(url_val));
+			}
+		}
+	} else if (!first_arg.IsNull()) {
+		bind_data->urls.push_back(StringValue::Get(first_arg));
+	}
+
+	if (input.inputs[1].IsNull() || StringValue::Get(input.inputs[1]).empty()) {
+		throw BinderException("crawl_to_parquet: output path must not be empty");
+	}
+	bind_data->path = StringValue::Get(input.inputs[1]);
+
+	for (auto &kv : input.named_parameters) {
+		if (kv.first == "user_agent") {
+			bind_data->options.user_agent = StringValue::Get(kv.second);
+		} else if (kv.first == "timeout") {
+			bind_data->options.timeout_ms = kv.second.GetValue<int>() * 1000;
+		} else if (kv.first == "workers") {
+			bind_data->options.concurrency = kv.second.GetValue<int>();
+		} else if (kv.first == "batch_size") {
+			bind_data->options.batch_size = MaxValue<int>(1, kv.second.GetValue<int>());
+		} else if (kv.first == "delay") {
+			bind_data->options.delay_ms = kv.second.GetValue<int>();
+		} else if (kv.first == "dedupe") {
+			bind_data->options.dedupe = kv.second.GetValue<bool>();
+		} else if (kv.first == "respect_robots") {
+			bind_data->options.respect_robots = kv.second.GetValue<bool>();
+		} else if (kv.first == "max_file_size") {
+			auto bytes = kv.second.GetValue<int64_t>();
+			if (bytes <= 0) {
+				throw BinderException("crawl_to_parquet: max_file_size must be positive");
+			}
+			bind_data->max_file_bytes = static_cast<idx_t>(bytes);
+		} else if (kv.first == "compression") {
+			bind_data->compression = StringUtil::Lower(StringValue::Get(kv.second));
+			if (bind_data->compression != "zstd" && bind_data->compression != "snappy" &&
+			    bind_data->compression != "gzip" && bind_data->compression != "uncompressed") {
+				throw BinderException("crawl_to_parquet: unsupported compression '%s'", bind_data->compression);
+			}
+		} else if (kv.first == "skip_bloom" && !kv.second.IsNull()) {
+			auto filter_blob = StringValue::Get(kv.second);
+			if (!UrlBloomFilter::IsFilter(filter_blob)) {
+				throw BinderException("crawl_to_parquet: skip_bloom must be a url_bloom_agg() filter");
+			}
+			UrlBloomFilter skip(filter_blob.data(), filter_blob.size());
+			auto &urls = bind_data->urls;
+			urls.erase(std::remove_if(urls.begin(), urls.end(), [&](const string &url) { return skip.Contains(url); }),
+			           urls.end());
+		}
+	}
+
+	return_types.push_back(LogicalType::VARCHAR);
+	names.push_back("path");
+	return_types.push_back(LogicalType::BIGINT);
+	names.push_back("pages_written");
+	return_types.push_back(LogicalType::BIGINT);
+	names.push_back("flushes");
+
+	return std::move(bind_data);
+}
+
+static unique_ptr<GlobalTableFunctionState> CrawlToParquetInitGlobal(ClientContext &context,
+                                                                     TableFunctionInitInput &input) {
+	auto &bind_data = input.bind_data->Cast<CrawlToParquetBindData>();
+	auto state = make_uniq<CrawlToParquetGlobalState>();
+	state->progress = RegisterCrawlProgress(context, "crawl_to_parquet");
+	state->progress->queued = NumericCast<int64_t>(bind_data.urls.size());
+	return std::move(state);
+}
+
+//===--------------------------------------------------------------------===//
+// Main Function
+//===--------------------------------------------------------------------===//
+
+static void CrawlToParquetFunction(ClientContext &context, TableFunctionInput &data, DataChunk &output) {
+	auto &bind_data = data.bind_data->Cast<CrawlToParquetBindData>();
+	auto &state = data.global_state->Cast<CrawlToParquetGlobalState>();
+
+	if (state.finished) {
+		output.SetCardinality(0);
+		return;
+	}
+
+	ParquetSinkWriter writer(*context.db, bind_data.path, bind_data.max_file_bytes, bind_data.compression);
+	CrawlBatchDedupe dedupe(context, bind_data.options.dedupe);
+
+	idx_t batch_size = static_cast<idx_t>(bind_data.options.batch_size);
+	for (idx_t start = 0; start < bind_data.urls.size(); start += batch_size) {
+		if (IsInterrupted()) {
+			break;
+		}
+		idx_t end = MinValue<idx_t>(start + batch_size, bind_data.urls.size());
+		vector<string> batch(bind_data.urls.begin() + start, bind_data.urls.begin() + end);
+		state.progress->queued -= NumericCast<int64_t>(batch.size());
+		// Variants of pages written by earlier batches are not fetched
+		state.progress->Complete(NumericCast<int64_t>(dedupe.SkipSeenUrls(batch)));
+		if (batch.empty()) {
+			continue;
+		}
+		auto batch_rows = NumericCast<int64_t>(batch.size());
+		state.progress->in_flight += batch_rows;
+
+		string response_json = CrawlBatchWithBackend(bind_data.options.fetch_backend,
+		                                             BuildCrawlBatchRequest(bind_data.options, batch));
+		auto results = ParseCrawlBatchResponse(response_json);
+		dedupe.CollapseDuplicates(results);
+		CompactCrawlBatchBodies(results, bind_data.options.store_body);
+		writer.Push(std::move(results));
+		state.progress->Complete(batch_rows, true);
+	}
+	// Interrupted: the rest is never fetched
+	state.progress->queued = 0;
+	writer.Finish();
+
+	state.finished = true;
+	output.SetValue(0, 0, Value(bind_data.path));
+	output.SetValue(1, 0, Value::BIGINT(writer.rows_written.load()));
+	output.SetValue(2, 0, Value::BIGINT(writer.flushes.load()));
+	output.SetCardinality(1);
+}
+
+static double CrawlToParquetProgress(ClientContext &context, const FunctionData *bind_data_p,
+                                     const GlobalTableFunctionState *gstate_p) {
+	if (!gstate_p) {
+		return -1.0;
+	}
+	return CrawlProgressPercentage(gstate_p->Cast<CrawlToParquetGlobalState>().progress);
+}
+
+//===--------------------------------------------------------------------===//
+// Register Function
+//===--------------------------------------------------------------------===//
+
+void RegisterCrawlToParquetFunction(ExtensionLoader &loader) {
+	auto add_params = [](TableFunction &func) {
+		func.named_parameters["user_agent"] = LogicalType::VARCHAR;
+		func.named_parameters["timeout"] = LogicalType::INTEGER;
+		func.named_parameters["workers"] = LogicalType::INTEGER;
+		func.named_parameters["batch_size"] = LogicalType::INTEGER;
+		func.named_parameters["delay"] = LogicalType::INTEGER;
+		func.named_parameters["respect_robots"] = LogicalType::BOOLEAN;
+		func.named_parameters["dedupe"] = LogicalType::BOOLEAN;
+		func.named_parameters["max_file_size"] = LogicalType::BIGINT;
+		func.named_parameters["compression"] = LogicalType::VARCHAR;
+		func.named_parameters["skip_bloom"] = LogicalType::BLOB;
+		func.table_scan_progress = CrawlToParquetProgress;
+	};
+
+	TableFunctionSet set("crawl_to_parquet");
+
+	TableFunction list_func({LogicalType::LIST(LogicalType::VARCHAR), LogicalType::VARCHAR},
+	                        CrawlToParquetFunction, CrawlToParquetBind, CrawlToParquetInitGlobal);
+	add_params(list_func);
+	set.AddFunction(list_func);
+
+	TableFunction single_func({LogicalType::VARCHAR, LogicalType::VARCHAR},
+	                          CrawlToParquetFunction, CrawlToParquetBind, CrawlToParquetInitGlobal);
+	add_params(single_func);
+	set.AddFunction(single_func);
+
+	loader.RegisterFunction(set);
+}
+
+} // namespace duckdb
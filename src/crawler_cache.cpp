@@ -0,0 +1,941 @@
+// __crawler_cache - bounded HTTP response cache
+//
+// Every fetched response is cached by URL. The cache is bounded by two settings:
+//
+//   SET crawler_cache_max_bytes = 512 * 1024 * 1024;   -- LRU by last access
+//   SET crawler_cache_max_age = INTERVAL '7 days';      -- by fetch time
+//
+// Eviction is incremental: stores keep a running byte total and only run an
+// eviction pass when it crosses max_bytes (evicting down to 90% so passes are
+// amortized) or every CACHE_AGE_SWEEP_INTERVAL stores when max_age is set. A
+// pass deletes CACHE_EVICT_BATCH entries at a time, least recently used first
+// (a top-N scan over last_accessed), and releases the cache lock between
+// batches. last_accessed is deliberately not indexed: DuckDB does not use an
+// ART index for ORDER BY ... LIMIT, and the index would make every touch UPDATE
+// more expensive. Hits are collected in memory and stamped into last_accessed
+// every CACHE_TOUCH_BATCH hits or CACHE_TOUCH_FLUSH_MICROS, so a cache hit stays
+// a single primary-key lookup.
+//
+//   SELECT * FROM crawler_cache_vacuum();
+//
+// applies the policy immediately, rewrites the table to drop deleted rows and
+// checkpoints, reporting what was evicted and how much storage was reclaimed.
+//
+// SET crawler_cache_keep_versions = n keeps the previous n versions of each
+// URL in __crawler_cache_versions (read them with crawler_cache_history()).
+// With n > 0 (and only then) bodies are delta-encoded: the first version of a
+// URL becomes a base in __crawler_cache_base and later versions are zstd
+// frames using the base as dictionary. Every delta is against a base, never against another delta, so
+// a read is one decode. A new base is started when a delta stops paying off or
+// after CACHE_DELTA_REBASE_VERSIONS versions; old bases are dropped once no
+// kept version refers to them. SET crawler_cache_delta = false keeps full
+// bodies instead.
+//
+// SET crawler_cache_dir = '/path' moves lookups and stores to a directory
+// shared across databases (crawler_cache_dir.cpp); the bounds above only apply
+// to the table, and crawler_cache_vacuum() compacts the directory instead.
+
+#include "crawler_cache.hpp"
+#include "crawler_cache_dir.hpp"
+#include "crawler_utils.hpp"
+
+#include "duckdb/function/table_function.hpp"
+#include "duckdb/main/appender.hpp"
+#include "duckdb/main/database.hpp"
+#include "duckdb/common/types/interval.hpp"
+#include "duckdb/common/types/timestamp.hpp"
+
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace duckdb {
+
+// Stores between max_age sweeps when the byte bound has not been hit
+static constexpr idx_t CACHE_AGE_SWEEP_INTERVAL = 256;
+// Bound on remembered hits between flushes
+static constexpr idx_t CACHE_MAX_PENDING_TOUCHES = 10000;
+// URLs per IN (...) list when stamping last_accessed; a full batch is flushed right away
+static constexpr idx_t CACHE_TOUCH_BATCH = 1000;
+// Remembered hits are stamped at least this often while lookups run
+static constexpr int64_t CACHE_TOUCH_FLUSH_MICROS = 10 * Interval::MICROS_PER_SEC;
+// Entries deleted per eviction step; the cache lock is released between steps
+static constexpr idx_t CACHE_EVICT_BATCH = 512;
+// Smaller bodies are kept inline: a base would not pay for itself
+static constexpr idx_t CACHE_DELTA_MIN_BODY = 1024;
+// Start a new base when a delta is larger than this fraction of the body
+static constexpr double CACHE_DELTA_MAX_RATIO = 0.5;
+// Start a new base after this many deltas so the base tracks the page
+static constexpr int32_t CACHE_DELTA_REBASE_VERSIONS = 30;
+
+static constexpr const char *CRAWLER_CACHE_VERSIONS_TABLE = "__crawler_cache_versions";
+static constexpr const char *CRAWLER_CACHE_BASE_TABLE = "__crawler_cache_base";
+// Index created by older versions on last_accessed; dropped on upgrade
+static constexpr const char *CRAWLER_CACHE_LRU_INDEX = "__crawler_cache_last_accessed";
+
+//===--------------------------------------------------------------------===//
+// Per-database cache state
+//===--------------------------------------------------------------------===//
+
+struct CrawlerCacheState {
+	std::mutex lock;
+	weak_ptr<DatabaseInstance> db;
+
+	bool table_ready = false;
+	bool bytes_known = false;
+	int64_t total_bytes = 0;
+	idx_t stores_since_sweep = 0;
+	// An eviction pass is running (it releases lock between batches)
+	bool evicting = false;
+	std::unordered_set<string> touched;
+	int64_t last_touch_flush = 0;
+};
+
+// Keyed by database instance pointer (same scheme as the pipeline state registry)
+static std::mutex g_cache_states_mutex;
+static std::unordered_map<uintptr_t, shared_ptr<CrawlerCacheState>> g_cache_states;
+
+static shared_ptr<CrawlerCacheState> GetCacheState(DatabaseInstance &db) {
+	uintptr_t key = reinterpret_cast<uintptr_t>(&db);
+	std::lock_guard<std::mutex> guard(g_cache_states_mutex);
+	auto &state = g_cache_states[key];
+	if (!state || state->db.expired()) {
+		// First use, or a new database reusing the address of a closed one
+		state = make_shared_ptr<CrawlerCacheState>();
+		state->db = db.shared_from_this();
+	}
+	return state;
+}
+
+static int64_t EntryBytes(const CrawlerCacheEntry &entry) {
+	return static_cast<int64_t>(entry.url.size() + entry.content_type.size() + entry.body.size() +
+	                            entry.error.size());
+}
+
+//===--------------------------------------------------------------------===//
+// Tables
+//===--------------------------------------------------------------------===//
+
+// body_encoding: NULL = body inline, 'base' = body is base base_id, 'delta' = body_delta against base base_id
+static string CacheTableDDL(const string &table_name) {
+	return "CREATE TABLE IF NOT EXISTS " + table_name + " ("
+	       "url VARCHAR PRIMARY KEY, "
+	       "status_code INTEGER, "
+	       "content_type VARCHAR, "
+	       "body VARCHAR, "
+	       "error VARCHAR, "
+	       "response_time_ms BIGINT, "
+	       "cached_at TIMESTAMP DEFAULT current_timestamp, "
+	       "last_accessed TIMESTAMP DEFAULT current_timestamp, "
+	       "body_bytes BIGINT DEFAULT 0, "
+	       "body_encoding VARCHAR, "
+	       "body_delta BLOB, "
+	       "base_id BIGINT)";
+}
+
+static const char *CACHE_COLUMNS = "url, status_code, content_type, body, error, response_time_ms, cached_at, "
+                                   "last_accessed, body_bytes, body_encoding, body_delta, base_id";
+
+// Previous versions, moved here from __crawler_cache when a URL is stored again
+static string CacheVersionsTableDDL(const string &table_name) {
+	return "CREATE TABLE IF NOT EXISTS " + table_name + " ("
+	       "url VARCHAR, "
+	       "status_code INTEGER, "
+	       "content_type VARCHAR, "
+	       "body VARCHAR, "
+	       "error VARCHAR, "
+	       "response_time_ms BIGINT, "
+	       "cached_at TIMESTAMP, "
+	       "body_bytes BIGINT DEFAULT 0, "
+	       "body_encoding VARCHAR, "
+	       "body_delta BLOB, "
+	       "base_id BIGINT)";
+}
+
+static const char *CACHE_VERSION_COLUMNS = "url, status_code, content_type, body, error, response_time_ms, cached_at, "
+                                           "body_bytes, body_encoding, body_delta, base_id";
+
+static string CacheBaseTableDDL(const string &table_name) {
+	return "CREATE TABLE IF NOT EXISTS " + table_name + " ("
+	       "url VARCHAR, "
+	       "base_id BIGINT, "
+	       "body VARCHAR, "
+	       "based_at TIMESTAMP DEFAULT current_timestamp, "
+	       "versions INTEGER DEFAULT 0, "
+	       "body_bytes BIGINT DEFAULT 0, "
+	       "PRIMARY KEY (url, base_id))";
+}
+
+static const char *CACHE_BASE_COLUMNS = "url, base_id, body, based_at, versions, body_bytes";
+
+static unique_ptr<MaterializedQueryResult> RunCacheQuery(Connection &conn, const string &sql) {
+	auto result = conn.Query(sql);
+	if (result->HasError()) {
+		throw IOException("crawler cache: " + result->GetError());
+	}
+	return result;
+}
+
+static int64_t QueryInt(Connection &conn, const string &sql) {
+	auto result = RunCacheQuery(conn, sql);
+	auto chunk = result->Fetch();
+	if (!chunk || chunk->size() == 0 || chunk->GetValue(0, 0).IsNull()) {
+		return 0;
+	}
+	return chunk->GetValue(0, 0).GetValue<int64_t>();
+}
+
+// Create the tables, or upgrade a cache created by an older version. Caller holds state.lock.
+static void EnsureCacheTableLocked(Connection &conn, CrawlerCacheState &state) {
+	if (state.table_ready) {
+		return;
+	}
+	string table = CRAWLER_CACHE_TABLE;
+	RunCacheQuery(conn, CacheTableDDL(table));
+	RunCacheQuery(conn, CacheVersionsTableDDL(CRAWLER_CACHE_VERSIONS_TABLE));
+	RunCacheQuery(conn, CacheBaseTableDDL(CRAWLER_CACHE_BASE_TABLE));
+
+	auto columns = QueryInt(conn, "SELECT count(*) FROM information_schema.columns WHERE table_name = '" + table +
+	                                  "' AND column_name IN ('last_accessed', 'body_bytes', 'body_encoding', "
+	                                  "'body_delta', 'base_id')");
+	if (columns < 5) {
+		RunCacheQuery(conn, "ALTER TABLE " + table + " ADD COLUMN IF NOT EXISTS last_accessed TIMESTAMP");
+		RunCacheQuery(conn, "ALTER TABLE " + table + " ADD COLUMN IF NOT EXISTS body_bytes BIGINT");
+		RunCacheQuery(conn, "ALTER TABLE " + table + " ADD COLUMN IF NOT EXISTS body_encoding VARCHAR");
+		RunCacheQuery(conn, "ALTER TABLE " + table + " ADD COLUMN IF NOT EXISTS body_delta BLOB");
+		RunCacheQuery(conn, "ALTER TABLE " + table + " ADD COLUMN IF NOT EXISTS base_id BIGINT");
+		RunCacheQuery(conn, "UPDATE " + table +
+		                        " SET last_accessed = coalesce(last_accessed, cached_at), "
+		                        "body_bytes = octet_length(encode(url)) + octet_length(encode(coalesce(content_type, ''))) + "
+		                        "octet_length(encode(coalesce(body, ''))) + octet_length(encode(coalesce(error, ''))) "
+		                        "WHERE body_bytes IS NULL");
+	}
+	RunCacheQuery(conn, "DROP INDEX IF EXISTS " + string(CRAWLER_CACHE_LRU_INDEX));
+	state.table_ready = true;
+	state.bytes_known = false;
+}
+
+// Stored bytes: entries, kept versions and bases
+static int64_t CacheTotalBytes(Connection &conn) {
+	return QueryInt(conn, "SELECT (SELECT coalesce(sum(body_bytes), 0) FROM " + string(CRAWLER_CACHE_TABLE) +
+	                          ") + (SELECT coalesce(sum(body_bytes), 0) FROM " + CRAWLER_CACHE_VERSIONS_TABLE +
+	                          ") + (SELECT coalesce(sum(body_bytes), 0) FROM " + CRAWLER_CACHE_BASE_TABLE + ")");
+}
+
+// Drop bases that neither the latest entry nor a kept version refers to. Returns the bytes freed.
+static int64_t DropUnusedBases(Connection &conn, const string &url_filter) {
+	string base = CRAWLER_CACHE_BASE_TABLE;
+	auto result = RunCacheQuery(conn, "DELETE FROM " + base + " b WHERE " + url_filter +
+	                                      "NOT EXISTS (SELECT 1 FROM " + string(CRAWLER_CACHE_TABLE) +
+	                                      " c WHERE c.url = b.url AND c.base_id = b.base_id) "
+	                                      "AND NOT EXISTS (SELECT 1 FROM " + string(CRAWLER_CACHE_VERSIONS_TABLE) +
+	                                      " v WHERE v.url = b.url AND v.base_id = b.base_id) RETURNING body_bytes");
+	int64_t bytes = 0;
+	while (auto chunk = result->Fetch()) {
+		for (idx_t row = 0; row < chunk->size(); row++) {
+			auto value = chunk->GetValue(0, row);
+			bytes += value.IsNull() ? 0 : value.GetValue<int64_t>();
+		}
+	}
+	return bytes;
+}
+
+// Reconstruct a stored body from its row (body, body_encoding, body_delta) and joined base body.
+// Returns false when the base is missing or the delta does not decode.
+static bool DecodeCachedBody(const Value &body, const Value &encoding, const Value &delta, const Value &base,
+                             string &result) {
+	if (encoding.IsNull()) {
+		result = body.IsNull() ? "" : StringValue::Get(body);
+		return true;
+	}
+	if (base.IsNull()) {
+		return false;
+	}
+	if (StringValue::Get(encoding) == "base") {
+		result = StringValue::Get(base);
+		return true;
+	}
+	return !delta.IsNull() && ZstdDeltaDecode(StringValue::Get(delta), StringValue::Get(base), result);
+}
+
+//===--------------------------------------------------------------------===//
+// Eviction
+//===--------------------------------------------------------------------===//
+
+struct CacheEvictionResult {
+	int64_t entries_evicted = 0;
+	int64_t bytes_evicted = 0;
+};
+
+// Quoted IN (...) list of urls[start, end)
+static string CacheUrlList(const vector<string> &urls, idx_t start, idx_t end) {
+	string url_list;
+	for (idx_t i = start; i < end; i++) {
+		if (i > start) url_list += ", ";
+		url_list += EscapeSqlString(urls[i]);
+	}
+	return url_list;
+}
+
+// Run a DELETE ... RETURNING body_bytes[, url] and sum what it removed, collecting the URLs
+static int64_t DeletedBytes(Connection &conn, const string &sql, std::unordered_set<string> *urls = nullptr) {
+	auto result = RunCacheQuery(conn, sql);
+	int64_t bytes = 0;
+	while (auto chunk = result->Fetch()) {
+		for (idx_t row = 0; row < chunk->size(); row++) {
+			auto value = chunk->GetValue(0, row);
+			bytes += value.IsNull() ? 0 : value.GetValue<int64_t>();
+			if (urls) {
+				urls->insert(chunk->GetValue(1, row).ToString());
+			}
+		}
+	}
+	return bytes;
+}
+
+// Stamp remembered hits into last_accessed. Caller holds state.lock.
+static void FlushTouchesLocked(Connection &conn, CrawlerCacheState &state) {
+	state.last_touch_flush = Timestamp::GetCurrentTimestamp().value;
+	if (state.touched.empty()) {
+		return;
+	}
+	vector<string> urls(state.touched.begin(), state.touched.end());
+	state.touched.clear();
+	for (idx_t start = 0; start < urls.size(); start += CACHE_TOUCH_BATCH) {
+		idx_t end = MinValue<idx_t>(start + CACHE_TOUCH_BATCH, urls.size());
+		RunCacheQuery(conn, "UPDATE " + string(CRAWLER_CACHE_TABLE) +
+		                        " SET last_accessed = current_timestamp WHERE url IN (" +
+		                        CacheUrlList(urls, start, end) + ")");
+	}
+}
+
+// Delete entries with their kept versions and bases in one transaction. Returns the bytes freed.
+static int64_t DeleteCacheUrls(Connection &conn, const vector<string> &urls) {
+	if (urls.empty()) {
+		return 0;
+	}
+	string url_list = CacheUrlList(urls, 0, urls.size());
+	int64_t bytes = 0;
+	conn.BeginTransaction();
+	try {
+		bytes += DeletedBytes(conn, "DELETE FROM " + string(CRAWLER_CACHE_VERSIONS_TABLE) + " WHERE url IN (" +
+		                                url_list + ") RETURNING body_bytes");
+		bytes += DeletedBytes(conn, "DELETE FROM " + string(CRAWLER_CACHE_BASE_TABLE) + " WHERE url IN (" +
+		                                url_list + ") RETURNING body_bytes");
+		bytes += DeletedBytes(conn, "DELETE FROM " + string(CRAWLER_CACHE_TABLE) + " WHERE url IN (" + url_list +
+		                                ") RETURNING body_bytes");
+		conn.Commit();
+	} catch (...) {
+		if (conn.HasActiveTransaction()) {
+			conn.Rollback();
+		}
+		throw;
+	}
+	return bytes;
+}
+
+static vector<string> QueryUrls(Connection &conn, const string &sql) {
+	vector<string> urls;
+	auto result = RunCacheQuery(conn, sql);
+	while (auto chunk = result->Fetch()) {
+		for (idx_t row = 0; row < chunk->size(); row++) {
+			urls.push_back(chunk->GetValue(0, row).ToString());
+		}
+	}
+	return urls;
+}
+
+// One bounded eviction step: at most CACHE_EVICT_BATCH entries (or expired versions).
+// Returns false when nothing was left to evict. Caller holds state.lock.
+static bool EvictBatchLocked(Connection &conn, CrawlerCacheState &state, const CrawlerCachePolicy &policy,
+                             CacheEvictionResult &result) {
+	string table = CRAWLER_CACHE_TABLE;
+	string versions = CRAWLER_CACHE_VERSIONS_TABLE;
+	string batch = std::to_string(CACHE_EVICT_BATCH);
+	int64_t freed = 0;
+	idx_t entries = 0;
+
+	if (policy.max_age_micros > 0) {
+		bool progress = false;
+		// Compared as TIMESTAMP so the filter is on the column itself
+		string cutoff = "(current_timestamp - to_microseconds(" + std::to_string(policy.max_age_micros) +
+		                "))::TIMESTAMP";
+		auto expired = QueryUrls(conn, "SELECT url FROM " + table + " WHERE cached_at < " + cutoff + " LIMIT " + batch);
+		if (!expired.empty()) {
+			entries = expired.size();
+			freed = DeleteCacheUrls(conn, expired);
+			progress = true;
+		} else {
+			// Expired versions of entries that are still fresh, then the bases only they used
+			std::unordered_set<string> version_urls;
+			freed = DeletedBytes(conn,
+			                     "DELETE FROM " + versions + " WHERE rowid IN (SELECT rowid FROM " + versions +
+			                         " WHERE cached_at < " + cutoff + " LIMIT " + batch + ") RETURNING body_bytes, url",
+			                     &version_urls);
+			if (!version_urls.empty()) {
+				vector<string> urls(version_urls.begin(), version_urls.end());
+				freed += DropUnusedBases(conn, "b.url IN (" + CacheUrlList(urls, 0, urls.size()) + ") AND ");
+				progress = true;
+			}
+		}
+		if (progress) {
+			result.entries_evicted += static_cast<int64_t>(entries);
+			result.bytes_evicted += freed;
+			state.total_bytes -= freed;
+			return true;
+		}
+	}
+
+	int64_t low_water = policy.max_bytes - policy.max_bytes / 10;
+	if (policy.max_bytes <= 0 || state.total_bytes <= low_water) {
+		return false;
+	}
+	// Least recently used first (top-N scan); take just enough to reach low water
+	vector<string> victims;
+	int64_t needed = state.total_bytes - low_water;
+	int64_t planned = 0;
+	auto candidates = RunCacheQuery(conn, "SELECT url, body_bytes FROM " + table +
+	                                          " ORDER BY last_accessed, cached_at LIMIT " + batch);
+	while (auto chunk = candidates->Fetch()) {
+		for (idx_t row = 0; row < chunk->size() && planned < needed; row++) {
+			victims.push_back(chunk->GetValue(0, row).ToString());
+			auto bytes = chunk->GetValue(1, row);
+			planned += bytes.IsNull() ? 0 : bytes.GetValue<int64_t>();
+		}
+	}
+	if (victims.empty()) {
+		// Only versions or bases are left: the estimate is off, recount on the next store
+		state.bytes_known = false;
+		return false;
+	}
+	freed = DeleteCacheUrls(conn, victims);
+	result.entries_evicted += static_cast<int64_t>(victims.size());
+	result.bytes_evicted += freed;
+	state.total_bytes -= freed;
+	return true;
+}
+
+// Apply max_age and max_bytes in bounded batches, releasing the cache lock between batches so
+// lookups and stores on other threads are not held up by a long pass. Only one pass runs at a
+// time; a store that finds a pass running leaves the work to it. guard holds state.lock.
+static CacheEvictionResult EvictLocked(Connection &conn, CrawlerCacheState &state, const CrawlerCachePolicy &policy,
+                                       std::unique_lock<std::mutex> &guard) {
+	CacheEvictionResult result;
+	if (state.evicting) {
+		return result;
+	}
+	state.evicting = true;
+	try {
+		// Recent hits must be stamped before least recently used entries are chosen
+		FlushTouchesLocked(conn, state);
+		if (!state.bytes_known) {
+			state.total_bytes = CacheTotalBytes(conn);
+			state.bytes_known = true;
+		}
+		while (EvictBatchLocked(conn, state, policy, result)) {
+			guard.unlock();
+			guard.lock();
+		}
+	} catch (...) {
+		state.evicting = false;
+		throw;
+	}
+	state.evicting = false;
+	state.stores_since_sweep = 0;
+	return result;
+}
+
+//===--------------------------------------------------------------------===//
+// Lookup / Store
+//===--------------------------------------------------------------------===//
+
+CrawlerCachePolicy LoadCrawlerCachePolicy(ClientContext &context) {
+	CrawlerCachePolicy policy;
+	Value setting_value;
+	if (context.TryGetCurrentSetting("crawler_cache_max_bytes", setting_value) && !setting_value.IsNull()) {
+		policy.max_bytes = MaxValue<int64_t>(0, setting_value.GetValue<int64_t>());
+	}
+	if (context.TryGetCurrentSetting("crawler_cache_max_age", setting_value) && !setting_value.IsNull()) {
+		policy.max_age_micros = MaxValue<int64_t>(0, Interval::GetMicro(IntervalValue::Get(setting_value)));
+	}
+	if (context.TryGetCurrentSetting("crawler_cache_keep_versions", setting_value) && !setting_value.IsNull()) {
+		policy.keep_versions = MaxValue<int64_t>(0, setting_value.GetValue<int64_t>());
+	}
+	if (context.TryGetCurrentSetting("crawler_cache_delta", setting_value) && !setting_value.IsNull()) {
+		policy.delta = setting_value.GetValue<bool>();
+	}
+	if (context.TryGetCurrentSetting("crawler_cache_dir", setting_value) && !setting_value.IsNull()) {
+		auto dir = setting_value.ToString();
+		if (!dir.empty()) {
+			policy.cache_dir = CrawlerCacheDir::Open(dir);
+		}
+	}
+	return policy;
+}
+
+vector<CrawlerCacheEntry> CrawlerCacheLookup(Connection &conn, const vector<string> &urls, int ttl_hours,
+                                             const CrawlerCachePolicy &policy) {
+	vector<CrawlerCacheEntry> cached;
+	if (urls.empty()) {
+		return cached;
+	}
+
+	if (policy.cache_dir) {
+		int64_t min_cached_at = ttl_hours < 0 ? NumericLimits<int64_t>::Minimum()
+		                                      : Timestamp::GetCurrentTimestamp().value -
+		                                            int64_t(ttl_hours) * Interval::MICROS_PER_HOUR;
+		for (auto &url : urls) {
+			CrawlerCacheEntry entry;
+			if (policy.cache_dir->Lookup(url, min_cached_at, entry)) {
+				cached.push_back(std::move(entry));
+			}
+		}
+		return cached;
+	}
+
+	auto state = GetCacheState(*conn.context->db);
+	{
+		std::lock_guard<std::mutex> guard(state->lock);
+		try {
+			EnsureCacheTableLocked(conn, *state);
+		} catch (std::exception &) {
+			return cached;
+		}
+	}
+
+	// Build IN clause with properly quoted URLs (single batch query instead of N queries)
+	string url_list;
+	for (size_t i = 0; i < urls.size(); i++) {
+		if (i > 0) url_list += ", ";
+		url_list += EscapeSqlString(urls[i]);
+	}
+	string sql = "SELECT c.url, c.status_code, c.content_type, c.body, c.error, c.response_time_ms, "
+	             "c.body_encoding, c.body_delta, b.body "
+	             "FROM " + string(CRAWLER_CACHE_TABLE) + " c "
+	             "LEFT JOIN " + string(CRAWLER_CACHE_BASE_TABLE) + " b ON b.url = c.url AND b.base_id = c.base_id "
+	             "WHERE c.url IN (" + url_list + ")";
+	if (ttl_hours >= 0) {
+		sql += " AND c.cached_at > current_timestamp - INTERVAL '" + std::to_string(ttl_hours) + " hours'";
+	}
+
+	auto result = conn.Query(sql);
+	if (result->HasError()) {
+		return cached;
+	}
+	while (auto chunk = result->Fetch()) {
+		for (idx_t row = 0; row < chunk->size(); row++) {
+			CrawlerCacheEntry entry;
+			// A body that cannot be reconstructed is a miss, never a corrupt hit
+			if (!DecodeCachedBody(chunk->GetValue(3, row), chunk->GetValue(6, row), chunk->GetValue(7, row),
+			                      chunk->GetValue(8, row), entry.body)) {
+				continue;
+			}
+			entry.url = chunk->GetValue(0, row).ToString();
+			entry.status_code = chunk->GetValue(1, row).GetValue<int>();
+			entry.content_type = chunk->GetValue(2, row).IsNull() ? "" : chunk->GetValue(2, row).ToString();
+			entry.error = chunk->GetValue(4, row).IsNull() ? "" : chunk->GetValue(4, row).ToString();
+			entry.response_time_ms = chunk->GetValue(5, row).IsNull() ? 0 : chunk->GetValue(5, row).GetValue<int64_t>();
+			cached.push_back(std::move(entry));
+		}
+	}
+
+	if (!cached.empty()) {
+		std::lock_guard<std::mutex> guard(state->lock);
+		for (auto &entry : cached) {
+			if (state->touched.size() >= CACHE_MAX_PENDING_TOUCHES) {
+				break;
+			}
+			state->touched.insert(entry.url);
+		}
+		// Stamp hits on a schedule, so the LRU order stays current between eviction passes
+		bool flush_due = state->touched.size() >= CACHE_TOUCH_BATCH ||
+		                 Timestamp::GetCurrentTimestamp().value - state->last_touch_flush >= CACHE_TOUCH_FLUSH_MICROS;
+		if (flush_due && !state->evicting) {
+			try {
+				FlushTouchesLocked(conn, *state);
+			} catch (std::exception &) {
+				// Best effort: the hits are stamped by a later flush or lost, never an error
+			}
+		}
+	}
+	return cached;
+}
+
+static constexpr const char *CACHE_PLAN_URLS_TABLE = "__crawler_cache_plan_urls";
+
+std::unordered_set<string> CrawlerCacheFreshUrls(Connection &conn, const vector<string> &urls, int ttl_hours,
+                                                 const CrawlerCachePolicy &policy) {
+	std::unordered_set<string> fresh;
+	if (urls.empty()) {
+		return fresh;
+	}
+
+	if (policy.cache_dir) {
+		int64_t min_cached_at = ttl_hours < 0 ? NumericLimits<int64_t>::Minimum()
+		                                      : Timestamp::GetCurrentTimestamp().value -
+		                                            int64_t(ttl_hours) * Interval::MICROS_PER_HOUR;
+		return policy.cache_dir->FreshUrls(urls, min_cached_at);
+	}
+
+	auto state = GetCacheState(*conn.context->db);
+	{
+		std::lock_guard<std::mutex> guard(state->lock);
+		try {
+			EnsureCacheTableLocked(conn, *state);
+		} catch (std::exception &) {
+			return fresh;
+		}
+	}
+
+	// Millions of URLs: append them to a temp table and let a hash semi-join find the cached ones
+	RunCacheQuery(conn, "CREATE OR REPLACE TEMP TABLE " + string(CACHE_PLAN_URLS_TABLE) + " (url VARCHAR)");
+	{
+		Appender appender(conn, CACHE_PLAN_URLS_TABLE);
+		for (auto &url : urls) {
+			appender.BeginRow();
+			appender.Append(string_t(url));
+			appender.EndRow();
+		}
+		appender.Close();
+	}
+	string sql = "SELECT p.url FROM " + string(CACHE_PLAN_URLS_TABLE) + " p WHERE p.url IN (SELECT c.url FROM " +
+	             string(CRAWLER_CACHE_TABLE) + " c";
+	if (ttl_hours >= 0) {
+		sql += " WHERE c.cached_at > current_timestamp - INTERVAL '" + std::to_string(ttl_hours) + " hours'";
+	}
+	sql += ")";
+	auto result = conn.Query(sql);
+	if (!result->HasError()) {
+		while (auto chunk = result->Fetch()) {
+			chunk->Flatten();
+			auto data = FlatVector::GetData<string_t>(chunk->data[0]);
+			for (idx_t row = 0; row < chunk->size(); row++) {
+				fresh.insert(data[row].GetString());
+			}
+		}
+	}
+	conn.Query("DROP TABLE IF EXISTS " + string(CACHE_PLAN_URLS_TABLE));
+	return fresh;
+}
+
+struct CacheBaseInfo {
+	int64_t base_id = -1;
+	string body;
+	int32_t versions = 0;
+};
+
+static bool LoadLatestBase(Connection &conn, const string &url, CacheBaseInfo &base) {
+	auto result = RunCacheQuery(conn, "SELECT base_id, body, versions FROM " + string(CRAWLER_CACHE_BASE_TABLE) +
+	                                      " WHERE url = " + EscapeSqlString(url) + " ORDER BY base_id DESC LIMIT 1");
+	auto chunk = result->Fetch();
+	if (!chunk || chunk->size() == 0 || chunk->GetValue(1, 0).IsNull()) {
+		return false;
+	}
+	base.base_id = chunk->GetValue(0, 0).GetValue<int64_t>();
+	base.body = StringValue::Get(chunk->GetValue(1, 0));
+	base.versions = chunk->GetValue(2, 0).IsNull() ? 0 : chunk->GetValue(2, 0).GetValue<int32_t>();
+	return true;
+}
+
+// Write entry as the URL's latest version, moving the previous one to the kept versions.
+// Runs inside the caller's transaction. Returns the net change in stored bytes.
+static int64_t WriteCacheEntry(Connection &conn, const CrawlerCacheEntry &entry, const CrawlerCachePolicy &policy) {
+	string table = CRAWLER_CACHE_TABLE;
+	string versions = CRAWLER_CACHE_VERSIONS_TABLE;
+	string base_table = CRAWLER_CACHE_BASE_TABLE;
+	string url = EscapeSqlString(entry.url);
+	bool keep = policy.keep_versions > 0;
+
+	// Bytes of the replaced entry and of dropped versions and bases
+	int64_t freed = 0;
+	if (keep) {
+		RunCacheQuery(conn, "INSERT INTO " + versions + " (" + CACHE_VERSION_COLUMNS + ") SELECT " +
+		                        CACHE_VERSION_COLUMNS + " FROM " + table + " WHERE url = " + url);
+		freed += DeletedBytes(conn, "DELETE FROM " + versions + " WHERE url = " + url +
+		                                " AND rowid NOT IN (SELECT rowid FROM " + versions + " WHERE url = " + url +
+		                                " ORDER BY cached_at DESC LIMIT " + std::to_string(policy.keep_versions) +
+		                                ") RETURNING body_bytes");
+	} else {
+		freed += QueryInt(conn, "SELECT body_bytes FROM " + table + " WHERE url = " + url);
+	}
+
+	// Encode against the URL's latest base, or start a new base with this body
+	string encoding;
+	string delta;
+	int64_t base_id = -1;
+	int64_t stored_body_bytes = static_cast<int64_t>(entry.body.size());
+	int64_t added_base_bytes = 0;
+	if (keep && policy.delta && entry.body.size() >= CACHE_DELTA_MIN_BODY) {
+		CacheBaseInfo base;
+		bool has_base = LoadLatestBase(conn, entry.url, base);
+		if (has_base && base.versions < CACHE_DELTA_REBASE_VERSIONS) {
+			delta = ZstdDeltaEncode(entry.body, base.body);
+			if (!delta.empty() && static_cast<double>(delta.size()) <=
+			                          static_cast<double>(entry.body.size()) * CACHE_DELTA_MAX_RATIO) {
+				encoding = "delta";
+				base_id = base.base_id;
+				stored_body_bytes = static_cast<int64_t>(delta.size());
+				RunCacheQuery(conn, "UPDATE " + base_table + " SET versions = versions + 1 WHERE url = " + url +
+				                        " AND base_id = " + std::to_string(base_id));
+			}
+		}
+		if (encoding.empty()) {
+			encoding = "base";
+			base_id = has_base ? base.base_id + 1 : 0;
+			stored_body_bytes = 0;
+			added_base_bytes = static_cast<int64_t>(entry.body.size());
+			auto result = conn.Query("INSERT INTO " + base_table + " (" + CACHE_BASE_COLUMNS +
+			                             ") VALUES ($1, $2, $3, current_timestamp, 0, $4)",
+			                         entry.url, Value::BIGINT(base_id), entry.body, Value::BIGINT(added_base_bytes));
+			if (result->HasError()) {
+				throw IOException("crawler cache: " + result->GetError());
+			}
+		}
+	}
+
+	int64_t bytes = EntryBytes(entry) - static_cast<int64_t>(entry.body.size()) + stored_body_bytes;
+	auto result = conn.Query(
+	    "INSERT OR REPLACE INTO " + table + " (" + CACHE_COLUMNS +
+	        ") VALUES ($1, $2, $3, $4, $5, $6, current_timestamp, current_timestamp, $7, $8, $9, $10)",
+	    entry.url, entry.status_code, entry.content_type.empty() ? Value() : Value(entry.content_type),
+	    entry.body.empty() || !encoding.empty() ? Value() : Value(entry.body),
+	    entry.error.empty() ? Value() : Value(entry.error), entry.response_time_ms, Value::BIGINT(bytes),
+	    encoding.empty() ? Value() : Value(encoding),
+	    encoding == "delta" ? Value::BLOB_RAW(delta) : Value(LogicalType::BLOB),
+	    base_id < 0 ? Value(LogicalType::BIGINT) : Value::BIGINT(base_id));
+	if (result->HasError()) {
+		throw IOException("crawler cache: " + result->GetError());
+	}
+
+	if (keep) {
+		freed += DropUnusedBases(conn, "b.url = " + url + " AND ");
+	}
+	return bytes + added_base_bytes - freed;
+}
+
+void CrawlerCacheStore(Connection &conn, const CrawlerCacheEntry &entry, const CrawlerCachePolicy &policy) {
+	if (policy.cache_dir) {
+		policy.cache_dir->Store(entry);
+		return;
+	}
+
+	auto state = GetCacheState(*conn.context->db);
+	std::unique_lock<std::mutex> guard(state->lock);
+	try {
+		EnsureCacheTableLocked(conn, *state);
+
+		int64_t bytes;
+		conn.BeginTransaction();
+		try {
+			bytes = WriteCacheEntry(conn, entry, policy);
+			conn.Commit();
+		} catch (...) {
+			if (conn.HasActiveTransaction()) {
+				conn.Rollback();
+			}
+			throw;
+		}
+
+		// Running total: WriteCacheEntry returns the net change, eviction subtracts what it deletes
+		if (!state->bytes_known) {
+			state->total_bytes = CacheTotalBytes(conn);
+			state->bytes_known = true;
+		} else {
+			state->total_bytes += bytes;
+		}
+		state->stores_since_sweep++;
+
+		bool over_budget = policy.max_bytes > 0 && state->total_bytes > policy.max_bytes;
+		bool sweep_due = policy.max_age_micros > 0 && state->stores_since_sweep >= CACHE_AGE_SWEEP_INTERVAL;
+		if (over_budget || sweep_due) {
+			EvictLocked(conn, *state, policy, guard);
+		}
+	} catch (std::exception &) {
+		// Caching is best effort and must never fail the crawl
+		state->table_ready = false;
+	}
+}
+
+//===--------------------------------------------------------------------===//
+// crawler_cache_history([url])
+//===--------------------------------------------------------------------===//
+
+struct CrawlerCacheHistoryBindData : public TableFunctionData {
+	string url; // empty = all URLs
+};
+
+struct CrawlerCacheHistoryGlobalState : public GlobalTableFunctionState {
+	unique_ptr<Connection> conn;
+	unique_ptr<MaterializedQueryResult> result;
+};
+
+static unique_ptr<FunctionData> CrawlerCacheHistoryBind(ClientContext &context, TableFunctionBindInput &input,
+                                                        vector<LogicalType> &return_types, vector<string> &names) {
+	auto bind_data = make_uniq<CrawlerCacheHistoryBindData>();
+	if (!input.inputs.empty() && !input.inputs[0].IsNull()) {
+		bind_data->url = StringValue::Get(input.inputs[0]);
+	}
+	names = {"url", "cached_at", "is_latest", "status_code", "content_type", "body", "error"};
+	return_types = {LogicalType::VARCHAR, LogicalType::TIMESTAMP, LogicalType::BOOLEAN, LogicalType::INTEGER,
+	                LogicalType::VARCHAR, LogicalType::VARCHAR,   LogicalType::VARCHAR};
+	return std::move(bind_data);
+}
+
+static unique_ptr<GlobalTableFunctionState> CrawlerCacheHistoryInitGlobal(ClientContext &context,
+                                                                          TableFunctionInitInput &input) {
+	auto &bind_data = input.bind_data->Cast<CrawlerCacheHistoryBindData>();
+	auto gstate = make_uniq<CrawlerCacheHistoryGlobalState>();
+	gstate->conn = make_uniq<Connection>(*context.db);
+	auto state = GetCacheState(*context.db);
+	{
+		std::lock_guard<std::mutex> guard(state->lock);
+		EnsureCacheTableLocked(*gstate->conn, *state);
+	}
+
+	string filter = bind_data.url.empty() ? "" : " WHERE url = " + EscapeSqlString(bind_data.url);
+	string columns = "url, cached_at, status_code, content_type, body, error, body_encoding, body_delta, base_id";
+	gstate->result = RunCacheQuery(
+	    *gstate->conn, "SELECT h.url, h.cached_at, h.is_latest, h.status_code, h.content_type, h.body, h.error, "
+	                   "h.body_encoding, h.body_delta, b.body FROM ("
+	                   "SELECT " + columns + ", true AS is_latest FROM " + string(CRAWLER_CACHE_TABLE) + filter +
+	                   " UNION ALL SELECT " + columns + ", false FROM " + CRAWLER_CACHE_VERSIONS_TABLE + filter +
+	                   ") h LEFT JOIN " + CRAWLER_CACHE_BASE_TABLE + " b ON b.url = h.url AND b.base_id = h.base_id "
+	                   "ORDER BY h.url, h.cached_at DESC");
+	return std::move(gstate);
+}
+
+static void CrawlerCacheHistoryFunction(ClientContext &context, TableFunctionInput &data, DataChunk &output) {
+	auto &gstate = data.global_state->Cast<CrawlerCacheHistoryGlobalState>();
+	auto chunk = gstate.result->Fetch();
+	if (!chunk) {
+		output.SetCardinality(0);
+		return;
+	}
+	for (idx_t row = 0; row < chunk->size(); row++) {
+		for (idx_t col = 0; col < 7; col++) {
+			if (col != 5) {
+				output.SetValue(col, row, chunk->GetValue(col, row));
+			}
+		}
+		string body;
+		bool decoded = DecodeCachedBody(chunk->GetValue(5, row), chunk->GetValue(7, row), chunk->GetValue(8, row),
+		                                chunk->GetValue(9, row), body);
+		output.SetValue(5, row, decoded && !body.empty() ? Value(body) : Value());
+	}
+	output.SetCardinality(chunk->size());
+}
+
+//===--------------------------------------------------------------------===//
+// crawler_cache_vacuum()
+//===--------------------------------------------------------------------===//
+
+struct CrawlerCacheVacuumGlobalState : public GlobalTableFunctionState {
+	bool finished = false;
+};
+
+static int64_t DatabaseStorageBytes(Connection &conn) {
+	return QueryInt(conn, "SELECT coalesce(used_blocks * block_size, 0) FROM pragma_database_size() "
+	                      "WHERE database_name = current_database()");
+}
+
+static void CompactCacheTable(Connection &conn, const string &table, string (*ddl)(const string &),
+                              const char *columns) {
+	string compact = table + "_compact";
+	RunCacheQuery(conn, "DROP TABLE IF EXISTS " + compact);
+	RunCacheQuery(conn, ddl(compact));
+	RunCacheQuery(conn, "INSERT INTO " + compact + " (" + columns + ") SELECT " + columns + " FROM " + table);
+	RunCacheQuery(conn, "DROP TABLE " + table);
+	RunCacheQuery(conn, "ALTER TABLE " + compact + " RENAME TO " + table);
+}
+
+static unique_ptr<FunctionData> CrawlerCacheVacuumBind(ClientContext &context, TableFunctionBindInput &input,
+                                                       vector<LogicalType> &return_types, vector<string> &names) {
+	names = {"entries_before", "entries_evicted", "entries_after", "bytes_evicted",
+	         "storage_bytes_before", "storage_bytes_after", "bytes_reclaimed"};
+	return_types = vector<LogicalType>(names.size(), LogicalType::BIGINT);
+	return make_uniq<TableFunctionData>();
+}
+
+static unique_ptr<GlobalTableFunctionState> CrawlerCacheVacuumInitGlobal(ClientContext &context,
+                                                                         TableFunctionInitInput &input) {
+	return make_uniq<CrawlerCacheVacuumGlobalState>();
+}
+
+static void CrawlerCacheVacuumFunction(ClientContext &context, TableFunctionInput &data, DataChunk &output) {
+	auto &gstate = data.global_state->Cast<CrawlerCacheVacuumGlobalState>();
+	if (gstate.finished) {
+		output.SetCardinality(0);
+		return;
+	}
+	gstate.finished = true;
+
+	auto policy = LoadCrawlerCachePolicy(context);
+	if (policy.cache_dir) {
+		// The directory is compacted and its unreferenced objects collected; the bounds apply to the table only
+		auto vacuumed = policy.cache_dir->Vacuum();
+		output.SetValue(0, 0, Value::BIGINT(vacuumed.records_before));
+		output.SetValue(1, 0, Value::BIGINT(vacuumed.records_before - vacuumed.records_after));
+		output.SetValue(2, 0, Value::BIGINT(vacuumed.records_after));
+		output.SetValue(3, 0, Value::BIGINT(vacuumed.bytes_removed));
+		output.SetValue(4, 0, Value::BIGINT(vacuumed.storage_bytes_before));
+		output.SetValue(5, 0, Value::BIGINT(vacuumed.storage_bytes_after));
+		output.SetValue(6, 0,
+		                Value::BIGINT(MaxValue<int64_t>(0, vacuumed.storage_bytes_before - vacuumed.storage_bytes_after)));
+		output.SetCardinality(1);
+		return;
+	}
+	Connection conn(*context.db);
+	auto state = GetCacheState(*context.db);
+	std::unique_lock<std::mutex> guard(state->lock);
+
+	EnsureCacheTableLocked(conn, *state);
+	int64_t storage_before = DatabaseStorageBytes(conn);
+	int64_t entries_before = QueryInt(conn, "SELECT count(*) FROM " + string(CRAWLER_CACHE_TABLE));
+	// An exact recount: vacuum also corrects a total that drifted through concurrent writers
+	state->total_bytes = CacheTotalBytes(conn);
+	state->bytes_known = true;
+	auto evicted = EvictLocked(conn, *state, policy, guard);
+
+	// Compact: rewrite the live rows into fresh tables so deleted row groups are dropped
+	conn.BeginTransaction();
+	try {
+		CompactCacheTable(conn, CRAWLER_CACHE_TABLE, CacheTableDDL, CACHE_COLUMNS);
+		CompactCacheTable(conn, CRAWLER_CACHE_VERSIONS_TABLE, CacheVersionsTableDDL, CACHE_VERSION_COLUMNS);
+		CompactCacheTable(conn, CRAWLER_CACHE_BASE_TABLE, CacheBaseTableDDL, CACHE_BASE_COLUMNS);
+		conn.Commit();
+	} catch (...) {
+		conn.Rollback();
+		throw;
+	}
+	// Re-check the compacted tables and recount their bytes
+	state->table_ready = false;
+	EnsureCacheTableLocked(conn, *state);
+	int64_t entries_after = QueryInt(conn, "SELECT count(*) FROM " + string(CRAWLER_CACHE_TABLE));
+	// Checkpointing is what actually returns the blocks; it is skipped while other writers are active
+	conn.Query("CHECKPOINT");
+	int64_t storage_after = DatabaseStorageBytes(conn);
+
+	output.SetValue(0, 0, Value::BIGINT(entries_before));
+	output.SetValue(1, 0, Value::BIGINT(evicted.entries_evicted));
+	output.SetValue(2, 0, Value::BIGINT(entries_after));
+	output.SetValue(3, 0, Value::BIGINT(evicted.bytes_evicted));
+	output.SetValue(4, 0, Value::BIGINT(storage_before));
+	output.SetValue(5, 0, Value::BIGINT(storage_after));
+	output.SetValue(6, 0, Value::BIGINT(MaxValue<int64_t>(0, storage_before - storage_after)));
+	output.SetCardinality(1);
+}
+
+void RegisterCrawlerCacheFunctions(ExtensionLoader &loader) {
+	TableFunction vacuum("crawler_cache_vacuum", {}, CrawlerCacheVacuumFunction, CrawlerCacheVacuumBind,
+	                     CrawlerCacheVacuumInitGlobal);
+	loader.RegisterFunction(vacuum);
+
+	TableFunctionSet history("crawler_cache_history");
+	history.AddFunction(TableFunction({}, CrawlerCacheHistoryFunction, CrawlerCacheHistoryBind,
+	                                  CrawlerCacheHistoryInitGlobal));
+	history.AddFunction(TableFunction({LogicalType::VARCHAR}, CrawlerCacheHistoryFunction, CrawlerCacheHistoryBind,
+	                                  CrawlerCacheHistoryInitGlobal));
+	loader.RegisterFunction(history);
+}
+
+} // namespace duckdb
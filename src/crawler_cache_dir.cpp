@@ -0,0 +1,687 @@
+// crawler_cache_dir - shared content-addressed response cache on disk
+//
+//   SET crawler_cache_dir = '/data/crawler-cache';
+//
+// crawl() and crawl_url() then look up and store responses in the directory
+// instead of __crawler_cache, so every database (and process) pointing at the
+// same directory shares one copy of each page. See crawler_cache_dir.hpp for
+// the layout.
+
+#include "crawler_cache_dir.hpp"
+#include "crawler_utils.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstring>
+#include <ctime>
+#include <functional>
+#include <unordered_map>
+#include <unordered_set>
+
+#ifndef _WIN32
+#include "mbedtls_wrapper.hpp"
+
+#include <cerrno>
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace duckdb {
+
+#ifndef _WIN32
+
+static constexpr const char *CACHE_DIR_VERSION = "crawler-cache 1\n";
+// Object names: hex of the first 16 bytes of SHA-256
+static constexpr idx_t CACHE_DIR_HASH_BYTES = 16;
+
+// One index entry. Written with a single write() under an exclusive shard lock.
+struct CacheDirRecord {
+	uint8_t url_hash[CACHE_DIR_HASH_BYTES];
+	uint8_t body_hash[CACHE_DIR_HASH_BYTES]; // all zero: empty body
+	uint8_t meta_hash[CACHE_DIR_HASH_BYTES]; // all zero: no content type / error
+	int64_t cached_at;                       // micros since epoch
+	int32_t status_code;
+	int32_t response_time_ms;
+};
+static_assert(sizeof(CacheDirRecord) == 64, "cache directory records must be 64 bytes");
+
+// A shard is compacted on store once it holds this many records and more than twice as many as URLs
+static constexpr idx_t CACHE_DIR_COMPACT_MIN_RECORDS = 4096;
+// Objects and tmp/ files younger than this are never collected: a store writes its objects
+// before the index record that refers to them
+static constexpr int64_t CACHE_DIR_GC_GRACE_SECONDS = 3600;
+
+static string HashBytes(const string &content) {
+	duckdb_mbedtls::MbedTlsWrapper::SHA256State state;
+	state.AddString(content);
+	return state.Finalize().substr(0, CACHE_DIR_HASH_BYTES);
+}
+
+static string HashHex(const uint8_t *hash) {
+	static const char *digits = "0123456789abcdef";
+	string hex;
+	hex.reserve(CACHE_DIR_HASH_BYTES * 2);
+	for (idx_t i = 0; i < CACHE_DIR_HASH_BYTES; i++) {
+		hex += digits[hash[i] >> 4];
+		hex += digits[hash[i] & 0xf];
+	}
+	return hex;
+}
+
+static bool IsZeroHash(const uint8_t *hash) {
+	for (idx_t i = 0; i < CACHE_DIR_HASH_BYTES; i++) {
+		if (hash[i]) {
+			return false;
+		}
+	}
+	return true;
+}
+
+// Metadata object: content_type NUL error
+static string EncodeMeta(const CrawlerCacheEntry &entry) {
+	if (entry.content_type.empty() && entry.error.empty()) {
+		return string();
+	}
+	return entry.content_type + string(1, '\0') + entry.error;
+}
+
+static void DecodeMeta(const string &meta, CrawlerCacheEntry &entry) {
+	auto sep = meta.find('\0');
+	if (sep == string::npos) {
+		entry.content_type = meta;
+		return;
+	}
+	entry.content_type = meta.substr(0, sep);
+	entry.error = meta.substr(sep + 1);
+}
+
+static int64_t NowMicros() {
+	return std::chrono::duration_cast<std::chrono::microseconds>(
+	           std::chrono::system_clock::now().time_since_epoch())
+	    .count();
+}
+
+//===--------------------------------------------------------------------===//
+// Index shards
+//===--------------------------------------------------------------------===//
+
+static bool WriteAll(int fd, const char *data, size_t size) {
+	size_t done = 0;
+	while (done < size) {
+		auto n = write(fd, data + done, size - done);
+		if (n < 0 && errno == EINTR) {
+			continue;
+		}
+		if (n <= 0) {
+			return false;
+		}
+		done += static_cast<size_t>(n);
+	}
+	return true;
+}
+
+// Hash index key: the URL hash is a SHA-256 prefix, so its first 8 bytes are already uniform
+struct CacheDirUrlKey {
+	uint8_t bytes[CACHE_DIR_HASH_BYTES];
+
+	bool operator==(const CacheDirUrlKey &other) const {
+		return memcmp(bytes, other.bytes, CACHE_DIR_HASH_BYTES) == 0;
+	}
+};
+
+struct CacheDirUrlKeyHash {
+	size_t operator()(const CacheDirUrlKey &key) const {
+		uint64_t value;
+		memcpy(&value, key.bytes, sizeof(value));
+		return static_cast<size_t>(value);
+	}
+};
+
+struct CrawlerCacheDirShard {
+	std::mutex lock;
+	string file;
+	int fd = -1;
+	const uint8_t *map = nullptr;
+	size_t mapped = 0;
+	// Offset of the newest record per URL, for the records in [0, indexed)
+	std::unordered_map<CacheDirUrlKey, size_t, CacheDirUrlKeyHash> newest;
+	size_t indexed = 0;
+
+	~CrawlerCacheDirShard() {
+		Unmap();
+		if (fd >= 0) {
+			close(fd);
+		}
+	}
+
+	void Unmap() {
+		if (map) {
+			munmap(const_cast<uint8_t *>(map), mapped);
+			map = nullptr;
+			mapped = 0;
+		}
+	}
+
+	// (Re)open the shard file and forget what was indexed from the previous one
+	void Reopen() {
+		Unmap();
+		newest.clear();
+		indexed = 0;
+		if (fd >= 0) {
+			close(fd);
+		}
+		fd = open(file.c_str(), O_RDWR | O_CREAT | O_APPEND, 0644);
+	}
+
+	// flock() the shard. Compaction renames a new file over the shard while holding the old
+	// one's exclusive lock, so once the lock is held check that fd is still the shard file and
+	// reopen if it is not. Caller holds lock.
+	bool Lock(int operation) {
+		for (idx_t attempt = 0; attempt < 8; attempt++) {
+			if (fd < 0) {
+				Reopen();
+				if (fd < 0) {
+					return false;
+				}
+			}
+			if (flock(fd, operation) != 0) {
+				return false;
+			}
+			struct stat current, opened;
+			if (stat(file.c_str(), &current) == 0 && fstat(fd, &opened) == 0 && current.st_ino == opened.st_ino &&
+			    current.st_dev == opened.st_dev) {
+				return true;
+			}
+			flock(fd, LOCK_UN);
+			Reopen();
+		}
+		return false;
+	}
+
+	void Unlock() {
+		flock(fd, LOCK_UN);
+	}
+
+	// Map the whole shard; other processes only ever append. Caller holds lock and a flock.
+	bool Remap() {
+		struct stat st;
+		if (fstat(fd, &st) != 0) {
+			return false;
+		}
+		size_t size = static_cast<size_t>(st.st_size) - static_cast<size_t>(st.st_size) % sizeof(CacheDirRecord);
+		if (size == mapped) {
+			return true;
+		}
+		Unmap();
+		if (size < indexed) {
+			newest.clear();
+			indexed = 0;
+		}
+		if (size == 0) {
+			return true;
+		}
+		void *ptr = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+		if (ptr == MAP_FAILED) {
+			return false;
+		}
+		map = static_cast<const uint8_t *>(ptr);
+		mapped = size;
+		return true;
+	}
+
+	// Add the records appended since the last call to the hash index. Caller holds lock and a flock.
+	void IndexNewRecords() {
+		for (size_t offset = indexed; offset + sizeof(CacheDirRecord) <= mapped; offset += sizeof(CacheDirRecord)) {
+			CacheDirUrlKey key;
+			memcpy(key.bytes, map + offset, CACHE_DIR_HASH_BYTES);
+			newest[key] = offset;
+		}
+		indexed = mapped;
+	}
+
+	idx_t RecordCount() const {
+		return mapped / sizeof(CacheDirRecord);
+	}
+
+	// Rewrite the shard with only the newest record per URL, renamed over the shard file.
+	// Caller holds lock and LOCK_EX, after Remap() and IndexNewRecords(); the new file is
+	// open (and unlocked) afterwards.
+	bool Compact(const string &tmp_dir) {
+		static std::atomic<uint64_t> tmp_counter {0};
+
+		vector<size_t> offsets;
+		offsets.reserve(newest.size());
+		for (auto &entry : newest) {
+			offsets.push_back(entry.second);
+		}
+		// Keep the append order
+		std::sort(offsets.begin(), offsets.end());
+		string data;
+		data.reserve(offsets.size() * sizeof(CacheDirRecord));
+		for (auto offset : offsets) {
+			data.append(reinterpret_cast<const char *>(map + offset), sizeof(CacheDirRecord));
+		}
+
+		string tmp = tmp_dir + "/" + std::to_string(getpid()) + "-" + std::to_string(tmp_counter.fetch_add(1)) +
+		             ".idx";
+		int tmp_fd = open(tmp.c_str(), O_WRONLY | O_CREAT | O_EXCL, 0644);
+		if (tmp_fd < 0) {
+			return false;
+		}
+		bool ok = WriteAll(tmp_fd, data.data(), data.size()) && fsync(tmp_fd) == 0;
+		close(tmp_fd);
+		if (!ok || rename(tmp.c_str(), file.c_str()) != 0) {
+			unlink(tmp.c_str());
+			return false;
+		}
+		// Waiting writers and readers now find the new file, see Lock()
+		flock(fd, LOCK_UN);
+		Reopen();
+		return true;
+	}
+};
+
+static bool MakeDirectory(const string &dir) {
+	if (mkdir(dir.c_str(), 0755) == 0 || errno == EEXIST) {
+		return true;
+	}
+	if (errno != ENOENT) {
+		return false;
+	}
+	// Create missing parents
+	auto slash = dir.find_last_of('/');
+	if (slash == string::npos || slash == 0 || !MakeDirectory(dir.substr(0, slash))) {
+		return false;
+	}
+	return mkdir(dir.c_str(), 0755) == 0 || errno == EEXIST;
+}
+
+static bool ReadFile(const string &file, string &content) {
+	int fd = open(file.c_str(), O_RDONLY);
+	if (fd < 0) {
+		return false;
+	}
+	struct stat st;
+	bool ok = fstat(fd, &st) == 0;
+	if (ok) {
+		content.resize(static_cast<size_t>(st.st_size));
+		size_t done = 0;
+		while (done < content.size()) {
+			auto n = read(fd, &content[done], content.size() - done);
+			if (n <= 0) {
+				ok = false;
+				break;
+			}
+			done += static_cast<size_t>(n);
+		}
+	}
+	close(fd);
+	return ok;
+}
+
+//===--------------------------------------------------------------------===//
+// CrawlerCacheDir
+//===--------------------------------------------------------------------===//
+
+CrawlerCacheDir::CrawlerCacheDir(string path_p) : path(std::move(path_p)) {
+}
+
+CrawlerCacheDir::~CrawlerCacheDir() {
+}
+
+shared_ptr<CrawlerCacheDir> CrawlerCacheDir::Open(const string &path_p) {
+	static std::mutex dirs_lock;
+	static std::unordered_map<string, weak_ptr<CrawlerCacheDir>> dirs;
+
+	string path = path_p;
+	while (path.size() > 1 && path.back() == '/') {
+		path.pop_back();
+	}
+
+	std::lock_guard<std::mutex> guard(dirs_lock);
+	auto existing = dirs[path].lock();
+	if (existing) {
+		return existing;
+	}
+
+	for (auto &dir : {path, path + "/index", path + "/objects", path + "/tmp"}) {
+		if (!MakeDirectory(dir)) {
+			throw IOException("crawler_cache_dir: cannot create \"%s\": %s", dir, strerror(errno));
+		}
+	}
+	string version;
+	if (ReadFile(path + "/VERSION", version)) {
+		if (version != CACHE_DIR_VERSION) {
+			throw IOException("crawler_cache_dir: \"%s\" has an unsupported layout version", path);
+		}
+	} else {
+		// Concurrent creators write identical content, so a plain rename is enough
+		string tmp = path + "/tmp/VERSION." + std::to_string(getpid());
+		int fd = open(tmp.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+		bool ok = fd >= 0 && WriteAll(fd, CACHE_DIR_VERSION, strlen(CACHE_DIR_VERSION));
+		if (fd >= 0) {
+			close(fd);
+		}
+		if (!ok || rename(tmp.c_str(), (path + "/VERSION").c_str()) != 0) {
+			unlink(tmp.c_str());
+			throw IOException("crawler_cache_dir: cannot write \"%s/VERSION\"", path);
+		}
+	}
+
+	auto dir = shared_ptr<CrawlerCacheDir>(new CrawlerCacheDir(path));
+	dirs[path] = dir;
+	return dir;
+}
+
+CrawlerCacheDirShard &CrawlerCacheDir::GetShard(uint8_t shard_id) {
+	std::lock_guard<std::mutex> guard(lock);
+	auto &shard = shards[shard_id];
+	if (!shard) {
+		shard = make_uniq<CrawlerCacheDirShard>();
+		char name[8];
+		snprintf(name, sizeof(name), "%02x.idx", shard_id);
+		shard->file = path + "/index/" + name;
+	}
+	return *shard;
+}
+
+string CrawlerCacheDir::ObjectPath(const string &hash_hex) const {
+	return path + "/objects/" + hash_hex.substr(0, 2) + "/" + hash_hex.substr(2);
+}
+
+bool CrawlerCacheDir::WriteObject(const string &hash_hex, const string &content) {
+	static std::atomic<uint64_t> tmp_counter {0};
+
+	auto target = ObjectPath(hash_hex);
+	// Same content is already stored. Refresh its mtime: this store appends its record after the
+	// object, so the vacuum grace period has to start again, or an old object could be collected
+	// before the new record refers to it
+	if (utimensat(AT_FDCWD, target.c_str(), nullptr, 0) == 0) {
+		return true;
+	}
+	if (!MakeDirectory(path + "/objects/" + hash_hex.substr(0, 2))) {
+		return false;
+	}
+	string tmp = path + "/tmp/" + std::to_string(getpid()) + "-" + std::to_string(tmp_counter.fetch_add(1)) + "-" +
+	             hash_hex;
+	int fd = open(tmp.c_str(), O_WRONLY | O_CREAT | O_EXCL, 0644);
+	if (fd < 0) {
+		return false;
+	}
+	bool ok = WriteAll(fd, content.data(), content.size());
+	close(fd);
+	// rename() is atomic: readers see either no object or the complete one
+	if (!ok || rename(tmp.c_str(), target.c_str()) != 0) {
+		unlink(tmp.c_str());
+		return false;
+	}
+	return true;
+}
+
+bool CrawlerCacheDir::ReadObject(const string &hash_hex, string &content) const {
+	return ReadFile(ObjectPath(hash_hex), content);
+}
+
+bool CrawlerCacheDir::Lookup(const string &url, int64_t min_cached_at, CrawlerCacheEntry &entry) {
+	auto url_hash = HashBytes(NormalizeUrl(url));
+	auto &shard = GetShard(static_cast<uint8_t>(url_hash[0]));
+
+	CacheDirRecord record;
+	bool found = false;
+	{
+		std::lock_guard<std::mutex> guard(shard.lock);
+		if (!shard.Lock(LOCK_SH)) {
+			return false;
+		}
+		if (shard.Remap()) {
+			// Only records appended since the last lookup are read; the newest record for the URL wins
+			shard.IndexNewRecords();
+			CacheDirUrlKey key;
+			memcpy(key.bytes, url_hash.data(), CACHE_DIR_HASH_BYTES);
+			auto entry_it = shard.newest.find(key);
+			if (entry_it != shard.newest.end()) {
+				memcpy(&record, shard.map + entry_it->second, sizeof(CacheDirRecord));
+				found = true;
+			}
+		}
+		shard.Unlock();
+	}
+	if (!found || record.cached_at < min_cached_at) {
+		return false;
+	}
+
+	entry = CrawlerCacheEntry();
+	entry.url = url;
+	entry.status_code = record.status_code;
+	entry.response_time_ms = record.response_time_ms;
+	// A missing object (e.g. removed by hand) is a miss
+	if (!IsZeroHash(record.body_hash) && !ReadObject(HashHex(record.body_hash), entry.body)) {
+		return false;
+	}
+	if (!IsZeroHash(record.meta_hash)) {
+		string meta;
+		if (!ReadObject(HashHex(record.meta_hash), meta)) {
+			return false;
+		}
+		DecodeMeta(meta, entry);
+	}
+	return true;
+}
+
+std::unordered_set<string> CrawlerCacheDir::FreshUrls(const vector<string> &urls, int64_t min_cached_at) {
+	// URL hashes grouped by shard
+	vector<std::pair<string, idx_t>> by_shard[256];
+	for (idx_t i = 0; i < urls.size(); i++) {
+		auto url_hash = HashBytes(NormalizeUrl(urls[i]));
+		by_shard[static_cast<uint8_t>(url_hash[0])].emplace_back(std::move(url_hash), i);
+	}
+
+	std::unordered_set<string> fresh;
+	for (idx_t shard_id = 0; shard_id < 256; shard_id++) {
+		auto &shard_urls = by_shard[shard_id];
+		if (shard_urls.empty()) {
+			continue;
+		}
+		auto &shard = GetShard(static_cast<uint8_t>(shard_id));
+		std::lock_guard<std::mutex> guard(shard.lock);
+		if (!shard.Lock(LOCK_SH)) {
+			continue;
+		}
+		if (shard.Remap()) {
+			shard.IndexNewRecords();
+			for (auto &url : shard_urls) {
+				CacheDirUrlKey key;
+				memcpy(key.bytes, url.first.data(), CACHE_DIR_HASH_BYTES);
+				auto entry_it = shard.newest.find(key);
+				if (entry_it == shard.newest.end()) {
+					continue;
+				}
+				int64_t cached_at;
+				memcpy(&cached_at, shard.map + entry_it->second + offsetof(CacheDirRecord, cached_at),
+				       sizeof(int64_t));
+				if (cached_at >= min_cached_at) {
+					fresh.insert(urls[url.second]);
+				}
+			}
+		}
+		shard.Unlock();
+	}
+	return fresh;
+}
+
+bool CrawlerCacheDir::Store(const CrawlerCacheEntry &entry) {
+	CacheDirRecord record;
+	memset(&record, 0, sizeof(record));
+
+	auto url_hash = HashBytes(NormalizeUrl(entry.url));
+	memcpy(record.url_hash, url_hash.data(), CACHE_DIR_HASH_BYTES);
+	// Objects first, so an index record never points to a missing object
+	if (!entry.body.empty()) {
+		auto body_hash = HashBytes(entry.body);
+		memcpy(record.body_hash, body_hash.data(), CACHE_DIR_HASH_BYTES);
+		if (!WriteObject(HashHex(record.body_hash), entry.body)) {
+			return false;
+		}
+	}
+	auto meta = EncodeMeta(entry);
+	if (!meta.empty()) {
+		auto meta_hash = HashBytes(meta);
+		memcpy(record.meta_hash, meta_hash.data(), CACHE_DIR_HASH_BYTES);
+		if (!WriteObject(HashHex(record.meta_hash), meta)) {
+			return false;
+		}
+	}
+	record.cached_at = NowMicros();
+	record.status_code = entry.status_code;
+	record.response_time_ms =
+	    static_cast<int32_t>(MinValue<int64_t>(entry.response_time_ms, NumericLimits<int32_t>::Maximum()));
+
+	auto &shard = GetShard(static_cast<uint8_t>(url_hash[0]));
+	std::lock_guard<std::mutex> guard(shard.lock);
+	if (!shard.Lock(LOCK_EX)) {
+		return false;
+	}
+	bool ok = WriteAll(shard.fd, reinterpret_cast<const char *>(&record), sizeof(record));
+	// Recrawls append superseded records; drop them once they outnumber the URLs
+	if (ok && shard.Remap()) {
+		shard.IndexNewRecords();
+		if (shard.RecordCount() >= CACHE_DIR_COMPACT_MIN_RECORDS && shard.RecordCount() > 2 * shard.newest.size()) {
+			shard.Compact(path + "/tmp");
+		}
+	}
+	shard.Unlock();
+	return ok;
+}
+
+static int64_t FileBytes(const string &file) {
+	struct stat st;
+	return stat(file.c_str(), &st) == 0 ? static_cast<int64_t>(st.st_size) : 0;
+}
+
+// Remove the files of dir older than the grace period for which keep() is false. Returns the bytes removed.
+static int64_t RemoveStaleFiles(const string &dir, const std::function<bool(const string &)> &keep, int64_t &files,
+                                int64_t &live_bytes) {
+	int64_t removed = 0;
+	auto handle = opendir(dir.c_str());
+	if (!handle) {
+		return 0;
+	}
+	auto cutoff = time(nullptr) - CACHE_DIR_GC_GRACE_SECONDS;
+	while (auto item = readdir(handle)) {
+		string name = item->d_name;
+		if (name == "." || name == "..") {
+			continue;
+		}
+		string file = dir + "/" + name;
+		struct stat st;
+		if (stat(file.c_str(), &st) != 0 || !S_ISREG(st.st_mode)) {
+			continue;
+		}
+		if (!keep(name) && st.st_mtime < cutoff && unlink(file.c_str()) == 0) {
+			removed += static_cast<int64_t>(st.st_size);
+			files++;
+		} else {
+			live_bytes += static_cast<int64_t>(st.st_size);
+		}
+	}
+	closedir(handle);
+	return removed;
+}
+
+CrawlerCacheDirVacuumResult CrawlerCacheDir::Vacuum() {
+	CrawlerCacheDirVacuumResult result;
+	std::unordered_set<string> live_objects;
+	int64_t index_bytes_after = 0;
+
+	// Compact every shard and collect the objects its records refer to
+	for (idx_t shard_id = 0; shard_id < 256; shard_id++) {
+		auto &shard = GetShard(static_cast<uint8_t>(shard_id));
+		std::lock_guard<std::mutex> guard(shard.lock);
+		if (!shard.Lock(LOCK_EX)) {
+			throw IOException("crawler_cache_dir: cannot lock \"%s\"", shard.file);
+		}
+		if (!shard.Remap()) {
+			shard.Unlock();
+			throw IOException("crawler_cache_dir: cannot read \"%s\"", shard.file);
+		}
+		shard.IndexNewRecords();
+		result.records_before += static_cast<int64_t>(shard.RecordCount());
+		result.storage_bytes_before += static_cast<int64_t>(shard.mapped);
+		for (auto &entry : shard.newest) {
+			CacheDirRecord record;
+			memcpy(&record, shard.map + entry.second, sizeof(CacheDirRecord));
+			if (!IsZeroHash(record.body_hash)) {
+				live_objects.insert(HashHex(record.body_hash));
+			}
+			if (!IsZeroHash(record.meta_hash)) {
+				live_objects.insert(HashHex(record.meta_hash));
+			}
+		}
+		result.records_after += static_cast<int64_t>(shard.newest.size());
+		if (shard.RecordCount() > shard.newest.size() && !shard.Compact(path + "/tmp")) {
+			shard.Unlock();
+			throw IOException("crawler_cache_dir: cannot compact \"%s\"", shard.file);
+		}
+		shard.Unlock();
+		index_bytes_after += FileBytes(shard.file);
+	}
+
+	// Objects no record refers to any more, and writes abandoned in tmp/
+	int64_t live_bytes = 0;
+	int64_t removed_files = 0;
+	for (idx_t prefix = 0; prefix < 256; prefix++) {
+		char name[3];
+		snprintf(name, sizeof(name), "%02x", static_cast<unsigned>(prefix));
+		string prefix_hex = name;
+		result.bytes_removed += RemoveStaleFiles(
+		    path + "/objects/" + prefix_hex,
+		    [&](const string &file) { return live_objects.count(prefix_hex + file) > 0; }, removed_files,
+		    live_bytes);
+	}
+	result.objects_removed = removed_files;
+	result.bytes_removed += RemoveStaleFiles(
+	    path + "/tmp", [](const string &) { return false; }, removed_files, live_bytes);
+	result.storage_bytes_before += live_bytes + result.bytes_removed;
+	result.storage_bytes_after = index_bytes_after + live_bytes;
+	return result;
+}
+
+#else // _WIN32
+
+struct CrawlerCacheDirShard {};
+
+CrawlerCacheDir::CrawlerCacheDir(string path_p) : path(std::move(path_p)) {
+}
+
+CrawlerCacheDir::~CrawlerCacheDir() {
+}
+
+shared_ptr<CrawlerCacheDir> CrawlerCacheDir::Open(const string &path) {
+	throw NotImplementedException("crawler_cache_dir is not supported on Windows");
+}
+
+bool CrawlerCacheDir::Lookup(const string &url, int64_t min_cached_at, CrawlerCacheEntry &entry) {
+	return false;
+}
+
+std::unordered_set<string> CrawlerCacheDir::FreshUrls(const vector<string> &urls, int64_t min_cached_at) {
+	return std::unordered_set<string>();
+}
+
+bool CrawlerCacheDir::Store(const CrawlerCacheEntry &entry) {
+	return false;
+}
+
+CrawlerCacheDirVacuumResult CrawlerCacheDir::Vacuum() {
+	return CrawlerCacheDirVacuumResult();
+}
+
+#endif
+
+} // namespace duckdb
@@ -3,9 +3,22 @@
 #include "crawler_extension.hpp"
 #include "crawl_parser.hpp"
 #include "css_extract_function.hpp"
+#include "extract_memo.hpp"
+#include "html_to_text_function.hpp"
+#include "detect_language_function.hpp"
+#include "html_diff_function.hpp"
+#include "xpath_function.hpp"
+#include "url_bloom_function.hpp"
+#include "page_rank_function.hpp"
 #include "crawl_stream_function.hpp"
 #include "crawl_table_function.hpp"
+#include "crawl_dedupe.hpp"
+#include "crawl_progress.hpp"
 #include "stream_merge_function.hpp"
+#include "crawl_into_function.hpp"
+#include "crawl_to_parquet_function.hpp"
+#include "crawler_cache.hpp"
+#include "fetch_backend.hpp"
 #include "sitemap_function.hpp"
 #include "importhtml_function.hpp"
 #include "rust_ffi.hpp"
@@ -73,9 +86,87 @@ static void LoadInternal(ExtensionLoader &loader) {
 	                          LogicalType::BIGINT,
 	                          Value::BIGINT(10485760)); // 10MB default
 
+	// Register crawler_cache_max_bytes setting
+	config.AddExtensionOption("crawler_cache_max_bytes",
+	                          "Maximum size of __crawler_cache in bytes, least recently used entries are evicted (0 = unbounded)",
+	                          LogicalType::BIGINT,
+	                          Value::BIGINT(0));
+
+	// Register crawler_cache_max_age setting
+	config.AddExtensionOption("crawler_cache_max_age",
+	                          "Maximum age of __crawler_cache entries, older entries are evicted (0 = unbounded)",
+	                          LogicalType::INTERVAL,
+	                          Value::INTERVAL(interval_t()));
+
+	// Register crawler_cache_keep_versions setting
+	config.AddExtensionOption("crawler_cache_keep_versions",
+	                          "Number of previous versions of each URL kept in the response cache",
+	                          LogicalType::INTEGER,
+	                          Value::INTEGER(0));
+
+	// Register crawler_cache_delta setting
+	config.AddExtensionOption("crawler_cache_delta",
+	                          "Store kept versions of recrawled pages as zstd deltas against a per-URL base "
+	                          "(only applies when crawler_cache_keep_versions > 0)",
+	                          LogicalType::BOOLEAN,
+	                          Value::BOOLEAN(true));
+
+	// Register crawler_cache_dir setting
+	config.AddExtensionOption("crawler_cache_dir",
+	                          "Directory of a response cache shared across databases, used instead of __crawler_cache",
+	                          LogicalType::VARCHAR,
+	                          Value(""));
+
+	// Register crawler_extract_memo setting
+	config.AddExtensionOption("crawler_extract_memo",
+	                          "Memoize jq / htmlpath / css_select results in memory for this connection",
+	                          LogicalType::BOOLEAN,
+	                          Value::BOOLEAN(false));
+
+	// Register crawler_store_body setting
+	config.AddExtensionOption("crawler_store_body",
+	                          "Body stored by crawl(), CRAWL INTO and crawl_to_parquet: 'raw', 'minified' or 'main_content'",
+	                          LogicalType::VARCHAR,
+	                          Value("raw"));
+
+	// Register crawler_fetch_backend setting
+	config.AddExtensionOption("crawler_fetch_backend",
+	                          "HTTP client for crawl(), crawl_url(), CRAWL INTO and crawl_to_parquet: 'reqwest' or 'curl'",
+	                          LogicalType::VARCHAR,
+	                          Value("reqwest"),
+	                          SetFetchBackendCallback);
+
+	// Register crawler_dedupe setting
+	config.AddExtensionOption("crawler_dedupe",
+	                          "Collapse URL variants by rel=canonical and body in CRAWL INTO, crawl_to_parquet, "
+	                          "crawl_stream and crawl() without follow",
+	                          LogicalType::BOOLEAN,
+	                          Value::BOOLEAN(false));
+
 	// Register $() scalar function for CSS extraction
 	RegisterCssExtractFunction(loader);
 
+	// Register crawler_extract_memo_stats() for the extraction memo
+	RegisterExtractMemoFunctions(loader);
+
+	// Register html_to_text() for plain text without readability
+	RegisterHtmlToTextFunction(loader);
+
+	// Register detect_language() for per-row language detection
+	RegisterDetectLanguageFunction(loader);
+
+	// Register html_changed() / html_diff() for change detection between crawls
+	RegisterHtmlDiffFunctions(loader);
+
+	// Register xpath() / xpath_all() for XPath extraction
+	RegisterXPathFunctions(loader);
+
+	// Register url_bloom_agg() / url_bloom_contains() for compact URL set filters
+	RegisterUrlBloomFunctions(loader);
+
+	// Register page_rank() for link graph analytics
+	RegisterPageRankFunction(loader);
+
 	// Register crawl_stream table function for streaming crawl results
 	RegisterCrawlStreamFunction(loader);
 
@@ -94,6 +185,21 @@ static void LoadInternal(ExtensionLoader &loader) {
 	// Register stream_merge_internal() for STREAM INTO ... USING ... ON (merge) syntax
 	RegisterCrawlingMergeFunction(loader);
 
+	// Register crawl_into_internal() for CRAWL (...) INTO <table> syntax
+	RegisterCrawlIntoFunction(loader);
+
+	// Register crawl_to_parquet() for Hive-partitioned Parquet output
+	RegisterCrawlToParquetFunction(loader);
+
+	// Register crawl_dedupe_stats() for the fetches and bytes saved by dedupe
+	RegisterCrawlDedupeFunctions(loader);
+
+	// Register crawl_progress() for watching running crawls from any connection
+	RegisterCrawlProgressFunction(loader);
+
+	// Register crawler_cache_vacuum() and crawler_cache_history()
+	RegisterCrawlerCacheFunctions(loader);
+
 	// Install signal handler for graceful shutdown (only once)
 	if (!g_signal_handler_installed) {
 		g_previous_sigint_handler = std::signal(SIGINT, CrawlerSignalHandler);
@@ -1,4 +1,5 @@
 #include "crawler_utils.hpp"
+#include "zstd.h"
 #include <zlib.h>
 #include <algorithm>
 #include <chrono>
@@ -114,6 +115,42 @@ bool IsGzippedData(const std::string &data) {
 	       static_cast<unsigned char>(data[1]) == 0x8b;
 }
 
+// DuckDB's vendored zstd (namespace duckdb_zstd), so the extension needs no zstd of its own.
+// Level 3 is the zstd default: long matches against the base are found at any level
+static constexpr int ZSTD_DELTA_LEVEL = 3;
+
+std::string ZstdDeltaEncode(const std::string &data, const std::string &base) {
+	auto cctx = duckdb_zstd::ZSTD_createCCtx();
+	if (!cctx) {
+		return "";
+	}
+	std::string delta(duckdb_zstd::ZSTD_compressBound(data.size()), '\0');
+	size_t size = duckdb_zstd::ZSTD_compress_usingDict(cctx, &delta[0], delta.size(), data.data(), data.size(),
+	                                                   base.data(), base.size(), ZSTD_DELTA_LEVEL);
+	duckdb_zstd::ZSTD_freeCCtx(cctx);
+	if (duckdb_zstd::ZSTD_isError(size)) {
+		return "";
+	}
+	delta.resize(size);
+	return delta;
+}
+
+bool ZstdDeltaDecode(const std::string &delta, const std::string &base, std::string &data) {
+	unsigned long long size = duckdb_zstd::ZSTD_getFrameContentSize(delta.data(), delta.size());
+	if (size == ZSTD_CONTENTSIZE_ERROR || size == ZSTD_CONTENTSIZE_UNKNOWN) {
+		return false;
+	}
+	auto dctx = duckdb_zstd::ZSTD_createDCtx();
+	if (!dctx) {
+		return false;
+	}
+	data.resize(static_cast<size_t>(size));
+	size_t result = duckdb_zstd::ZSTD_decompress_usingDict(dctx, &data[0], data.size(), delta.data(), delta.size(),
+	                                                       base.data(), base.size());
+	duckdb_zstd::ZSTD_freeDCtx(dctx);
+	return !duckdb_zstd::ZSTD_isError(result) && result == data.size();
+}
+
 //===--------------------------------------------------------------------===//
 // Backoff and Rate Limiting
 //===--------------------------------------------------------------------===//
@@ -297,6 +334,16 @@ std::string ExtractPath(const std::string &url) {
 	return url.substr(path_start);
 }
 
+std::string RobotsTxtUrl(const std::string &url) {
+	auto normalized = NormalizeUrl(url);
+	auto scheme_end = normalized.find("://");
+	if (scheme_end == std::string::npos) {
+		return "";
+	}
+	auto path_start = normalized.find('/', scheme_end + 3);
+	return normalized.substr(0, path_start) + "/robots.txt";
+}
+
 std::string GenerateSurtKey(const std::string &url) {
 	size_t proto_end = url.find("://");
 	if (proto_end == std::string::npos) {
@@ -395,6 +442,94 @@ std::string GenerateDomainSurt(const std::string &hostname) {
 	return surt;
 }
 
+std::string NormalizeUrl(const std::string &url) {
+	size_t proto_end = url.find("://");
+	if (proto_end == std::string::npos) {
+		return url;
+	}
+	std::string scheme = url.substr(0, proto_end);
+	std::transform(scheme.begin(), scheme.end(), scheme.begin(), ::tolower);
+
+	size_t host_start = proto_end + 3;
+	size_t host_end = url.find_first_of("/?#", host_start);
+	if (host_end == std::string::npos) {
+		host_end = url.length();
+	}
+	std::string host = url.substr(host_start, host_end - host_start);
+	std::transform(host.begin(), host.end(), host.begin(), ::tolower);
+
+	// Drop the default port
+	size_t port_pos = host.rfind(':');
+	if (port_pos != std::string::npos && host.find(']', port_pos) == std::string::npos) {
+		std::string port = host.substr(port_pos + 1);
+		if ((scheme == "http" && port == "80") || (scheme == "https" && port == "443") || port.empty()) {
+			host = host.substr(0, port_pos);
+		}
+	}
+
+	// Drop the fragment
+	std::string rest = url.substr(host_end);
+	size_t fragment = rest.find('#');
+	if (fragment != std::string::npos) {
+		rest = rest.substr(0, fragment);
+	}
+	if (rest.empty() || rest[0] != '/') {
+		rest = "/" + rest;
+	}
+	return scheme + "://" + host + rest;
+}
+
+static bool IsTrackingParam(const std::string &name) {
+	std::string lower = name;
+	std::transform(lower.begin(), lower.end(), lower.begin(), ::tolower);
+	if (lower.compare(0, 4, "utm_") == 0) {
+		return true;
+	}
+	static const char *params[] = {"gclid",     "fbclid", "msclkid",   "dclid",      "mc_cid", "mc_eid", "_ga",
+	                               "sessionid", "sid",    "session_id", "phpsessid", "jsessionid"};
+	for (auto param : params) {
+		if (lower == param) {
+			return true;
+		}
+	}
+	return false;
+}
+
+std::string UrlDedupeKey(const std::string &url) {
+	std::string normalized = NormalizeUrl(url);
+
+	// ;jsessionid=... path parameter
+	size_t query_start = normalized.find('?');
+	std::string path = normalized.substr(0, query_start);
+	size_t path_param = path.find(';');
+	if (path_param != std::string::npos) {
+		std::string lower = path.substr(path_param + 1);
+		std::transform(lower.begin(), lower.end(), lower.begin(), ::tolower);
+		if (lower.compare(0, 11, "jsessionid=") == 0) {
+			path = path.substr(0, path_param);
+		}
+	}
+	if (query_start == std::string::npos) {
+		return path;
+	}
+
+	std::string query;
+	std::string rest = normalized.substr(query_start + 1);
+	size_t pos = 0;
+	while (pos <= rest.size()) {
+		size_t amp = rest.find('&', pos);
+		if (amp == std::string::npos) {
+			amp = rest.size();
+		}
+		std::string param = rest.substr(pos, amp - pos);
+		if (!param.empty() && !IsTrackingParam(param.substr(0, param.find('=')))) {
+			query += (query.empty() ? "" : "&") + param;
+		}
+		pos = amp + 1;
+	}
+	return query.empty() ? path : path + "?" + query;
+}
+
 std::string GenerateContentHash(const std::string &content) {
 	if (content.empty()) {
 		return "";
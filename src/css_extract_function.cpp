@@ -8,6 +8,7 @@
 // Returns STRUCT(text VARCHAR, html VARCHAR, attr MAP(VARCHAR, VARCHAR))
 
 #include "css_extract_function.hpp"
+#include "extract_memo.hpp"
 #include "rust_ffi.hpp"
 #include "yyjson.hpp"
 #include "duckdb/function/scalar_function.hpp"
@@ -29,25 +30,62 @@ static LogicalType GetElementStructType() {
     return LogicalType::STRUCT(std::move(struct_children));
 }
 
+// Raw Rust output for every row of a chunk, served from the extraction memo where possible.
+// args[0] is the HTML; build_spec turns the remaining arguments into the selector spec.
+// Rows with a NULL argument are marked invalid and get no result.
+static vector<string> ExtractRowsMemoized(DataChunk &args, ExpressionState &state, const string &function,
+                                          const std::function<string(const vector<string_t> &)> &build_spec,
+                                          const ExtractMemoFunction &extract, vector<bool> &valid) {
+    idx_t count = args.size();
+    vector<UnifiedVectorFormat> formats(args.ColumnCount());
+    for (idx_t col = 0; col < args.ColumnCount(); col++) {
+        args.data[col].ToUnifiedFormat(count, formats[col]);
+    }
+
+    valid.assign(count, false);
+    vector<idx_t> rows;
+    vector<ExtractMemoRequest> requests;
+    vector<string_t> row_args(args.ColumnCount());
+    for (idx_t i = 0; i < count; i++) {
+        bool has_null = false;
+        for (idx_t col = 0; col < args.ColumnCount(); col++) {
+            auto idx = formats[col].sel->get_index(i);
+            if (!formats[col].validity.RowIsValid(idx)) {
+                has_null = true;
+                break;
+            }
+            row_args[col] = UnifiedVectorFormat::GetData<string_t>(formats[col])[idx];
+        }
+        if (has_null) {
+            continue;
+        }
+        valid[i] = true;
+        rows.push_back(i);
+        requests.push_back({row_args[0], build_spec(row_args)});
+    }
+
+    auto extracted = ExtractMemoized(state, function, requests, extract);
+    vector<string> results(count);
+    for (idx_t r = 0; r < rows.size(); r++) {
+        results[rows[r]] = std::move(extracted[r]);
+    }
+    return results;
+}
+
 // Scalar function implementation: $(html, selector) -> STRUCT
 static void CssExtractStructFunction(DataChunk &args, ExpressionState &state, Vector &result) {
-    auto &html_vec = args.data[0];
-    auto &selector_vec = args.data[1];
+    vector<bool> valid;
+    auto element_jsons = ExtractRowsMemoized(
+        args, state, "jq", [](const vector<string_t> &row) { return row[1].GetString(); },
+        [](const string &html, const string &selector) { return ExtractElementWithRust(html, selector); }, valid);
 
     for (idx_t i = 0; i < args.size(); i++) {
-        auto html_val = html_vec.GetValue(i);
-        auto selector_val = selector_vec.GetValue(i);
-
-        if (html_val.IsNull() || selector_val.IsNull()) {
+        if (!valid[i]) {
             FlatVector::SetNull(result, i, true);
             continue;
         }
 
-        string html = html_val.ToString();
-        string selector = selector_val.ToString();
-
-        // Call Rust to extract element data
-        string element_json = ExtractElementWithRust(html, selector);
+        const string &element_json = element_jsons[i];
 
         if (element_json == "null" || element_json.empty()) {
             FlatVector::SetNull(result, i, true);
@@ -176,16 +214,26 @@ static string CssExtractString(const string &html, const string &selector, const
 
 // 3-argument version: css_select(html, selector, accessor) -> VARCHAR
 static void CssSelectFunction3(DataChunk &args, ExpressionState &state, Vector &result) {
-    auto &html_vec = args.data[0];
-    auto &selector_vec = args.data[1];
-    auto &accessor_vec = args.data[2];
-
-    TernaryExecutor::Execute<string_t, string_t, string_t, string_t>(
-        html_vec, selector_vec, accessor_vec, result, args.size(),
-        [&result](string_t html, string_t selector, string_t accessor) {
-            string extracted = CssExtractString(html.GetString(), selector.GetString(), accessor.GetString());
-            return StringVector::AddString(result, extracted);
-        });
+    // Memo spec is selector NUL accessor
+    vector<bool> valid;
+    auto extracted = ExtractRowsMemoized(
+        args, state, "css_select",
+        [](const vector<string_t> &row) { return row[1].GetString() + '\0' + row[2].GetString(); },
+        [](const string &html, const string &spec) {
+            auto sep = spec.find('\0');
+            return CssExtractString(html, spec.substr(0, sep), spec.substr(sep + 1));
+        },
+        valid);
+
+    result.SetVectorType(VectorType::FLAT_VECTOR);
+    auto result_data = FlatVector::GetData<string_t>(result);
+    for (idx_t i = 0; i < args.size(); i++) {
+        if (!valid[i]) {
+            FlatVector::SetNull(result, i, true);
+            continue;
+        }
+        result_data[i] = StringVector::AddString(result, extracted[i]);
+    }
 }
 
 // Token-efficient page inventory for LLM agents
@@ -201,60 +249,77 @@ static void PageInfoFunction(DataChunk &args, ExpressionState &state, Vector &re
         });
 }
 
+// Unquote a JSON string literal returned by Rust
+static string UnquoteJsonString(const string &quoted) {
+    string unquoted = quoted.substr(1, quoted.size() - 2);
+    // Unescape JSON string escapes
+    string result_str;
+    for (size_t i = 0; i < unquoted.size(); i++) {
+        if (unquoted[i] == '\\' && i + 1 < unquoted.size()) {
+            char next = unquoted[i + 1];
+            if (next == '"' || next == '\\' || next == '/') {
+                result_str += next;
+                i++;
+            } else if (next == 'n') {
+                result_str += '\n';
+                i++;
+            } else if (next == 'r') {
+                result_str += '\r';
+                i++;
+            } else if (next == 't') {
+                result_str += '\t';
+                i++;
+            } else {
+                result_str += unquoted[i];
+            }
+        } else {
+            result_str += unquoted[i];
+        }
+    }
+    return result_str;
+}
+
 // jq with 3 args: jq(html, selector, attr_name) -> VARCHAR
 // Returns the attribute value directly for easy JSON casting
 static void JqAttrFunction(DataChunk &args, ExpressionState &state, Vector &result) {
-    auto &html_vec = args.data[0];
-    auto &selector_vec = args.data[1];
-    auto &attr_vec = args.data[2];
-
-    TernaryExecutor::Execute<string_t, string_t, string_t, string_t>(
-        html_vec, selector_vec, attr_vec, result, args.size(),
-        [&result](string_t html, string_t selector, string_t attr_name) {
-            if (html.GetSize() == 0 || selector.GetSize() == 0) {
-                return string_t();
+    // Build selector with @attr suffix for Rust (memoized under the same key as jq(html, 'sel @attr'))
+    vector<bool> valid;
+    auto element_jsons = ExtractRowsMemoized(
+        args, state, "jq",
+        [](const vector<string_t> &row) {
+            if (row[0].GetSize() == 0 || row[1].GetSize() == 0) {
+                return string();
             }
-
-            // Build selector with @attr suffix for Rust
-            string full_selector = selector.GetString() + " @" + attr_name.GetString();
-            string element_json = ExtractElementWithRust(html.GetString(), full_selector);
-
-            if (element_json == "null" || element_json.empty()) {
-                return string_t();
+            return row[1].GetString() + " @" + row[2].GetString();
+        },
+        [](const string &html, const string &full_selector) {
+            if (html.empty() || full_selector.empty()) {
+                return string();
             }
+            return ExtractElementWithRust(html, full_selector);
+        },
+        valid);
 
-            // Rust returns quoted JSON string, unquote it
-            if (element_json.size() >= 2 && element_json[0] == '"' && element_json.back() == '"') {
-                string unquoted = element_json.substr(1, element_json.size() - 2);
-                // Unescape JSON string escapes
-                string result_str;
-                for (size_t i = 0; i < unquoted.size(); i++) {
-                    if (unquoted[i] == '\\' && i + 1 < unquoted.size()) {
-                        char next = unquoted[i + 1];
-                        if (next == '"' || next == '\\' || next == '/') {
-                            result_str += next;
-                            i++;
-                        } else if (next == 'n') {
-                            result_str += '\n';
-                            i++;
-                        } else if (next == 'r') {
-                            result_str += '\r';
-                            i++;
-                        } else if (next == 't') {
-                            result_str += '\t';
-                            i++;
-                        } else {
-                            result_str += unquoted[i];
-                        }
-                    } else {
-                        result_str += unquoted[i];
-                    }
-                }
-                return StringVector::AddString(result, result_str);
-            }
+    result.SetVectorType(VectorType::FLAT_VECTOR);
+    auto result_data = FlatVector::GetData<string_t>(result);
+    for (idx_t i = 0; i < args.size(); i++) {
+        if (!valid[i]) {
+            FlatVector::SetNull(result, i, true);
+            continue;
+        }
+        const string &element_json = element_jsons[i];
+        if (element_json == "null" || element_json.empty()) {
+            result_data[i] = string_t();
+            continue;
+        }
 
-            return StringVector::AddString(result, element_json);
-        });
+        // Rust returns quoted JSON string, unquote it
+        if (element_json.size() >= 2 && element_json[0] == '"' && element_json.back() == '"') {
+            result_data[i] = StringVector::AddString(result, UnquoteJsonString(element_json));
+        } else {
+            result_data[i] = StringVector::AddString(result, element_json);
+        }
+    }
 }
 
 // htmlpath(html, path) -> JSON
@@ -264,15 +329,20 @@ static void JqAttrFunction(DataChunk &args, ExpressionState &state, Vector &resu
 //   htmlpath(doc, 'input#jobs@value[*]')        -> JSON array
 //   htmlpath(doc, 'input#jobs@value[*].id')     -> array of 'id' fields
 static void HtmlPathFunction(DataChunk &args, ExpressionState &state, Vector &result) {
-    auto &html_vec = args.data[0];
-    auto &path_vec = args.data[1];
+    vector<bool> valid;
+    auto json_results = ExtractRowsMemoized(
+        args, state, "htmlpath", [](const vector<string_t> &row) { return row[1].GetString(); },
+        [](const string &html, const string &path) { return ExtractPathWithRust(html, path); }, valid);
 
-    BinaryExecutor::Execute<string_t, string_t, string_t>(
-        html_vec, path_vec, result, args.size(),
-        [&result](string_t html, string_t path) {
-            string json_result = ExtractPathWithRust(html.GetString(), path.GetString());
-            return StringVector::AddString(result, json_result);
-        });
+    result.SetVectorType(VectorType::FLAT_VECTOR);
+    auto result_data = FlatVector::GetData<string_t>(result);
+    for (idx_t i = 0; i < args.size(); i++) {
+        if (!valid[i]) {
+            FlatVector::SetNull(result, i, true);
+            continue;
+        }
+        result_data[i] = StringVector::AddString(result, json_results[i]);
+    }
 }
 
 void RegisterCssExtractFunction(ExtensionLoader &loader) {
@@ -0,0 +1,812 @@
+// libcurl multi fetch backend (SET crawler_fetch_backend = 'curl')
+//
+// One event loop thread owns a curl multi handle. CrawlBatch() parses the
+// BatchCrawlRequest on the calling thread and queues the batch; the loop
+// starts transfers as each batch's concurrency and per-host delay allow and
+// drives all transfers of all queries together. Connections stay in the multi
+// handle's cache between batches (the reqwest path builds a new client per
+// batch), HTTP/2 streams to the same host share one connection, and DNS
+// results and TLS sessions are shared across transfers.
+//
+// The loop hands each response back as soon as its transfer finishes. The
+// calling thread decodes the body to UTF-8 and runs the EXTRACT specs in Rust
+// while the rest of its batch is still in flight, so the loop never parses
+// HTML and the caller is never parked until the whole batch is done. With
+// respect_robots, robots.txt is fetched on the loop once per host of the batch
+// and matched with RobotsParser.
+
+#include "fetch_backend.hpp"
+#include "crawler_utils.hpp"
+#include "robots_parser.hpp"
+#include "rust_ffi.hpp"
+#include "yyjson.hpp"
+
+#include <curl/curl.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+
+namespace duckdb {
+
+using namespace duckdb_yyjson;
+
+using FetchClock = std::chrono::steady_clock;
+
+// How often a caller waiting for responses checks for an interrupt
+static constexpr int64_t CURL_INTERRUPT_CHECK_MS = 100;
+
+//===--------------------------------------------------------------------===//
+// Request / Result
+//===--------------------------------------------------------------------===//
+
+// Method, headers and body of one URL (crawl() STRUCT input); default = plain GET
+struct CurlRequestOptions {
+	string method = "GET";
+	vector<string> headers; // "Name: value"
+	string body;
+	bool has_body = false;
+};
+
+struct CurlBatchRequest {
+	vector<string> urls;
+	vector<CurlRequestOptions> options; // Aligned with urls (empty = all GET)
+	string extraction_json; // ExtractionRequest JSON, empty = no extraction
+	string user_agent = "DuckDB-Crawler/1.0";
+	int64_t timeout_ms = 30000;
+	idx_t concurrency = 4;
+	int64_t delay_ms = 0;
+	bool respect_robots = false;
+	bool detect_language = false; // Fill each result's language (crawl(language := true))
+	string http_proxy;
+	string http_proxy_username;
+	string http_proxy_password;
+	vector<string> extra_headers; // "Name: value"
+};
+
+struct CurlFetchResult {
+	string url;
+	string final_url;
+	int32_t status = 0;
+	string content_type;
+	string content_language;
+	string body;
+	string error;
+	bool has_error = false;
+	int64_t response_time_ms = 0;
+};
+
+static string JsonString(yyjson_val *obj, const char *key) {
+	auto val = yyjson_obj_get(obj, key);
+	return val && yyjson_is_str(val) ? string(yyjson_get_str(val), yyjson_get_len(val)) : string();
+}
+
+static int64_t JsonInt(yyjson_val *obj, const char *key, int64_t default_value) {
+	auto val = yyjson_obj_get(obj, key);
+	return val && yyjson_is_int(val) ? yyjson_get_sint(val) : default_value;
+}
+
+// Same defaults as BatchCrawlRequest in rust_parser/src/ffi.rs
+static bool ParseCurlBatchRequest(const string &request_json, CurlBatchRequest &request, string &error) {
+	yyjson_doc *doc = yyjson_read(request_json.c_str(), request_json.size(), 0);
+	if (!doc) {
+		error = "Invalid request: not JSON";
+		return false;
+	}
+	yyjson_val *root = yyjson_doc_get_root(doc);
+	yyjson_val *urls = yyjson_obj_get(root, "urls");
+	size_t idx, max;
+	yyjson_val *item;
+	yyjson_arr_foreach(urls, idx, max, item) {
+		if (yyjson_is_str(item)) {
+			request.urls.emplace_back(yyjson_get_str(item), yyjson_get_len(item));
+		}
+	}
+	yyjson_val *requests = yyjson_obj_get(root, "requests");
+	if (requests && yyjson_is_arr(requests)) {
+		request.options.resize(request.urls.size());
+		yyjson_arr_foreach(requests, idx, max, item) {
+			if (idx >= request.options.size() || !yyjson_is_obj(item)) {
+				continue;
+			}
+			auto &options = request.options[idx];
+			auto method = JsonString(item, "method");
+			if (!method.empty()) {
+				options.method = method;
+			}
+			yyjson_val *request_headers = yyjson_obj_get(item, "headers");
+			if (request_headers && yyjson_is_obj(request_headers)) {
+				size_t header_idx, header_max;
+				yyjson_val *key, *val;
+				yyjson_obj_foreach(request_headers, header_idx, header_max, key, val) {
+					if (yyjson_is_str(val)) {
+						options.headers.push_back(string(yyjson_get_str(key)) + ": " + yyjson_get_str(val));
+					}
+				}
+			}
+			yyjson_val *body = yyjson_obj_get(item, "body");
+			if (body && yyjson_is_str(body)) {
+				options.body = string(yyjson_get_str(body), yyjson_get_len(body));
+				options.has_body = true;
+			}
+		}
+	}
+	yyjson_val *extraction = yyjson_obj_get(root, "extraction");
+	if (extraction && yyjson_is_obj(extraction)) {
+		size_t len = 0;
+		char *json = yyjson_val_write(extraction, 0, &len);
+		if (json) {
+			request.extraction_json = string(json, len);
+			free(json);
+		}
+	}
+	auto user_agent = JsonString(root, "user_agent");
+	if (!user_agent.empty()) {
+		request.user_agent = user_agent;
+	}
+	request.timeout_ms = JsonInt(root, "timeout_ms", request.timeout_ms);
+	request.concurrency = static_cast<idx_t>(MaxValue<int64_t>(1, MinValue<int64_t>(32, JsonInt(root, "concurrency", 4))));
+	request.delay_ms = JsonInt(root, "delay_ms", 0);
+	request.respect_robots = yyjson_get_bool(yyjson_obj_get(root, "respect_robots"));
+	request.detect_language = yyjson_get_bool(yyjson_obj_get(root, "detect_language"));
+	request.http_proxy = JsonString(root, "http_proxy");
+	request.http_proxy_username = JsonString(root, "http_proxy_username");
+	request.http_proxy_password = JsonString(root, "http_proxy_password");
+	yyjson_val *headers = yyjson_obj_get(root, "extra_headers");
+	if (headers && yyjson_is_obj(headers)) {
+		yyjson_val *key, *val;
+		yyjson_obj_foreach(headers, idx, max, key, val) {
+			if (yyjson_is_str(val)) {
+				request.extra_headers.push_back(string(yyjson_get_str(key)) + ": " + yyjson_get_str(val));
+			}
+		}
+	}
+	yyjson_doc_free(doc);
+	return true;
+}
+
+//===--------------------------------------------------------------------===//
+// Body decoding (as reqwest's Response::text())
+//===--------------------------------------------------------------------===//
+
+// windows-1252 code points of bytes 0x80-0x9F (iso-8859-1 labels decode as windows-1252 too)
+static const uint16_t WINDOWS_1252_HIGH[32] = {
+    0x20AC, 0x0081, 0x201A, 0x0192, 0x201E, 0x2026, 0x2020, 0x2021, 0x02C6, 0x2030, 0x0160,
+    0x2039, 0x0152, 0x008D, 0x017D, 0x008F, 0x0090, 0x2018, 0x2019, 0x201C, 0x201D, 0x2022,
+    0x2013, 0x2014, 0x02DC, 0x2122, 0x0161, 0x203A, 0x0153, 0x009D, 0x017E, 0x0178};
+
+static void AppendUtf8(uint32_t cp, string &out) {
+	if (cp < 0x80) {
+		out += static_cast<char>(cp);
+	} else if (cp < 0x800) {
+		out += static_cast<char>(0xC0 | (cp >> 6));
+		out += static_cast<char>(0x80 | (cp & 0x3F));
+	} else if (cp < 0x10000) {
+		out += static_cast<char>(0xE0 | (cp >> 12));
+		out += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+		out += static_cast<char>(0x80 | (cp & 0x3F));
+	} else {
+		out += static_cast<char>(0xF0 | (cp >> 18));
+		out += static_cast<char>(0x80 | ((cp >> 12) & 0x3F));
+		out += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+		out += static_cast<char>(0x80 | (cp & 0x3F));
+	}
+}
+
+// Length of the valid UTF-8 sequence at data[i], 0 if invalid
+static idx_t Utf8SequenceLength(const string &data, idx_t i) {
+	auto c = static_cast<unsigned char>(data[i]);
+	idx_t len;
+	uint32_t min_cp;
+	uint32_t cp;
+	if (c < 0x80) {
+		return 1;
+	} else if ((c & 0xE0) == 0xC0) {
+		len = 2, min_cp = 0x80, cp = c & 0x1F;
+	} else if ((c & 0xF0) == 0xE0) {
+		len = 3, min_cp = 0x800, cp = c & 0x0F;
+	} else if ((c & 0xF8) == 0xF0) {
+		len = 4, min_cp = 0x10000, cp = c & 0x07;
+	} else {
+		return 0;
+	}
+	if (i + len > data.size()) {
+		return 0;
+	}
+	for (idx_t k = 1; k < len; k++) {
+		auto cont = static_cast<unsigned char>(data[i + k]);
+		if ((cont & 0xC0) != 0x80) {
+			return 0;
+		}
+		cp = (cp << 6) | (cont & 0x3F);
+	}
+	if (cp < min_cp || cp > 0x10FFFF || (cp >= 0xD800 && cp <= 0xDFFF)) {
+		return 0;
+	}
+	return len;
+}
+
+// Body as UTF-8: single-byte Western charsets are transcoded, anything else is
+// read as UTF-8 with invalid sequences replaced by U+FFFD
+static string DecodeBody(string body, const string &content_type) {
+	auto lowered = StringUtil::Lower(content_type);
+	auto charset_pos = lowered.find("charset=");
+	string charset;
+	if (charset_pos != string::npos) {
+		charset = lowered.substr(charset_pos + 8);
+		auto end = charset.find_first_of("; ");
+		charset = charset.substr(0, end);
+		StringUtil::Trim(charset);
+		if (charset.size() >= 2 && (charset[0] == '"' || charset[0] == '\'')) {
+			charset = charset.substr(1, charset.size() - 2);
+		}
+	}
+	if (charset == "iso-8859-1" || charset == "latin1" || charset == "windows-1252" || charset == "cp1252" ||
+	    charset == "us-ascii") {
+		string out;
+		out.reserve(body.size() + body.size() / 8);
+		for (char c : body) {
+			auto b = static_cast<unsigned char>(c);
+			AppendUtf8(b >= 0x80 && b < 0xA0 ? WINDOWS_1252_HIGH[b - 0x80] : b, out);
+		}
+		return out;
+	}
+	idx_t i = 0;
+	while (i < body.size()) {
+		auto len = Utf8SequenceLength(body, i);
+		if (len == 0) {
+			break;
+		}
+		i += len;
+	}
+	if (i == body.size()) {
+		return body;
+	}
+	string out = body.substr(0, i);
+	while (i < body.size()) {
+		auto len = Utf8SequenceLength(body, i);
+		if (len == 0) {
+			AppendUtf8(0xFFFD, out);
+			i++;
+		} else {
+			out.append(body, i, len);
+			i += len;
+		}
+	}
+	return out;
+}
+
+//===--------------------------------------------------------------------===//
+// Event loop state
+//===--------------------------------------------------------------------===//
+
+// One queued batch. request is fixed once queued; pending, active and
+// host_next_fetch belong to the loop thread; responses move to the caller
+// through finished under lock.
+struct CurlBatch {
+	CurlBatchRequest request;
+	vector<idx_t> pending; // URL indexes not started yet, in order
+	idx_t active = 0;
+	std::unordered_map<string, FetchClock::time_point> host_next_fetch;
+	std::atomic<bool> cancelled {false}; // Set by the caller on interrupt
+
+	std::mutex lock;
+	std::condition_variable ready;
+	vector<CurlFetchResult> finished; // Not yet taken by the caller, in completion order
+	bool done = false;                // No transfer left; set after the last response is in finished
+};
+
+struct CurlTransfer {
+	shared_ptr<CurlBatch> batch;
+	idx_t url_index = 0;
+	CURL *easy = nullptr;
+	curl_slist *headers = nullptr;
+	string body;
+	string content_type;
+	string content_language;
+	FetchClock::time_point started;
+	char error_buffer[CURL_ERROR_SIZE];
+};
+
+static size_t CurlWriteCallback(char *data, size_t size, size_t nmemb, void *userp) {
+	auto transfer = static_cast<CurlTransfer *>(userp);
+	transfer->body.append(data, size * nmemb);
+	return size * nmemb;
+}
+
+// Keeps the Content-Type and Content-Language of the last response (redirect responses come first)
+static size_t CurlHeaderCallback(char *data, size_t size, size_t nitems, void *userp) {
+	auto transfer = static_cast<CurlTransfer *>(userp);
+	string header(data, size * nitems);
+	if (StringUtil::StartsWith(header, "HTTP/")) {
+		transfer->content_type.clear();
+		transfer->content_language.clear();
+	} else {
+		auto colon = header.find(':');
+		if (colon != string::npos) {
+			auto name = header.substr(0, colon);
+			auto value = header.substr(colon + 1);
+			StringUtil::Trim(value);
+			if (StringUtil::CIEquals(name, "content-type")) {
+				transfer->content_type = value;
+			} else if (StringUtil::CIEquals(name, "content-language")) {
+				transfer->content_language = value;
+			}
+		}
+	}
+	return size * nitems;
+}
+
+class CurlFetchBackend : public FetchBackend {
+public:
+	CurlFetchBackend() {
+		curl_global_init(CURL_GLOBAL_DEFAULT);
+		multi = curl_multi_init();
+		curl_multi_setopt(multi, CURLMOPT_PIPELINING, static_cast<long>(CURLPIPE_MULTIPLEX));
+		curl_multi_setopt(multi, CURLMOPT_MAXCONNECTS, 256L);
+		share = curl_share_init();
+		curl_share_setopt(share, CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS);
+		curl_share_setopt(share, CURLSHOPT_SHARE, CURL_LOCK_DATA_SSL_SESSION);
+		auto info = curl_version_info(CURLVERSION_NOW);
+		http2 = info && (info->features & CURL_VERSION_HTTP2);
+		// The backend is never destroyed, neither is its loop
+		std::thread([this]() { Run(); }).detach();
+	}
+
+	string CrawlBatch(const string &request_json) override;
+
+private:
+	// Caller side
+	void Submit(const shared_ptr<CurlBatch> &batch);
+	void TakeResponses(CurlBatch &batch, const std::function<void(CurlFetchResult &)> &handle);
+	void FilterByRobots(const shared_ptr<CurlBatch> &batch);
+
+	// Loop thread
+	void Run();
+	void StartTransfers(const shared_ptr<CurlBatch> &batch, FetchClock::time_point now, long &wait_ms);
+	void StartTransfer(const shared_ptr<CurlBatch> &batch, idx_t url_index);
+	void FinishTransfer(CURL *easy, CURLcode code);
+	void CancelTransfers(bool all);
+
+	CURLM *multi = nullptr;
+	CURLSH *share = nullptr; // Used by the loop thread only: no lock callbacks needed
+	bool http2 = false;
+
+	std::mutex queue_lock;
+	vector<shared_ptr<CurlBatch>> queued; // Submitted, not yet picked up by the loop
+
+	// Loop thread only
+	vector<shared_ptr<CurlBatch>> running;
+	std::unordered_map<CURL *, unique_ptr<CurlTransfer>> transfers;
+};
+
+//===--------------------------------------------------------------------===//
+// Event loop
+//===--------------------------------------------------------------------===//
+
+void CurlFetchBackend::StartTransfer(const shared_ptr<CurlBatch> &batch, idx_t url_index) {
+	auto &request = batch->request;
+	auto transfer = make_uniq<CurlTransfer>();
+	transfer->batch = batch;
+	transfer->url_index = url_index;
+	transfer->started = FetchClock::now();
+	transfer->error_buffer[0] = '\0';
+
+	CURL *easy = curl_easy_init();
+	transfer->easy = easy;
+	curl_easy_setopt(easy, CURLOPT_URL, request.urls[url_index].c_str());
+	curl_easy_setopt(easy, CURLOPT_SHARE, share);
+	curl_easy_setopt(easy, CURLOPT_NOSIGNAL, 1L);
+	curl_easy_setopt(easy, CURLOPT_ERRORBUFFER, transfer->error_buffer);
+	curl_easy_setopt(easy, CURLOPT_WRITEFUNCTION, CurlWriteCallback);
+	curl_easy_setopt(easy, CURLOPT_WRITEDATA, transfer.get());
+	curl_easy_setopt(easy, CURLOPT_HEADERFUNCTION, CurlHeaderCallback);
+	curl_easy_setopt(easy, CURLOPT_HEADERDATA, transfer.get());
+	curl_easy_setopt(easy, CURLOPT_USERAGENT, request.user_agent.c_str());
+	curl_easy_setopt(easy, CURLOPT_TIMEOUT_MS, static_cast<long>(request.timeout_ms));
+	// Every encoding this libcurl was built with
+	curl_easy_setopt(easy, CURLOPT_ACCEPT_ENCODING, "");
+	curl_easy_setopt(easy, CURLOPT_FOLLOWLOCATION, 1L);
+	curl_easy_setopt(easy, CURLOPT_MAXREDIRS, 10L);
+#if LIBCURL_VERSION_NUM >= 0x075500
+	curl_easy_setopt(easy, CURLOPT_PROTOCOLS_STR, "http,https");
+	curl_easy_setopt(easy, CURLOPT_REDIR_PROTOCOLS_STR, "http,https");
+#else
+	curl_easy_setopt(easy, CURLOPT_PROTOCOLS, static_cast<long>(CURLPROTO_HTTP | CURLPROTO_HTTPS));
+	curl_easy_setopt(easy, CURLOPT_REDIR_PROTOCOLS, static_cast<long>(CURLPROTO_HTTP | CURLPROTO_HTTPS));
+#endif
+	if (http2) {
+		curl_easy_setopt(easy, CURLOPT_HTTP_VERSION, static_cast<long>(CURL_HTTP_VERSION_2TLS));
+		// Wait for a connection that can multiplex instead of opening another one
+		curl_easy_setopt(easy, CURLOPT_PIPEWAIT, 1L);
+	}
+	if (!request.http_proxy.empty()) {
+		curl_easy_setopt(easy, CURLOPT_PROXY, request.http_proxy.c_str());
+		if (!request.http_proxy_username.empty()) {
+			curl_easy_setopt(easy, CURLOPT_PROXYUSERNAME, request.http_proxy_username.c_str());
+			curl_easy_setopt(easy, CURLOPT_PROXYPASSWORD, request.http_proxy_password.c_str());
+		}
+	}
+	// Per-request headers replace extra headers of the same name (as the reqwest path)
+	const CurlRequestOptions *options = url_index < request.options.size() ? &request.options[url_index] : nullptr;
+	for (auto &header : request.extra_headers) {
+		bool replaced = false;
+		auto name = header.substr(0, header.find(':'));
+		for (idx_t i = 0; options && i < options->headers.size() && !replaced; i++) {
+			replaced = StringUtil::CIEquals(options->headers[i].substr(0, options->headers[i].find(':')), name);
+		}
+		if (!replaced) {
+			transfer->headers = curl_slist_append(transfer->headers, header.c_str());
+		}
+	}
+	if (options) {
+		bool has_content_type = false;
+		for (auto &header : options->headers) {
+			transfer->headers = curl_slist_append(transfer->headers, header.c_str());
+			has_content_type = has_content_type || StringUtil::StartsWith(StringUtil::Lower(header), "content-type:");
+		}
+		if (options->has_body) {
+			// Send the body as given, as reqwest does: no form Content-Type, no "Expect: 100-continue"
+			if (!has_content_type) {
+				transfer->headers = curl_slist_append(transfer->headers, "Content-Type:");
+			}
+			transfer->headers = curl_slist_append(transfer->headers, "Expect:");
+		}
+		if (options->method == "HEAD") {
+			curl_easy_setopt(easy, CURLOPT_NOBODY, 1L);
+		} else if (options->method != "GET" || options->has_body) {
+			if (options->has_body) {
+				curl_easy_setopt(easy, CURLOPT_POSTFIELDSIZE_LARGE, static_cast<curl_off_t>(options->body.size()));
+				curl_easy_setopt(easy, CURLOPT_COPYPOSTFIELDS, options->body.c_str());
+			} else if (options->method == "POST") {
+				curl_easy_setopt(easy, CURLOPT_POSTFIELDSIZE, 0L);
+				curl_easy_setopt(easy, CURLOPT_POSTFIELDS, "");
+			}
+			if (options->method != "POST") {
+				curl_easy_setopt(easy, CURLOPT_CUSTOMREQUEST, options->method.c_str());
+			}
+		}
+	}
+	if (transfer->headers) {
+		curl_easy_setopt(easy, CURLOPT_HTTPHEADER, transfer->headers);
+	}
+
+	batch->active++;
+	curl_multi_add_handle(multi, easy);
+	transfers[easy] = std::move(transfer);
+}
+
+void CurlFetchBackend::StartTransfers(const shared_ptr<CurlBatch> &batch, FetchClock::time_point now, long &wait_ms) {
+	auto &request = batch->request;
+	auto delay = std::chrono::milliseconds(request.delay_ms);
+	idx_t i = 0;
+	while (i < batch->pending.size() && batch->active < request.concurrency) {
+		auto url_index = batch->pending[i];
+		if (request.delay_ms > 0) {
+			// Per-host delay within the batch, as the reqwest path
+			auto host = ExtractDomain(request.urls[url_index]);
+			auto next = batch->host_next_fetch.find(host);
+			if (next != batch->host_next_fetch.end() && next->second > now) {
+				auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(next->second - now).count();
+				wait_ms = MinValue<long>(wait_ms, static_cast<long>(remaining) + 1);
+				i++;
+				continue;
+			}
+			batch->host_next_fetch[host] = now + delay;
+		}
+		batch->pending.erase(batch->pending.begin() + static_cast<int64_t>(i));
+		StartTransfer(batch, url_index);
+	}
+}
+
+void CurlFetchBackend::FinishTransfer(CURL *easy, CURLcode code) {
+	auto entry = transfers.find(easy);
+	if (entry == transfers.end()) {
+		return;
+	}
+	auto transfer = std::move(entry->second);
+	transfers.erase(entry);
+	curl_multi_remove_handle(multi, easy);
+
+	auto &batch = *transfer->batch;
+	CurlFetchResult result;
+	result.url = batch.request.urls[transfer->url_index];
+	result.response_time_ms =
+	    std::chrono::duration_cast<std::chrono::milliseconds>(FetchClock::now() - transfer->started).count();
+	if (code == CURLE_OK) {
+		long status = 0;
+		curl_easy_getinfo(easy, CURLINFO_RESPONSE_CODE, &status);
+		char *effective_url = nullptr;
+		curl_easy_getinfo(easy, CURLINFO_EFFECTIVE_URL, &effective_url);
+		result.status = static_cast<int32_t>(status);
+		result.final_url = effective_url ? effective_url : result.url;
+		result.content_type = std::move(transfer->content_type);
+		result.content_language = std::move(transfer->content_language);
+		// Decoded by the caller
+		result.body = std::move(transfer->body);
+	} else {
+		result.final_url = result.url;
+		result.error = transfer->error_buffer[0] ? transfer->error_buffer : curl_easy_strerror(code);
+		result.has_error = true;
+	}
+	{
+		std::lock_guard<std::mutex> guard(batch.lock);
+		batch.finished.push_back(std::move(result));
+	}
+	batch.ready.notify_one();
+	batch.active--;
+
+	curl_slist_free_all(transfer->headers);
+	curl_easy_cleanup(easy);
+}
+
+// Ctrl+C (all) or a cancelled batch: abandon its transfers, the batch returns what
+// it has (as the reqwest path)
+void CurlFetchBackend::CancelTransfers(bool all) {
+	for (auto entry = transfers.begin(); entry != transfers.end();) {
+		auto &batch = *entry->second->batch;
+		if (!all && !batch.cancelled) {
+			++entry;
+			continue;
+		}
+		curl_multi_remove_handle(multi, entry->first);
+		curl_slist_free_all(entry->second->headers);
+		curl_easy_cleanup(entry->first);
+		batch.active--;
+		entry = transfers.erase(entry);
+	}
+	for (auto &batch : running) {
+		if (all || batch->cancelled) {
+			batch->pending.clear();
+		}
+	}
+}
+
+void CurlFetchBackend::Run() {
+	while (true) {
+		{
+			std::lock_guard<std::mutex> guard(queue_lock);
+			for (auto &batch : queued) {
+				running.push_back(std::move(batch));
+			}
+			queued.clear();
+		}
+		CancelTransfers(IsInterrupted());
+
+		long wait_ms = 1000;
+		auto now = FetchClock::now();
+		for (auto &batch : running) {
+			StartTransfers(batch, now, wait_ms);
+		}
+
+		int still_running = 0;
+		curl_multi_perform(multi, &still_running);
+		int msgs_left = 0;
+		while (CURLMsg *msg = curl_multi_info_read(multi, &msgs_left)) {
+			if (msg->msg == CURLMSG_DONE) {
+				FinishTransfer(msg->easy_handle, msg->data.result);
+			}
+		}
+
+		// Tell callers their batch is complete
+		for (idx_t i = 0; i < running.size();) {
+			auto &batch = running[i];
+			if (batch->pending.empty() && batch->active == 0) {
+				{
+					std::lock_guard<std::mutex> guard(batch->lock);
+					batch->done = true;
+				}
+				batch->ready.notify_one();
+				running.erase(running.begin() + static_cast<int64_t>(i));
+			} else {
+				i++;
+			}
+		}
+
+		long curl_timeout = -1;
+		curl_multi_timeout(multi, &curl_timeout);
+		if (curl_timeout >= 0) {
+			wait_ms = MinValue<long>(wait_ms, curl_timeout);
+		}
+		// Woken early by curl_multi_wakeup() when a batch is queued
+		curl_multi_poll(multi, nullptr, 0, static_cast<int>(wait_ms), nullptr);
+	}
+}
+
+//===--------------------------------------------------------------------===//
+// CrawlBatch
+//===--------------------------------------------------------------------===//
+
+void CurlFetchBackend::Submit(const shared_ptr<CurlBatch> &batch) {
+	if (batch->pending.empty()) {
+		batch->done = true;
+		return;
+	}
+	{
+		std::lock_guard<std::mutex> guard(queue_lock);
+		queued.push_back(batch);
+	}
+	curl_multi_wakeup(multi);
+}
+
+// Hand each response to handle on the calling thread as its transfer finishes, until the
+// batch is done. On interrupt the batch is cancelled and returns what it has.
+void CurlFetchBackend::TakeResponses(CurlBatch &batch, const std::function<void(CurlFetchResult &)> &handle) {
+	while (true) {
+		vector<CurlFetchResult> taken;
+		bool done;
+		{
+			std::unique_lock<std::mutex> guard(batch.lock);
+			batch.ready.wait_for(guard, std::chrono::milliseconds(CURL_INTERRUPT_CHECK_MS),
+			                     [&]() { return batch.done || !batch.finished.empty(); });
+			taken.swap(batch.finished);
+			done = batch.done;
+		}
+		for (auto &result : taken) {
+			handle(result);
+		}
+		if (done) {
+			return;
+		}
+		if (IsInterrupted() && !batch.cancelled) {
+			batch.cancelled = true;
+			curl_multi_wakeup(multi);
+		}
+	}
+}
+
+// Drop pending URLs that robots.txt disallows. Each host's robots.txt is fetched once,
+// on the loop with the batch's settings; a missing or failed robots.txt allows all.
+void CurlFetchBackend::FilterByRobots(const shared_ptr<CurlBatch> &batch) {
+	auto &request = batch->request;
+	auto robots = make_shared_ptr<CurlBatch>();
+	robots->request.user_agent = request.user_agent;
+	robots->request.timeout_ms = request.timeout_ms;
+	robots->request.concurrency = request.concurrency;
+	robots->request.http_proxy = request.http_proxy;
+	robots->request.http_proxy_username = request.http_proxy_username;
+	robots->request.http_proxy_password = request.http_proxy_password;
+	vector<string> robots_urls(request.urls.size());
+	std::unordered_map<string, RobotsRules> rules;
+	for (auto i : batch->pending) {
+		robots_urls[i] = RobotsTxtUrl(request.urls[i]);
+		if (!robots_urls[i].empty() && rules.emplace(robots_urls[i], RobotsRules()).second) {
+			robots->pending.push_back(robots->request.urls.size());
+			robots->request.urls.push_back(robots_urls[i]);
+		}
+	}
+	Submit(robots);
+	TakeResponses(*robots, [&](CurlFetchResult &result) {
+		if (!result.has_error && result.status >= 200 && result.status < 300) {
+			auto robots_txt = DecodeBody(std::move(result.body), result.content_type);
+			rules[result.url] = RobotsParser::GetRulesForUserAgent(RobotsParser::Parse(robots_txt), request.user_agent);
+		}
+	});
+
+	vector<idx_t> allowed;
+	for (auto i : batch->pending) {
+		if (robots_urls[i].empty() || RobotsParser::IsAllowed(rules[robots_urls[i]], ExtractPath(request.urls[i]))) {
+			allowed.push_back(i);
+		}
+	}
+	batch->pending = std::move(allowed);
+}
+
+// "extracted" object of one result: the values map of the Rust extraction result
+static yyjson_mut_val *ExtractedJson(yyjson_mut_doc *doc, const string &body, const string &extraction_json) {
+	auto extraction = ExtractWithRust(body, extraction_json);
+	yyjson_doc *result_doc = yyjson_read(extraction.c_str(), extraction.size(), 0);
+	if (!result_doc) {
+		return yyjson_mut_null(doc);
+	}
+	auto values = yyjson_obj_get(yyjson_doc_get_root(result_doc), "values");
+	auto copy = values && yyjson_is_obj(values) ? yyjson_val_mut_copy(doc, values) : yyjson_mut_null(doc);
+	yyjson_doc_free(result_doc);
+	return copy;
+}
+
+static string ErrorResponse(const string &error) {
+	yyjson_mut_doc *doc = yyjson_mut_doc_new(nullptr);
+	yyjson_mut_val *root = yyjson_mut_obj(doc);
+	yyjson_mut_doc_set_root(doc, root);
+	yyjson_mut_obj_add_strncpy(doc, root, "error", error.c_str(), error.size());
+	size_t len = 0;
+	char *json = yyjson_mut_write(doc, 0, &len);
+	yyjson_mut_doc_free(doc);
+	string response = json ? string(json, len) : "{\"error\":\"Serialization error\"}";
+	free(json);
+	return response;
+}
+
+string CurlFetchBackend::CrawlBatch(const string &request_json) {
+	auto batch = make_shared_ptr<CurlBatch>();
+	string error;
+	if (!ParseCurlBatchRequest(request_json, batch->request, error)) {
+		return ErrorResponse(error);
+	}
+	auto &request = batch->request;
+
+	yyjson_mut_doc *doc = yyjson_mut_doc_new(nullptr);
+	yyjson_mut_val *root = yyjson_mut_obj(doc);
+	yyjson_mut_doc_set_root(doc, root);
+	yyjson_mut_val *results = yyjson_mut_arr(doc);
+	auto add_result = [&](CurlFetchResult &result) {
+		yyjson_mut_val *item = yyjson_mut_obj(doc);
+		yyjson_mut_obj_add_strncpy(doc, item, "url", result.url.c_str(), result.url.size());
+		yyjson_mut_obj_add_strncpy(doc, item, "final_url", result.final_url.c_str(), result.final_url.size());
+		yyjson_mut_obj_add_int(doc, item, "status", result.status);
+		yyjson_mut_obj_add_strncpy(doc, item, "content_type", result.content_type.c_str(),
+		                           result.content_type.size());
+		yyjson_mut_obj_add_strncpy(doc, item, "content_language", result.content_language.c_str(),
+		                           result.content_language.size());
+		yyjson_mut_obj_add_strncpy(doc, item, "body", result.body.c_str(), result.body.size());
+		if (result.has_error) {
+			yyjson_mut_obj_add_strncpy(doc, item, "error", result.error.c_str(), result.error.size());
+		} else {
+			yyjson_mut_obj_add_null(doc, item, "error");
+		}
+		if (!result.has_error && !request.extraction_json.empty()) {
+			yyjson_mut_obj_add_val(doc, item, "extracted", ExtractedJson(doc, result.body, request.extraction_json));
+		} else {
+			yyjson_mut_obj_add_null(doc, item, "extracted");
+		}
+		// Detected with the extraction, as crawl_batch_ffi does for reqwest responses
+		string language;
+		if (!result.has_error && request.detect_language) {
+			language = DetectPageLanguageWithRust(result.body, result.content_type, result.content_language);
+		}
+		if (!language.empty()) {
+			yyjson_mut_obj_add_strncpy(doc, item, "language", language.c_str(), language.size());
+		} else {
+			yyjson_mut_obj_add_null(doc, item, "language");
+		}
+		yyjson_mut_obj_add_uint(doc, item, "response_time_ms", static_cast<uint64_t>(result.response_time_ms));
+		yyjson_mut_arr_append(results, item);
+	};
+
+	// Invalid URLs are answered here, only fetchable URLs reach the loop
+	for (idx_t i = 0; i < request.urls.size(); i++) {
+		auto url_error = GetUrlValidationError(request.urls[i]);
+		if (!url_error.empty()) {
+			CurlFetchResult result;
+			result.url = request.urls[i];
+			result.final_url = request.urls[i];
+			result.error = url_error;
+			result.has_error = true;
+			add_result(result);
+		} else {
+			batch->pending.push_back(i);
+		}
+	}
+	if (request.respect_robots) {
+		FilterByRobots(batch);
+	}
+	Submit(batch);
+	TakeResponses(*batch, [&](CurlFetchResult &result) {
+		if (!result.has_error) {
+			result.body = DecodeBody(std::move(result.body), result.content_type);
+		}
+		add_result(result);
+	});
+	yyjson_mut_obj_add_val(doc, root, "results", results);
+
+	size_t len = 0;
+	char *json = yyjson_mut_write(doc, 0, &len);
+	yyjson_mut_doc_free(doc);
+	if (!json) {
+		return ErrorResponse("Serialization error");
+	}
+	string response(json, len);
+	free(json);
+	return response;
+}
+
+unique_ptr<FetchBackend> MakeCurlFetchBackend() {
+	return make_uniq<CurlFetchBackend>();
+}
+
+} // namespace duckdb
@@ -0,0 +1,89 @@
+// detect_language(text [, hint]) - language of a text as an ISO 639-1 code
+//
+//   SELECT detect_language(html_to_text(body)) FROM pages;
+//   SELECT detect_language(description, 'de') FROM products;
+//
+// Trigram-based detection in Rust (whatlang), fully offline. Only the first
+// DETECT_LANGUAGE_TEXT_BYTES of a value are read, so the cost per row is
+// bounded however long the text is; a vector is classified in one call. hint
+// is a language tag such as 'en-US' (e.g. a page's <html lang>); it is
+// returned when the text is too short or too mixed for a reliable answer.
+// NULL when nothing can be told.
+
+#include "detect_language_function.hpp"
+#include "rust_ffi.hpp"
+
+#include "duckdb/common/types/vector.hpp"
+#include "duckdb/function/scalar_function.hpp"
+#include "duckdb/main/extension/extension_loader.hpp"
+
+namespace duckdb {
+
+// Text prefix that is classified (TEXT_PREFIX_BYTES in rust_parser/src/language.rs)
+static constexpr idx_t DETECT_LANGUAGE_TEXT_BYTES = 4096;
+
+static string TextPrefix(const string_t &text) {
+	return string(text.GetData(), MinValue<idx_t>(text.GetSize(), DETECT_LANGUAGE_TEXT_BYTES));
+}
+
+// Classify a whole vector in one call into Rust: the texts (and hints) of its non-NULL rows are
+// gathered first. A NULL text is NULL; a NULL hint is no hint, so the two-argument form is not
+// NULL-in NULL-out on it.
+static void DetectLanguageFunction(DataChunk &args, ExpressionState &state, Vector &result) {
+	auto count = args.size();
+	bool has_hint = args.ColumnCount() > 1;
+	UnifiedVectorFormat text_data;
+	UnifiedVectorFormat hint_data;
+	args.data[0].ToUnifiedFormat(count, text_data);
+	if (has_hint) {
+		args.data[1].ToUnifiedFormat(count, hint_data);
+	}
+	auto texts = UnifiedVectorFormat::GetData<string_t>(text_data);
+	auto hint_values = has_hint ? UnifiedVectorFormat::GetData<string_t>(hint_data) : nullptr;
+
+	vector<idx_t> rows;
+	vector<string> prefixes;
+	vector<string> hints;
+	for (idx_t i = 0; i < count; i++) {
+		auto text_idx = text_data.sel->get_index(i);
+		if (!text_data.validity.RowIsValid(text_idx)) {
+			continue;
+		}
+		rows.push_back(i);
+		prefixes.push_back(TextPrefix(texts[text_idx]));
+		if (has_hint) {
+			auto hint_idx = hint_data.sel->get_index(i);
+			hints.push_back(hint_data.validity.RowIsValid(hint_idx) ? hint_values[hint_idx].GetString() : string());
+		}
+	}
+	auto languages = DetectLanguagesWithRust(prefixes, hints);
+
+	result.SetVectorType(VectorType::FLAT_VECTOR);
+	auto result_data = FlatVector::GetData<string_t>(result);
+	auto &result_mask = FlatVector::Validity(result);
+	for (idx_t i = 0; i < count; i++) {
+		result_mask.SetInvalid(i);
+	}
+	for (idx_t r = 0; r < rows.size(); r++) {
+		if (languages[r].empty()) {
+			continue;
+		}
+		result_mask.SetValid(rows[r]);
+		result_data[rows[r]] = StringVector::AddString(result, languages[r]);
+	}
+	if (args.AllConstant()) {
+		result.SetVectorType(VectorType::CONSTANT_VECTOR);
+	}
+}
+
+void RegisterDetectLanguageFunction(ExtensionLoader &loader) {
+	ScalarFunctionSet detect_language("detect_language");
+	detect_language.AddFunction(ScalarFunction({LogicalType::VARCHAR}, LogicalType::VARCHAR, DetectLanguageFunction));
+	ScalarFunction with_hint({LogicalType::VARCHAR, LogicalType::VARCHAR}, LogicalType::VARCHAR,
+	                         DetectLanguageFunction);
+	with_hint.null_handling = FunctionNullHandling::SPECIAL_HANDLING;
+	detect_language.AddFunction(with_hint);
+	loader.RegisterFunction(detect_language);
+}
+
+} // namespace duckdb
@@ -0,0 +1,196 @@
+// Extraction memo - per-connection memoization of HTML extraction results
+//
+//   SET crawler_extract_memo = true;
+//   SELECT jq(body, '.price').text FROM pages;   -- parses every body
+//   SELECT jq(body, '.price').text FROM pages;   -- served from the memo
+//
+// The memo is opt-in and lives in memory only: a ClientContextState holds it,
+// so it is shared by the queries of one connection and dropped with it, and a
+// scalar function never writes to the database. Keys are the SHA-256 of the
+// HTML plus the exact function name and spec, so a hit is always the result
+// for the same bytes and selector. The memo is bounded by
+// EXTRACT_MEMO_MAX_BYTES and cleared when full.
+//
+//   SELECT * FROM crawler_extract_memo_stats();
+
+#include "extract_memo.hpp"
+
+#include "duckdb/common/types/hash.hpp"
+#include "duckdb/function/table_function.hpp"
+#include "duckdb/main/client_context.hpp"
+#include "duckdb/main/client_context_state.hpp"
+#include "mbedtls_wrapper.hpp"
+
+#include <cstring>
+#include <mutex>
+#include <unordered_map>
+
+namespace duckdb {
+
+static constexpr const char *EXTRACT_MEMO_STATE = "crawler_extract_memo";
+// Bytes of keys and results kept per connection; the memo is cleared when full
+static constexpr idx_t EXTRACT_MEMO_MAX_BYTES = 64 * 1024 * 1024;
+// Map node and string headers per entry, counted against the bound
+static constexpr idx_t EXTRACT_MEMO_ENTRY_OVERHEAD = 96;
+
+struct ExtractMemoKey {
+	string body_digest; // SHA-256 of the HTML
+	string spec;        // function NUL spec
+
+	bool operator==(const ExtractMemoKey &other) const {
+		return body_digest == other.body_digest && spec == other.spec;
+	}
+};
+
+struct ExtractMemoKeyHash {
+	size_t operator()(const ExtractMemoKey &key) const {
+		// The digest is uniform already
+		uint64_t value;
+		memcpy(&value, key.body_digest.data(), sizeof(value));
+		return CombineHash(value, Hash(key.spec.data(), key.spec.size()));
+	}
+};
+
+//===--------------------------------------------------------------------===//
+// Per-connection memo state
+//===--------------------------------------------------------------------===//
+
+class ExtractMemoState : public ClientContextState {
+public:
+	std::mutex lock;
+	std::unordered_map<ExtractMemoKey, string, ExtractMemoKeyHash> entries;
+	idx_t bytes = 0;
+	idx_t hits = 0;
+	idx_t misses = 0;
+};
+
+static shared_ptr<ExtractMemoState> GetMemoState(ClientContext &context) {
+	return context.registered_state->GetOrCreate<ExtractMemoState>(EXTRACT_MEMO_STATE);
+}
+
+static string BodyDigest(const string_t &html) {
+	duckdb_mbedtls::MbedTlsWrapper::SHA256State state;
+	state.AddString(string(html.GetData(), html.GetSize()));
+	return state.Finalize();
+}
+
+static bool MemoEnabled(ClientContext &context) {
+	Value setting_value;
+	if (context.TryGetCurrentSetting("crawler_extract_memo", setting_value) && !setting_value.IsNull()) {
+		return setting_value.GetValue<bool>();
+	}
+	return false;
+}
+
+//===--------------------------------------------------------------------===//
+// ExtractMemoized
+//===--------------------------------------------------------------------===//
+
+vector<string> ExtractMemoized(ExpressionState &state, const string &function,
+                               const vector<ExtractMemoRequest> &requests, const ExtractMemoFunction &extract) {
+	vector<string> results(requests.size());
+	if (!state.HasContext() || !MemoEnabled(state.GetContext())) {
+		for (idx_t i = 0; i < requests.size(); i++) {
+			results[i] = extract(requests[i].html.GetString(), requests[i].spec);
+		}
+		return results;
+	}
+	auto memo = GetMemoState(state.GetContext());
+
+	vector<ExtractMemoKey> keys(requests.size());
+	for (idx_t i = 0; i < requests.size(); i++) {
+		keys[i] = {BodyDigest(requests[i].html), function + '\0' + requests[i].spec};
+	}
+
+	vector<idx_t> missing;
+	{
+		std::lock_guard<std::mutex> guard(memo->lock);
+		for (idx_t i = 0; i < requests.size(); i++) {
+			auto entry = memo->entries.find(keys[i]);
+			if (entry != memo->entries.end()) {
+				results[i] = entry->second;
+				memo->hits++;
+			} else {
+				missing.push_back(i);
+			}
+		}
+		memo->misses += missing.size();
+	}
+	if (missing.empty()) {
+		return results;
+	}
+
+	// Extract outside the lock, once per distinct key of the chunk
+	std::unordered_map<ExtractMemoKey, idx_t, ExtractMemoKeyHash> extracted;
+	for (auto i : missing) {
+		auto entry = extracted.find(keys[i]);
+		if (entry != extracted.end()) {
+			results[i] = results[entry->second];
+			continue;
+		}
+		results[i] = extract(requests[i].html.GetString(), requests[i].spec);
+		extracted.emplace(keys[i], i);
+	}
+
+	std::lock_guard<std::mutex> guard(memo->lock);
+	for (auto &entry : extracted) {
+		idx_t entry_bytes = entry.first.body_digest.size() + entry.first.spec.size() + results[entry.second].size() +
+		                    EXTRACT_MEMO_ENTRY_OVERHEAD;
+		if (entry_bytes > EXTRACT_MEMO_MAX_BYTES) {
+			continue;
+		}
+		if (memo->bytes + entry_bytes > EXTRACT_MEMO_MAX_BYTES) {
+			memo->entries.clear();
+			memo->bytes = 0;
+		}
+		if (memo->entries.emplace(entry.first, results[entry.second]).second) {
+			memo->bytes += entry_bytes;
+		}
+	}
+	return results;
+}
+
+//===--------------------------------------------------------------------===//
+// crawler_extract_memo_stats()
+//===--------------------------------------------------------------------===//
+
+struct ExtractMemoStatsGlobalState : public GlobalTableFunctionState {
+	bool finished = false;
+};
+
+static unique_ptr<FunctionData> ExtractMemoStatsBind(ClientContext &context, TableFunctionBindInput &input,
+                                                     vector<LogicalType> &return_types, vector<string> &names) {
+	names = {"entries", "bytes", "hits", "misses"};
+	return_types = vector<LogicalType>(names.size(), LogicalType::BIGINT);
+	return make_uniq<TableFunctionData>();
+}
+
+static unique_ptr<GlobalTableFunctionState> ExtractMemoStatsInitGlobal(ClientContext &context,
+                                                                       TableFunctionInitInput &input) {
+	return make_uniq<ExtractMemoStatsGlobalState>();
+}
+
+static void ExtractMemoStatsFunction(ClientContext &context, TableFunctionInput &data, DataChunk &output) {
+	auto &gstate = data.global_state->Cast<ExtractMemoStatsGlobalState>();
+	if (gstate.finished) {
+		output.SetCardinality(0);
+		return;
+	}
+	gstate.finished = true;
+
+	auto memo = GetMemoState(context);
+	std::lock_guard<std::mutex> guard(memo->lock);
+	output.SetValue(0, 0, Value::BIGINT(static_cast<int64_t>(memo->entries.size())));
+	output.SetValue(1, 0, Value::BIGINT(static_cast<int64_t>(memo->bytes)));
+	output.SetValue(2, 0, Value::BIGINT(static_cast<int64_t>(memo->hits)));
+	output.SetValue(3, 0, Value::BIGINT(static_cast<int64_t>(memo->misses)));
+	output.SetCardinality(1);
+}
+
+void RegisterExtractMemoFunctions(ExtensionLoader &loader) {
+	TableFunction stats("crawler_extract_memo_stats", {}, ExtractMemoStatsFunction, ExtractMemoStatsBind,
+	                    ExtractMemoStatsInitGlobal);
+	loader.RegisterFunction(stats);
+}
+
+} // namespace duckdb
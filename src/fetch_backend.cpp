@@ -0,0 +1,80 @@
+#include "fetch_backend.hpp"
+#include "rust_ffi.hpp"
+
+#include "duckdb/main/client_context.hpp"
+
+#include <mutex>
+
+namespace duckdb {
+
+//===--------------------------------------------------------------------===//
+// reqwest (Rust)
+//===--------------------------------------------------------------------===//
+
+class ReqwestFetchBackend : public FetchBackend {
+public:
+	string CrawlBatch(const string &request_json) override {
+		return CrawlBatchWithRust(request_json);
+	}
+};
+
+//===--------------------------------------------------------------------===//
+// Selection
+//===--------------------------------------------------------------------===//
+
+bool TryParseFetchBackendType(const string &name, FetchBackendType &type) {
+	auto lowered = StringUtil::Lower(name);
+	if (lowered == "reqwest") {
+		type = FetchBackendType::REQWEST;
+	} else if (lowered == "curl") {
+		type = FetchBackendType::CURL;
+	} else {
+		return false;
+	}
+	return true;
+}
+
+void SetFetchBackendCallback(ClientContext &context, SetScope scope, Value &parameter) {
+	FetchBackendType type;
+	if (!parameter.IsNull() && !TryParseFetchBackendType(parameter.ToString(), type)) {
+		throw InvalidInputException("crawler_fetch_backend must be 'reqwest' or 'curl', got '%s'",
+		                            parameter.ToString());
+	}
+}
+
+FetchBackendType LoadFetchBackendType(ClientContext &context) {
+	auto type = FetchBackendType::REQWEST;
+	Value setting_value;
+	if (context.TryGetCurrentSetting("crawler_fetch_backend", setting_value) && !setting_value.IsNull()) {
+		if (!TryParseFetchBackendType(setting_value.ToString(), type)) {
+			throw InvalidInputException("crawler_fetch_backend must be 'reqwest' or 'curl', got '%s'",
+			                            setting_value.ToString());
+		}
+	}
+	return type;
+}
+
+// Backends are never destroyed: the curl event loop thread may still be running at process exit
+static std::mutex g_fetch_backends_mutex;
+static FetchBackend *g_reqwest_backend = nullptr;
+static FetchBackend *g_curl_backend = nullptr;
+
+FetchBackend &GetFetchBackend(FetchBackendType type) {
+	std::lock_guard<std::mutex> guard(g_fetch_backends_mutex);
+	if (type == FetchBackendType::CURL) {
+		if (!g_curl_backend) {
+			g_curl_backend = MakeCurlFetchBackend().release();
+		}
+		return *g_curl_backend;
+	}
+	if (!g_reqwest_backend) {
+		g_reqwest_backend = new ReqwestFetchBackend();
+	}
+	return *g_reqwest_backend;
+}
+
+string CrawlBatchWithBackend(FetchBackendType type, const string &request_json) {
+	return GetFetchBackend(type).CrawlBatch(request_json);
+}
+
+} // namespace duckdb
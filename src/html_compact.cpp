@@ -0,0 +1,297 @@
+// Compact HTML bodies for storage (crawl(store_body := ...), crawler_store_body)
+//
+//   SELECT url, html.document FROM crawl(urls, store_body := 'minified');
+//   SET crawler_store_body = 'main_content';  -- CRAWL INTO / crawl_to_parquet
+//
+// A single pass over the raw bytes, like html_to_text(): markup is copied
+// through unchanged except for the dropped elements and whitespace runs, so no
+// DOM is built and attribute values are never rewritten.
+
+#include "html_compact.hpp"
+#include "html_tokenizer.hpp"
+
+#include "duckdb/main/client_context.hpp"
+
+#include <cstring>
+
+namespace duckdb {
+
+// Content type parameter recording the mode of a cached compact body
+static constexpr const char *STORE_BODY_PARAM = "; x-store-body=";
+
+// Removed with their content (JSON data scripts excepted)
+static const char *const DROP_TAGS[] = {"script", "style", "noscript", "template", "svg", nullptr};
+// Whitespace is significant
+static const char *const PRESERVE_TAGS[] = {"pre", "textarea", nullptr};
+
+//===--------------------------------------------------------------------===//
+// Scanner (html_tokenizer.hpp) over std::string bodies
+//===--------------------------------------------------------------------===//
+
+static bool TagIs(const string &html, const HtmlTag &tag, const char *name) {
+	return HtmlTagIs(html.data() + tag.name_start, tag.name_len, name);
+}
+
+static bool TagIn(const string &html, const HtmlTag &tag, const char *const *names) {
+	return HtmlTagIn(html.data() + tag.name_start, tag.name_len, names);
+}
+
+static string TagName(const string &html, const HtmlTag &tag) {
+	return StringUtil::Lower(html.substr(tag.name_start, tag.name_len));
+}
+
+// Index just past the '>' of the end tag starting at pos
+static idx_t EndTagEnd(const string &html, idx_t pos) {
+	auto gt = html.find('>', pos);
+	return gt == string::npos ? html.size() : gt + 1;
+}
+
+// Lowercased value of attr in the tag, empty if missing
+static string TagAttribute(const string &html, const HtmlTag &tag, const char *attr) {
+	return StringUtil::Lower(HtmlTagAttribute(html.data(), tag.attr_start, tag.attr_end, attr));
+}
+
+static bool NextTag(const string &html, idx_t &pos, HtmlTag &tag) {
+	return NextHtmlTag(html.data(), html.size(), pos, tag);
+}
+
+//===--------------------------------------------------------------------===//
+// Minify
+//===--------------------------------------------------------------------===//
+
+static bool IsHtmlSpace(char c) {
+	return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\f';
+}
+
+// Text html[start, end): whitespace runs become one space unless preserved
+static void AppendText(const string &html, idx_t start, idx_t end, bool preserve_whitespace, string &out) {
+	if (preserve_whitespace) {
+		out.append(html, start, end - start);
+		return;
+	}
+	for (idx_t i = start; i < end; i++) {
+		char c = html[i];
+		if (IsHtmlSpace(c)) {
+			if (out.empty() || IsHtmlSpace(out.back())) {
+				continue;
+			}
+			c = ' ';
+		}
+		out += c;
+	}
+}
+
+// JSON data islands (schema.org JSON-LD, __NEXT_DATA__, ...) are content, not code
+static bool IsDataScript(const string &html, const HtmlTag &tag) {
+	return TagIs(html, tag, "script") && TagAttribute(html, tag, "type").find("json") != string::npos;
+}
+
+// Minified html[begin, end) appended to out
+static void MinifyRange(const string &html, idx_t begin, idx_t end, string &out) {
+	idx_t preserve_depth = 0;
+	idx_t pos = begin;
+	while (pos < end) {
+		auto lt = html.find('<', pos);
+		if (lt == string::npos || lt > end) {
+			lt = end;
+		}
+		AppendText(html, pos, lt, preserve_depth > 0, out);
+		if (lt >= end) {
+			break;
+		}
+
+		// Comments are dropped, doctype / processing instructions kept
+		if (html.compare(lt, 4, "<!--") == 0) {
+			pos = FindHtmlCommentEnd(html.data(), lt + 4, html.size());
+			continue;
+		}
+		if (lt + 1 < html.size() && (html[lt + 1] == '!' || html[lt + 1] == '?')) {
+			pos = EndTagEnd(html, lt);
+			out.append(html, lt, pos - lt);
+			continue;
+		}
+
+		HtmlTag tag;
+		if (!ReadHtmlTag(html.data(), html.size(), lt, tag)) {
+			out += '<';
+			pos = lt + 1;
+			continue;
+		}
+		pos = tag.end;
+
+		if (!tag.closing && TagIn(html, tag, DROP_TAGS)) {
+			if (tag.self_closing) {
+				continue;
+			}
+			idx_t close = FindHtmlEndTag(html.data(), tag.end, html.size(), TagName(html, tag));
+			idx_t close_end = close < html.size() ? EndTagEnd(html, close) : close;
+			if (IsDataScript(html, tag)) {
+				out.append(html, tag.start, tag.end - tag.start);
+				auto content = html.substr(tag.end, close - tag.end);
+				StringUtil::Trim(content);
+				out += content;
+				out.append(html, close, close_end - close);
+			}
+			pos = close_end;
+			continue;
+		}
+		if (TagIn(html, tag, PRESERVE_TAGS) && !tag.self_closing) {
+			if (!tag.closing) {
+				preserve_depth++;
+			} else if (preserve_depth > 0) {
+				preserve_depth--;
+			}
+		}
+		out.append(html, tag.start, tag.end - tag.start);
+	}
+}
+
+//===--------------------------------------------------------------------===//
+// Main content
+//===--------------------------------------------------------------------===//
+
+// Index just past the end tag matching the opening tag (size if unclosed)
+static idx_t FindElementEnd(const string &html, const HtmlTag &open) {
+	auto name = TagName(html, open);
+	idx_t depth = 1;
+	idx_t pos = open.end;
+	HtmlTag tag;
+	while (NextTag(html, pos, tag)) {
+		if (tag.self_closing || !TagIs(html, tag, name.c_str())) {
+			continue;
+		}
+		if (!tag.closing) {
+			depth++;
+		} else if (--depth == 0) {
+			return tag.end;
+		}
+	}
+	return html.size();
+}
+
+struct MainContentRange {
+	idx_t prefix_end = 0;  // <head> and the <body> tag are kept from [0, prefix_end)
+	bool has_body = false; // Close the kept <body>
+	idx_t start = 0;
+	idx_t end = 0;
+};
+
+// Locate <main>, else the first [role=main], else the first <article>
+static bool FindMainContent(const string &html, MainContentRange &range) {
+	HtmlTag best;
+	int best_rank = 0; // 3 = <main>, 2 = [role=main], 1 = <article>
+	idx_t body_end = 0;
+	idx_t head_end = 0;
+	idx_t pos = 0;
+	HtmlTag tag;
+	while (best_rank < 3 && NextTag(html, pos, tag)) {
+		if (tag.closing) {
+			if (head_end == 0 && TagIs(html, tag, "head")) {
+				head_end = tag.end;
+			}
+			continue;
+		}
+		int rank = 0;
+		if (TagIs(html, tag, "main")) {
+			rank = 3;
+		} else if (TagAttribute(html, tag, "role") == "main") {
+			rank = 2;
+		} else if (TagIs(html, tag, "article")) {
+			rank = 1;
+		} else if (body_end == 0 && TagIs(html, tag, "body")) {
+			body_end = tag.end;
+		}
+		if (rank > best_rank) {
+			best = tag;
+			best_rank = rank;
+		}
+	}
+	if (best_rank == 0 || best.self_closing) {
+		return false;
+	}
+	range.start = best.start;
+	range.end = FindElementEnd(html, best);
+	range.has_body = body_end > 0 && body_end <= best.start;
+	range.prefix_end = range.has_body ? body_end : (head_end <= best.start ? head_end : 0);
+	return true;
+}
+
+//===--------------------------------------------------------------------===//
+// Public
+//===--------------------------------------------------------------------===//
+
+bool TryParseStoreBodyMode(const string &name, StoreBodyMode &mode) {
+	auto lowered = StringUtil::Lower(name);
+	if (lowered == "raw") {
+		mode = StoreBodyMode::RAW;
+	} else if (lowered == "minified") {
+		mode = StoreBodyMode::MINIFIED;
+	} else if (lowered == "main_content") {
+		mode = StoreBodyMode::MAIN_CONTENT;
+	} else {
+		return false;
+	}
+	return true;
+}
+
+static const char *StoreBodyModeName(StoreBodyMode mode) {
+	switch (mode) {
+	case StoreBodyMode::MINIFIED:
+		return "minified";
+	case StoreBodyMode::MAIN_CONTENT:
+		return "main_content";
+	default:
+		return "raw";
+	}
+}
+
+StoreBodyMode LoadStoreBodyMode(ClientContext &context) {
+	auto mode = StoreBodyMode::RAW;
+	Value setting_value;
+	if (context.TryGetCurrentSetting("crawler_store_body", setting_value) && !setting_value.IsNull()) {
+		if (!TryParseStoreBodyMode(setting_value.ToString(), mode)) {
+			throw InvalidInputException("crawler_store_body must be 'raw', 'minified' or 'main_content', got '%s'",
+			                            setting_value.ToString());
+		}
+	}
+	return mode;
+}
+
+string CompactHtmlBody(const string &body, const string &content_type, StoreBodyMode mode) {
+	if (mode == StoreBodyMode::RAW || body.empty() || StringUtil::Lower(content_type).find("html") == string::npos) {
+		return body;
+	}
+	string out;
+	out.reserve(body.size() / 2);
+	MainContentRange range;
+	if (mode == StoreBodyMode::MAIN_CONTENT && FindMainContent(body, range)) {
+		MinifyRange(body, 0, range.prefix_end, out);
+		MinifyRange(body, range.start, range.end, out);
+		if (range.has_body) {
+			out += "</body></html>";
+		}
+		return out;
+	}
+	MinifyRange(body, 0, body.size(), out);
+	return out;
+}
+
+string TagStoredContentType(const string &content_type, StoreBodyMode mode) {
+	if (mode == StoreBodyMode::RAW || StringUtil::Lower(content_type).find("html") == string::npos) {
+		return content_type;
+	}
+	return content_type + STORE_BODY_PARAM + StoreBodyModeName(mode);
+}
+
+bool UntagStoredContentType(string &content_type, StoreBodyMode &mode) {
+	mode = StoreBodyMode::RAW;
+	auto pos = content_type.rfind(STORE_BODY_PARAM);
+	if (pos == string::npos) {
+		return true;
+	}
+	bool known = TryParseStoreBodyMode(content_type.substr(pos + strlen(STORE_BODY_PARAM)), mode);
+	content_type.erase(pos);
+	return known;
+}
+
+} // namespace duckdb
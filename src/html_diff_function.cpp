@@ -0,0 +1,332 @@
+// html_changed(old, new [, options]) / html_diff(old, new [, options]) - change detection for recrawled pages
+//
+//   SELECT url FROM prev JOIN cur USING (url) WHERE html_changed(prev.body, cur.body);
+//   SELECT html_diff(prev.body, cur.body, {'ignore': ['.ad', '#csrf', '[data-ts]']}).added FROM ...;
+//
+// Both pages are reduced to their visible text blocks with the html_to_text
+// tokenizer (one block per paragraph, heading, list item, table row, ...), so
+// markup, attributes, scripts and styles never count as a change. Each block
+// is hashed, and the two pages are compared as multisets of block hashes:
+//
+//   change_ratio = (removed blocks + added blocks) / (old blocks + new blocks)
+//
+// A moved block is not a change. Byte-identical pages are answered without
+// tokenizing, and all buffers are reused across the rows of a chunk.
+//
+// Options (STRUCT, all optional):
+//   ignore          VARCHAR[] volatile elements left out, as html_to_text's
+//                             'ignore' selectors ('.ad', '#csrf', '[data-ts]')
+//   ignore_numbers  BOOLEAN   compare blocks with every digit run replaced, so
+//                             counters, dates and timestamps do not count
+//   threshold       DOUBLE    changed = change_ratio > threshold (default 0)
+//
+// html_changed returns changed; html_diff returns
+// STRUCT(changed BOOLEAN, change_ratio DOUBLE, removed VARCHAR[], added VARCHAR[])
+// with the removed and added blocks in document order. NULL if either page is NULL.
+
+#include "html_diff_function.hpp"
+#include "html_to_text_function.hpp"
+
+#include "duckdb/common/types/hash.hpp"
+#include "duckdb/common/vector_operations/binary_executor.hpp"
+#include "duckdb/execution/expression_executor.hpp"
+#include "duckdb/function/scalar_function.hpp"
+#include "duckdb/main/extension/extension_loader.hpp"
+#include "duckdb/planner/expression/bound_function_expression.hpp"
+
+#include <algorithm>
+
+namespace duckdb {
+
+struct HtmlDiffOptions {
+	HtmlToTextOptions text;
+	bool ignore_numbers = false;
+	double threshold = 0;
+
+	bool operator==(const HtmlDiffOptions &other) const {
+		return text == other.text && ignore_numbers == other.ignore_numbers && threshold == other.threshold;
+	}
+};
+
+struct HtmlDiffBindData : public FunctionData {
+	HtmlDiffOptions options;
+
+	unique_ptr<FunctionData> Copy() const override {
+		auto copy = make_uniq<HtmlDiffBindData>();
+		copy->options = options;
+		return std::move(copy);
+	}
+	bool Equals(const FunctionData &other) const override {
+		return options == other.Cast<HtmlDiffBindData>().options;
+	}
+};
+
+//===--------------------------------------------------------------------===//
+// Block comparison
+//===--------------------------------------------------------------------===//
+
+struct HtmlTextBlock {
+	hash_t hash;
+	// Position in the page (document order) and the block's bytes in the page text
+	uint32_t index;
+	uint32_t offset;
+	uint32_t length;
+	bool matched;
+};
+
+struct HtmlPageBlocks {
+	string text;
+	vector<HtmlTextBlock> blocks;
+};
+
+class HtmlBlockDiffer {
+public:
+	explicit HtmlBlockDiffer(const HtmlDiffOptions &options_p) : options(options_p) {
+		options.text.block_whitespace = true;
+		options.text.max_length = 0;
+	}
+
+	// Compare two pages; the unmatched blocks are left in old_page / new_page for Changed()
+	double Compare(const string_t &old_html, const string_t &new_html) {
+		if (old_html == new_html) {
+			old_page.blocks.clear();
+			new_page.blocks.clear();
+			return 0;
+		}
+		Split(old_html, old_page);
+		Split(new_html, new_page);
+		idx_t total = old_page.blocks.size() + new_page.blocks.size();
+		if (total == 0) {
+			return 0;
+		}
+		// Merge the hash-sorted blocks; equal hashes pair up one to one
+		idx_t matched = 0;
+		idx_t i = 0;
+		idx_t j = 0;
+		auto &old_blocks = old_page.blocks;
+		auto &new_blocks = new_page.blocks;
+		while (i < old_blocks.size() && j < new_blocks.size()) {
+			if (old_blocks[i].hash < new_blocks[j].hash) {
+				i++;
+			} else if (new_blocks[j].hash < old_blocks[i].hash) {
+				j++;
+			} else {
+				old_blocks[i++].matched = true;
+				new_blocks[j++].matched = true;
+				matched++;
+			}
+		}
+		return double(total - 2 * matched) / double(total);
+	}
+
+	bool IsChanged(double change_ratio) const {
+		return change_ratio > options.threshold;
+	}
+
+	// Text of the unmatched blocks of a page from the last Compare(), in document order
+	void Changed(HtmlPageBlocks &page, vector<string_t> &out) {
+		changed.clear();
+		for (auto &block : page.blocks) {
+			if (!block.matched) {
+				changed.push_back(block);
+			}
+		}
+		std::sort(changed.begin(), changed.end(),
+		          [](const HtmlTextBlock &a, const HtmlTextBlock &b) { return a.index < b.index; });
+		out.clear();
+		for (auto &block : changed) {
+			out.emplace_back(page.text.c_str() + block.offset, block.length);
+		}
+	}
+
+	HtmlPageBlocks old_page;
+	HtmlPageBlocks new_page;
+
+private:
+	// One block per non-empty line of the page text, sorted by hash
+	void Split(const string_t &html, HtmlPageBlocks &page) {
+		HtmlToText(html.GetData(), html.GetSize(), options.text, page.text);
+		page.blocks.clear();
+		auto &text = page.text;
+		idx_t start = 0;
+		while (start < text.size()) {
+			auto end = text.find('\n', start);
+			if (end == string::npos) {
+				end = text.size();
+			}
+			if (end > start) {
+				HtmlTextBlock block;
+				block.hash = BlockHash(text.c_str() + start, end - start);
+				block.index = NumericCast<uint32_t>(page.blocks.size());
+				block.offset = NumericCast<uint32_t>(start);
+				block.length = NumericCast<uint32_t>(end - start);
+				block.matched = false;
+				page.blocks.push_back(block);
+			}
+			start = end + 1;
+		}
+		std::sort(page.blocks.begin(), page.blocks.end(),
+		          [](const HtmlTextBlock &a, const HtmlTextBlock &b) { return a.hash < b.hash; });
+	}
+
+	hash_t BlockHash(const char *data, idx_t len) {
+		if (!options.ignore_numbers) {
+			return Hash(data, len);
+		}
+		// Every run of digits (with separators inside it, as in 12:30 or 1,024.5) becomes one '#'
+		normalized.clear();
+		for (idx_t i = 0; i < len; i++) {
+			if (!StringUtil::CharacterIsDigit(data[i])) {
+				normalized += data[i];
+				continue;
+			}
+			while (i + 1 < len && (StringUtil::CharacterIsDigit(data[i + 1]) ||
+			                       ((data[i + 1] == '.' || data[i + 1] == ',' || data[i + 1] == ':') && i + 2 < len &&
+			                        StringUtil::CharacterIsDigit(data[i + 2])))) {
+				i++;
+			}
+			normalized += '#';
+		}
+		return Hash(normalized.c_str(), normalized.size());
+	}
+
+	HtmlDiffOptions options;
+	string normalized;
+	vector<HtmlTextBlock> changed;
+};
+
+//===--------------------------------------------------------------------===//
+// Scalar functions
+//===--------------------------------------------------------------------===//
+
+static void HtmlChangedFunction(DataChunk &args, ExpressionState &state, Vector &result) {
+	auto &func_expr = state.expr.Cast<BoundFunctionExpression>();
+	auto &options = func_expr.bind_info->Cast<HtmlDiffBindData>().options;
+
+	// One differ (and its text buffers) for every row of the chunk
+	HtmlBlockDiffer differ(options);
+	BinaryExecutor::Execute<string_t, string_t, bool>(
+	    args.data[0], args.data[1], result, args.size(),
+	    [&](string_t old_html, string_t new_html) { return differ.IsChanged(differ.Compare(old_html, new_html)); });
+}
+
+static void SetBlockList(Vector &list, idx_t row, const vector<string_t> &blocks) {
+	auto list_data = FlatVector::GetData<list_entry_t>(list);
+	auto &child = ListVector::GetEntry(list);
+	auto offset = ListVector::GetListSize(list);
+	ListVector::Reserve(list, offset + blocks.size());
+	auto child_data = FlatVector::GetData<string_t>(child);
+	for (idx_t b = 0; b < blocks.size(); b++) {
+		child_data[offset + b] = StringVector::AddString(child, blocks[b]);
+	}
+	list_data[row] = list_entry_t(offset, blocks.size());
+	ListVector::SetListSize(list, offset + blocks.size());
+}
+
+static void HtmlDiffFunction(DataChunk &args, ExpressionState &state, Vector &result) {
+	auto &func_expr = state.expr.Cast<BoundFunctionExpression>();
+	auto &options = func_expr.bind_info->Cast<HtmlDiffBindData>().options;
+
+	UnifiedVectorFormat old_data;
+	UnifiedVectorFormat new_data;
+	args.data[0].ToUnifiedFormat(args.size(), old_data);
+	args.data[1].ToUnifiedFormat(args.size(), new_data);
+	auto old_pages = UnifiedVectorFormat::GetData<string_t>(old_data);
+	auto new_pages = UnifiedVectorFormat::GetData<string_t>(new_data);
+
+	result.SetVectorType(VectorType::FLAT_VECTOR);
+	auto &fields = StructVector::GetEntries(result);
+	auto changed_data = FlatVector::GetData<bool>(*fields[0]);
+	auto ratio_data = FlatVector::GetData<double>(*fields[1]);
+	auto &removed_list = *fields[2];
+	auto &added_list = *fields[3];
+
+	HtmlBlockDiffer differ(options);
+	vector<string_t> blocks;
+	for (idx_t i = 0; i < args.size(); i++) {
+		auto old_idx = old_data.sel->get_index(i);
+		auto new_idx = new_data.sel->get_index(i);
+		if (!old_data.validity.RowIsValid(old_idx) || !new_data.validity.RowIsValid(new_idx)) {
+			FlatVector::SetNull(result, i, true);
+			continue;
+		}
+		auto change_ratio = differ.Compare(old_pages[old_idx], new_pages[new_idx]);
+		changed_data[i] = differ.IsChanged(change_ratio);
+		ratio_data[i] = change_ratio;
+		differ.Changed(differ.old_page, blocks);
+		SetBlockList(removed_list, i, blocks);
+		differ.Changed(differ.new_page, blocks);
+		SetBlockList(added_list, i, blocks);
+	}
+	if (args.AllConstant()) {
+		result.SetVectorType(VectorType::CONSTANT_VECTOR);
+	}
+}
+
+static unique_ptr<FunctionData> HtmlDiffBind(ClientContext &context, ScalarFunction &bound_function,
+                                             vector<unique_ptr<Expression>> &arguments) {
+	auto &name = bound_function.name;
+	auto bind_data = make_uniq<HtmlDiffBindData>();
+	if (arguments.size() < 3) {
+		return std::move(bind_data);
+	}
+	auto &options_arg = arguments[2];
+	if (options_arg->HasParameter() || !options_arg->IsFoldable()) {
+		throw BinderException("%s: options must be a constant STRUCT", name);
+	}
+	auto options_value = ExpressionExecutor::EvaluateScalar(context, *options_arg);
+	if (options_value.type().id() != LogicalTypeId::STRUCT) {
+		throw BinderException("%s: options must be a STRUCT, e.g. {'ignore': ['.ad']}", name);
+	}
+	if (!options_value.IsNull()) {
+		auto &children = StructValue::GetChildren(options_value);
+		for (idx_t i = 0; i < children.size(); i++) {
+			auto key = StringUtil::Lower(StructType::GetChildName(options_value.type(), i));
+			auto &value = children[i];
+			if (value.IsNull()) {
+				continue;
+			}
+			if (key == "ignore") {
+				bind_data->options.text.ignore = ParseHtmlIgnoreOption(name, value);
+			} else if (key == "ignore_numbers") {
+				bind_data->options.ignore_numbers = value.GetValue<bool>();
+			} else if (key == "threshold") {
+				auto threshold = value.GetValue<double>();
+				if (!(threshold >= 0 && threshold < 1)) {
+					throw BinderException("%s: threshold must be >= 0 and < 1", name);
+				}
+				bind_data->options.threshold = threshold;
+			} else {
+				throw BinderException("%s: unknown option '%s'", name, key);
+			}
+		}
+	}
+	// The options are baked into the bind data
+	Function::EraseArgument(bound_function, arguments, 2);
+	return std::move(bind_data);
+}
+
+void RegisterHtmlDiffFunctions(ExtensionLoader &loader) {
+	ScalarFunctionSet html_changed("html_changed");
+	html_changed.AddFunction(ScalarFunction({LogicalType::VARCHAR, LogicalType::VARCHAR}, LogicalType::BOOLEAN,
+	                                        HtmlChangedFunction, HtmlDiffBind));
+	html_changed.AddFunction(ScalarFunction({LogicalType::VARCHAR, LogicalType::VARCHAR, LogicalType::ANY},
+	                                        LogicalType::BOOLEAN, HtmlChangedFunction, HtmlDiffBind));
+	loader.RegisterFunction(html_changed);
+
+	child_list_t<LogicalType> diff_fields;
+	diff_fields.emplace_back("changed", LogicalType::BOOLEAN);
+	diff_fields.emplace_back("change_ratio", LogicalType::DOUBLE);
+	diff_fields.emplace_back("removed", LogicalType::LIST(LogicalType::VARCHAR));
+	diff_fields.emplace_back("added", LogicalType::LIST(LogicalType::VARCHAR));
+	auto diff_type = LogicalType::STRUCT(std::move(diff_fields));
+
+	ScalarFunctionSet html_diff("html_diff");
+	html_diff.AddFunction(
+	    ScalarFunction({LogicalType::VARCHAR, LogicalType::VARCHAR}, diff_type, HtmlDiffFunction, HtmlDiffBind));
+	html_diff.AddFunction(ScalarFunction({LogicalType::VARCHAR, LogicalType::VARCHAR, LogicalType::ANY}, diff_type,
+	                                     HtmlDiffFunction, HtmlDiffBind));
+	loader.RegisterFunction(html_diff);
+}
+
+} // namespace duckdb
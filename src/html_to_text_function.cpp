@@ -0,0 +1,726 @@
+// html_to_text(html [, options]) - visible text of an HTML document
+//
+//   SELECT html_to_text(body) FROM pages;
+//   SELECT html_to_text(body, {'max_length': 2000, 'links': 'inline', 'block_whitespace': false}) FROM pages;
+//
+// A single-pass tokenizer over the raw bytes (no DOM tree, no FFI call): tags
+// are recognised and dropped as they stream by, content of script / style /
+// nav / ... is skipped, and entities are decoded. Much cheaper than
+// html.readability when only the text is needed (full-text indexes,
+// embedding input).
+//
+// Options (STRUCT, all optional):
+//   block_whitespace  BOOLEAN  true: block elements start new lines, paragraphs
+//                              are separated by a blank line; false: one line
+//   max_length        BIGINT   stop after this many characters (0 = no limit)
+//   links             VARCHAR  'text' (default) keeps link text, 'skip' drops
+//                              it, 'inline' appends " (href)"
+//   ignore            VARCHAR[] elements dropped with their content, as simple
+//                              selectors: 'aside', '.ad', '#csrf', '[data-ts]',
+//                              'div.banner', 'meta[name=date]'
+
+#include "html_to_text_function.hpp"
+#include "html_tokenizer.hpp"
+
+#include "duckdb/common/vector_operations/unary_executor.hpp"
+#include "duckdb/execution/expression_executor.hpp"
+#include "duckdb/function/scalar_function.hpp"
+#include "duckdb/main/extension/extension_loader.hpp"
+#include "duckdb/planner/expression/bound_function_expression.hpp"
+
+namespace duckdb {
+
+struct HtmlToTextBindData : public FunctionData {
+	HtmlToTextOptions options;
+
+	unique_ptr<FunctionData> Copy() const override {
+		auto copy = make_uniq<HtmlToTextBindData>();
+		copy->options = options;
+		return std::move(copy);
+	}
+	bool Equals(const FunctionData &other) const override {
+		return options == other.Cast<HtmlToTextBindData>().options;
+	}
+};
+
+//===--------------------------------------------------------------------===//
+// Tag tables
+//===--------------------------------------------------------------------===//
+
+// Content never shown as text. <head> is not skipped as a whole: its end tag is often
+// omitted, and its elements (title, script, style, meta, ...) show no text anyway, while
+// stray text or flow content implicitly opens the body.
+static const char *const SKIP_TAGS[] = {"script", "style",  "noscript", "template", "svg",    "nav",
+                                        "iframe", "object", "canvas",   "select",   nullptr};
+// Raw text elements: content is not markup, skip straight to the end tag
+static const char *const RAW_TEXT_TAGS[] = {"script", "style", nullptr};
+// Separated from the surrounding text by a blank line
+static const char *const PARAGRAPH_TAGS[] = {"p",       "h1",      "h2",     "h3",    "h4",  "h5", "h6",
+                                             "article", "section", "header", "footer", "pre", "blockquote",
+                                             "table",   "ul",      "ol",     "dl",     "form", nullptr};
+// Start on a new line
+static const char *const LINE_TAGS[] = {"div", "br",         "li",   "tr",      "dt",   "dd", "hr",
+                                        "main", "figcaption", "figure", "address", "aside", "caption", nullptr};
+// Table cells and similar inline separators
+static const char *const CELL_TAGS[] = {"td", "th", nullptr};
+// Elements without content or end tag
+static const char *const VOID_TAGS[] = {"area", "base", "br",    "col",    "embed", "hr",  "img",  "input",
+                                        "link", "meta", "param", "source", "track", "wbr", nullptr};
+
+// Elements whose end tag may be omitted. An ignored one also ends where HTML implies its end
+// tag: at the start tag of a following sibling (siblings) or the end tag of its parent
+// (parents). Inside a nested container (a list in a list item, a table in a cell) those
+// tags belong to the inner element.
+struct ImpliedEndTag {
+	const char *tag;
+	const char *const *siblings;
+	const char *const *parents;
+	const char *const *containers;
+};
+
+static const char *const NO_TAGS[] = {nullptr};
+static const char *const LI_SIBLINGS[] = {"li", nullptr};
+static const char *const LIST_TAGS[] = {"ul", "ol", "menu", nullptr};
+static const char *const DD_SIBLINGS[] = {"dd", "dt", nullptr};
+static const char *const DL_TAGS[] = {"dl", nullptr};
+static const char *const OPTION_SIBLINGS[] = {"option", "optgroup", nullptr};
+static const char *const OPTION_PARENTS[] = {"select", "datalist", "optgroup", nullptr};
+static const char *const TABLE_TAGS[] = {"table", nullptr};
+static const char *const TR_SIBLINGS[] = {"tr", "tbody", "thead", "tfoot", nullptr};
+static const char *const TR_PARENTS[] = {"tbody", "thead", "tfoot", nullptr};
+static const char *const CELL_SIBLINGS[] = {"td", "th", "tr", "tbody", "thead", "tfoot", nullptr};
+static const char *const CELL_PARENTS[] = {"tr", "tbody", "thead", "tfoot", nullptr};
+static const char *const P_SIBLINGS[] = {"address", "article", "aside",  "blockquote", "details", "dialog", "div",
+                                         "dl",      "fieldset", "figcaption", "figure", "footer", "form",   "h1",
+                                         "h2",      "h3",      "h4",     "h5",         "h6",      "header", "hgroup",
+                                         "hr",      "main",    "menu",   "nav",        "ol",      "p",      "pre",
+                                         "search",  "section", "table",  "ul",         nullptr};
+static const char *const P_PARENTS[] = {"address", "article", "aside", "blockquote", "body", "caption", "dd",
+                                        "details", "dialog",  "div",   "dt",         "fieldset", "figcaption",
+                                        "figure",  "footer",  "form",  "header",     "html", "li",  "main",
+                                        "section", "td",      "th",    nullptr};
+
+static const ImpliedEndTag IMPLIED_END_TAGS[] = {
+    {"li", LI_SIBLINGS, NO_TAGS, LIST_TAGS},
+    {"dd", DD_SIBLINGS, NO_TAGS, DL_TAGS},
+    {"dt", DD_SIBLINGS, NO_TAGS, DL_TAGS},
+    {"option", OPTION_SIBLINGS, OPTION_PARENTS, NO_TAGS},
+    {"tr", TR_SIBLINGS, TR_PARENTS, TABLE_TAGS},
+    {"td", CELL_SIBLINGS, CELL_PARENTS, TABLE_TAGS},
+    {"th", CELL_SIBLINGS, CELL_PARENTS, TABLE_TAGS},
+    {"p", P_SIBLINGS, P_PARENTS, NO_TAGS},
+};
+
+static const ImpliedEndTag *FindImpliedEndTag(const char *name, idx_t name_len) {
+	for (auto &entry : IMPLIED_END_TAGS) {
+		if (HtmlTagIs(name, name_len, entry.tag)) {
+			return &entry;
+		}
+	}
+	return nullptr;
+}
+
+//===--------------------------------------------------------------------===//
+// Text writer (whitespace collapsing, length limit)
+//===--------------------------------------------------------------------===//
+
+class HtmlTextWriter {
+public:
+	HtmlTextWriter(string &out_p, const HtmlToTextOptions &options_p) : out(out_p), options(options_p) {
+		out.clear();
+	}
+
+	bool Full() const {
+		return stopped || (options.max_length > 0 && chars >= options.max_length);
+	}
+
+	// Request a break of n newlines (1 = line, 2 = paragraph) before the next text
+	void Break(idx_t newlines) {
+		pending_break = MaxValue(pending_break, options.block_whitespace ? newlines : idx_t(1));
+	}
+
+	void Space() {
+		pending_space = true;
+	}
+
+	void Text(const char *data, idx_t len, bool preserve_whitespace) {
+		for (idx_t i = 0; i < len; i++) {
+			char c = data[i];
+			if (Full() && !IsContinuation(c)) {
+				return;
+			}
+			if (c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\f') {
+				if (preserve_whitespace && options.block_whitespace && c == '\n') {
+					Break(1);
+				} else {
+					pending_space = true;
+				}
+				continue;
+			}
+			Char(c);
+		}
+	}
+
+	void Char(char c) {
+		// Continuation bytes complete the character already counted against max_length
+		if (IsContinuation(c)) {
+			if (!dropping) {
+				out += c;
+			}
+			return;
+		}
+		// The pending separator counts against max_length too
+		if (!Fits(1)) {
+			Stop();
+			return;
+		}
+		if (!out.empty()) {
+			if (pending_break > 0) {
+				out.append(options.block_whitespace ? pending_break : 1, options.block_whitespace ? '\n' : ' ');
+			} else if (pending_space) {
+				out += ' ';
+			}
+		}
+		chars += SeparatorLength();
+		pending_break = 0;
+		pending_space = false;
+		out += c;
+		chars++;
+	}
+
+	// links := 'inline': " (href)" after the link text, whole or not at all
+	void LinkSuffix(const string &href) {
+		Space();
+		// The href's whitespace collapses, so this bounds what is written
+		idx_t suffix_chars = 2;
+		for (auto c : href) {
+			suffix_chars += IsContinuation(c) ? 0 : 1;
+		}
+		if (!Fits(suffix_chars)) {
+			Stop();
+			return;
+		}
+		Char('(');
+		Text(href.c_str(), href.size(), false);
+		Char(')');
+	}
+
+	void Utf8(uint32_t cp) {
+		if (cp < 0x80) {
+			Char(static_cast<char>(cp));
+		} else if (cp < 0x800) {
+			Char(static_cast<char>(0xC0 | (cp >> 6)));
+			Char(static_cast<char>(0x80 | (cp & 0x3F)));
+		} else if (cp < 0x10000) {
+			Char(static_cast<char>(0xE0 | (cp >> 12)));
+			Char(static_cast<char>(0x80 | ((cp >> 6) & 0x3F)));
+			Char(static_cast<char>(0x80 | (cp & 0x3F)));
+		} else if (cp < 0x110000) {
+			Char(static_cast<char>(0xF0 | (cp >> 18)));
+			Char(static_cast<char>(0x80 | ((cp >> 12) & 0x3F)));
+			Char(static_cast<char>(0x80 | ((cp >> 6) & 0x3F)));
+			Char(static_cast<char>(0x80 | (cp & 0x3F)));
+		}
+	}
+
+private:
+	static bool IsContinuation(char c) {
+		return (static_cast<unsigned char>(c) & 0xC0) == 0x80;
+	}
+
+	// Characters of the break or space written before the next character
+	idx_t SeparatorLength() const {
+		if (out.empty()) {
+			return 0;
+		}
+		if (pending_break > 0) {
+			return options.block_whitespace ? pending_break : 1;
+		}
+		return pending_space ? 1 : 0;
+	}
+
+	// Whether the pending separator and n more characters fit in max_length
+	bool Fits(idx_t n) const {
+		return !stopped && (options.max_length == 0 || chars + SeparatorLength() + n <= options.max_length);
+	}
+
+	// Nothing more is written, not even the continuation bytes of a dropped character
+	void Stop() {
+		stopped = true;
+		dropping = true;
+	}
+
+	string &out;
+	const HtmlToTextOptions &options;
+	idx_t chars = 0; // UTF-8 code points written
+	bool stopped = false;
+	bool dropping = false;
+	idx_t pending_break = 0;
+	bool pending_space = false;
+};
+
+//===--------------------------------------------------------------------===//
+// Tokenizer
+//===--------------------------------------------------------------------===//
+
+struct HtmlNamedEntity {
+	const char *name;
+	uint32_t code_point;
+};
+
+// Named entities common in body text (the numeric forms are decoded generally)
+static const HtmlNamedEntity NAMED_ENTITIES[] = {
+    {"amp", '&'},        {"lt", '<'},         {"gt", '>'},         {"quot", '"'},       {"apos", '\''},
+    {"nbsp", 0xA0},      {"copy", 0xA9},      {"reg", 0xAE},       {"trade", 0x2122},   {"hellip", 0x2026},
+    {"mdash", 0x2014},   {"ndash", 0x2013},   {"lsquo", 0x2018},   {"rsquo", 0x2019},   {"ldquo", 0x201C},
+    {"rdquo", 0x201D},   {"laquo", 0xAB},     {"raquo", 0xBB},     {"middot", 0xB7},    {"bull", 0x2022},
+    {"euro", 0x20AC},    {"pound", 0xA3},     {"deg", 0xB0},       {"times", 0xD7},     {nullptr, 0}};
+
+// Decode the entity starting at html[pos] == '&'. Returns the number of bytes consumed (0 = not an entity).
+static idx_t DecodeEntity(const char *html, idx_t pos, idx_t len, HtmlTextWriter &writer) {
+	idx_t end = pos + 1;
+	while (end < len && end - pos <= 10 && html[end] != ';' && html[end] != '&' && html[end] != '<' &&
+	       !StringUtil::CharacterIsSpace(html[end])) {
+		end++;
+	}
+	if (end >= len || html[end] != ';') {
+		return 0;
+	}
+	const char *name = html + pos + 1;
+	idx_t name_len = end - pos - 1;
+	uint32_t cp = 0;
+	if (name_len >= 2 && name[0] == '#') {
+		bool hex = name[1] == 'x' || name[1] == 'X';
+		for (idx_t i = hex ? 2 : 1; i < name_len; i++) {
+			char c = name[i];
+			uint32_t digit;
+			if (c >= '0' && c <= '9') {
+				digit = uint32_t(c - '0');
+			} else if (hex && c >= 'a' && c <= 'f') {
+				digit = uint32_t(c - 'a' + 10);
+			} else if (hex && c >= 'A' && c <= 'F') {
+				digit = uint32_t(c - 'A' + 10);
+			} else {
+				return 0;
+			}
+			cp = cp * (hex ? 16 : 10) + digit;
+			if (cp > 0x10FFFF) {
+				return 0;
+			}
+		}
+	} else {
+		for (idx_t i = 0; NAMED_ENTITIES[i].name; i++) {
+			// Entity names are case-sensitive
+			if (strlen(NAMED_ENTITIES[i].name) == name_len && memcmp(NAMED_ENTITIES[i].name, name, name_len) == 0) {
+				cp = NAMED_ENTITIES[i].code_point;
+				break;
+			}
+		}
+		if (cp == 0) {
+			return 0;
+		}
+	}
+	if (cp == 0 || cp == 0xA0) {
+		writer.Space();
+	} else {
+		writer.Utf8(cp);
+	}
+	return end - pos + 1;
+}
+
+//===--------------------------------------------------------------------===//
+// Ignore selectors
+//===--------------------------------------------------------------------===//
+
+static bool IsSelectorNameChar(char c) {
+	return StringUtil::CharacterIsAlphaNumeric(c) || c == '-' || c == '_' || c == ':';
+}
+
+HtmlSelector ParseHtmlSelector(const string &function_name, const string &selector) {
+	HtmlSelector result;
+	// Tag, class and attribute names are matched case-insensitively, ids exactly
+	auto text = selector;
+	StringUtil::Trim(text);
+	auto invalid = [&]() {
+		return BinderException("%s: unsupported ignore selector '%s' (use tag, .class, #id, [attr] or [attr=value])",
+		                       function_name, selector);
+	};
+	idx_t i = 0;
+	auto read_name = [&]() {
+		idx_t start = i;
+		while (i < text.size() && IsSelectorNameChar(text[i])) {
+			i++;
+		}
+		if (i == start) {
+			throw invalid();
+		}
+		return text.substr(start, i - start);
+	};
+	if (text.empty()) {
+		throw invalid();
+	}
+	if (text[0] != '.' && text[0] != '#' && text[0] != '[') {
+		result.tag = StringUtil::Lower(read_name());
+	}
+	while (i < text.size()) {
+		char c = text[i++];
+		if (c == '.') {
+			result.classes.push_back(StringUtil::Lower(read_name()));
+		} else if (c == '#' && result.id.empty()) {
+			result.id = read_name();
+		} else if (c == '[' && result.attribute.empty()) {
+			result.attribute = StringUtil::Lower(read_name());
+			if (i < text.size() && text[i] == '=') {
+				i++;
+				result.match_attribute_value = true;
+				if (i < text.size() && (text[i] == '"' || text[i] == '\'')) {
+					char quote = text[i++];
+					auto end = text.find(quote, i);
+					if (end == string::npos) {
+						throw invalid();
+					}
+					result.attribute_value = StringUtil::Lower(text.substr(i, end - i));
+					i = end + 1;
+				} else {
+					idx_t start = i;
+					while (i < text.size() && text[i] != ']') {
+						i++;
+					}
+					result.attribute_value = StringUtil::Lower(text.substr(start, i - start));
+				}
+			}
+			if (i >= text.size() || text[i] != ']') {
+				throw invalid();
+			}
+			i++;
+		} else {
+			throw invalid();
+		}
+	}
+	return result;
+}
+
+vector<HtmlSelector> ParseHtmlIgnoreOption(const string &function_name, const Value &value) {
+	vector<HtmlSelector> result;
+	if (value.type().id() == LogicalTypeId::LIST) {
+		for (auto &child : ListValue::GetChildren(value)) {
+			if (!child.IsNull()) {
+				result.push_back(ParseHtmlSelector(function_name, child.ToString()));
+			}
+		}
+	} else if (value.type().id() == LogicalTypeId::VARCHAR) {
+		result.push_back(ParseHtmlSelector(function_name, value.ToString()));
+	} else {
+		throw BinderException("%s: ignore must be a list of selectors, e.g. ['.ad', '#csrf']", function_name);
+	}
+	return result;
+}
+
+// Whether the space-separated class list contains cls (classes match case-insensitively here)
+static bool HasClass(const string &class_list, const string &cls) {
+	idx_t i = 0;
+	while (i < class_list.size()) {
+		while (i < class_list.size() && StringUtil::CharacterIsSpace(class_list[i])) {
+			i++;
+		}
+		idx_t start = i;
+		while (i < class_list.size() && !StringUtil::CharacterIsSpace(class_list[i])) {
+			i++;
+		}
+		if (i - start == cls.size() && HtmlTagIs(class_list.c_str() + start, cls.size(), cls.c_str())) {
+			return true;
+		}
+	}
+	return false;
+}
+
+// Whether the start tag name[0, name_len) with attributes html[attr_start, attr_end) matches any selector
+static bool MatchesIgnore(const vector<HtmlSelector> &ignore, const char *name, idx_t name_len, const char *html,
+                          idx_t attr_start, idx_t attr_end) {
+	for (auto &selector : ignore) {
+		if (!selector.tag.empty() && !HtmlTagIs(name, name_len, selector.tag.c_str())) {
+			continue;
+		}
+		if (!selector.id.empty() && HtmlTagAttribute(html, attr_start, attr_end, "id") != selector.id) {
+			continue;
+		}
+		if (!selector.classes.empty()) {
+			auto class_list = HtmlTagAttribute(html, attr_start, attr_end, "class");
+			bool all = true;
+			for (auto &cls : selector.classes) {
+				all = all && HasClass(class_list, cls);
+			}
+			if (!all) {
+				continue;
+			}
+		}
+		if (!selector.attribute.empty()) {
+			string value;
+			if (!FindHtmlTagAttribute(html, attr_start, attr_end, selector.attribute.c_str(), value)) {
+				continue;
+			}
+			if (selector.match_attribute_value && StringUtil::Lower(value) != selector.attribute_value) {
+				continue;
+			}
+		}
+		return true;
+	}
+	return false;
+}
+
+void HtmlToText(const char *html, idx_t len, const HtmlToTextOptions &options, string &out) {
+	HtmlTextWriter writer(out, options);
+	idx_t skip_depth = 0;      // Inside a skipped element (nav, svg, ...), counting nested same-name tags
+	string skip_tag;
+	const ImpliedEndTag *skip_implied = nullptr; // The skipped element's end tag may be omitted
+	idx_t skip_nesting = 0;                      // Containers of skip_implied opened inside it
+	idx_t link_skip_depth = 0; // links := 'skip': inside <a>
+	idx_t pre_depth = 0;
+	vector<string> link_hrefs; // links := 'inline': href of each open <a>
+
+	idx_t pos = 0;
+	while (pos < len && !writer.Full()) {
+		char c = html[pos];
+		if (c != '<') {
+			// Text run up to the next tag or entity
+			idx_t end = pos;
+			while (end < len && html[end] != '<' && html[end] != '&') {
+				end++;
+			}
+			if (skip_depth == 0 && link_skip_depth == 0) {
+				writer.Text(html + pos, end - pos, pre_depth > 0);
+			}
+			pos = end;
+			if (pos < len && html[pos] == '&') {
+				idx_t consumed = 0;
+				if (skip_depth == 0 && link_skip_depth == 0) {
+					consumed = DecodeEntity(html, pos, len, writer);
+					if (consumed == 0) {
+						writer.Char('&');
+					}
+				}
+				pos += MaxValue<idx_t>(consumed, 1);
+			}
+			continue;
+		}
+
+		// Comments, doctype, processing instructions
+		if (pos + 3 < len && html[pos + 1] == '!' && html[pos + 2] == '-' && html[pos + 3] == '-') {
+			pos = FindHtmlCommentEnd(html, pos + 4, len);
+			continue;
+		}
+		if (pos + 1 < len && (html[pos + 1] == '!' || html[pos + 1] == '?')) {
+			while (pos < len && html[pos] != '>') {
+				pos++;
+			}
+			pos++;
+			continue;
+		}
+
+		// Tag: <name ...> or </name>
+		HtmlTag token;
+		if (!ReadHtmlTag(html, len, pos, token)) {
+			// A lone '<' is text
+			if (skip_depth == 0 && link_skip_depth == 0) {
+				writer.Char('<');
+			}
+			pos++;
+			continue;
+		}
+		pos = token.end;
+		const char *name = html + token.name_start;
+		idx_t name_len = token.name_len;
+		idx_t attr_start = token.attr_start;
+		idx_t attr_end = token.attr_end;
+		bool closing = token.closing;
+		bool self_closing = token.self_closing;
+
+		if (skip_implied) {
+			bool ends = false;
+			if (self_closing) {
+			} else if (HtmlTagIn(name, name_len, skip_implied->containers)) {
+				if (!closing) {
+					skip_nesting++;
+				} else if (skip_nesting > 0) {
+					skip_nesting--;
+				} else {
+					ends = true;
+				}
+			} else if (skip_nesting == 0) {
+				if (closing && HtmlTagIs(name, name_len, skip_implied->tag)) {
+					skip_implied = nullptr;
+					skip_depth = 0;
+					continue;
+				}
+				ends = HtmlTagIn(name, name_len, closing ? skip_implied->parents : skip_implied->siblings);
+			}
+			if (!ends) {
+				continue;
+			}
+			// The tag that implies the end tag is processed as usual
+			skip_implied = nullptr;
+			skip_depth = 0;
+		}
+		if (skip_depth > 0) {
+			if (!self_closing && HtmlTagIs(name, name_len, skip_tag.c_str())) {
+				if (closing) {
+					skip_depth--;
+				} else {
+					skip_depth++;
+				}
+			}
+			continue;
+		}
+		if (!closing && !self_closing && HtmlTagIn(name, name_len, SKIP_TAGS)) {
+			auto tag = StringUtil::Lower(string(name, name_len));
+			if (HtmlTagIn(name, name_len, RAW_TEXT_TAGS)) {
+				pos = FindHtmlEndTag(html, pos, len, tag);
+			} else {
+				skip_depth = 1;
+				skip_tag = tag;
+			}
+			continue;
+		}
+		if (!closing && !self_closing && !options.ignore.empty() && !HtmlTagIn(name, name_len, VOID_TAGS) &&
+		    MatchesIgnore(options.ignore, name, name_len, html, attr_start, attr_end)) {
+			skip_depth = 1;
+			skip_tag = StringUtil::Lower(string(name, name_len));
+			skip_implied = FindImpliedEndTag(name, name_len);
+			skip_nesting = 0;
+			continue;
+		}
+		if (!closing && HtmlTagIs(name, name_len, "title")) {
+			// <title> outside <head> is not visible text either
+			pos = FindHtmlEndTag(html, pos, len, "title");
+			continue;
+		}
+
+		if (HtmlTagIs(name, name_len, "a")) {
+			if (options.links == HtmlLinkMode::SKIP) {
+				if (!closing && !self_closing) {
+					link_skip_depth++;
+				} else if (closing && link_skip_depth > 0) {
+					link_skip_depth--;
+				}
+			} else if (options.links == HtmlLinkMode::INLINE) {
+				if (!closing && !self_closing) {
+					link_hrefs.push_back(HtmlTagAttribute(html, attr_start, attr_end, "href"));
+				} else if (closing && !link_hrefs.empty()) {
+					auto href = link_hrefs.back();
+					link_hrefs.pop_back();
+					if (!href.empty() && href[0] != '#' && !StringUtil::StartsWith(StringUtil::Lower(href), "javascript:")) {
+						writer.LinkSuffix(href);
+					}
+				}
+			}
+			continue;
+		}
+		if (link_skip_depth > 0) {
+			continue;
+		}
+
+		if (HtmlTagIs(name, name_len, "pre")) {
+			if (!closing) {
+				pre_depth++;
+			} else if (pre_depth > 0) {
+				pre_depth--;
+			}
+		}
+		if (HtmlTagIn(name, name_len, PARAGRAPH_TAGS)) {
+			writer.Break(2);
+		} else if (HtmlTagIn(name, name_len, LINE_TAGS)) {
+			writer.Break(1);
+		} else if (HtmlTagIn(name, name_len, CELL_TAGS) || HtmlTagIs(name, name_len, "img")) {
+			writer.Space();
+		}
+	}
+}
+
+string HtmlVisibleText(const string &html, idx_t max_length) {
+	HtmlToTextOptions options;
+	options.block_whitespace = false;
+	options.max_length = max_length;
+	string text;
+	HtmlToText(html.c_str(), html.size(), options, text);
+	return text;
+}
+
+//===--------------------------------------------------------------------===//
+// Scalar function
+//===--------------------------------------------------------------------===//
+
+static void HtmlToTextFunction(DataChunk &args, ExpressionState &state, Vector &result) {
+	auto &func_expr = state.expr.Cast<BoundFunctionExpression>();
+	auto &options = func_expr.bind_info->Cast<HtmlToTextBindData>().options;
+
+	// One text buffer reused for every row of the chunk
+	string text;
+	UnaryExecutor::Execute<string_t, string_t>(args.data[0], result, args.size(), [&](string_t html) {
+		HtmlToText(html.GetData(), html.GetSize(), options, text);
+		return StringVector::AddString(result, text);
+	});
+}
+
+static unique_ptr<FunctionData> HtmlToTextBind(ClientContext &context, ScalarFunction &bound_function,
+                                               vector<unique_ptr<Expression>> &arguments) {
+	auto bind_data = make_uniq<HtmlToTextBindData>();
+	if (arguments.size() < 2) {
+		return std::move(bind_data);
+	}
+	auto &options_arg = arguments[1];
+	if (options_arg->HasParameter() || !options_arg->IsFoldable()) {
+		throw BinderException("html_to_text: options must be a constant STRUCT");
+	}
+	auto options_value = ExpressionExecutor::EvaluateScalar(context, *options_arg);
+	if (options_value.type().id() != LogicalTypeId::STRUCT) {
+		throw BinderException("html_to_text: options must be a STRUCT, e.g. {'max_length': 1000}");
+	}
+	if (!options_value.IsNull()) {
+		auto &children = StructValue::GetChildren(options_value);
+		for (idx_t i = 0; i < children.size(); i++) {
+			auto key = StringUtil::Lower(StructType::GetChildName(options_value.type(), i));
+			auto &value = children[i];
+			if (value.IsNull()) {
+				continue;
+			}
+			if (key == "block_whitespace") {
+				bind_data->options.block_whitespace = value.GetValue<bool>();
+			} else if (key == "max_length") {
+				auto max_length = value.GetValue<int64_t>();
+				if (max_length < 0) {
+					throw BinderException("html_to_text: max_length must be >= 0");
+				}
+				bind_data->options.max_length = NumericCast<idx_t>(max_length);
+			} else if (key == "links") {
+				auto mode = StringUtil::Lower(value.ToString());
+				if (mode == "text") {
+					bind_data->options.links = HtmlLinkMode::TEXT;
+				} else if (mode == "skip") {
+					bind_data->options.links = HtmlLinkMode::SKIP;
+				} else if (mode == "inline") {
+					bind_data->options.links = HtmlLinkMode::INLINE;
+				} else {
+					throw BinderException("html_to_text: links must be 'text', 'skip' or 'inline', got '%s'", mode);
+				}
+			} else if (key == "ignore") {
+				bind_data->options.ignore = ParseHtmlIgnoreOption("html_to_text", value);
+			} else {
+				throw BinderException("html_to_text: unknown option '%s'", key);
+			}
+		}
+	}
+	// The options are baked into the bind data
+	Function::EraseArgument(bound_function, arguments, 1);
+	return std::move(bind_data);
+}
+
+void RegisterHtmlToTextFunction(ExtensionLoader &loader) {
+	ScalarFunctionSet html_to_text("html_to_text");
+	html_to_text.AddFunction(
+	    ScalarFunction({LogicalType::VARCHAR}, LogicalType::VARCHAR, HtmlToTextFunction, HtmlToTextBind));
+	html_to_text.AddFunction(ScalarFunction({LogicalType::VARCHAR, LogicalType::ANY}, LogicalType::VARCHAR,
+	                                        HtmlToTextFunction, HtmlToTextBind));
+	loader.RegisterFunction(html_to_text);
+}
+
+} // namespace duckdb
@@ -0,0 +1,179 @@
+// Tokenizer primitives shared by the single-pass HTML scanners (see html_tokenizer.hpp)
+
+#include "html_tokenizer.hpp"
+
+#include "duckdb/common/string_util.hpp"
+
+#include <cstring>
+
+namespace duckdb {
+
+// Raw text elements: content is not markup
+static const char *const RAW_TEXT_TAGS[] = {"script", "style", nullptr};
+
+bool HtmlTagIs(const char *name, idx_t len, const char *tag) {
+	idx_t i = 0;
+	for (; i < len && tag[i]; i++) {
+		if (StringUtil::CharacterToLower(name[i]) != tag[i]) {
+			return false;
+		}
+	}
+	return i == len && tag[i] == '\0';
+}
+
+bool HtmlTagIn(const char *name, idx_t len, const char *const *tags) {
+	for (idx_t i = 0; tags[i]; i++) {
+		if (HtmlTagIs(name, len, tags[i])) {
+			return true;
+		}
+	}
+	return false;
+}
+
+bool ReadHtmlTag(const char *html, idx_t len, idx_t pos, HtmlTag &tag) {
+	idx_t i = pos + 1;
+	tag.start = pos;
+	tag.closing = i < len && html[i] == '/';
+	if (tag.closing) {
+		i++;
+	}
+	tag.name_start = i;
+	while (i < len && (StringUtil::CharacterIsAlphaNumeric(html[i]) || html[i] == '-' || html[i] == ':')) {
+		i++;
+	}
+	tag.name_len = i - tag.name_start;
+	if (tag.name_len == 0) {
+		return false;
+	}
+	// Find the end of the tag, skipping quoted attribute values
+	tag.attr_start = i;
+	char quote = 0;
+	while (i < len && (quote || html[i] != '>')) {
+		if (quote) {
+			if (html[i] == quote) {
+				quote = 0;
+			}
+		} else if (html[i] == '"' || html[i] == '\'') {
+			quote = html[i];
+		}
+		i++;
+	}
+	tag.attr_end = i;
+	tag.self_closing = tag.attr_end > tag.attr_start && html[tag.attr_end - 1] == '/';
+	tag.end = i < len ? i + 1 : len;
+	return true;
+}
+
+idx_t FindHtmlEndTag(const char *html, idx_t pos, idx_t len, const string &tag) {
+	while (pos + 2 + tag.size() <= len) {
+		auto lt = static_cast<const char *>(memchr(html + pos, '<', len - pos));
+		if (!lt) {
+			break;
+		}
+		idx_t i = static_cast<idx_t>(lt - html);
+		if (i + 2 + tag.size() > len) {
+			break;
+		}
+		if (html[i + 1] == '/' && HtmlTagIs(html + i + 2, tag.size(), tag.c_str())) {
+			return i;
+		}
+		pos = i + 1;
+	}
+	return len;
+}
+
+idx_t FindHtmlCommentEnd(const char *html, idx_t pos, idx_t len) {
+	for (idx_t i = pos; i + 3 <= len; i++) {
+		if (html[i] == '-' && html[i + 1] == '-' && html[i + 2] == '>') {
+			return i + 3;
+		}
+	}
+	return len;
+}
+
+bool FindHtmlTagAttribute(const char *html, idx_t start, idx_t end, const char *attr, string &value) {
+	idx_t attr_len = strlen(attr);
+	idx_t i = start;
+	while (i < end) {
+		while (i < end && (StringUtil::CharacterIsSpace(html[i]) || html[i] == '/')) {
+			i++;
+		}
+		idx_t name_start = i;
+		while (i < end && html[i] != '=' && html[i] != '>' && !StringUtil::CharacterIsSpace(html[i])) {
+			i++;
+		}
+		idx_t name_len = i - name_start;
+		while (i < end && StringUtil::CharacterIsSpace(html[i])) {
+			i++;
+		}
+		value.clear();
+		if (i < end && html[i] == '=') {
+			i++;
+			while (i < end && StringUtil::CharacterIsSpace(html[i])) {
+				i++;
+			}
+			if (i < end && (html[i] == '"' || html[i] == '\'')) {
+				char quote = html[i++];
+				idx_t value_start = i;
+				while (i < end && html[i] != quote) {
+					i++;
+				}
+				value = string(html + value_start, i - value_start);
+				i++;
+			} else {
+				idx_t value_start = i;
+				while (i < end && !StringUtil::CharacterIsSpace(html[i]) && html[i] != '>') {
+					i++;
+				}
+				value = string(html + value_start, i - value_start);
+			}
+		}
+		if (name_len == attr_len && HtmlTagIs(html + name_start, name_len, attr)) {
+			return true;
+		}
+		if (name_len == 0) {
+			i++;
+		}
+	}
+	value.clear();
+	return false;
+}
+
+string HtmlTagAttribute(const char *html, idx_t start, idx_t end, const char *attr) {
+	string value;
+	FindHtmlTagAttribute(html, start, end, attr, value);
+	return value;
+}
+
+bool NextHtmlTag(const char *html, idx_t len, idx_t &pos, HtmlTag &tag) {
+	while (pos < len) {
+		auto lt = static_cast<const char *>(memchr(html + pos, '<', len - pos));
+		if (!lt) {
+			pos = len;
+			return false;
+		}
+		idx_t i = static_cast<idx_t>(lt - html);
+		if (i + 3 < len && html[i + 1] == '!' && html[i + 2] == '-' && html[i + 3] == '-') {
+			pos = FindHtmlCommentEnd(html, i + 4, len);
+			continue;
+		}
+		if (i + 1 < len && (html[i + 1] == '!' || html[i + 1] == '?')) {
+			auto gt = static_cast<const char *>(memchr(html + i, '>', len - i));
+			pos = gt ? static_cast<idx_t>(gt - html) + 1 : len;
+			continue;
+		}
+		if (!ReadHtmlTag(html, len, i, tag)) {
+			pos = i + 1;
+			continue;
+		}
+		pos = tag.end;
+		const char *name = html + tag.name_start;
+		if (!tag.closing && !tag.self_closing && HtmlTagIn(name, tag.name_len, RAW_TEXT_TAGS)) {
+			pos = FindHtmlEndTag(html, pos, len, StringUtil::Lower(string(name, tag.name_len)));
+		}
+		return true;
+	}
+	return false;
+}
+
+} // namespace duckdb
@@ -0,0 +1,82 @@
+#pragma once
+
+//===--------------------------------------------------------------------===//
+// crawl_batch.hpp - Batch fetch helpers shared by bulk crawl sinks
+//===--------------------------------------------------------------------===//
+// Builds Rust crawl_batch_ffi requests and parses their responses for
+// executors that fetch many URLs per call (CRAWL INTO, crawl_to_parquet).
+
+#include "duckdb.hpp"
+#include "crawl_dedupe.hpp"
+#include "fetch_backend.hpp"
+#include "html_compact.hpp"
+
+#include <mutex>
+#include <unordered_map>
+
+namespace duckdb {
+
+// Options for one Rust batch crawl request
+struct CrawlBatchOptions {
+	string user_agent = "DuckDB-Crawler/1.0";
+	int timeout_ms = 30000;
+	int delay_ms = 0;
+	int concurrency = 8;
+	int batch_size = 64;
+	bool respect_robots = false;
+	bool dedupe = false;  // crawler_dedupe
+	string extraction_json;  // Rust ExtractionRequest JSON, empty = no extraction
+	StoreBodyMode store_body = StoreBodyMode::RAW;  // crawler_store_body
+	FetchBackendType fetch_backend = FetchBackendType::REQWEST;  // crawler_fetch_backend
+	string http_proxy;
+	string http_proxy_username;
+	string http_proxy_password;
+};
+
+// Single fetched page from a batch response
+struct CrawlBatchResult {
+	string url;
+	string final_url;
+	int32_t status_code = 0;
+	string content_type;
+	string body;
+	string error;
+	int64_t elapsed_ms = 0;
+	bool has_body = false;
+	bool has_error = false;
+	// EXTRACT alias -> value (missing key = NULL)
+	std::unordered_map<string, string> extracted;
+};
+
+// Dedupe of one bulk run (CrawlBatchOptions::dedupe), shared by its threads. URL
+// variants and duplicate bodies of pages stored earlier in the run are dropped.
+class CrawlBatchDedupe {
+public:
+	CrawlBatchDedupe(ClientContext &context, bool enabled);
+
+	// Remove the URLs whose page this run already stored. Returns the number removed.
+	idx_t SkipSeenUrls(vector<string> &urls);
+	// Count the fetched pages and remove duplicates of pages this run already stored
+	void CollapseDuplicates(vector<CrawlBatchResult> &results);
+
+private:
+	bool enabled;
+	shared_ptr<CrawlDedupeCounters> counters;
+	std::mutex lock;
+	CrawlDedupe dedupe;
+};
+
+// Read crawler_* and http_proxy* settings as defaults
+void LoadCrawlBatchSettings(ClientContext &context, CrawlBatchOptions &options);
+
+// Build JSON request for CrawlBatchWithRust
+string BuildCrawlBatchRequest(const CrawlBatchOptions &options, const vector<string> &urls);
+
+// Parse CrawlBatchWithRust response. Throws IOException on crawler errors.
+vector<CrawlBatchResult> ParseCrawlBatchResponse(const string &response_json);
+
+// Compact HTML bodies for store_body just before they are stored. EXTRACT values are
+// computed by Rust and dedupe runs on the raw bodies.
+void CompactCrawlBatchBodies(vector<CrawlBatchResult> &results, StoreBodyMode store_body);
+
+} // namespace duckdb
@@ -0,0 +1,58 @@
+#pragma once
+
+#include "duckdb.hpp"
+#include "duckdb/main/client_context_state.hpp"
+#include "duckdb/main/extension/extension_loader.hpp"
+
+#include <atomic>
+#include <unordered_set>
+
+namespace duckdb {
+
+//===--------------------------------------------------------------------===//
+// Crawl dedupe (crawl(dedupe := true), SET crawler_dedupe = true)
+//===--------------------------------------------------------------------===//
+// URL variants of one run (tracking / session parameters, alternate paths with
+// the same <link rel=canonical> or the exact same body) are stored once. Keys
+// are UrlDedupeKey() of the requested URL, final URL and canonical URL; only
+// 2xx responses are recorded, so a failed fetch never hides a variant that
+// might succeed. Not thread-safe: callers serialize access.
+
+class CrawlDedupe {
+public:
+	// True if a stored page already covers url: the variant need not be fetched
+	bool SeenUrl(const string &url) const;
+
+	// Canonical URL of a 2xx HTML response, resolved against final_url (or url). Empty = none.
+	static string PageCanonicalUrl(const string &url, const string &final_url, int status_code,
+	                               const string &content_type, const string &body);
+
+	// True if the fetched page duplicates a page already stored. canonical_url receives
+	// the page's canonical URL, so it is resolved once per row. A non-duplicate 2xx page
+	// is recorded; other responses are neither duplicates nor recorded.
+	bool IsDuplicate(const string &url, const string &final_url, int status_code, const string &content_type,
+	                 const string &body, string &canonical_url);
+
+private:
+	std::unordered_set<string> seen_url_keys;
+	std::unordered_set<string> seen_fingerprints;
+};
+
+// Per-connection counters reported by crawl_dedupe_stats()
+class CrawlDedupeCounters : public ClientContextState {
+public:
+	std::atomic<int64_t> pages_fetched {0};
+	std::atomic<int64_t> fetches_avoided {0};      // Queued variants of an already stored page, never fetched
+	std::atomic<int64_t> duplicates_collapsed {0}; // Fetched, but canonical / content already stored
+	std::atomic<int64_t> bytes_not_returned {0};   // Body bytes of collapsed duplicates
+};
+
+shared_ptr<CrawlDedupeCounters> GetCrawlDedupeCounters(ClientContext &context);
+
+// SET crawler_dedupe: dedupe default of crawl() without follow, CRAWL INTO, crawl_to_parquet and crawl_stream
+bool LoadCrawlDedupeSetting(ClientContext &context);
+
+// Register crawl_dedupe_stats()
+void RegisterCrawlDedupeFunctions(ExtensionLoader &loader);
+
+} // namespace duckdb
@@ -0,0 +1,28 @@
+#pragma once
+
+#include "duckdb.hpp"
+#include "duckdb/main/extension/extension_loader.hpp"
+
+namespace duckdb {
+
+// Split a comma separated list at top level (ignores commas inside quotes and parentheses)
+// Used for EXTRACT items, WITH options and COALESCE arguments
+vector<string> SplitCrawlList(const string &list);
+
+// Compile EXTRACT items into the Rust extraction request JSON
+// Examples:
+//   "jsonld.Product.name"                        -> alias name
+//   "og.title AS title"
+//   "css '.price::text' AS price"
+//   "css 'img.hero::attr(src)' AS image"
+//   "COALESCE(jsonld.Product.gtin13, microdata.Product.gtin) AS gtin"
+// Fills aliases in item order. Throws ParserException on invalid items.
+string CompileCrawlExtractSpecs(const vector<string> &items, vector<string> &aliases);
+
+// Column names produced for every crawled page: standard columns, then EXTRACT aliases
+vector<string> CrawlIntoOutputColumns(const vector<string> &aliases);
+
+// Register crawl_into_internal() for CRAWL (...) INTO <table> [EXTRACT (...)] syntax
+void RegisterCrawlIntoFunction(ExtensionLoader &loader);
+
+} // namespace duckdb
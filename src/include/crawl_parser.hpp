@@ -59,6 +59,32 @@ struct CrawlingMergeParseData : public ParserExtensionParseData {
 	string ToString() const override;
 };
 
+// Parsed data from CRAWL (<source>) INTO <table> [EXTRACT (...)] [WHERE ...] [WITH (...)] [LIMIT n]
+struct CrawlIntoParseData : public ParserExtensionParseData {
+	// Source query producing URLs (WHERE applied; LIMIT is row_limit, applied to the distinct URLs)
+	string source_query_sql;
+
+	// Target table (optionally schema qualified)
+	string target_table;
+
+	// Compiled EXTRACT specs (Rust ExtractionRequest JSON) and output column names
+	string extraction_json;
+	vector<string> extract_aliases;
+
+	// WITH options (-1 / empty = use extension settings)
+	string user_agent;
+	int32_t timeout_ms = -1;
+	int32_t delay_ms = -1;
+	int32_t concurrency = -1;
+	int32_t batch_size = -1;
+	int32_t respect_robots = -1;
+
+	int64_t row_limit = 0;
+
+	unique_ptr<ParserExtensionParseData> Copy() const override;
+	string ToString() const override;
+};
+
 // Parser extension for CRAWLING statements
 class CrawlParserExtension : public ParserExtension {
 public:
@@ -0,0 +1,74 @@
+#pragma once
+
+#include "duckdb.hpp"
+#include "duckdb/main/extension/extension_loader.hpp"
+
+#include <atomic>
+#include <mutex>
+
+namespace duckdb {
+
+//===--------------------------------------------------------------------===//
+// Crawl progress (table_scan_progress and crawl_progress())
+//===--------------------------------------------------------------------===//
+// Counters of one running crawl table function. The scan updates them, DuckDB's
+// progress bar reads them through table_scan_progress, and crawl_progress()
+// lists the runs of every connection of the database, so another connection can
+// watch (and interrupt) a crawl that stopped making progress.
+//
+// URLs move from queued to in_flight to completed. Completed includes cache hits,
+// errors and skipped URLs. When following links the final total is unknown: it
+// is estimated from the queued URLs that will still be expanded times the new
+// links found per expanded page so far. A run fed by another crawl (STREAM INTO
+// over crawl()) expects about one row per URL of that source crawl.
+
+struct CrawlProgress {
+	string function;
+	idx_t connection_id = 0;
+	timestamp_t started_at;
+
+	std::atomic<int64_t> completed {0};
+	std::atomic<int64_t> in_flight {0};
+	std::atomic<int64_t> queued {0};
+	// More URLs may still be found (link following, unread source rows, sitemap discovery)
+	std::atomic<bool> discovering {false};
+	// Link following: queued URLs whose links will be followed, pages expanded, new URLs found on them
+	std::atomic<int64_t> expandable {0};
+	std::atomic<int64_t> expanded {0};
+	std::atomic<int64_t> discovered {0};
+	// Results wanted (max_results / LIMIT / row_limit), -1 = all
+	std::atomic<int64_t> limit {-1};
+	// Time of the last completed URL, microseconds since epoch
+	std::atomic<int64_t> last_activity_us {0};
+
+	// Source crawl whose estimated total bounds this run's total while discovering
+	void SetSource(shared_ptr<CrawlProgress> source);
+
+	// Mark count URLs as completed (and no longer in flight when from_in_flight)
+	void Complete(int64_t count = 1, bool from_in_flight = false);
+
+	int64_t EstimatedTotal() const;
+	// True while EstimatedTotal() may still change by more than the queued URLs
+	bool TotalIsEstimate() const;
+	// Percentage for table_scan_progress, -1 if nothing is known yet
+	double Percentage() const;
+
+private:
+	mutable std::mutex source_lock;
+	weak_ptr<CrawlProgress> source;
+};
+
+// Create and list the progress of a crawl run on context's database. The run
+// is listed by crawl_progress() as long as the returned pointer is held.
+shared_ptr<CrawlProgress> RegisterCrawlProgress(ClientContext &context, const string &function);
+
+// Most recent run started by connection_id on context's database (nullptr if none is running)
+shared_ptr<CrawlProgress> FindCrawlProgress(ClientContext &context, idx_t connection_id);
+
+// table_scan_progress value for an optional progress record
+double CrawlProgressPercentage(const shared_ptr<CrawlProgress> &progress);
+
+// Register crawl_progress()
+void RegisterCrawlProgressFunction(ExtensionLoader &loader);
+
+} // namespace duckdb
@@ -0,0 +1,12 @@
+#pragma once
+
+#include "duckdb.hpp"
+#include "duckdb/main/extension/extension_loader.hpp"
+
+namespace duckdb {
+
+// Register crawl_to_parquet() - crawl straight into Hive-partitioned Parquet files
+// Usage: SELECT * FROM crawl_to_parquet(['https://example.com'], 'crawl_output/')
+void RegisterCrawlToParquetFunction(ExtensionLoader &loader);
+
+} // namespace duckdb
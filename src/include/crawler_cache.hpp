@@ -0,0 +1,59 @@
+#pragma once
+
+#include "duckdb.hpp"
+#include "duckdb/main/connection.hpp"
+#include "duckdb/main/extension/extension_loader.hpp"
+
+#include <unordered_set>
+
+namespace duckdb {
+
+//===--------------------------------------------------------------------===//
+// HTTP response cache (__crawler_cache) shared by crawl() and crawl_url()
+//===--------------------------------------------------------------------===//
+
+static constexpr const char *CRAWLER_CACHE_TABLE = "__crawler_cache";
+
+struct CrawlerCacheEntry {
+	string url;
+	int status_code = 0;
+	string content_type;
+	string body;
+	string error;
+	int64_t response_time_ms = 0;
+};
+
+class CrawlerCacheDir;
+
+// Size / age bounds (SET crawler_cache_max_bytes, crawler_cache_max_age). 0 = unbounded.
+// With SET crawler_cache_dir the shared directory store replaces the table.
+struct CrawlerCachePolicy {
+	int64_t max_bytes = 0;
+	int64_t max_age_micros = 0;
+	// Previous versions kept per URL (SET crawler_cache_keep_versions)
+	int64_t keep_versions = 0;
+	// Store kept versions as deltas against a per-URL base (SET crawler_cache_delta); only with keep_versions > 0
+	bool delta = true;
+	shared_ptr<CrawlerCacheDir> cache_dir;
+};
+
+CrawlerCachePolicy LoadCrawlerCachePolicy(ClientContext &context);
+
+// Fresh entries (cached within ttl_hours, any age if negative) for the given URLs, in one query.
+// Hits are remembered and stamped into last_accessed in batches.
+vector<CrawlerCacheEntry> CrawlerCacheLookup(Connection &conn, const vector<string> &urls, int ttl_hours,
+                                             const CrawlerCachePolicy &policy);
+
+// The URLs of urls that have a fresh entry, without reading bodies or counting as hits
+// (crawl_plan()). With a cache directory only the index is read, one shard lock per shard.
+std::unordered_set<string> CrawlerCacheFreshUrls(Connection &conn, const vector<string> &urls, int ttl_hours,
+                                                 const CrawlerCachePolicy &policy);
+
+// Insert or replace an entry. Runs an incremental eviction pass when the cache
+// exceeds policy.max_bytes or when the periodic max_age sweep is due.
+void CrawlerCacheStore(Connection &conn, const CrawlerCacheEntry &entry, const CrawlerCachePolicy &policy);
+
+// Register crawler_cache_vacuum() and crawler_cache_history()
+void RegisterCrawlerCacheFunctions(ExtensionLoader &loader);
+
+} // namespace duckdb
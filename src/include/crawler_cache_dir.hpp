@@ -0,0 +1,80 @@
+#pragma once
+
+#include "duckdb.hpp"
+#include "crawler_cache.hpp"
+
+#include <mutex>
+#include <unordered_set>
+
+namespace duckdb {
+
+//===--------------------------------------------------------------------===//
+// Shared on-disk cache directory (SET crawler_cache_dir = '/path')
+//===--------------------------------------------------------------------===//
+// A content-addressed file store that several databases and processes can
+// share instead of each keeping responses in its own __crawler_cache:
+//
+//   <dir>/VERSION
+//   <dir>/index/00.idx .. ff.idx   append-only 64-byte records, sharded by URL hash
+//   <dir>/objects/ab/<hash>        bodies / metadata, named by their SHA-256 prefix
+//   <dir>/tmp/                     in-progress object writes
+//
+// Index records are keyed by the hash of the normalized URL and point to
+// objects by content hash, so identical bodies are stored once. Objects are
+// written to tmp/ and renamed into place; index appends hold an exclusive
+// flock() on the shard and lookups a shared one. Each shard is memory-mapped
+// and indexed in a hash map from URL hash to its newest record, extended with
+// the records appended since the last lookup, so a hit is one probe.
+//
+// A shard is compacted (rewritten with the newest record per URL and renamed
+// over the old file) when superseded records outnumber live ones;
+// crawler_cache_vacuum() compacts every shard and deletes objects that no
+// record refers to any more.
+
+struct CrawlerCacheDirShard;
+
+struct CrawlerCacheDirVacuumResult {
+	int64_t records_before = 0;
+	int64_t records_after = 0;
+	int64_t objects_removed = 0;
+	// Object and tmp/ bytes deleted; compacted index bytes are in the storage totals
+	int64_t bytes_removed = 0;
+	int64_t storage_bytes_before = 0;
+	int64_t storage_bytes_after = 0;
+};
+
+class CrawlerCacheDir {
+public:
+	~CrawlerCacheDir();
+
+	// Process-wide handle per directory. Creates the layout; throws IOException if it cannot.
+	static shared_ptr<CrawlerCacheDir> Open(const string &path);
+
+	// Newest entry for url cached at or after min_cached_at (micros since epoch)
+	bool Lookup(const string &url, int64_t min_cached_at, CrawlerCacheEntry &entry);
+	// The URLs of urls with an entry cached at or after min_cached_at, from the index alone
+	// (no objects are read): each shard is locked and brought up to date once for all its URLs
+	std::unordered_set<string> FreshUrls(const vector<string> &urls, int64_t min_cached_at);
+	// Best effort: returns false if the entry could not be written
+	bool Store(const CrawlerCacheEntry &entry);
+	// Compact all shards and collect unreferenced objects older than an hour
+	CrawlerCacheDirVacuumResult Vacuum();
+
+	const string &Path() const {
+		return path;
+	}
+
+private:
+	explicit CrawlerCacheDir(string path_p);
+
+	CrawlerCacheDirShard &GetShard(uint8_t shard_id);
+	string ObjectPath(const string &hash_hex) const;
+	bool WriteObject(const string &hash_hex, const string &content);
+	bool ReadObject(const string &hash_hex, string &content) const;
+
+	string path;
+	std::mutex lock;
+	unique_ptr<CrawlerCacheDirShard> shards[256];
+};
+
+} // namespace duckdb
@@ -37,6 +37,13 @@ std::string DecompressGzip(const std::string &compressed_data);
 // Check if data starts with gzip magic bytes (0x1f 0x8b)
 bool IsGzippedData(const std::string &data);
 
+// Encode data as a zstd frame using base as a raw-content dictionary, so bytes
+// shared with base cost almost nothing. Returns empty string on error.
+std::string ZstdDeltaEncode(const std::string &data, const std::string &base);
+
+// Reconstruct data from ZstdDeltaEncode output and the same base. Returns false on error.
+bool ZstdDeltaDecode(const std::string &delta, const std::string &base, std::string &data);
+
 //===--------------------------------------------------------------------===//
 // Backoff and Rate Limiting
 //===--------------------------------------------------------------------===//
@@ -69,6 +76,9 @@ std::string ExtractDomain(const std::string &url);
 // Extract path from URL (including query string)
 std::string ExtractPath(const std::string &url);
 
+// <scheme>://<host[:port]>/robots.txt of url (empty if it has no host)
+std::string RobotsTxtUrl(const std::string &url);
+
 // Generate SURT key (Sort-friendly URI Reordering Transform)
 // Example: https://www.example.com/path?q=1 → com,example)/path?q=1
 std::string GenerateSurtKey(const std::string &url);
@@ -77,6 +87,16 @@ std::string GenerateSurtKey(const std::string &url);
 // Example: "www.example.com" → "com,example)"
 std::string GenerateDomainSurt(const std::string &hostname);
 
+// Normalize URL for use as a cache key: lowercase scheme and host, drop the
+// default port and #fragment, empty path becomes "/"
+// Example: HTTP://Example.com:80?q=1#top → http://example.com/?q=1
+std::string NormalizeUrl(const std::string &url);
+
+// Key for collapsing URL variants: NormalizeUrl() without tracking and session
+// parameters (utm_*, gclid, fbclid, sessionid, jsessionid, ...)
+// Example: https://a.com/p?utm_source=x&id=3&sid=9 → https://a.com/p?id=3
+std::string UrlDedupeKey(const std::string &url);
+
 // Generate content hash for deduplication (hex string)
 std::string GenerateContentHash(const std::string &content);
 
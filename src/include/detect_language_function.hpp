@@ -0,0 +1,10 @@
+#pragma once
+
+#include "duckdb.hpp"
+
+namespace duckdb {
+
+// Register detect_language(text [, hint]) scalar function
+void RegisterDetectLanguageFunction(ExtensionLoader &loader);
+
+} // namespace duckdb
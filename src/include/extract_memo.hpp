@@ -0,0 +1,33 @@
+#pragma once
+
+#include "duckdb.hpp"
+#include "duckdb/main/extension/extension_loader.hpp"
+
+#include <functional>
+
+namespace duckdb {
+
+//===--------------------------------------------------------------------===//
+// Extraction memo (SET crawler_extract_memo = true)
+//===--------------------------------------------------------------------===//
+// Results of the HTML extraction functions (jq, htmlpath, css_select) keyed by
+// (SHA-256 of the HTML, function + selector spec), so re-running a query over
+// unchanged bodies skips HTML parsing. Opt-in, in memory and scoped to the
+// connection: nothing is written to the database.
+
+struct ExtractMemoRequest {
+	string_t html;
+	string spec;
+};
+
+// Raw extractor output for html + spec, called for memo misses only
+using ExtractMemoFunction = std::function<string(const string &html, const string &spec)>;
+
+// One result per request, in order
+vector<string> ExtractMemoized(ExpressionState &state, const string &function,
+                               const vector<ExtractMemoRequest> &requests, const ExtractMemoFunction &extract);
+
+// Register crawler_extract_memo_stats()
+void RegisterExtractMemoFunctions(ExtensionLoader &loader);
+
+} // namespace duckdb
@@ -0,0 +1,51 @@
+#pragma once
+
+#include "duckdb.hpp"
+#include "duckdb/common/enums/set_scope.hpp"
+
+namespace duckdb {
+
+//===--------------------------------------------------------------------===//
+// Fetch backends (crawler_fetch_backend)
+//===--------------------------------------------------------------------===//
+// Batch fetches use the crawl_batch_ffi JSON documents in both directions (see
+// CrawlBatchWithRust in rust_ffi.hpp), so callers build and parse the same
+// request / response whichever backend runs it:
+//   'reqwest' (default)  Rust reqwest client, one client and runtime per batch
+//   'curl'               libcurl multi event loop on one thread, shared by all
+//                        queries: HTTP/2 multiplexing and a connection, DNS and
+//                        TLS session cache that outlives single batches.
+//                        Responses are decoded and EXTRACT specs run on the
+//                        calling thread as transfers finish; robots.txt is
+//                        fetched once per host of a batch.
+
+enum class FetchBackendType : uint8_t { REQWEST, CURL };
+
+class FetchBackend {
+public:
+	virtual ~FetchBackend() = default;
+
+	// BatchCrawlRequest JSON in, BatchCrawlResponse JSON ({"results": [...]} or {"error": "..."}) out.
+	// Returns when the batch is done or the query is interrupted.
+	virtual string CrawlBatch(const string &request_json) = 0;
+};
+
+// 'reqwest' / 'curl' (case-insensitive). Returns false for other names.
+bool TryParseFetchBackendType(const string &name, FetchBackendType &type);
+
+// crawler_fetch_backend setting ('reqwest' when unset). Throws InvalidInputException for unknown backends.
+FetchBackendType LoadFetchBackendType(ClientContext &context);
+
+// SET crawler_fetch_backend callback: rejects unknown backends
+void SetFetchBackendCallback(ClientContext &context, SetScope scope, Value &parameter);
+
+// Process-wide backend instance (created on first use)
+FetchBackend &GetFetchBackend(FetchBackendType type);
+
+// GetFetchBackend(type).CrawlBatch(request_json)
+string CrawlBatchWithBackend(FetchBackendType type, const string &request_json);
+
+// libcurl multi backend (curl_fetch_backend.cpp)
+unique_ptr<FetchBackend> MakeCurlFetchBackend();
+
+} // namespace duckdb
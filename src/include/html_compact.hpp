@@ -0,0 +1,38 @@
+#pragma once
+
+#include "duckdb.hpp"
+
+namespace duckdb {
+
+//===--------------------------------------------------------------------===//
+// Compact body storage (store_body := 'raw' | 'minified' | 'main_content')
+//===--------------------------------------------------------------------===//
+// 'minified' drops comments, scripts, styles, noscript / template / svg content
+// and collapses whitespace outside <pre> / <textarea>. Tags and attributes are
+// kept as they are, so CSS selectors, <head> meta / canonical tags and link
+// following work on the stored body; JSON data scripts (application/ld+json,
+// application/json) are kept for schema and jq extraction.
+// 'main_content' is 'minified' with the body reduced to its <main> element
+// (else the first [role=main], else the first <article>). Documents without
+// one are only minified.
+
+enum class StoreBodyMode : uint8_t { RAW, MINIFIED, MAIN_CONTENT };
+
+// 'raw' / 'minified' / 'main_content' (case-insensitive). Returns false for other names.
+bool TryParseStoreBodyMode(const string &name, StoreBodyMode &mode);
+
+// crawler_store_body setting ('raw' when unset). Throws InvalidInputException for unknown modes.
+StoreBodyMode LoadStoreBodyMode(ClientContext &context);
+
+// Body as stored for mode. Non-HTML content types are returned unchanged.
+string CompactHtmlBody(const string &body, const string &content_type, StoreBodyMode mode);
+
+// Cached content type of a body stored in mode: compacted HTML is tagged with
+// "; x-store-body=<mode>", because the raw markup is gone
+string TagStoredContentType(const string &content_type, StoreBodyMode mode);
+
+// Remove the tag from a cached content type and set mode to the mode the body was stored in
+// (RAW if untagged). Returns false for a mode this version does not know.
+bool UntagStoredContentType(string &content_type, StoreBodyMode &mode);
+
+} // namespace duckdb
@@ -0,0 +1,11 @@
+#pragma once
+
+#include "duckdb.hpp"
+
+namespace duckdb {
+
+// Register html_changed(old, new [, options]) and html_diff(old, new [, options]) for
+// change detection between two crawls of a page
+void RegisterHtmlDiffFunctions(ExtensionLoader &loader);
+
+} // namespace duckdb
@@ -0,0 +1,56 @@
+#pragma once
+
+#include "duckdb.hpp"
+
+namespace duckdb {
+
+enum class HtmlLinkMode : uint8_t { TEXT, SKIP, INLINE };
+
+// Element selector for the 'ignore' option: tag, #id, .class, [attr] or [attr=value], or a
+// compound of them such as div.ad or span[data-ts] (no combinators or pseudo-classes).
+// id is matched exactly; tag, classes and attribute (name and value) are lowercase and
+// matched case-insensitively.
+struct HtmlSelector {
+	string tag;
+	string id;
+	vector<string> classes;
+	string attribute;
+	string attribute_value;
+	bool match_attribute_value = false;
+
+	bool operator==(const HtmlSelector &other) const {
+		return tag == other.tag && id == other.id && classes == other.classes && attribute == other.attribute &&
+		       attribute_value == other.attribute_value && match_attribute_value == other.match_attribute_value;
+	}
+};
+
+// Throws BinderException("<function_name>: ...") for selectors outside the supported subset
+HtmlSelector ParseHtmlSelector(const string &function_name, const string &selector);
+// Selectors of an 'ignore' option value (a VARCHAR[] or a single VARCHAR)
+vector<HtmlSelector> ParseHtmlIgnoreOption(const string &function_name, const Value &value);
+
+struct HtmlToTextOptions {
+	bool block_whitespace = true;
+	idx_t max_length = 0;
+	HtmlLinkMode links = HtmlLinkMode::TEXT;
+	// Elements left out together with their content (ads, timestamps, CSRF tokens, ...)
+	vector<HtmlSelector> ignore;
+
+	bool operator==(const HtmlToTextOptions &other) const {
+		return block_whitespace == other.block_whitespace && max_length == other.max_length && links == other.links &&
+		       ignore == other.ignore;
+	}
+};
+
+// Visible text of html[0, len) into out (cleared first); with block_whitespace every block
+// element (paragraph, heading, list item, table row, ...) is on its own line
+void HtmlToText(const char *html, idx_t len, const HtmlToTextOptions &options, string &out);
+
+// Visible text of html on one line (html_to_text(html, {'block_whitespace': false,
+// 'max_length': max_length})), for page signatures outside SQL
+string HtmlVisibleText(const string &html, idx_t max_length = 0);
+
+// Register html_to_text(html [, options]) scalar function
+void RegisterHtmlToTextFunction(ExtensionLoader &loader);
+
+} // namespace duckdb
@@ -0,0 +1,51 @@
+#pragma once
+
+#include "duckdb.hpp"
+
+namespace duckdb {
+
+//===--------------------------------------------------------------------===//
+// HTML tokenizer shared by the single-pass scanners (html_to_text(),
+// store_body compaction, soft error signatures)
+//===--------------------------------------------------------------------===//
+// The scanners work on the raw bytes without building a DOM: they find the
+// next tag, look at its name and attributes, and skip raw text content. Names
+// passed in (tags, attributes) are lowercase and compared case-insensitively.
+
+// Tag html[start, end) as found by ReadHtmlTag
+struct HtmlTag {
+	idx_t start = 0; // '<'
+	idx_t end = 0;   // Just past '>'
+	idx_t name_start = 0;
+	idx_t name_len = 0;
+	// Attributes html[attr_start, attr_end), including a trailing '/'
+	idx_t attr_start = 0;
+	idx_t attr_end = 0;
+	bool closing = false;
+	bool self_closing = false;
+};
+
+// Whether the tag name name[0, len) is tag
+bool HtmlTagIs(const char *name, idx_t len, const char *tag);
+// Whether the tag name name[0, len) is one of the nullptr-terminated tags
+bool HtmlTagIn(const char *name, idx_t len, const char *const *tags);
+
+// Parse the tag at html[pos] == '<'. Returns false for a lone '<' (text).
+bool ReadHtmlTag(const char *html, idx_t len, idx_t pos, HtmlTag &tag);
+
+// Index of the first case-insensitive "</tag" at or after pos (len if none)
+idx_t FindHtmlEndTag(const char *html, idx_t pos, idx_t len, const string &tag);
+// Index just past the "-->" closing a comment whose body starts at pos (len if none)
+idx_t FindHtmlCommentEnd(const char *html, idx_t pos, idx_t len);
+
+// Find attribute attr in the tag body html[start, end); value is "" for a bare attribute
+bool FindHtmlTagAttribute(const char *html, idx_t start, idx_t end, const char *attr, string &value);
+// Value of attribute attr in the tag body html[start, end) ("" if missing), case preserved
+string HtmlTagAttribute(const char *html, idx_t start, idx_t end, const char *attr);
+
+// Next tag at or after pos, skipping text, comments, doctypes and processing instructions.
+// pos is left after the tag, or after the content of a <script> / <style> start tag (at its
+// end tag). Returns false at the end of the document.
+bool NextHtmlTag(const char *html, idx_t len, idx_t &pos, HtmlTag &tag);
+
+} // namespace duckdb
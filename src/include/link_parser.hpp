@@ -19,7 +19,7 @@ public:
 	// Resolve relative URL to absolute
 	static std::string ResolveUrl(const std::string &base_url, const std::string &href);
 
-	// Extract canonical URL from <link rel="canonical">
+	// Extract canonical URL from <link rel="canonical"> in the head (the scan stops at </head> or <body>)
 	static std::string ExtractCanonical(const std::string &html, const std::string &base_url);
 
 	// Check for <meta name="robots" content="nofollow">
@@ -0,0 +1,43 @@
+#pragma once
+
+#include "duckdb.hpp"
+
+namespace duckdb {
+
+//===--------------------------------------------------------------------===//
+// PageRank over a link graph (page_rank)
+//===--------------------------------------------------------------------===//
+// Nodes are dictionary-encoded to dense ids, and the graph is held as
+// compressed sparse rows of incoming edges. Each iteration pulls the rank
+// contributions of a node's in-neighbours, so scheduler tasks work on disjoint
+// ranges of nodes without synchronization; the rounds share one TaskExecutor.
+
+struct PageRankOptions {
+	double damping = 0.85;
+	idx_t max_iterations = 100;
+	// Stop once the L1 change of the rank vector is below tolerance (0 = never)
+	double tolerance = 1e-6;
+	idx_t threads = 1;
+};
+
+// Edges as pairs of dense node ids in [0, node_count); page_rank() loads each distinct edge once
+struct PageRankGraph {
+	idx_t node_count = 0;
+	vector<uint32_t> sources;
+	vector<uint32_t> targets;
+};
+
+struct PageRankResult {
+	vector<double> ranks;
+	vector<uint32_t> in_degree;
+	vector<uint32_t> out_degree;
+	idx_t iterations = 0;
+};
+
+// Throws InterruptException if the query is interrupted between two rounds
+PageRankResult ComputePageRank(ClientContext &context, const PageRankGraph &graph, const PageRankOptions &options);
+
+// Register page_rank(edges_table, src_col, dst_col [, damping [, iterations]])
+void RegisterPageRankFunction(ExtensionLoader &loader);
+
+} // namespace duckdb
@@ -0,0 +1,45 @@
+#pragma once
+
+#include "duckdb.hpp"
+#include "yyjson.hpp"
+
+#include <map>
+
+namespace duckdb {
+
+//===--------------------------------------------------------------------===//
+// Request specs (crawl() / crawl_url() STRUCT input)
+//===--------------------------------------------------------------------===//
+// An input row of STRUCT(url, method, headers, body) is sent with its own
+// method, headers and body, through the same fetch backend, per-host delay and
+// cache as plain URLs. Batch requests carry the specs in a "requests" array
+// aligned with "urls" (see BatchCrawlRequest in rust_parser/src/ffi.rs).
+
+struct CrawlRequestSpec {
+	string url;
+	string method = "GET";
+	std::map<string, string> headers;
+	string body;
+	bool has_body = false;
+
+	// Cache and state key: the URL for GETs without a body or credentials, else
+	// "<METHOD> <url>[ body:<sha256>][ auth:<sha256>]", which never collides with a URL.
+	// Credential headers (Authorization, Proxy-Authorization, Cookie) are part of the
+	// key, so one user's cached response is never served for another's; other headers are not.
+	string Key() const;
+	// SHA-256 hex of the credential headers, empty if there are none
+	string CredentialDigest() const;
+};
+
+// STRUCT(url VARCHAR, method VARCHAR, headers MAP(VARCHAR, VARCHAR), body VARCHAR)
+LogicalType CrawlRequestSpecType();
+
+// Spec of a STRUCT value with a url field; method, headers and body are optional
+// (NULL = GET, none, none). Throws InvalidInputException for a NULL url or an
+// unsupported method.
+CrawlRequestSpec CrawlRequestSpecFromValue(const Value &value);
+
+// {"method": ..., "headers": {...}, "body": ...}: one element of a batch request's "requests"
+duckdb_yyjson::yyjson_mut_val *CrawlRequestSpecJson(duckdb_yyjson::yyjson_mut_doc *doc, const CrawlRequestSpec &spec);
+
+} // namespace duckdb
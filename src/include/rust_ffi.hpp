@@ -31,6 +31,18 @@ std::string PageInfoWithRust(const std::string &html, const std::string &url);
 // Returns JSON: {"title": "...", "content": "<html>", "text_content": "...", "length": 123, "excerpt": "..."}
 std::string ExtractReadabilityWithRust(const std::string &html, const std::string &url);
 
+// Languages of texts as ISO 639-1 codes ("" if unknown), in one call; only a bounded prefix of each
+// is read. hints is empty or aligned with texts: language tags ("en-US") that decide when a text
+// is too short to classify ("" = no hint).
+std::vector<std::string> DetectLanguagesWithRust(const std::vector<std::string> &texts,
+                                                 const std::vector<std::string> &hints = {});
+
+// Language of a response body ("" if unknown): an HTML page by its visible text with <html lang>
+// and then content_language (the Content-Language header) as hints, other text/* bodies as text.
+// crawl_batch_ffi detects fetched pages itself (detect_language); this is for cached bodies.
+std::string DetectPageLanguageWithRust(const std::string &body, const std::string &content_type,
+                                       const std::string &content_language = "");
+
 // Batch crawl + extract (HTTP done in Rust)
 // Takes JSON request: {"urls": [...], "extraction": {...}, "user_agent": "...", "timeout_ms": 30000, "concurrency": 4}
 // Returns JSON response: {"results": [{url, status, content_type, body, error, extracted, response_time_ms}, ...]}
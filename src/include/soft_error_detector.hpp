@@ -0,0 +1,80 @@
+#pragma once
+
+#include "duckdb.hpp"
+
+#include <functional>
+#include <mutex>
+
+namespace duckdb {
+
+//===--------------------------------------------------------------------===//
+// Soft error detection (crawl(soft_404 := 'flag' | 'skip'))
+//===--------------------------------------------------------------------===//
+// Many sites answer unknown paths with HTTP 200 and a "page not found"
+// template. The first time a host is seen, a path that cannot exist there (with
+// a random suffix per crawl run) is requested once; a 2xx HTML answer is that
+// host's soft error template. Pages whose visible text is a near-duplicate of
+// the template (or whose markup has the template's structure and text that
+// differs only in a few words, such as the echoed path) are soft errors. When
+// the probe is redirected, only pages redirected to the same target can be
+// soft errors, and only if their content matches the probe's answer as well.
+
+enum class SoftErrorMode : uint8_t { OFF, FLAG, SKIP };
+
+// 'flag' / 'skip' / 'off' (case-insensitive). Returns false for other names.
+bool TryParseSoftErrorMode(const string &name, SoftErrorMode &mode);
+
+// 64-bit SimHashes of an HTML page: of its visible text (word 3-gram shingles,
+// words of url's path and query left out) and of its markup (tag name 3-grams,
+// script and style content skipped)
+struct PageSignature {
+	uint64_t text = 0;
+	uint64_t structure = 0;
+	bool has_text = false;
+};
+
+PageSignature ComputePageSignature(const string &html, const string &url = "");
+
+// Number of differing bits of two SimHashes
+idx_t SimHashDistance(uint64_t a, uint64_t b);
+
+// Response to a request, as far as soft error detection needs it
+struct SoftErrorResponse {
+	string url;
+	string final_url; // Empty when not redirected
+	int status_code = 0;
+	string content_type;
+	string body;
+};
+
+// Soft error templates of the hosts (scheme://host[:port]) seen by one crawl run.
+// Thread-safe; every host is probed at most once.
+class SoftErrorDetector {
+public:
+	// Fetches the probe URL of a host. cache_key is the same for every run (the probe URL
+	// without its random suffix). A status_code of 0 means the probe failed.
+	using ProbeFunction = std::function<SoftErrorResponse(const string &probe_url, const string &cache_key)>;
+
+	SoftErrorDetector();
+
+	// True if the 2xx HTML response is a soft error of its host; other responses never are
+	bool IsSoftError(const SoftErrorResponse &response, const ProbeFunction &probe);
+
+private:
+	struct HostProfile {
+		std::mutex lock;
+		bool probed = false;
+		bool has_template = false;
+		PageSignature signature;
+		string redirect_target;
+	};
+
+	HostProfile &GetProfile(const string &origin);
+
+	// "-" and random hex digits appended to the probe path
+	string probe_suffix;
+	std::mutex hosts_lock;
+	unordered_map<string, unique_ptr<HostProfile>> hosts;
+};
+
+} // namespace duckdb
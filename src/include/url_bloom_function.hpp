@@ -0,0 +1,50 @@
+#pragma once
+
+#include "duckdb.hpp"
+
+namespace duckdb {
+
+//===--------------------------------------------------------------------===//
+// URL Bloom filters (url_bloom_agg / url_bloom_contains / skip_bloom)
+//===--------------------------------------------------------------------===//
+// A url_bloom_agg() BLOB is a standard Bloom filter over the seeded MurmurHash64A
+// of NormalizeUrl()-normalized URLs (the crawler's cache key), so 'HTTP://A.com:80/x#y'
+// and 'http://a.com/x' are the same member. Layout (little-endian):
+//   "UBFL" | uint32 format version | uint32 hash count | uint32 reserved |
+//   uint64 bit count | uint64 estimated URL count | bit words
+// Filters of another format version are rejected rather than misread.
+
+// Hash of url as stored in a filter
+hash_t UrlBloomHash(const string &url);
+
+// Read-only view of a serialized filter; the bytes must outlive the view
+class UrlBloomFilter {
+public:
+	// Throws InvalidInputException if data is not a url_bloom_agg() filter
+	UrlBloomFilter(const char *data, idx_t size);
+
+	static bool IsFilter(const char *data, idx_t size);
+	static bool IsFilter(const string &data) {
+		return IsFilter(data.data(), data.size());
+	}
+
+	// May return true for URLs that were never added (at about the filter's target rate)
+	bool Contains(const string &url) const;
+	bool ContainsHash(hash_t hash) const;
+
+	// Distinct URLs added, estimated from the set bits
+	idx_t Count() const {
+		return url_count;
+	}
+
+private:
+	const char *words;
+	uint64_t bit_count;
+	uint32_t hash_count;
+	uint64_t url_count;
+};
+
+// Register url_bloom_agg(url [, fpr]) and url_bloom_contains(filter, url)
+void RegisterUrlBloomFunctions(ExtensionLoader &loader);
+
+} // namespace duckdb
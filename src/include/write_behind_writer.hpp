@@ -0,0 +1,183 @@
+#pragma once
+
+//===--------------------------------------------------------------------===//
+// write_behind_writer.hpp - Background writer for table-writing executors
+//===--------------------------------------------------------------------===//
+// The scan thread produces batches (source chunks, fetched pages) and hands
+// them to a writer thread with its own Connection through a bounded queue:
+//   - Push() blocks while max_pending batches are queued (backpressure), so a
+//     slow target cannot make the crawler buffer unbounded results
+//   - writes are grouped into explicit transactions of ~rows_per_transaction
+//     rows instead of one autocommit per statement (0 = no explicit transaction)
+//   - the first write error stops the writer, rolls back the open transaction
+//     and is rethrown from the next Push() / Finish() on the scan thread
+
+#include "duckdb.hpp"
+#include "duckdb/main/connection.hpp"
+#include "duckdb/common/error_data.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace duckdb {
+
+template <class BATCH>
+class WriteBehindWriter {
+public:
+	// Write one batch on the writer connection, returns number of rows written. Throw on error.
+	using WriteFunction = std::function<idx_t(Connection &conn, BATCH &batch)>;
+	// Called once after the last batch (inside the last transaction), e.g. to flush buffers
+	using FinishFunction = std::function<void(Connection &conn)>;
+	// Called on the writer thread before its connection is destroyed, whether the writer
+	// finished, was cancelled or failed, e.g. to release appenders on that connection
+	using CloseFunction = std::function<void()>;
+
+	WriteBehindWriter(DatabaseInstance &db, string name_p, idx_t max_pending_p, idx_t rows_per_transaction_p,
+	                  WriteFunction write_p, FinishFunction finish_p = nullptr, CloseFunction close_p = nullptr)
+	    : name(std::move(name_p)), max_pending(MaxValue<idx_t>(max_pending_p, 1)),
+	      rows_per_transaction(rows_per_transaction_p), write(std::move(write_p)), finish(std::move(finish_p)),
+	      close(std::move(close_p)) {
+		thread = std::thread([this, &db]() { Run(db); });
+	}
+
+	// Without Finish() (e.g. the scan failed) queued batches are dropped and the open transaction rolled back
+	~WriteBehindWriter() {
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			cancelled = true;
+			done = true;
+		}
+		queue_cv.notify_all();
+		space_cv.notify_all();
+		if (thread.joinable()) {
+			thread.join();
+		}
+	}
+
+	// Queue a batch for writing. Blocks while the writer is max_pending batches behind.
+	void Push(BATCH batch) {
+		std::unique_lock<std::mutex> lock(mutex);
+		space_cv.wait(lock, [this]() { return pending.size() < max_pending || !error.empty(); });
+		ThrowIfFailed();
+		pending.push_back(std::move(batch));
+		queue_cv.notify_one();
+	}
+
+	// Write all queued batches, commit and stop the writer. Rethrows the writer error, if any.
+	void Finish() {
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			done = true;
+		}
+		queue_cv.notify_all();
+		if (thread.joinable()) {
+			thread.join();
+		}
+		std::lock_guard<std::mutex> lock(mutex);
+		ThrowIfFailed();
+	}
+
+	// Set once the writer has failed; producers can stop fetching early
+	bool HasFailed() {
+		std::lock_guard<std::mutex> lock(mutex);
+		return !error.empty();
+	}
+
+	std::atomic<int64_t> rows_written {0};
+	std::atomic<int64_t> transactions_committed {0};
+
+private:
+	void ThrowIfFailed() {
+		if (!error.empty()) {
+			throw IOException("%s writer failed: %s", name, error);
+		}
+	}
+
+	void Run(DatabaseInstance &db) {
+		Connection conn(db);
+		idx_t rows_in_transaction = 0;
+		try {
+			while (true) {
+				BATCH batch;
+				{
+					std::unique_lock<std::mutex> lock(mutex);
+					queue_cv.wait(lock, [this]() { return !pending.empty() || done; });
+					if (cancelled) {
+						break;
+					}
+					if (pending.empty()) {
+						break;
+					}
+					batch = std::move(pending.front());
+					pending.pop_front();
+				}
+				space_cv.notify_one();
+
+				if (rows_per_transaction > 0 && !conn.HasActiveTransaction()) {
+					conn.BeginTransaction();
+				}
+				idx_t rows = write(conn, batch);
+				rows_written.fetch_add(static_cast<int64_t>(rows));
+				rows_in_transaction += rows;
+				if (rows_per_transaction > 0 && rows_in_transaction >= rows_per_transaction) {
+					conn.Commit();
+					transactions_committed.fetch_add(1);
+					rows_in_transaction = 0;
+				}
+			}
+
+			if (cancelled) {
+				if (conn.HasActiveTransaction()) {
+					conn.Rollback();
+				}
+			} else {
+				if (finish) {
+					finish(conn);
+				}
+				if (conn.HasActiveTransaction()) {
+					conn.Commit();
+					transactions_committed.fetch_add(1);
+				}
+			}
+		} catch (std::exception &ex) {
+			if (conn.HasActiveTransaction()) {
+				try {
+					conn.Rollback();
+				} catch (...) {
+				}
+			}
+			std::lock_guard<std::mutex> lock(mutex);
+			error = ErrorData(ex).RawMessage();
+			pending.clear();
+			space_cv.notify_all();
+		}
+		if (close) {
+			try {
+				close();
+			} catch (...) {
+			}
+		}
+	}
+
+	string name;
+	idx_t max_pending;
+	idx_t rows_per_transaction;
+	WriteFunction write;
+	FinishFunction finish;
+	CloseFunction close;
+
+	std::mutex mutex;
+	std::condition_variable queue_cv;
+	std::condition_variable space_cv;
+	std::deque<BATCH> pending;
+	bool done = false;
+	bool cancelled = false;
+	string error;
+	std::thread thread;
+};
+
+} // namespace duckdb
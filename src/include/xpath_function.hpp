@@ -0,0 +1,10 @@
+#pragma once
+
+#include "duckdb.hpp"
+
+namespace duckdb {
+
+// Register xpath(html, expr) and xpath_all(html, expr) scalar functions and crawler_xpath_stats()
+void RegisterXPathFunctions(ExtensionLoader &loader);
+
+} // namespace duckdb
@@ -353,26 +353,44 @@ std::vector<ExtractedLink> LinkParser::ExtractLinks(const std::string &html, con
 	return links;
 }
 
-std::string LinkParser::ExtractCanonical(const std::string &html, const std::string &base_url) {
-	// Look for <link rel="canonical" href="...">
-	std::string lower_html = ToLower(html);
+// Helper: True if html[pos..] starts with the lowercase tag name, case-insensitively,
+// followed by a delimiter (so "<link" does not match "<linkset")
+static bool TagNameAt(const std::string &html, size_t pos, const char *name) {
+	size_t i = 0;
+	for (; name[i]; i++) {
+		if (pos + i >= html.size() || std::tolower(static_cast<unsigned char>(html[pos + i])) != name[i]) {
+			return false;
+		}
+	}
+	if (pos + i >= html.size()) {
+		return false;
+	}
+	char next = html[pos + i];
+	return next == '>' || next == '/' || std::isspace(static_cast<unsigned char>(next));
+}
 
+std::string LinkParser::ExtractCanonical(const std::string &html, const std::string &base_url) {
+	// Look for <link rel="canonical" href="..."> in the head, without copying the body:
+	// the scan stops at </head> or <body>
 	size_t pos = 0;
-	while (pos < lower_html.length()) {
-		size_t link_start = lower_html.find("<link", pos);
-		if (link_start == std::string::npos) {
+	while ((pos = html.find('<', pos)) != std::string::npos) {
+		if (TagNameAt(html, pos + 1, "body") || TagNameAt(html, pos + 1, "/head")) {
 			break;
 		}
+		if (!TagNameAt(html, pos + 1, "link")) {
+			pos++;
+			continue;
+		}
 
-		size_t link_end = html.find('>', link_start);
+		size_t link_end = html.find('>', pos);
 		if (link_end == std::string::npos) {
 			break;
 		}
 
-		std::string tag = html.substr(link_start, link_end - link_start + 1);
+		std::string tag = html.substr(pos, link_end - pos + 1);
 		std::string rel = ExtractAttribute(tag, "rel");
 
-		if (ToLower(rel) == "canonical") {
+		if (ToLower(Trim(rel)) == "canonical") {
 			std::string href = ExtractAttribute(tag, "href");
 			if (!href.empty()) {
 				return ResolveUrl(base_url, href);
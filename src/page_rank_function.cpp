@@ -0,0 +1,365 @@
+// page_rank(edges_table, src_col, dst_col [, damping [, iterations]]) - PageRank of a link graph
+//
+//   SELECT node, rank FROM page_rank('links', 'from_url', 'to_url') ORDER BY rank DESC LIMIT 20;
+//   SELECT * FROM page_rank('links', 'src', 'dst', 0.9, 50, tolerance := 0);
+//
+// The edge columns are read once as VARCHAR. DuckDB assigns the dense node ids
+// (distinct values, joined back onto the edges), so the extension only holds
+// two uint32 arrays per edge and the node names. Duplicate edges count once,
+// as in a directed graph without multi-edges; self-links count. Rows with a
+// NULL endpoint are ignored.
+//
+// Power iteration with the damping factor (default 0.85). Pages without
+// outgoing links spread their rank evenly over all nodes. Iteration stops
+// after `iterations` rounds (default 100), or earlier once the L1 change of
+// the rank vector drops below tolerance (default 1e-6). networkx scales its
+// tolerance by the node count, which on large graphs stops it after the first
+// round. Ranks sum to 1.
+//
+// edges_table is read on a separate connection, so it must not be a TEMP table.
+
+#include "page_rank_function.hpp"
+#include "crawler_utils.hpp"
+
+#include "duckdb/common/string_util.hpp"
+#include "duckdb/function/table_function.hpp"
+#include "duckdb/main/connection.hpp"
+#include "duckdb/main/database.hpp"
+#include "duckdb/main/extension/extension_loader.hpp"
+#include "duckdb/parallel/task_executor.hpp"
+#include "duckdb/parallel/task_scheduler.hpp"
+
+#include <atomic>
+#include <cmath>
+
+namespace duckdb {
+
+//===--------------------------------------------------------------------===//
+// Power iteration
+//===--------------------------------------------------------------------===//
+
+// Run task(range, begin, end) for ranges taken off the shared counter until none are left
+template <class TASK>
+static void RunRanges(const vector<idx_t> &bounds, std::atomic<idx_t> &next, TASK &task) {
+	idx_t range_count = bounds.size() - 1;
+	for (idx_t range = next++; range < range_count; range = next++) {
+		task(range, bounds[range], bounds[range + 1]);
+	}
+}
+
+template <class TASK>
+class PageRankRangeTask : public BaseExecutorTask {
+public:
+	PageRankRangeTask(TaskExecutor &executor, const vector<idx_t> &bounds, std::atomic<idx_t> &next, TASK &task)
+	    : BaseExecutorTask(executor), bounds(bounds), next(next), task(task) {
+	}
+
+	void ExecuteTask() override {
+		RunRanges(bounds, next, task);
+	}
+
+private:
+	const vector<idx_t> &bounds;
+	std::atomic<idx_t> &next;
+	TASK &task;
+};
+
+// Run task(range, begin, end) for each range [bounds[i], bounds[i + 1]) as up to threads
+// tasks on DuckDB's scheduler, so no threads are started per round. WorkOnTasks() joins
+// in and returns once every task is done: the barrier between two rounds.
+template <class TASK>
+static void ParallelRanges(TaskExecutor &executor, const vector<idx_t> &bounds, idx_t threads, TASK &task) {
+	std::atomic<idx_t> next {0};
+	idx_t task_count = MinValue(threads, bounds.size() - 1);
+	if (task_count <= 1) {
+		RunRanges(bounds, next, task);
+		return;
+	}
+	for (idx_t i = 0; i < task_count; i++) {
+		executor.ScheduleTask(make_uniq<PageRankRangeTask<TASK>>(executor, bounds, next, task));
+	}
+	executor.WorkOnTasks();
+}
+
+PageRankResult ComputePageRank(ClientContext &context, const PageRankGraph &graph, const PageRankOptions &options) {
+	PageRankResult result;
+	idx_t n = graph.node_count;
+	if (n == 0) {
+		return result;
+	}
+
+	// Compressed sparse rows of incoming edges: the sources of node v are
+	// in_sources[in_offsets[v] .. in_offsets[v + 1])
+	result.in_degree.assign(n, 0);
+	result.out_degree.assign(n, 0);
+	for (idx_t i = 0; i < graph.sources.size(); i++) {
+		result.out_degree[graph.sources[i]]++;
+		result.in_degree[graph.targets[i]]++;
+	}
+	vector<idx_t> in_offsets(n + 1, 0);
+	for (idx_t v = 0; v < n; v++) {
+		in_offsets[v + 1] = in_offsets[v] + result.in_degree[v];
+	}
+	vector<uint32_t> in_sources(graph.sources.size());
+	{
+		vector<idx_t> fill(in_offsets.begin(), in_offsets.end() - 1);
+		for (idx_t i = 0; i < graph.sources.size(); i++) {
+			in_sources[fill[graph.targets[i]]++] = graph.sources[i];
+		}
+	}
+
+	// Ranges of nodes with about the same number of edges, so hubs of a
+	// power-law graph do not leave one thread with most of the work
+	idx_t threads = MaxValue<idx_t>(1, options.threads);
+	idx_t work = graph.sources.size() + n;
+	idx_t range_work = MaxValue<idx_t>(work / (threads * 8) + 1, 4096);
+	vector<idx_t> bounds {0};
+	idx_t acc = 0;
+	for (idx_t v = 0; v < n; v++) {
+		acc += result.in_degree[v] + 1;
+		if (acc >= range_work) {
+			bounds.push_back(v + 1);
+			acc = 0;
+		}
+	}
+	if (bounds.back() != n) {
+		bounds.push_back(n);
+	}
+
+	// contribution[u] = rank[u] / out_degree[u]; dangling is the rank of nodes without outgoing links
+	double d = options.damping;
+	vector<double> rank(n, 1.0 / static_cast<double>(n));
+	vector<double> next_rank(n);
+	vector<double> contribution(n);
+	double dangling = 0;
+	for (idx_t u = 0; u < n; u++) {
+		if (result.out_degree[u] == 0) {
+			dangling += rank[u];
+		} else {
+			contribution[u] = rank[u] / result.out_degree[u];
+		}
+	}
+	vector<double> next_contribution(n);
+	vector<double> range_dangling(bounds.size() - 1);
+	vector<double> range_delta(bounds.size() - 1);
+
+	// One executor for all rounds; a query can be cancelled between them
+	TaskExecutor executor(context);
+	for (idx_t iteration = 0; iteration < options.max_iterations; iteration++) {
+		if (context.interrupted) {
+			throw InterruptException();
+		}
+		double base = (1.0 - d) / static_cast<double>(n) + d * dangling / static_cast<double>(n);
+		auto pass = [&](idx_t range, idx_t begin, idx_t end) {
+			double dangling_sum = 0;
+			double delta = 0;
+			for (idx_t v = begin; v < end; v++) {
+				double sum = 0;
+				for (idx_t e = in_offsets[v]; e < in_offsets[v + 1]; e++) {
+					sum += contribution[in_sources[e]];
+				}
+				double value = base + d * sum;
+				delta += std::fabs(value - rank[v]);
+				next_rank[v] = value;
+				if (result.out_degree[v] == 0) {
+					next_contribution[v] = 0;
+					dangling_sum += value;
+				} else {
+					next_contribution[v] = value / result.out_degree[v];
+				}
+			}
+			range_dangling[range] = dangling_sum;
+			range_delta[range] = delta;
+		};
+		ParallelRanges(executor, bounds, threads, pass);
+		rank.swap(next_rank);
+		contribution.swap(next_contribution);
+		dangling = 0;
+		double delta = 0;
+		for (idx_t range = 0; range < range_delta.size(); range++) {
+			dangling += range_dangling[range];
+			delta += range_delta[range];
+		}
+		result.iterations = iteration + 1;
+		if (delta < options.tolerance) {
+			break;
+		}
+	}
+	result.ranks = std::move(rank);
+	return result;
+}
+
+//===--------------------------------------------------------------------===//
+// Table function
+//===--------------------------------------------------------------------===//
+
+struct PageRankBindData : public TableFunctionData {
+	string edges_table;
+	string src_col;
+	string dst_col;
+	PageRankOptions options;
+};
+
+struct PageRankGlobalState : public GlobalTableFunctionState {
+	bool computed = false;
+	vector<string> nodes;
+	PageRankResult result;
+	idx_t offset = 0;
+};
+
+// "schema.table" with each part quoted
+static string QuoteTableName(const string &name) {
+	auto parts = StringUtil::Split(name, '.');
+	string quoted;
+	for (auto &part : parts) {
+		quoted += (quoted.empty() ? "" : ".") + QuoteSqlIdentifier(part);
+	}
+	return quoted;
+}
+
+static string RequireName(const Value &value, const char *what) {
+	if (value.IsNull() || StringValue::Get(value).empty()) {
+		throw BinderException("page_rank: %s must not be NULL or empty", what);
+	}
+	return StringValue::Get(value);
+}
+
+static unique_ptr<FunctionData> PageRankBind(ClientContext &context, TableFunctionBindInput &input,
+                                             vector<LogicalType> &return_types, vector<string> &names) {
+	auto bind_data = make_uniq<PageRankBindData>();
+	bind_data->edges_table = RequireName(input.inputs[0], "edges_table");
+	if (!IsValidSqlIdentifier(bind_data->edges_table)) {
+		throw BinderException("page_rank: invalid table name '%s'", bind_data->edges_table);
+	}
+	bind_data->src_col = RequireName(input.inputs[1], "src_col");
+	bind_data->dst_col = RequireName(input.inputs[2], "dst_col");
+
+	auto &options = bind_data->options;
+	if (input.inputs.size() > 3 && !input.inputs[3].IsNull()) {
+		options.damping = input.inputs[3].GetValue<double>();
+		if (!(options.damping >= 0 && options.damping < 1)) {
+			throw BinderException("page_rank: damping must be >= 0 and < 1");
+		}
+	}
+	if (input.inputs.size() > 4 && !input.inputs[4].IsNull()) {
+		auto iterations = input.inputs[4].GetValue<int64_t>();
+		if (iterations < 1) {
+			throw BinderException("page_rank: iterations must be >= 1");
+		}
+		options.max_iterations = NumericCast<idx_t>(iterations);
+	}
+	for (auto &kv : input.named_parameters) {
+		if (kv.first == "tolerance") {
+			options.tolerance = kv.second.GetValue<double>();
+			if (!(options.tolerance >= 0)) {
+				throw BinderException("page_rank: tolerance must be >= 0");
+			}
+		}
+	}
+	options.threads = NumericCast<idx_t>(TaskScheduler::GetScheduler(context).NumberOfThreads());
+
+	return_types.push_back(LogicalType::VARCHAR);
+	return_types.push_back(LogicalType::DOUBLE);
+	return_types.push_back(LogicalType::BIGINT);
+	return_types.push_back(LogicalType::BIGINT);
+	names.push_back("node");
+	names.push_back("rank");
+	names.push_back("in_degree");
+	names.push_back("out_degree");
+	return std::move(bind_data);
+}
+
+static unique_ptr<GlobalTableFunctionState> PageRankInitGlobal(ClientContext &context,
+                                                               TableFunctionInitInput &input) {
+	return make_uniq<PageRankGlobalState>();
+}
+
+// Node names by id and the edges as id pairs, in one streamed query. The node
+// CTE is materialized so both halves see the same ids.
+static PageRankGraph LoadPageRankGraph(ClientContext &context, const PageRankBindData &bind_data,
+                                       vector<string> &nodes) {
+	auto src = QuoteSqlIdentifier(bind_data.src_col);
+	auto dst = QuoteSqlIdentifier(bind_data.dst_col);
+	string sql = "WITH __pr_edges AS MATERIALIZED (SELECT DISTINCT " + src + "::VARCHAR AS s, " + dst +
+	             "::VARCHAR AS d FROM " + QuoteTableName(bind_data.edges_table) + " WHERE " + src +
+	             " IS NOT NULL AND " + dst + " IS NOT NULL), "
+	             "__pr_nodes AS MATERIALIZED (SELECT node, (row_number() OVER () - 1)::UINTEGER AS id "
+	             "FROM (SELECT s AS node FROM __pr_edges UNION SELECT d FROM __pr_edges)) "
+	             "SELECT id, node, NULL::UINTEGER, NULL::UINTEGER FROM __pr_nodes "
+	             "UNION ALL "
+	             "SELECT NULL, NULL, a.id, b.id FROM __pr_edges JOIN __pr_nodes a ON s = a.node "
+	             "JOIN __pr_nodes b ON d = b.node";
+
+	Connection conn(*context.db);
+	auto result = conn.SendQuery(sql);
+	if (result->HasError()) {
+		throw InvalidInputException("page_rank: cannot read edges: %s", result->GetError());
+	}
+	PageRankGraph graph;
+	while (auto chunk = result->Fetch()) {
+		chunk->Flatten();
+		auto ids = FlatVector::GetData<uint32_t>(chunk->data[0]);
+		auto names = FlatVector::GetData<string_t>(chunk->data[1]);
+		auto sources = FlatVector::GetData<uint32_t>(chunk->data[2]);
+		auto targets = FlatVector::GetData<uint32_t>(chunk->data[3]);
+		auto &node_rows = FlatVector::Validity(chunk->data[0]);
+		for (idx_t row = 0; row < chunk->size(); row++) {
+			if (node_rows.RowIsValid(row)) {
+				if (ids[row] >= nodes.size()) {
+					nodes.resize(ids[row] + 1);
+				}
+				nodes[ids[row]] = names[row].GetString();
+			} else {
+				graph.sources.push_back(sources[row]);
+				graph.targets.push_back(targets[row]);
+			}
+		}
+	}
+	if (result->HasError()) {
+		throw InvalidInputException("page_rank: cannot read edges: %s", result->GetError());
+	}
+	graph.node_count = nodes.size();
+	return graph;
+}
+
+static void PageRankFunction(ClientContext &context, TableFunctionInput &data, DataChunk &output) {
+	auto &bind_data = data.bind_data->Cast<PageRankBindData>();
+	auto &state = data.global_state->Cast<PageRankGlobalState>();
+	if (!state.computed) {
+		state.computed = true;
+		auto graph = LoadPageRankGraph(context, bind_data, state.nodes);
+		state.result = ComputePageRank(context, graph, bind_data.options);
+	}
+
+	idx_t count = 0;
+	auto node_data = FlatVector::GetData<string_t>(output.data[0]);
+	auto rank_data = FlatVector::GetData<double>(output.data[1]);
+	auto in_data = FlatVector::GetData<int64_t>(output.data[2]);
+	auto out_data = FlatVector::GetData<int64_t>(output.data[3]);
+	while (state.offset < state.nodes.size() && count < STANDARD_VECTOR_SIZE) {
+		auto id = state.offset++;
+		node_data[count] = StringVector::AddString(output.data[0], state.nodes[id]);
+		rank_data[count] = state.result.ranks[id];
+		in_data[count] = state.result.in_degree[id];
+		out_data[count] = state.result.out_degree[id];
+		count++;
+	}
+	output.SetCardinality(count);
+}
+
+void RegisterPageRankFunction(ExtensionLoader &loader) {
+	TableFunctionSet page_rank("page_rank");
+	auto add_overload = [&](vector<LogicalType> arguments) {
+		TableFunction func("page_rank", std::move(arguments), PageRankFunction, PageRankBind, PageRankInitGlobal);
+		func.named_parameters["tolerance"] = LogicalType::DOUBLE;
+		page_rank.AddFunction(func);
+	};
+	// edges_table, src_col, dst_col [, damping [, iterations]]
+	add_overload({LogicalType::VARCHAR, LogicalType::VARCHAR, LogicalType::VARCHAR});
+	add_overload({LogicalType::VARCHAR, LogicalType::VARCHAR, LogicalType::VARCHAR, LogicalType::DOUBLE});
+	add_overload(
+	    {LogicalType::VARCHAR, LogicalType::VARCHAR, LogicalType::VARCHAR, LogicalType::DOUBLE, LogicalType::BIGINT});
+	loader.RegisterFunction(page_rank);
+}
+
+} // namespace duckdb
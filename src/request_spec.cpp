@@ -0,0 +1,137 @@
+// Request specs - crawl() / crawl_url() rows with a method, headers and a body
+//
+//   SELECT url, status, html.document FROM crawl([
+//       {'url': 'https://api.example.com/graphql', 'method': 'POST',
+//        'headers': MAP {'Content-Type': 'application/json'}, 'body': '{"query": "{ products { id } }"}'}
+//   ]);
+
+#include "request_spec.hpp"
+
+#include "mbedtls_wrapper.hpp"
+
+namespace duckdb {
+
+using namespace duckdb_yyjson;
+
+static const char *const CRAWL_REQUEST_METHODS[] = {"GET", "HEAD", "POST", "PUT", "PATCH", "DELETE", "OPTIONS"};
+
+// Headers that select whose response is returned: requests differing in them are different entries
+static const char *const CRAWL_CREDENTIAL_HEADERS[] = {"authorization", "proxy-authorization", "cookie"};
+
+static string Sha256Hex(const string &data) {
+	duckdb_mbedtls::MbedTlsWrapper::SHA256State state;
+	state.AddString(data);
+	auto digest = state.Finalize();
+	static const char *hex = "0123456789abcdef";
+	string result;
+	result.reserve(digest.size() * 2);
+	for (auto byte : digest) {
+		result += hex[static_cast<uint8_t>(byte) >> 4];
+		result += hex[static_cast<uint8_t>(byte) & 0xf];
+	}
+	return result;
+}
+
+string CrawlRequestSpec::CredentialDigest() const {
+	// Lowercased names in a fixed order, so the digest does not depend on header case or order
+	std::map<string, string> credentials;
+	for (auto &header : headers) {
+		auto name = StringUtil::Lower(header.first);
+		for (auto credential : CRAWL_CREDENTIAL_HEADERS) {
+			if (name == credential) {
+				credentials[name] = header.second;
+			}
+		}
+	}
+	if (credentials.empty()) {
+		return "";
+	}
+	string canonical;
+	for (auto &credential : credentials) {
+		canonical += credential.first + ":" + credential.second + "\n";
+	}
+	return Sha256Hex(canonical);
+}
+
+string CrawlRequestSpec::Key() const {
+	auto credentials = CredentialDigest();
+	if (method == "GET" && !has_body && credentials.empty()) {
+		return url;
+	}
+	string key = method + " " + url;
+	if (has_body) {
+		key += " body:" + Sha256Hex(body);
+	}
+	if (!credentials.empty()) {
+		key += " auth:" + credentials;
+	}
+	return key;
+}
+
+LogicalType CrawlRequestSpecType() {
+	child_list_t<LogicalType> children;
+	children.push_back(make_pair("url", LogicalType::VARCHAR));
+	children.push_back(make_pair("method", LogicalType::VARCHAR));
+	children.push_back(make_pair("headers", LogicalType::MAP(LogicalType::VARCHAR, LogicalType::VARCHAR)));
+	children.push_back(make_pair("body", LogicalType::VARCHAR));
+	return LogicalType::STRUCT(children);
+}
+
+CrawlRequestSpec CrawlRequestSpecFromValue(const Value &value) {
+	CrawlRequestSpec spec;
+	bool has_url = false;
+	auto &child_types = StructType::GetChildTypes(value.type());
+	auto &children = StructValue::GetChildren(value);
+	for (idx_t i = 0; i < children.size(); i++) {
+		auto &name = child_types[i].first;
+		auto &child = children[i];
+		if (child.IsNull()) {
+			continue;
+		}
+		if (StringUtil::CIEquals(name, "url")) {
+			spec.url = child.ToString();
+			has_url = true;
+		} else if (StringUtil::CIEquals(name, "method")) {
+			spec.method = StringUtil::Upper(child.ToString());
+		} else if (StringUtil::CIEquals(name, "headers")) {
+			for (auto &entry : MapValue::GetChildren(child)) {
+				auto &key_value = StructValue::GetChildren(entry);
+				if (!key_value[0].IsNull() && !key_value[1].IsNull()) {
+					spec.headers[key_value[0].ToString()] = key_value[1].ToString();
+				}
+			}
+		} else if (StringUtil::CIEquals(name, "body")) {
+			spec.body = child.ToString();
+			spec.has_body = true;
+		}
+	}
+	if (!has_url) {
+		throw InvalidInputException("crawl: request url must not be NULL");
+	}
+	bool known_method = false;
+	for (auto method : CRAWL_REQUEST_METHODS) {
+		known_method = known_method || spec.method == method;
+	}
+	if (!known_method) {
+		throw InvalidInputException("crawl: unsupported request method '%s'", spec.method);
+	}
+	return spec;
+}
+
+yyjson_mut_val *CrawlRequestSpecJson(yyjson_mut_doc *doc, const CrawlRequestSpec &spec) {
+	yyjson_mut_val *item = yyjson_mut_obj(doc);
+	yyjson_mut_obj_add_strcpy(doc, item, "method", spec.method.c_str());
+	if (!spec.headers.empty()) {
+		yyjson_mut_val *headers = yyjson_mut_obj(doc);
+		for (auto &header : spec.headers) {
+			yyjson_mut_obj_add_strcpy(doc, headers, header.first.c_str(), header.second.c_str());
+		}
+		yyjson_mut_obj_add_val(doc, item, "headers", headers);
+	}
+	if (spec.has_body) {
+		yyjson_mut_obj_add_strncpy(doc, item, "body", spec.body.c_str(), spec.body.size());
+	}
+	return item;
+}
+
+} // namespace duckdb
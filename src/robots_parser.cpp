@@ -171,25 +171,55 @@ RobotsRules RobotsParser::GetRulesForUserAgent(const RobotsData &data, const std
 	return RobotsRules();
 }
 
+// Does a rule match path? '*' matches any sequence, a trailing '$' anchors the end (RFC 9309)
+static bool RuleMatches(const std::string &rule, const std::string &path) {
+	bool anchored = !rule.empty() && rule.back() == '$';
+	size_t rule_end = anchored ? rule.size() - 1 : rule.size();
+	size_t r = 0;
+	size_t p = 0;
+	size_t star = std::string::npos; // Rule position after the last '*'
+	size_t star_path = 0;            // Path position that '*' matched up to
+	while (true) {
+		if (r == rule_end) {
+			if (!anchored || p == path.size()) {
+				return true;
+			}
+		} else if (rule[r] == '*') {
+			star = ++r;
+			star_path = p;
+			continue;
+		} else if (p < path.size() && rule[r] == path[p]) {
+			r++;
+			p++;
+			continue;
+		}
+		// Mismatch: let the last '*' absorb one more character
+		if (star == std::string::npos || star_path >= path.size()) {
+			return false;
+		}
+		r = star;
+		p = ++star_path;
+	}
+}
+
+// The longest matching rule decides, Allow winning ties (RFC 9309)
 bool RobotsParser::IsAllowed(const RobotsRules &rules, const std::string &path) {
-	// Check Allow rules first (more specific)
+	size_t allow_length = 0;
+	bool allow_matched = false;
 	for (const auto &allow : rules.allow) {
-		if (path.find(allow) == 0) {
-			return true;
+		if (!allow.empty() && allow.size() >= allow_length && RuleMatches(allow, path)) {
+			allow_length = allow.size();
+			allow_matched = true;
 		}
 	}
-
-	// Check Disallow rules
 	for (const auto &disallow : rules.disallow) {
 		if (disallow.empty()) {
 			continue; // Empty disallow means allow all
 		}
-		if (path.find(disallow) == 0) {
+		if ((!allow_matched || disallow.size() > allow_length) && RuleMatches(disallow, path)) {
 			return false;
 		}
 	}
-
-	// Default: allowed
 	return true;
 }
 
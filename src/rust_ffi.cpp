@@ -30,6 +30,11 @@ extern "C" {
     // Token-efficient page inventory
     ExtractionResultFFI page_info_ffi(const char *html_ptr, size_t html_len,
                                        const char *url);
+    // Language detection: a JSON array of codes for a batch of texts, the bare code of a response body
+    ExtractionResultFFI detect_languages_ffi(const char *const *text_ptrs, const size_t *text_lens,
+                                             const char *const *hint_ptrs, size_t count);
+    ExtractionResultFFI detect_page_language_ffi(const char *body_ptr, size_t body_len, const char *content_type,
+                                                 const char *content_language);
     // Batch crawl + extract (HTTP in Rust)
     ExtractionResultFFI crawl_batch_ffi(const char *request_json);
     // Sitemap fetching (simple API - returns char* directly)
@@ -161,6 +166,58 @@ std::string ExtractReadabilityWithRust(const std::string &html, const std::strin
     return result.HasError() ? "{}" : result.GetJson();
 }
 
+std::vector<std::string> DetectLanguagesWithRust(const std::vector<std::string> &texts,
+                                                 const std::vector<std::string> &hints) {
+    std::vector<std::string> result(texts.size());
+    if (texts.empty()) return result;
+
+    std::vector<const char *> text_ptrs;
+    std::vector<size_t> text_lens;
+    std::vector<const char *> hint_ptrs;
+    text_ptrs.reserve(texts.size());
+    text_lens.reserve(texts.size());
+    for (const auto &text : texts) {
+        text_ptrs.push_back(text.c_str());
+        text_lens.push_back(text.length());
+    }
+    for (const auto &hint : hints) {
+        hint_ptrs.push_back(hint.c_str());
+    }
+    auto ffi_result = detect_languages_ffi(text_ptrs.data(), text_lens.data(),
+                                           hints.empty() ? nullptr : hint_ptrs.data(), texts.size());
+    RustResult rust_result(ffi_result);
+    if (rust_result.HasError()) {
+        return result;
+    }
+
+    // JSON array of codes, aligned with texts
+    std::string json = rust_result.GetJson();
+    yyjson_doc *doc = yyjson_read(json.c_str(), json.length(), 0);
+    if (!doc) return result;
+
+    yyjson_val *root = yyjson_doc_get_root(doc);
+    if (yyjson_is_arr(root)) {
+        size_t idx, max_idx;
+        yyjson_val *val;
+        yyjson_arr_foreach(root, idx, max_idx, val) {
+            if (idx < result.size() && yyjson_is_str(val)) {
+                result[idx] = yyjson_get_str(val);
+            }
+        }
+    }
+    yyjson_doc_free(doc);
+    return result;
+}
+
+std::string DetectPageLanguageWithRust(const std::string &body, const std::string &content_type,
+                                       const std::string &content_language) {
+    if (body.empty()) return "";
+    auto ffi_result = detect_page_language_ffi(body.c_str(), body.length(), content_type.c_str(),
+                                               content_language.c_str());
+    RustResult result(ffi_result);
+    return result.HasError() ? "" : result.GetJson();
+}
+
 std::string CrawlBatchWithRust(const std::string &request_json) {
     if (request_json.empty()) return "{\"results\":[]}";
     auto ffi_result = crawl_batch_ffi(request_json.c_str());
@@ -348,6 +405,20 @@ std::string ExtractReadabilityWithRust(const std::string &html, const std::strin
     return "{}";
 }
 
+std::vector<std::string> DetectLanguagesWithRust(const std::vector<std::string> &texts,
+                                                 const std::vector<std::string> &hints) {
+    (void)hints;
+    return std::vector<std::string>(texts.size());
+}
+
+std::string DetectPageLanguageWithRust(const std::string &body, const std::string &content_type,
+                                       const std::string &content_language) {
+    (void)body;
+    (void)content_type;
+    (void)content_language;
+    return "";
+}
+
 std::string CrawlBatchWithRust(const std::string &request_json) {
     (void)request_json;
     return "{\"error\":\"Rust parser not available\"}";
@@ -1,6 +1,7 @@
 // Sitemap table function for DuckDB Crawler
 // Fetches and parses XML sitemaps
 
+#include "crawl_progress.hpp"
 #include "duckdb.hpp"
 #include "duckdb/function/table_function.hpp"
 #include "rust_ffi.hpp"
@@ -40,6 +41,8 @@ struct SitemapGlobalState : public GlobalTableFunctionState {
     vector<SitemapEntry> entries;
     idx_t current_idx = 0;
     bool fetched = false;
+    // Sitemap discovery is one Rust call: in flight until it returns, then entries are emitted
+    shared_ptr<CrawlProgress> progress;
 
     idx_t MaxThreads() const override { return 1; }
 };
@@ -187,7 +190,10 @@ static unique_ptr<FunctionData> SitemapBind(ClientContext &context,
 
 static unique_ptr<GlobalTableFunctionState> SitemapInitGlobal(ClientContext &context,
                                                                TableFunctionInitInput &input) {
-    return make_uniq<SitemapGlobalState>();
+    auto state = make_uniq<SitemapGlobalState>();
+    state->progress = RegisterCrawlProgress(context, "sitemap");
+    state->progress->discovering = true;
+    return std::move(state);
 }
 
 //===--------------------------------------------------------------------===//
@@ -200,10 +206,14 @@ static void SitemapFunction(ClientContext &context, TableFunctionInput &data, Da
 
     // Fetch sitemap on first call
     if (!state.fetched) {
+        state.progress->in_flight = 1;
         string request_json = BuildSitemapRequest(bind_data);
         string response_json = FetchSitemapWithRust(request_json);
         state.entries = ParseSitemapResponse(response_json, bind_data.filter_pattern);
         state.fetched = true;
+        state.progress->in_flight = 0;
+        state.progress->queued = NumericCast<int64_t>(state.entries.size());
+        state.progress->discovering = false;
     }
 
     // Return results
@@ -218,10 +228,20 @@ static void SitemapFunction(ClientContext &context, TableFunctionInput &data, Da
 
         count++;
     }
+    state.progress->queued -= NumericCast<int64_t>(count);
+    state.progress->Complete(NumericCast<int64_t>(count));
 
     output.SetCardinality(count);
 }
 
+static double SitemapProgress(ClientContext &context, const FunctionData *bind_data_p,
+                              const GlobalTableFunctionState *gstate_p) {
+    if (!gstate_p) {
+        return -1.0;
+    }
+    return CrawlProgressPercentage(gstate_p->Cast<SitemapGlobalState>().progress);
+}
+
 //===--------------------------------------------------------------------===//
 // Register Function
 //===--------------------------------------------------------------------===//
@@ -237,6 +257,7 @@ void RegisterSitemapFunction(ExtensionLoader &loader) {
     sitemap_func.named_parameters["user_agent"] = LogicalType::VARCHAR;
     sitemap_func.named_parameters["timeout"] = LogicalType::INTEGER;
     sitemap_func.named_parameters["filter"] = LogicalType::VARCHAR;
+    sitemap_func.table_scan_progress = SitemapProgress;
 
     loader.RegisterFunction(sitemap_func);
 }
@@ -0,0 +1,258 @@
+// Soft error (soft 404) detection for crawl(soft_404 := 'flag' | 'skip')
+//
+//   SELECT url, soft_404 FROM crawl(urls, soft_404 := 'flag');
+//
+// Signatures are SimHashes, so two renderings of the same template that
+// differ in a few words (the requested path, a search box value) stay within
+// a few bits of each other, while pages with their own content do not.
+
+#include "soft_error_detector.hpp"
+#include "html_to_text_function.hpp"
+#include "html_tokenizer.hpp"
+
+#include "duckdb/common/random_engine.hpp"
+#include "duckdb/common/string_util.hpp"
+#include "duckdb/common/types/hash.hpp"
+
+#include <cstdio>
+#include <unordered_set>
+
+namespace duckdb {
+
+// Path requested once per host, followed by "-" and a random suffix drawn per crawl run
+// so that no site can serve (or have cached) a real page under it
+static constexpr const char *SOFT_ERROR_PROBE_PATH = "/duckdb-crawler-soft-404-probe";
+
+// Visible text considered per page
+static constexpr idx_t SOFT_ERROR_TEXT_LIMIT = 64 * 1024;
+
+// Near-duplicate text: a soft error on its own
+static constexpr idx_t SOFT_ERROR_TEXT_DISTANCE = 3;
+// Same markup structure: text may differ a little more (echoed path, search terms)
+static constexpr idx_t SOFT_ERROR_STRUCTURE_DISTANCE = 3;
+static constexpr idx_t SOFT_ERROR_TEXT_DISTANCE_SAME_STRUCTURE = 10;
+
+bool TryParseSoftErrorMode(const string &name, SoftErrorMode &mode) {
+	auto lowered = StringUtil::Lower(name);
+	if (lowered == "off") {
+		mode = SoftErrorMode::OFF;
+	} else if (lowered == "flag") {
+		mode = SoftErrorMode::FLAG;
+	} else if (lowered == "skip") {
+		mode = SoftErrorMode::SKIP;
+	} else {
+		return false;
+	}
+	return true;
+}
+
+//===--------------------------------------------------------------------===//
+// Signatures
+//===--------------------------------------------------------------------===//
+
+// scheme://host[:port] of url, empty if it has none
+static string UrlOrigin(const string &url) {
+	auto scheme_end = url.find("://");
+	if (scheme_end == string::npos || scheme_end == 0) {
+		return "";
+	}
+	auto authority_end = url.find_first_of("/?#", scheme_end + 3);
+	if (authority_end == string::npos) {
+		authority_end = url.size();
+	}
+	if (authority_end == scheme_end + 3) {
+		return "";
+	}
+	return StringUtil::Lower(url.substr(0, authority_end));
+}
+
+struct SimHashBuilder {
+	int32_t weights[64] = {};
+
+	void Add(hash_t feature) {
+		for (idx_t bit = 0; bit < 64; bit++) {
+			weights[bit] += (feature >> bit) & 1 ? 1 : -1;
+		}
+	}
+
+	uint64_t Finish() const {
+		uint64_t result = 0;
+		for (idx_t bit = 0; bit < 64; bit++) {
+			if (weights[bit] > 0) {
+				result |= uint64_t(1) << bit;
+			}
+		}
+		return result;
+	}
+};
+
+// Adds the 3-grams of a sequence of token hashes (the tokens themselves when there are fewer)
+struct ShingleBuilder {
+	SimHashBuilder simhash;
+	hash_t window[3] = {};
+	idx_t tokens = 0;
+
+	void Add(hash_t token) {
+		window[0] = window[1];
+		window[1] = window[2];
+		window[2] = token;
+		tokens++;
+		if (tokens >= 3) {
+			simhash.Add(CombineHash(CombineHash(window[0], window[1]), window[2]));
+		}
+	}
+
+	uint64_t Finish() {
+		if (tokens < 3) {
+			for (idx_t i = 3 - tokens; i < 3; i++) {
+				simhash.Add(window[i]);
+			}
+		}
+		return simhash.Finish();
+	}
+};
+
+static bool IsWordByte(unsigned char c) {
+	return StringUtil::CharacterIsAlphaNumeric(static_cast<char>(c)) || c >= 0x80;
+}
+
+// Lowercase words of text, in order
+template <class FUNC>
+static void ForEachWord(const string &text, FUNC &&callback) {
+	string word;
+	for (idx_t i = 0; i <= text.size(); i++) {
+		auto c = i < text.size() ? static_cast<unsigned char>(text[i]) : ' ';
+		if (IsWordByte(c)) {
+			word += StringUtil::CharacterToLower(static_cast<char>(c));
+		} else if (!word.empty()) {
+			callback(word);
+			word.clear();
+		}
+	}
+}
+
+// Words of the page's own path and query are skipped: error templates often
+// echo the requested path ("The page /old-page could not be found")
+static void AddTextShingles(const string &text, const string &url_path, ShingleBuilder &shingles) {
+	std::unordered_set<string> path_words;
+	ForEachWord(url_path, [&](const string &word) { path_words.insert(word); });
+	ForEachWord(text, [&](const string &word) {
+		if (path_words.count(word) == 0) {
+			shingles.Add(Hash(word.c_str(), word.size()));
+		}
+	});
+}
+
+// Tag name sequence of the opening tags; comments, doctypes and raw text
+// (script / style content) are skipped
+static void AddStructureShingles(const string &html, ShingleBuilder &shingles) {
+	idx_t pos = 0;
+	HtmlTag tag;
+	while (NextHtmlTag(html.data(), html.size(), pos, tag)) {
+		if (tag.closing) {
+			continue;
+		}
+		auto name = StringUtil::Lower(html.substr(tag.name_start, tag.name_len));
+		shingles.Add(Hash(name.c_str(), name.size()));
+	}
+}
+
+PageSignature ComputePageSignature(const string &html, const string &url) {
+	PageSignature signature;
+	ShingleBuilder text_shingles;
+	AddTextShingles(HtmlVisibleText(html, SOFT_ERROR_TEXT_LIMIT), url.substr(UrlOrigin(url).size()), text_shingles);
+	signature.has_text = text_shingles.tokens > 0;
+	signature.text = text_shingles.Finish();
+
+	ShingleBuilder structure_shingles;
+	AddStructureShingles(html, structure_shingles);
+	signature.structure = structure_shingles.Finish();
+	return signature;
+}
+
+idx_t SimHashDistance(uint64_t a, uint64_t b) {
+	uint64_t diff = a ^ b;
+	idx_t bits = 0;
+	while (diff) {
+		diff &= diff - 1;
+		bits++;
+	}
+	return bits;
+}
+
+//===--------------------------------------------------------------------===//
+// SoftErrorDetector
+//===--------------------------------------------------------------------===//
+
+static bool IsSuccessfulHtml(const SoftErrorResponse &response) {
+	return response.status_code >= 200 && response.status_code < 300 && !response.body.empty() &&
+	       response.content_type.find("html") != string::npos;
+}
+
+SoftErrorDetector::SoftErrorDetector() {
+	RandomEngine engine;
+	char suffix[20];
+	snprintf(suffix, sizeof(suffix), "-%08x%08x", engine.NextRandomInteger(), engine.NextRandomInteger());
+	probe_suffix = suffix;
+}
+
+// Same template: near-duplicate text, or the same markup with text that differs in a few words
+static bool MatchesTemplate(const PageSignature &signature, const PageSignature &template_signature) {
+	auto structure_distance = SimHashDistance(signature.structure, template_signature.structure);
+	if (!signature.has_text || !template_signature.has_text) {
+		return signature.has_text == template_signature.has_text &&
+		       structure_distance <= SOFT_ERROR_STRUCTURE_DISTANCE;
+	}
+	auto text_distance = SimHashDistance(signature.text, template_signature.text);
+	return text_distance <= SOFT_ERROR_TEXT_DISTANCE ||
+	       (structure_distance <= SOFT_ERROR_STRUCTURE_DISTANCE &&
+	        text_distance <= SOFT_ERROR_TEXT_DISTANCE_SAME_STRUCTURE);
+}
+
+SoftErrorDetector::HostProfile &SoftErrorDetector::GetProfile(const string &origin) {
+	std::lock_guard<std::mutex> guard(hosts_lock);
+	auto &profile = hosts[origin];
+	if (!profile) {
+		profile = make_uniq<HostProfile>();
+	}
+	return *profile;
+}
+
+bool SoftErrorDetector::IsSoftError(const SoftErrorResponse &response, const ProbeFunction &probe) {
+	if (!IsSuccessfulHtml(response)) {
+		return false;
+	}
+	auto origin = UrlOrigin(response.url);
+	if (origin.empty()) {
+		return false;
+	}
+	auto &profile = GetProfile(origin);
+	std::lock_guard<std::mutex> guard(profile.lock);
+	if (!profile.probed) {
+		profile.probed = true;
+		auto cache_key = origin + SOFT_ERROR_PROBE_PATH;
+		auto probe_url = cache_key + probe_suffix;
+		auto answer = probe(probe_url, cache_key);
+		if (IsSuccessfulHtml(answer)) {
+			profile.has_template = true;
+			profile.signature = ComputePageSignature(answer.body, answer.url);
+			if (!answer.final_url.empty() && answer.final_url != answer.url) {
+				// Unknown paths redirect (usually to the home page)
+				profile.redirect_target = answer.final_url;
+			}
+		}
+	}
+	if (!profile.has_template) {
+		return false;
+	}
+	if (!profile.redirect_target.empty()) {
+		// Only pages redirected to the same target can be the probe's answer; the target itself
+		// (and pages that merely redirect there with content of their own) are not
+		if (response.final_url != profile.redirect_target || response.url == profile.redirect_target) {
+			return false;
+		}
+	}
+	return MatchesTemplate(ComputePageSignature(response.body, response.url), profile.signature);
+}
+
+} // namespace duckdb
@@ -9,10 +9,12 @@
 #include "duckdb/function/table_function.hpp"
 #include "duckdb/main/extension/extension_loader.hpp"
 #include "duckdb/main/connection.hpp"
+#include "duckdb/main/appender.hpp"
 #include "duckdb/common/string_util.hpp"
 #include "duckdb/parser/parser.hpp"
 #include "crawler_utils.hpp"
 #include "pipeline_state.hpp"
+#include "write_behind_writer.hpp"
 
 namespace duckdb {
 
@@ -72,6 +74,12 @@ static unique_ptr<GlobalTableFunctionState> StreamIntoInitGlobal(ClientContext &
 //===--------------------------------------------------------------------===//
 // Main Function - Streaming Execution
 //===--------------------------------------------------------------------===//
+// The source query is streamed on this thread while a write-behind writer
+// appends the chunks on its own connection, committing every batch_size rows.
+// The bounded queue between them applies backpressure to the source.
+
+// Source chunks queued ahead of the writer before the scan blocks
+static constexpr idx_t STREAM_WRITER_MAX_PENDING_CHUNKS = 4;
 
 static void StreamIntoFunction(ClientContext &context, TableFunctionInput &data, DataChunk &output) {
     auto &bind_data = data.bind_data->CastNoConst<StreamIntoBindData>();
@@ -93,90 +101,61 @@ static void StreamIntoFunction(ClientContext &context, TableFunctionInput &data,
         InitPipelineLimit(*context.db, bind_data.row_limit);
     }
 
-    // Execute source query
-    auto query_result = conn.Query(bind_data.source_query);
+    // Stream source query
+    auto query_result = conn.SendQuery(bind_data.source_query);
     if (query_result->HasError()) {
         throw IOException("STREAM source query error: " + query_result->GetError());
     }
 
-    // Create target table from first chunk if needed
-    auto first_chunk = query_result->Fetch();
-
-    if (first_chunk && first_chunk->size() > 0) {
-        // Check if table exists
-        auto check_result = conn.Query("SELECT 1 FROM information_schema.tables WHERE table_name = $1",
-                                        bind_data.target_table);
-        auto check_chunk = check_result->Fetch();
-        if (!check_chunk || check_chunk->size() == 0) {
-            // Create table with columns from query result
-            string create_sql = "CREATE TABLE " + QuoteSqlIdentifier(bind_data.target_table) + " (";
-            for (idx_t i = 0; i < query_result->names.size(); i++) {
-                if (i > 0) create_sql += ", ";
-                create_sql += QuoteSqlIdentifier(query_result->names[i]) + " " +
-                              query_result->types[i].ToString();
+    vector<string> col_names = query_result->names;
+    vector<LogicalType> col_types = query_result->types;
+    bool target_checked = false;
+
+    // Writer: create the target table from the source schema on the first chunk, then append
+    idx_t rows_per_transaction = bind_data.batch_size > 0 ? static_cast<idx_t>(bind_data.batch_size) : 100;
+    WriteBehindWriter<unique_ptr<DataChunk>> writer(
+        *context.db, "STREAM", STREAM_WRITER_MAX_PENDING_CHUNKS, rows_per_transaction,
+        [&](Connection &writer_conn, unique_ptr<DataChunk> &chunk) -> idx_t {
+            if (!target_checked) {
+                target_checked = true;
+                auto check_result = writer_conn.Query(
+                    "SELECT 1 FROM information_schema.tables WHERE table_name = $1", bind_data.target_table);
+                auto check_chunk = check_result->Fetch();
+                if (!check_chunk || check_chunk->size() == 0) {
+                    string create_sql = "CREATE TABLE " + QuoteSqlIdentifier(bind_data.target_table) + " (";
+                    for (idx_t i = 0; i < col_names.size(); i++) {
+                        if (i > 0) create_sql += ", ";
+                        create_sql += QuoteSqlIdentifier(col_names[i]) + " " + col_types[i].ToString();
+                    }
+                    create_sql += ")";
+                    auto create_result = writer_conn.Query(create_sql);
+                    if (create_result->HasError()) {
+                        throw IOException("STREAM create table error: " + create_result->GetError());
+                    }
+                }
             }
-            create_sql += ")";
-            conn.Query(create_sql);
-        }
-    }
-
-    // Process chunks and insert rows
-    int64_t total_inserted = 0;
-    idx_t batch_rows = 0;
-    bool limit_reached = false;
-
-    auto insert_row = [&](unique_ptr<DataChunk> &chunk, idx_t row) -> bool {
-        // Check if limit reached before inserting
-        if (bind_data.row_limit > 0 && total_inserted >= bind_data.row_limit) {
-            return false;  // Stop processing
-        }
-
-        string insert_sql = "INSERT INTO " + QuoteSqlIdentifier(bind_data.target_table) + " VALUES (";
-        for (idx_t col = 0; col < chunk->ColumnCount(); col++) {
-            if (col > 0) insert_sql += ", ";
-            auto val = chunk->GetValue(col, row);
-            if (val.IsNull()) {
-                insert_sql += "NULL";
-            } else {
-                insert_sql += val.ToSQLString();
-            }
-        }
-        insert_sql += ")";
-        conn.Query(insert_sql);
-        total_inserted++;
-        batch_rows++;
-
-        if (batch_rows >= (idx_t)bind_data.batch_size) {
-            state.batches_written++;
-            batch_rows = 0;
-        }
-
-        return true;  // Continue processing
-    };
-
-    // Process first chunk
-    if (first_chunk && first_chunk->size() > 0) {
-        for (idx_t row = 0; row < first_chunk->size(); row++) {
-            if (!insert_row(first_chunk, row)) {
-                limit_reached = true;
-                break;
-            }
-        }
-    }
-
-    // Process remaining chunks (unless limit already reached)
-    while (!limit_reached) {
+            Appender appender(writer_conn, bind_data.target_table);
+            appender.AppendDataChunk(*chunk);
+            appender.Close();
+            return chunk->size();
+        });
+
+    // Push chunks until the source is exhausted or the limit is reached
+    int64_t total_pushed = 0;
+    while (bind_data.row_limit <= 0 || total_pushed < bind_data.row_limit) {
         auto chunk = query_result->Fetch();
         if (!chunk || chunk->size() == 0) break;
-        for (idx_t row = 0; row < chunk->size(); row++) {
-            if (!insert_row(chunk, row)) {
-                limit_reached = true;
-                break;
-            }
+        if (bind_data.row_limit > 0 && total_pushed + (int64_t)chunk->size() > bind_data.row_limit) {
+            chunk->SetCardinality(static_cast<idx_t>(bind_data.row_limit - total_pushed));
         }
+        total_pushed += chunk->size();
+        writer.Push(std::move(chunk));
     }
+    query_result.reset();
+    writer.Finish();
 
-    state.rows_inserted = total_inserted;
+    state.rows_inserted = writer.rows_written.load();
+    state.batches_written = writer.transactions_committed.load();
     state.finished = true;
 
     // Clean up pipeline state
@@ -185,7 +164,7 @@ static void StreamIntoFunction(ClientContext &context, TableFunctionInput &data,
     }
 
     // Return rows_inserted count
-    output.SetValue(0, 0, Value::BIGINT(total_inserted));
+    output.SetValue(0, 0, Value::BIGINT(state.rows_inserted));
     output.SetCardinality(1);
 }
 
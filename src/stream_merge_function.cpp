@@ -10,12 +10,15 @@
 //   WHEN MATCHED AND age(jobs.crawled_at) > INTERVAL '24 hours' THEN UPDATE BY NAME
 //   WHEN NOT MATCHED THEN INSERT BY NAME;
 
+#include "stream_merge_function.hpp"
+#include "crawl_progress.hpp"
 #include "duckdb/function/table_function.hpp"
 #include "duckdb/main/extension/extension_loader.hpp"
 #include "duckdb/main/connection.hpp"
 #include "duckdb/common/string_util.hpp"
 #include "crawler_utils.hpp"
 #include "pipeline_state.hpp"
+#include "write_behind_writer.hpp"
 #include <unordered_set>
 #include <regex>
 #include <atomic>
@@ -251,9 +254,8 @@ struct CrawlingMergeGlobalState : public GlobalTableFunctionState {
 	int64_t rows_updated = 0;
 	int64_t rows_deleted = 0;
 
-	// Progress tracking for progress bar
-	std::atomic<int64_t> total_rows{0};
-	std::atomic<int64_t> processed_rows{0};
+	// Source rows: queued once read from the source, completed once merged
+	shared_ptr<CrawlProgress> progress;
 
 	idx_t MaxThreads() const override { return 1; }
 };
@@ -334,7 +336,14 @@ static unique_ptr<FunctionData> CrawlingMergeBind(ClientContext &context, TableF
 
 static unique_ptr<GlobalTableFunctionState> CrawlingMergeInitGlobal(ClientContext &context,
                                                                     TableFunctionInitInput &input) {
-	return make_uniq<CrawlingMergeGlobalState>();
+	auto &bind_data = input.bind_data->Cast<CrawlingMergeBindData>();
+	auto state = make_uniq<CrawlingMergeGlobalState>();
+	state->progress = RegisterCrawlProgress(context, "stream_merge");
+	state->progress->discovering = true;
+	if (bind_data.row_limit > 0) {
+		state->progress->limit = bind_data.row_limit;
+	}
+	return std::move(state);
 }
 
 //===--------------------------------------------------------------------===//
@@ -470,9 +479,195 @@ static string BuildInsertByName(const CrawlingMergeBindData &bind_data,
 	return sql;
 }
 
+//===--------------------------------------------------------------------===//
+// Write-Behind Merge
+//===--------------------------------------------------------------------===//
+
+// Source chunks queued ahead of the writer before the scan blocks
+static constexpr idx_t MERGE_WRITER_MAX_PENDING_CHUNKS = 4;
+
+// Run a merge statement on the writer connection, failing the statement on error
+static void RunMergeStatement(Connection &conn, const string &sql) {
+	auto result = conn.Query(sql);
+	if (result->HasError()) {
+		throw IOException(result->GetError());
+	}
+}
+
+// Shared between the scan thread and the writer thread
+struct CrawlingMergeWriteState {
+	vector<string> col_names;
+	vector<LogicalType> col_types;
+	bool target_checked = false;
+
+	std::atomic<int64_t> rows_inserted {0};
+	std::atomic<int64_t> rows_updated {0};
+	std::atomic<int64_t> rows_deleted {0};
+	std::atomic<int64_t> total_processed {0};
+	std::atomic<bool> limit_reached {false};
+};
+
+// Create the target table from the source schema if it does not exist yet
+static void EnsureMergeTarget(Connection &conn, const CrawlingMergeBindData &bind_data,
+                              CrawlingMergeWriteState &write_state) {
+	if (write_state.target_checked) {
+		return;
+	}
+	write_state.target_checked = true;
+
+	auto check_result = conn.Query("SELECT 1 FROM information_schema.tables WHERE table_name = $1",
+	                               bind_data.target_table);
+	auto check_chunk = check_result->Fetch();
+	if (check_chunk && check_chunk->size() > 0) {
+		return;
+	}
+	string create_sql = "CREATE TABLE " + QuoteSqlIdentifier(bind_data.target_table) + " (";
+	for (idx_t i = 0; i < write_state.col_names.size(); i++) {
+		if (i > 0) create_sql += ", ";
+		create_sql += QuoteSqlIdentifier(write_state.col_names[i]) + " " + write_state.col_types[i].ToString();
+	}
+	create_sql += ")";
+	RunMergeStatement(conn, create_sql);
+}
+
+// Apply WHEN MATCHED / WHEN NOT MATCHED to one source chunk (runs on the writer thread)
+static idx_t MergeSourceChunk(Connection &conn, const CrawlingMergeBindData &bind_data,
+                              CrawlingMergeWriteState &write_state, CrawlingMergeGlobalState &state,
+                              unique_ptr<DataChunk> &chunk) {
+	EnsureMergeTarget(conn, bind_data, write_state);
+	auto &col_names = write_state.col_names;
+
+	idx_t written = 0;
+	for (idx_t row = 0; row < chunk->size(); row++) {
+		if (bind_data.row_limit > 0 && write_state.total_processed.load() >= bind_data.row_limit) {
+			write_state.limit_reached = true;
+			break;
+		}
+
+		bool exists = CheckExists(conn, bind_data, col_names, chunk, row);
+
+		if (exists && bind_data.has_matched) {
+			// Row exists, check matched condition
+			if (CheckMatchedCondition(conn, bind_data, col_names, chunk, row)) {
+				if (bind_data.matched_action == MergeAction::DELETE) {
+					RunMergeStatement(conn, BuildDelete(bind_data, col_names, chunk, row));
+					write_state.rows_deleted++;
+				} else {
+					// UPDATE BY NAME
+					RunMergeStatement(conn,
+					                  BuildUpdateByName(bind_data, col_names, write_state.col_types, chunk, row));
+					write_state.rows_updated++;
+				}
+				write_state.total_processed++;
+				written++;
+			}
+		} else if (!exists && bind_data.has_not_matched) {
+			RunMergeStatement(conn, BuildInsertByName(bind_data, col_names, chunk, row));
+			write_state.rows_inserted++;
+			write_state.total_processed++;
+			written++;
+		}
+
+		state.progress->queued--;
+		state.progress->Complete();
+	}
+	return written;
+}
+
+// WHEN NOT MATCHED BY SOURCE - rows in target whose join key never appeared in the source
+static void MergeNotMatchedBySource(Connection &conn, const CrawlingMergeBindData &bind_data,
+                                    const unordered_set<string> &source_join_keys,
+                                    CrawlingMergeWriteState &write_state) {
+	string target_keys_sql = "SELECT ";
+	for (size_t i = 0; i < bind_data.join_columns.size(); i++) {
+		if (i > 0) target_keys_sql += ", ";
+		target_keys_sql += QuoteSqlIdentifier(bind_data.join_columns[i]);
+	}
+	target_keys_sql += " FROM " + QuoteSqlIdentifier(bind_data.target_table);
+
+	// Add optional condition
+	if (!bind_data.not_matched_by_source_condition.empty()) {
+		target_keys_sql += " WHERE " + bind_data.not_matched_by_source_condition;
+	}
+
+	auto target_result = conn.Query(target_keys_sql);
+	if (target_result->HasError()) {
+		// Target was never created (empty source)
+		return;
+	}
+
+	// Collect the statements first, the result must be consumed before running more queries
+	vector<string> statements;
+	bool is_delete = bind_data.not_matched_by_source_action == MergeAction::DELETE;
+	while (auto target_chunk = target_result->Fetch()) {
+		for (idx_t row = 0; row < target_chunk->size(); row++) {
+			// Build join key from target row
+			string key;
+			for (idx_t col = 0; col < target_chunk->ColumnCount(); col++) {
+				if (col > 0) key += "\x1F";
+				auto val = target_chunk->GetValue(col, row);
+				if (!val.IsNull()) {
+					key += val.ToString();
+				}
+			}
+			if (source_join_keys.find(key) != source_join_keys.end()) {
+				continue;
+			}
+
+			string where_clause;
+			for (idx_t col = 0; col < bind_data.join_columns.size(); col++) {
+				if (col > 0) where_clause += " AND ";
+				auto val = target_chunk->GetValue(col, row);
+				where_clause += QuoteSqlIdentifier(bind_data.join_columns[col]) + " = ";
+				where_clause += val.IsNull() ? "NULL" : val.ToSQLString();
+			}
+
+			if (is_delete) {
+				statements.push_back("DELETE FROM " + QuoteSqlIdentifier(bind_data.target_table) + " WHERE " +
+				                     where_clause);
+			} else if (!bind_data.not_matched_by_source_set_clauses.empty()) {
+				// UPDATE with explicit SET clauses
+				string sql = "UPDATE " + QuoteSqlIdentifier(bind_data.target_table) + " SET ";
+				bool first = true;
+				for (const auto &clause : bind_data.not_matched_by_source_set_clauses) {
+					if (!first) sql += ", ";
+					first = false;
+					sql += QuoteSqlIdentifier(clause.first) + " = " + clause.second;
+				}
+				sql += " WHERE " + where_clause;
+				statements.push_back(sql);
+			}
+		}
+	}
+	target_result.reset();
+
+	if (statements.empty()) {
+		return;
+	}
+	conn.BeginTransaction();
+	try {
+		for (auto &sql : statements) {
+			RunMergeStatement(conn, sql);
+			if (is_delete) {
+				write_state.rows_deleted++;
+			} else {
+				write_state.rows_updated++;
+			}
+		}
+		conn.Commit();
+	} catch (...) {
+		conn.Rollback();
+		throw;
+	}
+}
+
 //===--------------------------------------------------------------------===//
 // Main Function - Merge Execution
 //===--------------------------------------------------------------------===//
+// The source query is streamed on this thread (it drives the crawl) while a
+// write-behind writer applies the merge on its own connection in batches of
+// batch_size rows per transaction. The queue between them is bounded, so a
+// slow target throttles fetching instead of buffering the whole crawl.
 
 static void CrawlingMergeFunction(ClientContext &context, TableFunctionInput &data, DataChunk &output) {
 	auto &bind_data = data.bind_data->CastNoConst<CrawlingMergeBindData>();
@@ -516,12 +711,12 @@ static void CrawlingMergeFunction(ClientContext &context, TableFunctionInput &da
 		}
 	}
 
-	// Execute source query (possibly rewritten with exclusion CTE)
-	auto query_result = conn.Query(effective_query);
+	// Stream source query (possibly rewritten with exclusion CTE)
+	auto query_result = conn.SendQuery(effective_query);
 	if (query_result->HasError()) {
 		// If rewritten query fails, fall back to original query
 		if (effective_query != bind_data.source_query) {
-			query_result = conn.Query(bind_data.source_query);
+			query_result = conn.SendQuery(bind_data.source_query);
 			if (query_result->HasError()) {
 				throw IOException("STREAM INTO source query error: " + query_result->GetError());
 			}
@@ -530,215 +725,69 @@ static void CrawlingMergeFunction(ClientContext &context, TableFunctionInput &da
 		}
 	}
 
-	// Get column names and types from result
-	vector<string> col_names = query_result->names;
-	vector<LogicalType> col_types = query_result->types;
+	CrawlingMergeWriteState write_state;
+	write_state.col_names = query_result->names;
+	write_state.col_types = query_result->types;
+	// The crawl feeding the source runs on conn: its estimated total is our row estimate
+	state.progress->SetSource(FindCrawlProgress(context, conn.context->GetConnectionId()));
 
-	// Collect all chunks first to know total (enables progress bar)
-	vector<unique_ptr<DataChunk>> all_chunks;
-	int64_t total_rows = 0;
-	while (auto chunk = query_result->Fetch()) {
-		if (chunk->size() > 0) {
-			total_rows += chunk->size();
-			all_chunks.push_back(std::move(chunk));
-		}
-	}
+	idx_t rows_per_transaction = bind_data.batch_size > 0 ? static_cast<idx_t>(bind_data.batch_size) : 100;
+	WriteBehindWriter<unique_ptr<DataChunk>> writer(
+	    *context.db, "STREAM INTO", MERGE_WRITER_MAX_PENDING_CHUNKS, rows_per_transaction,
+	    [&](Connection &writer_conn, unique_ptr<DataChunk> &chunk) {
+		    return MergeSourceChunk(writer_conn, bind_data, write_state, state, chunk);
+	    });
 
-	// Update progress state with total
-	state.total_rows.store(total_rows);
-	state.processed_rows.store(0);
-
-	// Get first chunk for table creation
-	unique_ptr<DataChunk> first_chunk;
-	if (!all_chunks.empty()) {
-		first_chunk = std::move(all_chunks[0]);
-		all_chunks.erase(all_chunks.begin());
-	}
-
-	if (first_chunk && first_chunk->size() > 0) {
-		// Check if table exists
-		auto check_result = conn.Query("SELECT 1 FROM information_schema.tables WHERE table_name = $1",
-		                               bind_data.target_table);
-		auto check_chunk = check_result->Fetch();
-		if (!check_chunk || check_chunk->size() == 0) {
-			// Create table with columns from query result
-			string create_sql = "CREATE TABLE " + QuoteSqlIdentifier(bind_data.target_table) + " (";
-			for (idx_t i = 0; i < col_names.size(); i++) {
-				if (i > 0) create_sql += ", ";
-				create_sql += QuoteSqlIdentifier(col_names[i]) + " " + col_types[i].ToString();
+	// Track join keys from source for NOT MATCHED BY SOURCE handling
+	unordered_set<string> source_join_keys;
+	bool track_source_keys = bind_data.has_not_matched_by_source && !bind_data.join_columns.empty();
+	vector<idx_t> join_key_cols;
+	for (const auto &jc : bind_data.join_columns) {
+		for (idx_t col = 0; col < write_state.col_names.size(); col++) {
+			if (StringUtil::Lower(write_state.col_names[col]) == StringUtil::Lower(jc)) {
+				join_key_cols.push_back(col);
+				break;
 			}
-			create_sql += ")";
-			conn.Query(create_sql);
 		}
 	}
 
-	int64_t rows_inserted = 0;
-	int64_t rows_updated = 0;
-	int64_t rows_deleted = 0;
-	int64_t total_processed = 0;
-
-	// Track join keys from source for NOT MATCHED BY SOURCE handling
-	unordered_set<string> source_join_keys;
-
-	// Helper to extract join key from source row
-	auto get_join_key = [&](unique_ptr<DataChunk> &chunk, idx_t row) -> string {
-		string key;
-		for (const auto &jc : bind_data.join_columns) {
-			// Find column index by name
-			for (idx_t col = 0; col < col_names.size(); col++) {
-				if (StringUtil::Lower(col_names[col]) == StringUtil::Lower(jc)) {
+	while (!write_state.limit_reached.load()) {
+		auto chunk = query_result->Fetch();
+		if (!chunk || chunk->size() == 0) {
+			break;
+		}
+		if (track_source_keys) {
+			for (idx_t row = 0; row < chunk->size(); row++) {
+				string key;
+				for (auto col : join_key_cols) {
 					if (!key.empty()) key += "\x1F";  // Unit separator
 					auto val = chunk->GetValue(col, row);
 					if (!val.IsNull()) {
 						key += val.ToString();
 					}
-					break;
 				}
+				source_join_keys.insert(key);
 			}
 		}
-		return key;
-	};
-
-	auto process_row = [&](unique_ptr<DataChunk> &chunk, idx_t row) -> bool {
-		// Check limit
-		if (bind_data.row_limit > 0 && total_processed >= bind_data.row_limit) {
-			return false;  // Stop processing
-		}
-
-		// Track join key for NOT MATCHED BY SOURCE
-		if (bind_data.has_not_matched_by_source && !bind_data.join_columns.empty()) {
-			source_join_keys.insert(get_join_key(chunk, row));
-		}
-
-		// Check if row exists in target
-		bool exists = CheckExists(conn, bind_data, col_names, chunk, row);
-
-		if (exists && bind_data.has_matched) {
-			// Row exists, check matched condition
-			if (CheckMatchedCondition(conn, bind_data, col_names, chunk, row)) {
-				if (bind_data.matched_action == MergeAction::DELETE) {
-					string sql = BuildDelete(bind_data, col_names, chunk, row);
-					auto result = conn.Query(sql);
-					if (!result->HasError()) {
-						rows_deleted++;
-						total_processed++;
-					}
-				} else {
-					// UPDATE BY NAME
-					string sql = BuildUpdateByName(bind_data, col_names, col_types, chunk, row);
-					auto result = conn.Query(sql);
-					if (!result->HasError()) {
-						rows_updated++;
-						total_processed++;
-					}
-				}
-			}
-		} else if (!exists && bind_data.has_not_matched) {
-			// Row doesn't exist, insert
-			string sql = BuildInsertByName(bind_data, col_names, chunk, row);
-			auto result = conn.Query(sql);
-			if (!result->HasError()) {
-				rows_inserted++;
-				total_processed++;
-			}
-		}
-
-		// Update progress bar
-		state.processed_rows.fetch_add(1);
-
-		return true;  // Continue processing
-	};
-
-	// Process first chunk
-	bool continue_processing = true;
-	if (first_chunk && first_chunk->size() > 0) {
-		for (idx_t row = 0; row < first_chunk->size() && continue_processing; row++) {
-			continue_processing = process_row(first_chunk, row);
-		}
+		state.progress->queued += NumericCast<int64_t>(chunk->size());
+		writer.Push(std::move(chunk));
 	}
+	query_result.reset();
 
-	// Process remaining chunks (already collected)
-	for (auto &chunk : all_chunks) {
-		if (!continue_processing) break;
-		for (idx_t row = 0; row < chunk->size() && continue_processing; row++) {
-			continue_processing = process_row(chunk, row);
-		}
-	}
+	// Source exhausted: total is known from here on
+	state.progress->discovering = false;
+	writer.Finish();
+	// Rows left unmerged by row_limit
+	state.progress->queued = 0;
 
 	// Handle WHEN NOT MATCHED BY SOURCE - rows in target but not in source
-	if (bind_data.has_not_matched_by_source && !bind_data.join_columns.empty()) {
-		// Query all join keys from target
-		string target_keys_sql = "SELECT ";
-		for (size_t i = 0; i < bind_data.join_columns.size(); i++) {
-			if (i > 0) target_keys_sql += ", ";
-			target_keys_sql += QuoteSqlIdentifier(bind_data.join_columns[i]);
-		}
-		target_keys_sql += " FROM " + QuoteSqlIdentifier(bind_data.target_table);
-
-		// Add optional condition
-		if (!bind_data.not_matched_by_source_condition.empty()) {
-			target_keys_sql += " WHERE " + bind_data.not_matched_by_source_condition;
-		}
-
-		auto target_result = conn.Query(target_keys_sql);
-		if (!target_result->HasError()) {
-			while (auto target_chunk = target_result->Fetch()) {
-				for (idx_t row = 0; row < target_chunk->size(); row++) {
-					// Build join key from target row
-					string key;
-					for (idx_t col = 0; col < target_chunk->ColumnCount(); col++) {
-						if (col > 0) key += "\x1F";
-						auto val = target_chunk->GetValue(col, row);
-						if (!val.IsNull()) {
-							key += val.ToString();
-						}
-					}
-
-					// Check if this key was NOT in source
-					if (source_join_keys.find(key) == source_join_keys.end()) {
-						// Build WHERE clause for this target row
-						string where_clause;
-						for (idx_t col = 0; col < bind_data.join_columns.size(); col++) {
-							if (col > 0) where_clause += " AND ";
-							auto val = target_chunk->GetValue(col, row);
-							where_clause += QuoteSqlIdentifier(bind_data.join_columns[col]) + " = ";
-							where_clause += val.IsNull() ? "NULL" : val.ToSQLString();
-						}
-
-						if (bind_data.not_matched_by_source_action == MergeAction::DELETE) {
-							// DELETE unmatched rows
-							string sql = "DELETE FROM " + QuoteSqlIdentifier(bind_data.target_table) +
-							             " WHERE " + where_clause;
-							auto result = conn.Query(sql);
-							if (!result->HasError()) {
-								rows_deleted++;
-							}
-						} else {
-							// UPDATE with explicit SET clauses
-							if (!bind_data.not_matched_by_source_set_clauses.empty()) {
-								string sql = "UPDATE " + QuoteSqlIdentifier(bind_data.target_table) + " SET ";
-								bool first = true;
-								for (const auto &clause : bind_data.not_matched_by_source_set_clauses) {
-									if (!first) sql += ", ";
-									first = false;
-									sql += QuoteSqlIdentifier(clause.first) + " = " + clause.second;
-								}
-								sql += " WHERE " + where_clause;
-								auto result = conn.Query(sql);
-								if (!result->HasError()) {
-									rows_updated++;
-								}
-							}
-						}
-					}
-				}
-			}
-		}
+	if (track_source_keys) {
+		MergeNotMatchedBySource(conn, bind_data, source_join_keys, write_state);
 	}
 
-	state.rows_inserted = rows_inserted;
-	state.rows_updated = rows_updated;
-	state.rows_deleted = rows_deleted;
+	state.rows_inserted = write_state.rows_inserted.load();
+	state.rows_updated = write_state.rows_updated.load();
+	state.rows_deleted = write_state.rows_deleted.load();
 	state.finished = true;
 
 	// Clean up pipeline state
@@ -747,9 +796,9 @@ static void CrawlingMergeFunction(ClientContext &context, TableFunctionInput &da
 	}
 
 	// Return counts
-	output.SetValue(0, 0, Value::BIGINT(rows_inserted));
-	output.SetValue(1, 0, Value::BIGINT(rows_updated));
-	output.SetValue(2, 0, Value::BIGINT(rows_deleted));
+	output.SetValue(0, 0, Value::BIGINT(state.rows_inserted));
+	output.SetValue(1, 0, Value::BIGINT(state.rows_updated));
+	output.SetValue(2, 0, Value::BIGINT(state.rows_deleted));
 	output.SetCardinality(1);
 }
 
@@ -762,17 +811,7 @@ static double CrawlingMergeProgress(ClientContext &context, const FunctionData *
 	if (!gstate_p) {
 		return -1.0;  // Unknown progress
 	}
-
-	auto &gstate = gstate_p->Cast<CrawlingMergeGlobalState>();
-
-	int64_t total = gstate.total_rows.load();
-	int64_t processed = gstate.processed_rows.load();
-
-	if (total <= 0) {
-		return -1.0;  // Still collecting rows
-	}
-
-	return (static_cast<double>(processed) / static_cast<double>(total)) * 100.0;
+	return CrawlProgressPercentage(gstate_p->Cast<CrawlingMergeGlobalState>().progress);
 }
 
 //===--------------------------------------------------------------------===//
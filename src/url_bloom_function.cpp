@@ -0,0 +1,394 @@
+// url_bloom_agg(url [, fpr [, capacity]]) / url_bloom_contains(filter, url) - compact URL set filters
+//
+//   CREATE TABLE seen_filter AS SELECT url_bloom_agg(url, 0.001, 200000000) AS f FROM crawled_urls;
+//   SELECT url FROM candidates, seen_filter WHERE NOT url_bloom_contains(f, url);
+//   SELECT * FROM crawl('SELECT url FROM candidates', skip_bloom := (SELECT f FROM seen_filter));
+//
+// A filter costs about 1.44 * log2(1 / fpr) bits per URL of its capacity (~1.2
+// bytes at 1%), instead of the full URL strings an anti-join keeps in its hash
+// table. url_bloom_contains() never misses a URL that was added and wrongly
+// reports about fpr of the others while no more than capacity distinct URLs
+// were added.
+//
+// The aggregate state is the filter itself, sized at bind for capacity URLs:
+// each URL sets its bits directly and partial states combine by bitwise OR.
+
+#include "url_bloom_function.hpp"
+#include "crawler_utils.hpp"
+
+#include "duckdb/common/vector_operations/binary_executor.hpp"
+#include "duckdb/common/vector_operations/unary_executor.hpp"
+#include "duckdb/execution/expression_executor.hpp"
+#include "duckdb/function/aggregate_function.hpp"
+#include "duckdb/function/scalar_function.hpp"
+#include "duckdb/main/extension/extension_loader.hpp"
+
+#include <cmath>
+#include <cstring>
+
+namespace duckdb {
+
+static constexpr char URL_BLOOM_MAGIC[4] = {'U', 'B', 'F', 'L'};
+static constexpr uint32_t URL_BLOOM_FORMAT_VERSION = 1;
+static constexpr idx_t URL_BLOOM_HEADER_SIZE = 4 + 3 * sizeof(uint32_t) + 2 * sizeof(uint64_t);
+static constexpr double URL_BLOOM_DEFAULT_FPR = 0.01;
+static constexpr int64_t URL_BLOOM_DEFAULT_CAPACITY = 1000000;
+static constexpr uint32_t URL_BLOOM_MAX_HASHES = 32;
+// Filters stay well below the BLOB size limit
+static constexpr uint64_t URL_BLOOM_MAX_BITS = uint64_t(1) << 33;
+static constexpr uint64_t URL_BLOOM_SEED = 0x55424631a5c3e96dULL;
+
+//===--------------------------------------------------------------------===//
+// Filter layout
+//===--------------------------------------------------------------------===//
+
+// MurmurHash64A: fixed across DuckDB versions and platforms, so stored filters stay valid
+static uint64_t UrlBloomMurmurHash(const char *data, idx_t size, uint64_t seed) {
+	const uint64_t m = 0xc6a4a7935bd1e995ULL;
+	const int r = 47;
+	uint64_t h = seed ^ (size * m);
+	idx_t blocks = size / 8;
+	for (idx_t i = 0; i < blocks; i++) {
+		uint64_t k;
+		memcpy(&k, data + i * 8, sizeof(uint64_t));
+		k *= m;
+		k ^= k >> r;
+		k *= m;
+		h ^= k;
+		h *= m;
+	}
+	auto tail = reinterpret_cast<const unsigned char *>(data + blocks * 8);
+	idx_t tail_size = size & 7;
+	if (tail_size > 0) {
+		for (idx_t i = tail_size; i > 0; i--) {
+			h ^= uint64_t(tail[i - 1]) << (8 * (i - 1));
+		}
+		h *= m;
+	}
+	h ^= h >> r;
+	h *= m;
+	h ^= h >> r;
+	return h;
+}
+
+hash_t UrlBloomHash(const string &url) {
+	auto normalized = NormalizeUrl(url);
+	return UrlBloomMurmurHash(normalized.data(), normalized.size(), URL_BLOOM_SEED);
+}
+
+// Double hashing (Kirsch-Mitzenmacher): bit i of a URL is (h1 + i * h2) mod bit_count,
+// h2 the murmur3 finalizer of h1 (odd, so it never stays on one bit)
+static inline uint64_t SecondBloomHash(hash_t hash) {
+	uint64_t k = hash;
+	k ^= k >> 33;
+	k *= 0xff51afd7ed558ccdULL;
+	k ^= k >> 33;
+	k *= 0xc4ceb9fe1a85ec53ULL;
+	k ^= k >> 33;
+	return k | 1;
+}
+
+struct UrlBloomHeader {
+	uint32_t version;
+	uint32_t hash_count;
+	uint64_t bit_count;
+	uint64_t url_count;
+};
+
+static bool HasUrlBloomMagic(const char *data, idx_t size) {
+	return size >= URL_BLOOM_HEADER_SIZE && memcmp(data, URL_BLOOM_MAGIC, sizeof(URL_BLOOM_MAGIC)) == 0;
+}
+
+static bool TryReadUrlBloomHeader(const char *data, idx_t size, UrlBloomHeader &header) {
+	if (!HasUrlBloomMagic(data, size)) {
+		return false;
+	}
+	memcpy(&header.version, data + 4, sizeof(uint32_t));
+	memcpy(&header.hash_count, data + 8, sizeof(uint32_t));
+	memcpy(&header.bit_count, data + 16, sizeof(uint64_t));
+	memcpy(&header.url_count, data + 24, sizeof(uint64_t));
+	return header.version == URL_BLOOM_FORMAT_VERSION && header.hash_count > 0 &&
+	       header.hash_count <= URL_BLOOM_MAX_HASHES && header.bit_count > 0 && header.bit_count % 64 == 0 &&
+	       header.bit_count <= URL_BLOOM_MAX_BITS && size == URL_BLOOM_HEADER_SIZE + header.bit_count / 8;
+}
+
+bool UrlBloomFilter::IsFilter(const char *data, idx_t size) {
+	UrlBloomHeader header;
+	return TryReadUrlBloomHeader(data, size, header);
+}
+
+UrlBloomFilter::UrlBloomFilter(const char *data, idx_t size) {
+	UrlBloomHeader header;
+	if (!TryReadUrlBloomHeader(data, size, header)) {
+		if (HasUrlBloomMagic(data, size) && header.version != URL_BLOOM_FORMAT_VERSION) {
+			throw InvalidInputException("url_bloom_contains: filter format version %u is not supported (expected "
+			                            "%u), build it again with url_bloom_agg()",
+			                            header.version, URL_BLOOM_FORMAT_VERSION);
+		}
+		throw InvalidInputException("url_bloom_contains: not a url_bloom_agg() filter");
+	}
+	words = data + URL_BLOOM_HEADER_SIZE;
+	bit_count = header.bit_count;
+	hash_count = header.hash_count;
+	url_count = header.url_count;
+}
+
+bool UrlBloomFilter::ContainsHash(hash_t hash) const {
+	uint64_t step = SecondBloomHash(hash);
+	uint64_t position = hash;
+	for (uint32_t i = 0; i < hash_count; i++) {
+		uint64_t bit = position % bit_count;
+		uint64_t word;
+		// The BLOB payload is not necessarily 8-byte aligned
+		memcpy(&word, words + (bit / 64) * sizeof(uint64_t), sizeof(uint64_t));
+		if (!(word & (uint64_t(1) << (bit % 64)))) {
+			return false;
+		}
+		position += step;
+	}
+	return true;
+}
+
+bool UrlBloomFilter::Contains(const string &url) const {
+	return ContainsHash(UrlBloomHash(url));
+}
+
+// Distinct URLs behind the set bits (Swamidass-Baldi): n = -(m / k) ln(1 - X / m)
+static uint64_t EstimateUrlCount(const uint64_t *words, uint64_t bit_count, uint32_t hash_count) {
+	uint64_t set_bits = 0;
+	for (uint64_t i = 0; i < bit_count / 64; i++) {
+		uint64_t word = words[i];
+		while (word) {
+			word &= word - 1;
+			set_bits++;
+		}
+	}
+	if (set_bits == bit_count) {
+		return bit_count;
+	}
+	double m = static_cast<double>(bit_count);
+	return static_cast<uint64_t>(
+	    std::llround(-m / hash_count * std::log(1.0 - static_cast<double>(set_bits) / m)));
+}
+
+//===--------------------------------------------------------------------===//
+// url_bloom_agg(url [, fpr [, capacity]])
+//===--------------------------------------------------------------------===//
+
+struct UrlBloomBindData : public FunctionData {
+	double fpr = URL_BLOOM_DEFAULT_FPR;
+	int64_t capacity = URL_BLOOM_DEFAULT_CAPACITY;
+	// Optimal size for capacity URLs at fpr: bits = -n ln(p) / ln(2)^2, hashes = bits / n * ln(2)
+	uint64_t bit_count = 0;
+	uint32_t hash_count = 0;
+
+	void SizeFilter() {
+		double n = static_cast<double>(capacity);
+		double ln2 = std::log(2.0);
+		double optimal_bits = std::ceil(-n * std::log(fpr) / (ln2 * ln2));
+		if (optimal_bits > static_cast<double>(URL_BLOOM_MAX_BITS)) {
+			throw BinderException("url_bloom_agg: a filter for %d URLs at fpr %g exceeds %d bytes", capacity,
+			                      fpr, URL_BLOOM_MAX_BITS / 8);
+		}
+		bit_count = MaxValue<uint64_t>(64, (static_cast<uint64_t>(optimal_bits) + 63) / 64 * 64);
+		hash_count = static_cast<uint32_t>(
+		    MinValue<double>(URL_BLOOM_MAX_HASHES, MaxValue<double>(1, std::round(bit_count / n * ln2))));
+	}
+
+	idx_t WordCount() const {
+		return bit_count / 64;
+	}
+
+	unique_ptr<FunctionData> Copy() const override {
+		auto copy = make_uniq<UrlBloomBindData>();
+		copy->fpr = fpr;
+		copy->capacity = capacity;
+		copy->bit_count = bit_count;
+		copy->hash_count = hash_count;
+		return std::move(copy);
+	}
+
+	bool Equals(const FunctionData &other_p) const override {
+		auto &other = other_p.Cast<UrlBloomBindData>();
+		return fpr == other.fpr && capacity == other.capacity;
+	}
+};
+
+struct UrlBloomState {
+	// Filter words, allocated with the first URL (bit_count / 64 of the bind data)
+	uint64_t *words;
+};
+
+struct UrlBloomOperation {
+	template <class STATE>
+	static void Initialize(STATE &state) {
+		state.words = nullptr;
+	}
+
+	template <class STATE>
+	static void AddHash(STATE &state, hash_t hash, const UrlBloomBindData &bind_data) {
+		if (!state.words) {
+			state.words = new uint64_t[bind_data.WordCount()]();
+		}
+		uint64_t step = SecondBloomHash(hash);
+		uint64_t position = hash;
+		for (uint32_t i = 0; i < bind_data.hash_count; i++) {
+			uint64_t bit = position % bind_data.bit_count;
+			state.words[bit / 64] |= uint64_t(1) << (bit % 64);
+			position += step;
+		}
+	}
+
+	template <class INPUT_TYPE, class STATE, class OP>
+	static void Operation(STATE &state, const INPUT_TYPE &input, AggregateUnaryInput &unary_input) {
+		auto &bind_data = unary_input.input.bind_data->template Cast<UrlBloomBindData>();
+		AddHash(state, UrlBloomHash(input.GetString()), bind_data);
+	}
+
+	template <class INPUT_TYPE, class STATE, class OP>
+	static void ConstantOperation(STATE &state, const INPUT_TYPE &input, AggregateUnaryInput &unary_input,
+	                              idx_t count) {
+		// The same URL count times is one member
+		Operation<INPUT_TYPE, STATE, OP>(state, input, unary_input);
+	}
+
+	template <class STATE, class OP>
+	static void Combine(const STATE &source, STATE &target, AggregateInputData &input_data) {
+		if (!source.words) {
+			return;
+		}
+		auto word_count = input_data.bind_data->template Cast<UrlBloomBindData>().WordCount();
+		if (!target.words) {
+			target.words = new uint64_t[word_count];
+			memcpy(target.words, source.words, word_count * sizeof(uint64_t));
+			return;
+		}
+		for (idx_t i = 0; i < word_count; i++) {
+			target.words[i] |= source.words[i];
+		}
+	}
+
+	// No rows: an empty filter (contains nothing), so anti-joins against it keep every URL
+	template <class T, class STATE>
+	static void Finalize(STATE &state, T &target, AggregateFinalizeData &finalize_data) {
+		auto &bind_data = finalize_data.input.bind_data->template Cast<UrlBloomBindData>();
+		auto words_size = bind_data.WordCount() * sizeof(uint64_t);
+		uint32_t version = URL_BLOOM_FORMAT_VERSION;
+		uint32_t reserved = 0;
+		uint64_t url_count = state.words ? EstimateUrlCount(state.words, bind_data.bit_count, bind_data.hash_count) : 0;
+
+		target = StringVector::EmptyString(finalize_data.result, URL_BLOOM_HEADER_SIZE + words_size);
+		auto filter = target.GetDataWriteable();
+		memcpy(filter, URL_BLOOM_MAGIC, sizeof(URL_BLOOM_MAGIC));
+		memcpy(filter + 4, &version, sizeof(uint32_t));
+		memcpy(filter + 8, &bind_data.hash_count, sizeof(uint32_t));
+		memcpy(filter + 12, &reserved, sizeof(uint32_t));
+		memcpy(filter + 16, &bind_data.bit_count, sizeof(uint64_t));
+		memcpy(filter + 24, &url_count, sizeof(uint64_t));
+		if (state.words) {
+			memcpy(filter + URL_BLOOM_HEADER_SIZE, state.words, words_size);
+		} else {
+			memset(filter + URL_BLOOM_HEADER_SIZE, 0, words_size);
+		}
+		target.Finalize();
+	}
+
+	template <class STATE>
+	static void Destroy(STATE &state, AggregateInputData &) {
+		delete[] state.words;
+		state.words = nullptr;
+	}
+
+	static bool IgnoreNull() {
+		return true;
+	}
+};
+
+static Value EvaluateUrlBloomConstant(ClientContext &context, Expression &arg, const string &name) {
+	if (arg.HasParameter() || !arg.IsFoldable()) {
+		throw BinderException("url_bloom_agg: %s must be a constant", name);
+	}
+	auto value = ExpressionExecutor::EvaluateScalar(context, arg);
+	if (value.IsNull()) {
+		throw BinderException("url_bloom_agg: %s must not be NULL", name);
+	}
+	return value;
+}
+
+static unique_ptr<FunctionData> UrlBloomAggBind(ClientContext &context, AggregateFunction &function,
+                                                vector<unique_ptr<Expression>> &arguments) {
+	auto bind_data = make_uniq<UrlBloomBindData>();
+	if (arguments.size() >= 2) {
+		bind_data->fpr = EvaluateUrlBloomConstant(context, *arguments[1], "fpr").GetValue<double>();
+		if (!(bind_data->fpr > 0 && bind_data->fpr < 1)) {
+			throw BinderException("url_bloom_agg: fpr must be in (0, 1)");
+		}
+	}
+	if (arguments.size() >= 3) {
+		bind_data->capacity = EvaluateUrlBloomConstant(context, *arguments[2], "capacity").GetValue<int64_t>();
+		if (bind_data->capacity <= 0) {
+			throw BinderException("url_bloom_agg: capacity must be positive");
+		}
+	}
+	bind_data->SizeFilter();
+	// Rate and capacity only size the filter
+	while (arguments.size() > 1) {
+		Function::EraseArgument(function, arguments, arguments.size() - 1);
+	}
+	return std::move(bind_data);
+}
+
+static AggregateFunction GetUrlBloomAggFunction() {
+	auto function = AggregateFunction::UnaryAggregateDestructor<UrlBloomState, string_t, string_t, UrlBloomOperation>(
+	    LogicalType::VARCHAR, LogicalType::BLOB);
+	function.name = "url_bloom_agg";
+	function.bind = UrlBloomAggBind;
+	return function;
+}
+
+//===--------------------------------------------------------------------===//
+// url_bloom_contains(filter, url)
+//===--------------------------------------------------------------------===//
+
+static void UrlBloomContainsFunction(DataChunk &args, ExpressionState &state, Vector &result) {
+	auto &filter_vector = args.data[0];
+	auto &url_vector = args.data[1];
+
+	// Usual case: one filter for the whole column, parsed once per chunk
+	if (filter_vector.GetVectorType() == VectorType::CONSTANT_VECTOR) {
+		if (ConstantVector::IsNull(filter_vector)) {
+			result.SetVectorType(VectorType::CONSTANT_VECTOR);
+			ConstantVector::SetNull(result, true);
+			return;
+		}
+		auto blob = ConstantVector::GetData<string_t>(filter_vector)[0];
+		UrlBloomFilter filter(blob.GetData(), blob.GetSize());
+		UnaryExecutor::Execute<string_t, bool>(url_vector, result, args.size(),
+		                                       [&](string_t url) { return filter.Contains(url.GetString()); });
+		return;
+	}
+
+	BinaryExecutor::Execute<string_t, string_t, bool>(filter_vector, url_vector, result, args.size(),
+	                                                  [&](string_t blob, string_t url) {
+		                                                  UrlBloomFilter filter(blob.GetData(), blob.GetSize());
+		                                                  return filter.Contains(url.GetString());
+	                                                  });
+}
+
+void RegisterUrlBloomFunctions(ExtensionLoader &loader) {
+	AggregateFunctionSet agg_set("url_bloom_agg");
+	agg_set.AddFunction(GetUrlBloomAggFunction());
+	auto with_fpr = GetUrlBloomAggFunction();
+	with_fpr.arguments.push_back(LogicalType::DOUBLE);
+	agg_set.AddFunction(with_fpr);
+	auto with_capacity = with_fpr;
+	with_capacity.arguments.push_back(LogicalType::BIGINT);
+	agg_set.AddFunction(with_capacity);
+	loader.RegisterFunction(agg_set);
+
+	ScalarFunction contains_func("url_bloom_contains", {LogicalType::BLOB, LogicalType::VARCHAR}, LogicalType::BOOLEAN,
+	                             UrlBloomContainsFunction);
+	loader.RegisterFunction(contains_func);
+}
+
+} // namespace duckdb
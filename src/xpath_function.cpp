@@ -0,0 +1,500 @@
+// xpath(html, expr) / xpath_all(html, expr) - XPath 1.0 extraction with libxml2
+//
+//   SELECT xpath(body, '//h1') AS title FROM pages;
+//   SELECT xpath(body, '//link[@rel="canonical"]/@href') FROM pages;
+//   SELECT xpath_all(body, '//a/@href') AS links FROM pages;
+//
+// xpath() returns the string value of the first matching node (or of a
+// number / string / boolean result), NULL when nothing matches. xpath_all()
+// returns the string values of all matching nodes as VARCHAR[].
+//
+// A constant expression is compiled once at bind and shared by all threads;
+// per-row expressions are compiled once per distinct string per thread.
+// Parsed documents are kept for the rest of the query, in a cache per worker
+// thread keyed by the HTML, so several xpath calls over the same column parse
+// each document once. The caches are dropped when the query ends.
+//
+//   SELECT * FROM crawler_xpath_stats();  -- documents parsed / reused
+
+#include "xpath_function.hpp"
+
+#include "duckdb/common/types/hash.hpp"
+#include "duckdb/execution/expression_executor.hpp"
+#include "duckdb/execution/expression_executor_state.hpp"
+#include "duckdb/function/scalar_function.hpp"
+#include "duckdb/function/table_function.hpp"
+#include "duckdb/main/client_context.hpp"
+#include "duckdb/main/client_context_state.hpp"
+#include "duckdb/main/extension/extension_loader.hpp"
+#include "duckdb/planner/expression/bound_function_expression.hpp"
+
+#include <libxml/HTMLparser.h>
+#include <libxml/parser.h>
+#include <libxml/tree.h>
+#include <libxml/xmlerror.h>
+#include <libxml/xpath.h>
+
+#include <atomic>
+#include <cstring>
+#include <list>
+#include <mutex>
+#include <thread>
+
+namespace duckdb {
+
+//===--------------------------------------------------------------------===//
+// Compiled expressions
+//===--------------------------------------------------------------------===//
+
+static void XPathSilentError(void *, xmlErrorPtr) {
+}
+
+// libxml2 reports syntax errors through the thread's error handler; the caller
+// gets an exception instead, so keep them off stderr
+class XPathErrorSilencer {
+public:
+	XPathErrorSilencer() : previous(xmlStructuredError), previous_context(xmlStructuredErrorContext) {
+		xmlSetStructuredErrorFunc(nullptr, reinterpret_cast<xmlStructuredErrorFunc>(XPathSilentError));
+	}
+	~XPathErrorSilencer() {
+		xmlSetStructuredErrorFunc(previous_context, previous);
+	}
+
+private:
+	xmlStructuredErrorFunc previous;
+	void *previous_context;
+};
+
+struct XPathCompiled {
+	explicit XPathCompiled(xmlXPathCompExprPtr comp) : comp(comp) {
+	}
+	~XPathCompiled() {
+		xmlXPathFreeCompExpr(comp);
+	}
+	// Read-only after compilation, safe to evaluate from several threads
+	xmlXPathCompExprPtr comp;
+};
+
+// nullptr if expr is not a valid XPath 1.0 expression
+static shared_ptr<XPathCompiled> CompileXPath(const string &expr) {
+	XPathErrorSilencer silencer;
+	auto comp = xmlXPathCompile(reinterpret_cast<const xmlChar *>(expr.c_str()));
+	if (!comp) {
+		return nullptr;
+	}
+	return make_shared_ptr<XPathCompiled>(comp);
+}
+
+struct XPathBindData : public FunctionData {
+	// Set when the expression argument is constant
+	bool constant = false;
+	string expr;
+	shared_ptr<XPathCompiled> compiled;
+
+	unique_ptr<FunctionData> Copy() const override {
+		auto copy = make_uniq<XPathBindData>();
+		copy->constant = constant;
+		copy->expr = expr;
+		copy->compiled = compiled;
+		return std::move(copy);
+	}
+	bool Equals(const FunctionData &other_p) const override {
+		auto &other = other_p.Cast<XPathBindData>();
+		return constant == other.constant && expr == other.expr && (compiled == nullptr) == (other.compiled == nullptr);
+	}
+};
+
+// Expressions compiled by this thread when the expression is not constant
+struct XPathLocalState : public FunctionLocalState {
+	static constexpr idx_t MAX_COMPILED = 1024;
+	unordered_map<string, shared_ptr<XPathCompiled>> compiled;
+
+	XPathCompiled &Compile(const string &function, string_t expr_str) {
+		auto expr = expr_str.GetString();
+		auto entry = compiled.find(expr);
+		if (entry != compiled.end()) {
+			return *entry->second;
+		}
+		auto comp = CompileXPath(expr);
+		if (!comp) {
+			throw InvalidInputException("%s: invalid XPath expression '%s'", function, expr);
+		}
+		if (compiled.size() >= MAX_COMPILED) {
+			compiled.clear();
+		}
+		auto &result = *comp;
+		compiled.emplace(std::move(expr), std::move(comp));
+		return result;
+	}
+};
+
+static unique_ptr<FunctionLocalState> XPathInitLocalState(ExpressionState &state, const BoundFunctionExpression &expr,
+                                                          FunctionData *bind_data) {
+	return make_uniq<XPathLocalState>();
+}
+
+//===--------------------------------------------------------------------===//
+// Document cache
+//===--------------------------------------------------------------------===//
+
+struct XPathDocument {
+	~XPathDocument() {
+		if (context) {
+			xmlXPathFreeContext(context);
+		}
+		if (doc) {
+			xmlFreeDoc(doc);
+		}
+	}
+	xmlDocPtr doc = nullptr;
+	xmlXPathContextPtr context = nullptr;
+};
+
+// Least recently used parsed documents of one thread, bounded by the size of
+// their source HTML times DOM_SIZE_FACTOR (libxml2 trees take several times the
+// bytes of their source). The expression executor evaluates each function over
+// a whole chunk before the next one, so the budget is at least the documents of
+// the current chunk: otherwise the second call over a chunk of large pages would
+// find the first ones evicted and parse every document again.
+class XPathDocumentCache {
+public:
+	static constexpr idx_t MIN_DOM_BYTES = 128ULL * 1024 * 1024;
+	static constexpr idx_t DOM_SIZE_FACTOR = 4;
+
+	// Size the budget for a chunk whose documents total html_bytes
+	void ReserveChunk(idx_t html_bytes) {
+		max_bytes = MaxValue<idx_t>(MIN_DOM_BYTES, EntryBytes(html_bytes));
+	}
+
+	// Parsed document for html, nullptr if libxml2 cannot parse it. Valid until
+	// the next call.
+	XPathDocument *Get(string_t html) {
+		auto size = html.GetSize();
+		auto key = Hash(html.GetData(), size);
+		auto entry = index.find(key);
+		if (entry != index.end() && entry->second->html.size() == size &&
+		    memcmp(entry->second->html.data(), html.GetData(), size) == 0) {
+			lru.splice(lru.begin(), lru, entry->second);
+			hits++;
+			return entry->second->document.get();
+		}
+		if (entry != index.end()) {
+			Evict(entry->second);
+		}
+
+		parses++;
+		auto document = make_uniq<XPathDocument>();
+		if (size > 0) {
+			document->doc = htmlReadMemory(html.GetData(), NumericCast<int>(size), nullptr, "UTF-8",
+			                               HTML_PARSE_RECOVER | HTML_PARSE_NOERROR | HTML_PARSE_NOWARNING |
+			                                   HTML_PARSE_NONET | HTML_PARSE_COMPACT);
+		}
+		if (document->doc) {
+			document->context = xmlXPathNewContext(document->doc);
+		}
+		if (!document->context) {
+			return nullptr;
+		}
+
+		auto entry_bytes = EntryBytes(size);
+		if (entry_bytes > max_bytes) {
+			// Parsed for this call only
+			uncached = std::move(document);
+			return uncached.get();
+		}
+		while (!lru.empty() && cached_bytes + entry_bytes > max_bytes) {
+			Evict(std::prev(lru.end()));
+		}
+		lru.push_front({key, html.GetString(), std::move(document)});
+		index[key] = lru.begin();
+		cached_bytes += entry_bytes;
+		return lru.front().document.get();
+	}
+
+	// Documents parsed and documents served from the cache
+	idx_t parses = 0;
+	idx_t hits = 0;
+
+private:
+	struct Entry {
+		hash_t key;
+		string html; // Compared on a hit: equal hashes are no proof of equal documents
+		unique_ptr<XPathDocument> document;
+	};
+
+	// Source copy plus estimated tree
+	static idx_t EntryBytes(idx_t html_size) {
+		return html_size * (1 + DOM_SIZE_FACTOR);
+	}
+
+	void Evict(std::list<Entry>::iterator entry) {
+		cached_bytes -= EntryBytes(entry->html.size());
+		index.erase(entry->key);
+		lru.erase(entry);
+	}
+
+	std::list<Entry> lru;
+	unordered_map<hash_t, std::list<Entry>::iterator> index;
+	idx_t cached_bytes = 0;
+	idx_t max_bytes = MIN_DOM_BYTES;
+	unique_ptr<XPathDocument> uncached;
+};
+
+// The document caches of a query, one per worker thread (a parsed document and its
+// XPath context are not shared between threads). Dropped when the query ends; their
+// counts are added to the totals of the connection.
+class XPathQueryDocuments : public ClientContextState {
+public:
+	XPathDocumentCache &ThreadCache() {
+		std::lock_guard<std::mutex> guard(lock);
+		auto &cache = caches[std::this_thread::get_id()];
+		if (!cache) {
+			cache = make_uniq<XPathDocumentCache>();
+		}
+		return *cache;
+	}
+
+	void QueryEnd(ClientContext &context) override {
+		std::lock_guard<std::mutex> guard(lock);
+		for (auto &cache : caches) {
+			parses += cache.second->parses;
+			hits += cache.second->hits;
+		}
+		caches.clear();
+	}
+
+	std::atomic<idx_t> parses {0};
+	std::atomic<idx_t> hits {0};
+
+private:
+	std::mutex lock;
+	unordered_map<std::thread::id, unique_ptr<XPathDocumentCache>> caches;
+};
+
+static constexpr const char *XPATH_DOCUMENTS_STATE = "crawler_xpath_documents";
+
+//===--------------------------------------------------------------------===//
+// Evaluation
+//===--------------------------------------------------------------------===//
+
+class XPathObjectGuard {
+public:
+	explicit XPathObjectGuard(xmlXPathObjectPtr obj) : obj(obj) {
+	}
+	~XPathObjectGuard() {
+		if (obj) {
+			xmlXPathFreeObject(obj);
+		}
+	}
+	xmlXPathObjectPtr get() const {
+		return obj;
+	}
+
+private:
+	xmlXPathObjectPtr obj;
+};
+
+static string TakeXmlString(xmlChar *str) {
+	if (!str) {
+		return string();
+	}
+	string result(reinterpret_cast<const char *>(str));
+	xmlFree(str);
+	return result;
+}
+
+// Evaluate comp against html; values receives the string value of every
+// result (one for number / string / boolean results). first_only stops after one.
+static void EvaluateXPath(XPathDocumentCache &documents, string_t html, XPathCompiled &compiled, bool first_only,
+                          vector<string> &values) {
+	values.clear();
+	auto document = documents.Get(html);
+	if (!document) {
+		return;
+	}
+	XPathErrorSilencer silencer;
+	XPathObjectGuard obj(xmlXPathCompiledEval(compiled.comp, document->context));
+	if (!obj.get()) {
+		return;
+	}
+	if (obj.get()->type == XPATH_NODESET) {
+		auto nodes = obj.get()->nodesetval;
+		if (!nodes) {
+			return;
+		}
+		for (int i = 0; i < nodes->nodeNr; i++) {
+			values.push_back(TakeXmlString(xmlXPathCastNodeToString(nodes->nodeTab[i])));
+			if (first_only) {
+				break;
+			}
+		}
+		return;
+	}
+	values.push_back(TakeXmlString(xmlXPathCastToString(obj.get())));
+}
+
+// Calls emit(row, values) for every row with non-NULL arguments, NULL rows are
+// marked invalid in result
+template <class EMIT>
+static void XPathExecute(DataChunk &args, ExpressionState &state, Vector &result, const string &function,
+                         bool first_only, EMIT &&emit) {
+	auto &func_expr = state.expr.Cast<BoundFunctionExpression>();
+	auto &bind_data = func_expr.bind_info->Cast<XPathBindData>();
+	auto &local_state = ExecuteFunctionState::GetFunctionState(state)->Cast<XPathLocalState>();
+
+	idx_t count = args.size();
+	result.SetVectorType(VectorType::FLAT_VECTOR);
+	UnifiedVectorFormat html_format;
+	args.data[0].ToUnifiedFormat(count, html_format);
+	auto html_data = UnifiedVectorFormat::GetData<string_t>(html_format);
+	UnifiedVectorFormat expr_format;
+	if (!bind_data.constant) {
+		args.data[1].ToUnifiedFormat(count, expr_format);
+	}
+
+	// Without a client context (constant folding) documents live for this call
+	unique_ptr<XPathDocumentCache> call_documents;
+	shared_ptr<XPathQueryDocuments> query_documents;
+	if (state.HasContext()) {
+		query_documents =
+		    state.GetContext().registered_state->GetOrCreate<XPathQueryDocuments>(XPATH_DOCUMENTS_STATE);
+	} else {
+		call_documents = make_uniq<XPathDocumentCache>();
+	}
+	auto &documents = query_documents ? query_documents->ThreadCache() : *call_documents;
+
+	idx_t chunk_bytes = 0;
+	for (idx_t i = 0; i < count; i++) {
+		auto html_idx = html_format.sel->get_index(i);
+		if (html_format.validity.RowIsValid(html_idx)) {
+			chunk_bytes += html_data[html_idx].GetSize();
+		}
+	}
+	documents.ReserveChunk(chunk_bytes);
+
+	vector<string> values;
+	for (idx_t i = 0; i < count; i++) {
+		auto html_idx = html_format.sel->get_index(i);
+		if (!html_format.validity.RowIsValid(html_idx)) {
+			FlatVector::SetNull(result, i, true);
+			continue;
+		}
+		XPathCompiled *compiled = bind_data.compiled.get();
+		if (!bind_data.constant) {
+			auto expr_idx = expr_format.sel->get_index(i);
+			if (!expr_format.validity.RowIsValid(expr_idx)) {
+				FlatVector::SetNull(result, i, true);
+				continue;
+			}
+			compiled = &local_state.Compile(function, UnifiedVectorFormat::GetData<string_t>(expr_format)[expr_idx]);
+		} else if (!compiled) {
+			// Constant NULL expression
+			FlatVector::SetNull(result, i, true);
+			continue;
+		}
+		EvaluateXPath(documents, html_data[html_idx], *compiled, first_only, values);
+		emit(i, values);
+	}
+}
+
+static void XPathFunction(DataChunk &args, ExpressionState &state, Vector &result) {
+	auto result_data = FlatVector::GetData<string_t>(result);
+	XPathExecute(args, state, result, "xpath", true, [&](idx_t row, const vector<string> &values) {
+		if (values.empty()) {
+			FlatVector::SetNull(result, row, true);
+			return;
+		}
+		result_data[row] = StringVector::AddString(result, values[0]);
+	});
+}
+
+static void XPathAllFunction(DataChunk &args, ExpressionState &state, Vector &result) {
+	auto list_data = FlatVector::GetData<list_entry_t>(result);
+	auto &child = ListVector::GetEntry(result);
+	XPathExecute(args, state, result, "xpath_all", false, [&](idx_t row, const vector<string> &values) {
+		auto offset = ListVector::GetListSize(result);
+		ListVector::Reserve(result, offset + values.size());
+		auto child_data = FlatVector::GetData<string_t>(child);
+		for (idx_t v = 0; v < values.size(); v++) {
+			child_data[offset + v] = StringVector::AddString(child, values[v]);
+		}
+		list_data[row] = list_entry_t(offset, values.size());
+		ListVector::SetListSize(result, offset + values.size());
+	});
+}
+
+static unique_ptr<FunctionData> XPathBind(ClientContext &context, ScalarFunction &bound_function,
+                                          vector<unique_ptr<Expression>> &arguments) {
+	auto bind_data = make_uniq<XPathBindData>();
+	auto &expr_arg = arguments[1];
+	if (expr_arg->HasParameter() || !expr_arg->IsFoldable()) {
+		return std::move(bind_data);
+	}
+	bind_data->constant = true;
+	auto expr_value = ExpressionExecutor::EvaluateScalar(context, *expr_arg);
+	if (!expr_value.IsNull()) {
+		bind_data->expr = expr_value.ToString();
+		bind_data->compiled = CompileXPath(bind_data->expr);
+		if (!bind_data->compiled) {
+			throw BinderException("%s: invalid XPath expression '%s'", bound_function.name, bind_data->expr);
+		}
+	}
+	// The compiled expression is baked into the bind data
+	Function::EraseArgument(bound_function, arguments, 1);
+	return std::move(bind_data);
+}
+
+//===--------------------------------------------------------------------===//
+// crawler_xpath_stats()
+//===--------------------------------------------------------------------===//
+
+struct XPathStatsGlobalState : public GlobalTableFunctionState {
+	bool finished = false;
+};
+
+static unique_ptr<FunctionData> XPathStatsBind(ClientContext &context, TableFunctionBindInput &input,
+                                               vector<LogicalType> &return_types, vector<string> &names) {
+	names = {"documents_parsed", "document_hits"};
+	return_types = vector<LogicalType>(names.size(), LogicalType::BIGINT);
+	return make_uniq<TableFunctionData>();
+}
+
+static unique_ptr<GlobalTableFunctionState> XPathStatsInitGlobal(ClientContext &context,
+                                                                 TableFunctionInitInput &input) {
+	return make_uniq<XPathStatsGlobalState>();
+}
+
+// Totals of the finished queries of this connection
+static void XPathStatsFunction(ClientContext &context, TableFunctionInput &data, DataChunk &output) {
+	auto &gstate = data.global_state->Cast<XPathStatsGlobalState>();
+	if (gstate.finished) {
+		output.SetCardinality(0);
+		return;
+	}
+	gstate.finished = true;
+
+	auto documents = context.registered_state->GetOrCreate<XPathQueryDocuments>(XPATH_DOCUMENTS_STATE);
+	output.SetValue(0, 0, Value::BIGINT(static_cast<int64_t>(documents->parses.load())));
+	output.SetValue(1, 0, Value::BIGINT(static_cast<int64_t>(documents->hits.load())));
+	output.SetCardinality(1);
+}
+
+void RegisterXPathFunctions(ExtensionLoader &loader) {
+	// Initialize libxml2 globals once, before any worker thread parses
+	xmlInitParser();
+
+	ScalarFunction xpath_func("xpath", {LogicalType::VARCHAR, LogicalType::VARCHAR}, LogicalType::VARCHAR,
+	                          XPathFunction, XPathBind);
+	xpath_func.init_local_state = XPathInitLocalState;
+	loader.RegisterFunction(xpath_func);
+
+	ScalarFunction xpath_all_func("xpath_all", {LogicalType::VARCHAR, LogicalType::VARCHAR},
+	                              LogicalType::LIST(LogicalType::VARCHAR), XPathAllFunction, XPathBind);
+	xpath_all_func.init_local_state = XPathInitLocalState;
+	loader.RegisterFunction(xpath_all_func);
+
+	TableFunction stats_func("crawler_xpath_stats", {}, XPathStatsFunction, XPathStatsBind, XPathStatsInitGlobal);
+	loader.RegisterFunction(stats_func);
+}
+
+} // namespace duckdb